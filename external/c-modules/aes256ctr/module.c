@@ -4,6 +4,7 @@
 #include "py/obj.h"
 #include "py/runtime.h"
 #include "py/builtin.h"
+#include "py/mphal.h"
 #include "aes_256_ctr.h"
 
 #if MICROPY_ENABLE_DYNRUNTIME
@@ -64,18 +65,143 @@ is_unaligned(const void *p)
     return !!(((uint32_t)p) & 0x3);
 }
 
-STATIC mp_obj_t s_AES256CTR_cipher(mp_obj_t self_in, mp_obj_t buf_in)
+// inc counter (big endian, assumes nonce != ~0)
+    static void inline
+next_ctr(mp_obj_AES256CTR_t *self)
 {
-    mp_obj_AES256CTR_t *self = MP_OBJ_TO_PTR(self_in);
+    uint8_t *ctr = &self->p.ctr[3];
+    while(1) {
+        ctr[0] += 1;
+        if(ctr[0]) break;
+        ctr--;
+    }
+}
 
-    mp_buffer_info_t buf;
-    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_READ);
+// whole blocks, word-aligned buffers only
+//
+// NOTE: the ASM can do many blocks per call, but it counts in the first word of
+// the state (little-endian), and we need standard big-endian counter in the last.
+    static void
+cipher_blocks(mp_obj_AES256CTR_t *self, const uint8_t *inp, uint8_t *outp, int count)
+{
+    for(; count; count--, inp += BLKSIZE, outp += BLKSIZE) {
+        AES_256_encrypt_ctr(&self->p, inp, outp, BLKSIZE);
+        next_ctr(self);
+    }
+}
+
+// blocks per bounce through aligned scratch, when caller's data is unaligned
+#define SCRATCH_BLKS    16
 
-    int len = buf.len, in_len = buf.len;
-    const uint8_t *inp = buf.buf;
-    uint8_t *rv = m_malloc(in_len);
-    uint8_t *outp = rv;
+#ifdef AES
+// Chip has the AES peripheral (Mk4). Worth the setup cost only for longer runs.
+#define HW_MIN_BLKS     4
+
+    static inline uint32_t
+get_be32(const uint8_t *p)
+{
+    return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
 
+// hw_cipher_blocks()
+//
+// Same as cipher_blocks(), but on the AES peripheral, and any alignment is fine.
+// Hardware state is setup and wiped on each call, so objects can interleave and
+// the bootloader (which also uses it) is unaffected. Returns blocks done, which may
+// be less than count: hardware only counts in the last 32 bits, so stop at the wrap,
+// and carry into the nonce ourselves.
+//
+    static int
+hw_cipher_blocks(mp_obj_AES256CTR_t *self, const uint8_t *inp, uint8_t *outp, int count)
+{
+    uint32_t ctr = get_be32(self->p.ctr);
+    uint32_t room = -ctr;
+    if(room && (room < count)) {
+        count = room;
+    }
+
+    __HAL_RCC_AES_CLK_ENABLE();
+
+    // most changes have to be made w/ module disabled
+    AES->CR &= ~AES_CR_EN;
+
+    // AES-256, encrypt, CTR; data is byte-swapped by hardware
+    MODIFY_REG(AES->CR, AES_CR_KEYSIZE | AES_CR_DATATYPE | AES_CR_MODE | AES_CR_CHMOD,
+                    AES_CR_KEYSIZE | AES_CR_DATATYPE_1 | AES_CR_CHMOD_1);
+
+    // raw key is kept at start of rk[]
+    const uint8_t *k = self->p.rk;
+    AES->KEYR7 = get_be32(k+0);
+    AES->KEYR6 = get_be32(k+4);
+    AES->KEYR5 = get_be32(k+8);
+    AES->KEYR4 = get_be32(k+12);
+    AES->KEYR3 = get_be32(k+16);
+    AES->KEYR2 = get_be32(k+20);
+    AES->KEYR1 = get_be32(k+24);
+    AES->KEYR0 = get_be32(k+28);
+
+    const uint8_t *n = self->p.nonce;
+    AES->IVR3 = get_be32(n+0);
+    AES->IVR2 = get_be32(n+4);
+    AES->IVR1 = get_be32(n+8);
+    AES->IVR0 = ctr;
+
+    AES->CR |= AES_CR_EN;
+
+    for(int i=0; i<count; i++) {
+        uint32_t    tmp[4];
+
+        memcpy(tmp, inp, BLKSIZE);
+        AES->DINR = tmp[0];
+        AES->DINR = tmp[1];
+        AES->DINR = tmp[2];
+        AES->DINR = tmp[3];
+
+        while(!(AES->SR & AES_SR_CCF)) {
+            // very short wait
+        }
+        SET_BIT(AES->CR, AES_CR_CCFC);
+
+        tmp[0] = AES->DOUTR;
+        tmp[1] = AES->DOUTR;
+        tmp[2] = AES->DOUTR;
+        tmp[3] = AES->DOUTR;
+        memcpy(outp, tmp, BLKSIZE);
+
+        inp += BLKSIZE;
+        outp += BLKSIZE;
+    }
+
+    // reset state of chip block (clears key), and leave clock off as well
+    __HAL_RCC_AES_FORCE_RESET();
+    __HAL_RCC_AES_RELEASE_RESET();
+    __HAL_RCC_AES_CLK_DISABLE();
+
+    // our copy of the counter
+    ctr += count;
+    self->p.ctr[0] = ctr >> 24;
+    self->p.ctr[1] = ctr >> 16;
+    self->p.ctr[2] = ctr >> 8;
+    self->p.ctr[3] = ctr;
+
+    if(!ctr) {
+        // wrapped: carry into nonce, same as next_ctr()
+        uint8_t *n = &self->p.nonce[11];
+        while(1) {
+            n[0] += 1;
+            if(n[0]) break;
+            n--;
+        }
+    }
+
+    return count;
+}
+#endif
+
+// en/decrypt len bytes from inp into outp; they may be the same buffer
+    STATIC void
+do_cipher(mp_obj_AES256CTR_t *self, const uint8_t *inp, uint8_t *outp, int in_len)
+{
     if(self->runt_len) {
         // we've already encrypted (w/ zero bytes) for this part
         uint8_t *ch = &self->runt[BLKSIZE - self->runt_len];
@@ -86,48 +212,84 @@ STATIC mp_obj_t s_AES256CTR_cipher(mp_obj_t self_in, mp_obj_t buf_in)
         }
     }
 
-    bool nogood = (is_unaligned(inp) || is_unaligned(outp));
-
-    while(in_len) {
-        if(in_len >= BLKSIZE) {
-            if(nogood) {
-                uint8_t     blk[BLKSIZE];
-
-                // align data so ASM can work
-                memcpy(blk, inp, BLKSIZE);
-                AES_256_encrypt_ctr(&self->p, blk, blk, BLKSIZE);
-                memcpy(outp, blk, BLKSIZE);
-            } else {
-                // rare? but faster case
-                AES_256_encrypt_ctr(&self->p, inp, outp, BLKSIZE);
-            }
-
-            outp += BLKSIZE;
-            inp += BLKSIZE;
-            in_len -= BLKSIZE;
-        } else {
-            uint8_t     blk[BLKSIZE] = {};
-            memcpy(blk, inp, in_len);
-
-            AES_256_encrypt_ctr(&self->p, blk, self->runt, BLKSIZE);
-            memcpy(outp, self->runt, in_len);
-            self->runt_len = BLKSIZE - in_len;
-            in_len = 0;
-        }
-        
-        // inc counter (big endian, assumes nonce != ~0)
-        uint8_t *ctr = &self->p.ctr[3];
-        while(1) {
-            ctr[0] += 1;
-            if(ctr[0]) break;
-            ctr--;
+    int count = in_len / BLKSIZE;
+    in_len -= count * BLKSIZE;
+
+#ifdef AES
+    if(count >= HW_MIN_BLKS) {
+        int done = hw_cipher_blocks(self, inp, outp, count);
+
+        inp += done * BLKSIZE;
+        outp += done * BLKSIZE;
+        count -= done;
+    }
+#endif
+
+    if(!is_unaligned(inp) && !is_unaligned(outp)) {
+        // typical case, and fastest
+        cipher_blocks(self, inp, outp, count);
+        inp += count * BLKSIZE;
+        outp += count * BLKSIZE;
+    } else {
+        // align data so ASM can work, many blocks at once
+        uint32_t    scratch[SCRATCH_BLKS * BLKSIZE / 4];
+
+        while(count) {
+            int here = MIN(count, SCRATCH_BLKS);
+            int ln = here * BLKSIZE;
+
+            memcpy(scratch, inp, ln);
+            cipher_blocks(self, (uint8_t *)scratch, (uint8_t *)scratch, here);
+            memcpy(outp, scratch, ln);
+
+            inp += ln;
+            outp += ln;
+            count -= here;
         }
     }
 
-    return mp_obj_new_bytearray_by_ref(len, rv);
+    if(in_len) {
+        // partial block at end; keep rest of keystream for next call
+        uint8_t     blk[BLKSIZE] = {};
+        memcpy(blk, inp, in_len);
+
+        AES_256_encrypt_ctr(&self->p, blk, self->runt, BLKSIZE);
+        memcpy(outp, self->runt, in_len);
+        self->runt_len = BLKSIZE - in_len;
+
+        next_ctr(self);
+    }
+}
+
+STATIC mp_obj_t s_AES256CTR_cipher(mp_obj_t self_in, mp_obj_t buf_in)
+{
+    mp_obj_AES256CTR_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_READ);
+
+    uint8_t *rv = m_malloc(buf.len);
+
+    do_cipher(self, buf.buf, rv, buf.len);
+
+    return mp_obj_new_bytearray_by_ref(buf.len, rv);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(s_AES256CTR_cipher_obj, s_AES256CTR_cipher);
 
+STATIC mp_obj_t s_AES256CTR_cipher_into(mp_obj_t self_in, mp_obj_t buf_in)
+{
+    // same as cipher(), but works in-place: no allocation
+    mp_obj_AES256CTR_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_RW);
+
+    do_cipher(self, buf.buf, buf.buf, buf.len);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(s_AES256CTR_cipher_into_obj, s_AES256CTR_cipher_into);
+
 STATIC mp_obj_t s_AES256CTR_copy(mp_obj_t self_in) {
     mp_obj_AES256CTR_t *self = MP_OBJ_TO_PTR(self_in);
 
@@ -152,8 +314,22 @@ STATIC mp_obj_t s_AES256CTR_blank(mp_obj_t self_in) {
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(s_AES256CTR_blank_obj, s_AES256CTR_blank);
 
 
+// backend()
+//
+// Report what will be used for longer runs of data: "hw" or "sw".
+//
+STATIC mp_obj_t s_AES256CTR_backend(void) {
+#ifdef AES
+    return MP_OBJ_NEW_QSTR(MP_QSTR_hw);
+#else
+    return MP_OBJ_NEW_QSTR(MP_QSTR_sw);
+#endif
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(s_AES256CTR_backend_obj, s_AES256CTR_backend);
+
 STATIC const mp_rom_map_elem_t s_AES256CTR_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_cipher), MP_ROM_PTR(&s_AES256CTR_cipher_obj) },
+    { MP_ROM_QSTR(MP_QSTR_cipher_into), MP_ROM_PTR(&s_AES256CTR_cipher_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_blank), MP_ROM_PTR(&s_AES256CTR_blank_obj) },
     { MP_ROM_QSTR(MP_QSTR_blank), MP_ROM_PTR(&s_AES256CTR_blank_obj) },
     { MP_ROM_QSTR(MP_QSTR_copy), MP_ROM_PTR(&s_AES256CTR_copy_obj) },
@@ -173,6 +349,7 @@ STATIC const mp_rom_map_elem_t mp_module_aes256ctr_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_aes256ctr) },
 
     { MP_ROM_QSTR(MP_QSTR_new), MP_ROM_PTR(&s_AES256CTR_type) },
+    { MP_ROM_QSTR(MP_QSTR_backend), MP_ROM_PTR(&s_AES256CTR_backend_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(mp_module_aes256ctr_globals, mp_module_aes256ctr_globals_table);
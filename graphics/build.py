@@ -52,6 +52,28 @@ def compress(n, wbits=-9):
     rv += z.flush(zlib.Z_FINISH)
     return rv
 
+def packbits(n):
+    # PackBits-style RLE, see unpack_rle() in shared/display.py
+    # - 0..127: copy next N+1 bytes; 129..255: repeat next byte 257-N times
+    rv = b''
+    i = 0
+    while i < len(n):
+        j = i
+        while j < len(n) and j-i < 128 and n[j] == n[i]:
+            j += 1
+        if j-i >= 2:
+            rv += bytes([257-(j-i), n[i]])
+            i = j
+            continue
+
+        j = i
+        while j < len(n) and j-i < 128 and not (j+1 < len(n) and n[j] == n[j+1]):
+            j += 1
+        rv += bytes([j-i-1]) + n[i:j]
+        i = j
+
+    return rv
+
 def crunch(n):
     # try them all... not finding any difference tho.
     a = [(wb,compress(n, wb)) for wb in range(-9, -15, -1)]
@@ -76,6 +98,7 @@ def doit(outfname, fnames):
 #
 class Graphics:
     # (w,h, w_bytes, wbits, data)
+    # - wbits: 0=raw bitmap, 1=packbits RLE, else zlib window bits
 
 """)
 
@@ -101,6 +124,12 @@ class Graphics:
             # disable; taking too much runtime memory
             is_comp = False
 
+        if not is_comp:
+            # RLE is cheap to decode and needs no extra memory; use if it helps
+            rle = packbits(raw)
+            if len(rle)+8 < len(raw):
+                wbits, comp, is_comp = 1, rle, True
+
         print("    %s = (%d, %d,  %d, %s, %r)\n" % (varname, w, h, ((w+7)//8),
                         wbits if is_comp else 0, raw if not is_comp else comp), file=fp)
 
@@ -2,6 +2,7 @@
 #
 class Graphics:
     # (w,h, w_bytes, wbits, data)
+    # - wbits: 0=raw bitmap, 1=packbits RLE, else zlib window bits
 
     arrow_down = (7, 11,  1, 0, b'\x10\x10\x10\x10\x10\x10\x10\xfe|8\x10')
 
@@ -17,7 +18,7 @@ class Graphics:
 
     space = (9, 2,  2, 0, b'\x80\x80\xff\x80')
 
-    spin = (13, 36,  2, 0, b'\x02\x00\x07\x00\x0f\x80\x1f\xc0\x00\x00\x00\x00\x00\x00\xf2x\x80\x08\x80\x08\x80\x08\x00\x00\x00\x00\x80\x08\x00\x00\x00\x00\x00\x00\x80\x08\x00\x00\x00\x00\x00\x00\x80\x08\x00\x00\x00\x00\x80\x08\x80\x08\x80\x08\xf2x\x00\x00\x00\x00\x00\x00\x1f\xc0\x0f\x80\x07\x00\x02\x00\x00\x00')
+    spin = (13, 36,  2, 1, b'\x07\x02\x00\x07\x00\x0f\x80\x1f\xc0\xfb\x00\x07\xf2x\x80\x08\x80\x08\x80\x08\xfd\x00\x01\x80\x08\xfb\x00\x01\x80\x08\xfb\x00\x01\x80\x08\xfd\x00\x07\x80\x08\x80\x08\x80\x08\xf2x\xfb\x00\x06\x1f\xc0\x0f\x80\x07\x00\x02\xfe\x00')
 
     wedge = (6, 11,  1, 0, b'\x00\x00\xc0\xe0p8\x1c8p\xe0\xc0')
 
@@ -2,14 +2,15 @@
 #
 class Graphics:
     # (w,h, w_bytes, wbits, data)
+    # - wbits: 0=raw bitmap, 1=packbits RLE, else zlib window bits
 
-    mk4_nfc_1 = (126, 49,  16, 0, b'\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x0e\x00\xe0\x0e\x03\xff\xff\xff\xff\xff\xff\xff\xff\x80\x00\xe0\x0e\x00\xe0\x0e\x07\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xe0\x0e\x00\xe0\x0e\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x000D\x04\x10\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x000D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00(D\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00(D\x04\x00\x00\x00xp\x00\xff\xff\xff\xff\xfe0\x00$G\xe4\x00\x00\x00xp\x00\xff\xff\xff\xff\xfe0\x00$G\xe4\x00\x00\x00xp\x00\xe0\x0e\x00\xe0\x0e0\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x00\xe0\x0e0\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x00\xe0\x0e0\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xff\xff\xff\xff\xfe0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e?\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xff\xff\xff\xff\xfe\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xc0\x00\xff\xff\xff\xff\xfe\x0f\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00?\xff\xff\xff\xf8\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00')
+    mk4_nfc_1 = (126, 49,  16, 1, b'\x01\x00\x7f\xfe\xff\x00\xfc\xf6\x00\xfd\xff\x00\xfe\xf6\x00\xfd\xff\x00\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\x04\xe0\x00\x03\xcf\xfe\xf6\x00\x04\xe0\x00\x03\xcf\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\x04\xe0\x00\x03\xcf\xfe\xf6\x00\x04\xe0\x00\x03\xcf\xfe\xf6\x00\x04\xe0\x00\x03\xff\xfe\xf6\x00\xfd\xff\x00\xfe\xf6\x00\xfd\xff\x00\xfe\xf6\x00\xfd\xff\x00\xfe\xf6\x00\xfd\xff\x00\xfe\xf6\x00\x05\xe0\x0e\x00\xe0\x0e\x03\xf9\xff\x07\x80\x00\xe0\x0e\x00\xe0\x0e\x07\xf9\xff\x07\xe0\x00\xe0\x0e\x00\xe0\x0e\x1f\xf9\xff\x07\xf0\x00\xe0\x0e\x00\xe0\x0e0\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x01\xfe0\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x01\xfe0\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x01\xfe0\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x01\xfe0\xfa\x00\r\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 G\xe3\xe0\xff\x00\r\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 G\xe3\xe0\xff\x00\r\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x000D\x04\x10\xff\x00\r\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x000D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x05\xfe0\x00(D\x04\xfe\x00\x02\x7f\xf0\x00\xfd\xff\x05\xfe0\x00(D\x04\xfe\x00\x02xp\x00\xfd\xff\x05\xfe0\x00$G\xe4\xfe\x00\x02xp\x00\xfd\xff\x05\xfe0\x00$G\xe4\xfe\x00\x0cxp\x00\xe0\x0e\x00\xe0\x0e0\x00"D\x04\xfe\x00\x0cxp\x00\xe0\x0e\x00\xe0\x0e0\x00"D\x04\xfe\x00\x0cxp\x00\xe0\x0e\x00\xe0\x0e0\x00 \xc4\x04\xfe\x00\x0c\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\x00 \xc4\x04\xfe\x00\x02\x7f\xf0\x00\xfd\xff\x06\xfe0\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x06\xfe0\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x06\xfe0\x00 D\x03\xe0\xff\x00\x02\x7f\xf0\x00\xfd\xff\x06\xfe0\x00 D\x03\xe0\xff\x00\x08\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\xfa\x00\x08\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\xfa\x00\x08\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e0\xfa\x00\x08\x7f\xf0\x00\xe0\x0e\x00\xe0\x0e?\xf9\xff\x01\xe0\x00\xfd\xff\x01\xfe\x1f\xf9\xff\x01\xc0\x00\xfd\xff\x01\xfe\x0f\xf9\xff\xff\x00\x00\x7f\xfe\xff\x00\xfc\xf6\x00\x00?\xfe\xff\x00\xf8\xf7\x00')
 
-    mk4_nfc_2 = (118, 49,  15, 0, b'\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xe0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x0e\x00\xe0\x03\xff\xff\xff\xff\xff\xff\xff\xff\x80\x00\xe0\x0e\x00\xe0\x07\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xe0\x0e\x00\xe0\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xf0\x00\xe0\x0e\x00\xe00\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x000D\x04\x10\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x000D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00(D\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00(D\x04\x00\x00\x00xp\x00\xff\xff\xff\xff0\x00$G\xe4\x00\x00\x00xp\x00\xff\xff\xff\xff0\x00$G\xe4\x00\x00\x00xp\x00\xe0\x0e\x00\xe00\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x00\xe00\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x00\xe00\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xff\xff\xff\xff0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe00\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00\xe0?\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xff\xff\xff\xff\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xc0\x00\xff\xff\xff\xff\x0f\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00?\xff\xff\xff\xf8\x00\x00\x00\x00\x00\x00\x00\x00\x00')
+    mk4_nfc_2 = (118, 49,  15, 1, b'\x01\x00\x7f\xfe\xff\x00\xfc\xf7\x00\xfd\xff\x00\xfe\xf7\x00\xfd\xff\x00\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\x04\xe0\x00\x03\xcf\xfe\xf7\x00\x04\xe0\x00\x03\xcf\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\x04\xe0\x00\x03\xcf\xfe\xf7\x00\x04\xe0\x00\x03\xcf\xfe\xf7\x00\x04\xe0\x00\x03\xff\xfe\xf7\x00\xfd\xff\x00\xfe\xf7\x00\xfd\xff\x00\xfe\xf7\x00\xfd\xff\x00\xfe\xf7\x00\xfd\xff\x00\xe0\xf7\x00\x04\xe0\x0e\x00\xe0\x03\xf9\xff\x06\x80\x00\xe0\x0e\x00\xe0\x07\xf9\xff\x06\xe0\x00\xe0\x0e\x00\xe0\x1f\xf9\xff\x06\xf0\x00\xe0\x0e\x00\xe00\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfd\xff\x000\xfa\x00\x0c\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 G\xe3\xe0\xff\x00\x0c\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 G\xe3\xe0\xff\x00\x0c\x7f\xf0\x00\xe0\x0e\x00\xe00\x000D\x04\x10\xff\x00\x0c\x7f\xf0\x00\xe0\x0e\x00\xe00\x000D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x040\x00(D\x04\xfe\x00\x02\x7f\xf0\x00\xfd\xff\x040\x00(D\x04\xfe\x00\x02xp\x00\xfd\xff\x040\x00$G\xe4\xfe\x00\x02xp\x00\xfd\xff\x040\x00$G\xe4\xfe\x00\x0bxp\x00\xe0\x0e\x00\xe00\x00"D\x04\xfe\x00\x0bxp\x00\xe0\x0e\x00\xe00\x00"D\x04\xfe\x00\x0bxp\x00\xe0\x0e\x00\xe00\x00 \xc4\x04\xfe\x00\x0b\x7f\xf0\x00\xe0\x0e\x00\xe00\x00 \xc4\x04\xfe\x00\x02\x7f\xf0\x00\xfd\xff\x050\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x050\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfd\xff\x050\x00 D\x03\xe0\xff\x00\x02\x7f\xf0\x00\xfd\xff\x050\x00 D\x03\xe0\xff\x00\x07\x7f\xf0\x00\xe0\x0e\x00\xe00\xfa\x00\x07\x7f\xf0\x00\xe0\x0e\x00\xe00\xfa\x00\x07\x7f\xf0\x00\xe0\x0e\x00\xe00\xfa\x00\x07\x7f\xf0\x00\xe0\x0e\x00\xe0?\xf9\xff\x01\xe0\x00\xfd\xff\x00\x1f\xf9\xff\x01\xc0\x00\xfd\xff\x00\x0f\xf9\xff\xff\x00\x00\x7f\xfe\xff\x00\xfc\xf7\x00\x00?\xfe\xff\x00\xf8\xf8\x00')
 
-    mk4_nfc_3 = (110, 49,  14, 0, b'\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xf0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x0e\x00\x03\xff\xff\xff\xff\xff\xff\xff\xff\x80\x00\xe0\x0e\x00\x07\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xe0\x0e\x00\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xf0\x00\xe0\x0e\x000\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x000D\x04\x10\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x000D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00(D\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00(D\x04\x00\x00\x00xp\x00\xff\xff\xff0\x00$G\xe4\x00\x00\x00xp\x00\xff\xff\xff0\x00$G\xe4\x00\x00\x00xp\x00\xe0\x0e\x000\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x000\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e\x000\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xff\xff\xff0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x000\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e\x00?\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xff\xff\xff\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xc0\x00\xff\xff\xff\x0f\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x7f\xff\xff\xc0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00?\xff\xff\xff\xf8\x00\x00\x00\x00\x00\x00\x00\x00')
+    mk4_nfc_3 = (110, 49,  14, 1, b'\x01\x00\x7f\xfe\xff\x00\xfc\xf8\x00\xfd\xff\x00\xfe\xf8\x00\xfd\xff\x00\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\x04\xe0\x00\x03\xcf\xfe\xf8\x00\x04\xe0\x00\x03\xcf\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\x04\xe0\x00\x03\xcf\xfe\xf8\x00\x04\xe0\x00\x03\xcf\xfe\xf8\x00\x04\xe0\x00\x03\xff\xfe\xf8\x00\xfd\xff\x00\xfe\xf8\x00\xfd\xff\x00\xfe\xf8\x00\xfd\xff\x00\xfe\xf8\x00\xfe\xff\x00\xf0\xf7\x00\x03\xe0\x0e\x00\x03\xf9\xff\x05\x80\x00\xe0\x0e\x00\x07\xf9\xff\x05\xe0\x00\xe0\x0e\x00\x1f\xf9\xff\x05\xf0\x00\xe0\x0e\x000\xfa\x00\x02\x7f\xf0\x00\xfe\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfe\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfe\xff\x000\xfa\x00\x02\x7f\xf0\x00\xfe\xff\x000\xfa\x00\x0b\x7f\xf0\x00\xe0\x0e\x000\x00 G\xe3\xe0\xff\x00\x0b\x7f\xf0\x00\xe0\x0e\x000\x00 G\xe3\xe0\xff\x00\x0b\x7f\xf0\x00\xe0\x0e\x000\x000D\x04\x10\xff\x00\x0b\x7f\xf0\x00\xe0\x0e\x000\x000D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfe\xff\x040\x00(D\x04\xfe\x00\x02\x7f\xf0\x00\xfe\xff\x040\x00(D\x04\xfe\x00\x02xp\x00\xfe\xff\x040\x00$G\xe4\xfe\x00\x02xp\x00\xfe\xff\x040\x00$G\xe4\xfe\x00\nxp\x00\xe0\x0e\x000\x00"D\x04\xfe\x00\nxp\x00\xe0\x0e\x000\x00"D\x04\xfe\x00\nxp\x00\xe0\x0e\x000\x00 \xc4\x04\xfe\x00\n\x7f\xf0\x00\xe0\x0e\x000\x00 \xc4\x04\xfe\x00\x02\x7f\xf0\x00\xfe\xff\x050\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfe\xff\x050\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xfe\xff\x050\x00 D\x03\xe0\xff\x00\x02\x7f\xf0\x00\xfe\xff\x050\x00 D\x03\xe0\xff\x00\x06\x7f\xf0\x00\xe0\x0e\x000\xfa\x00\x06\x7f\xf0\x00\xe0\x0e\x000\xfa\x00\x06\x7f\xf0\x00\xe0\x0e\x000\xfa\x00\x06\x7f\xf0\x00\xe0\x0e\x00?\xf9\xff\x01\xe0\x00\xfe\xff\x00\x1f\xf9\xff\x01\xc0\x00\xfe\xff\x00\x0f\xf9\xff\xff\x00\x00\x7f\xff\xff\x00\xc0\xf7\x00\x00?\xfe\xff\x00\xf8\xf9\x00')
 
-    mk4_nfc_4 = (102, 49,  13, 0, b'\x00\x7f\xff\xff\xff\xfc\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xcf\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x00\x03\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\xfe\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xf0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xe0\x0e\x03\xff\xff\xff\xff\xff\xff\xff\xff\x80\x00\xe0\x0e\x07\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xe0\x0e\x1f\xff\xff\xff\xff\xff\xff\xff\xff\xf0\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e0\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e0\x00 G\xe3\xe0\x00\x00\x7f\xf0\x00\xe0\x0e0\x000D\x04\x10\x00\x00\x7f\xf0\x00\xe0\x0e0\x000D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00(D\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00(D\x04\x00\x00\x00xp\x00\xff\xff\xb0\x00$G\xe4\x00\x00\x00xp\x00\xff\xff\xb0\x00$G\xe4\x00\x00\x00xp\x00\xe0\x0e0\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e0\x00"D\x04\x00\x00\x00xp\x00\xe0\x0e0\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xe0\x0e0\x00 \xc4\x04\x00\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00 D\x04\x10\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xff\xff\xb0\x00 D\x03\xe0\x00\x00\x7f\xf0\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e0\x00\x00\x00\x00\x00\x00\x00\x7f\xf0\x00\xe0\x0e?\xff\xff\xff\xff\xff\xff\xff\xff\xe0\x00\xff\xff\x9f\xff\xff\xff\xff\xff\xff\xff\xff\xc0\x00\xff\xff\x8f\xff\xff\xff\xff\xff\xff\xff\xff\x00\x00\x7f\xff\xc0\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00?\xff\xff\xff\xf8\x00\x00\x00\x00\x00\x00\x00')
+    mk4_nfc_4 = (102, 49,  13, 1, b'\x01\x00\x7f\xfe\xff\x00\xfc\xf9\x00\xfd\xff\x00\xfe\xf9\x00\xfd\xff\x00\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\x04\xe0\x00\x03\xcf\xfe\xf9\x00\x04\xe0\x00\x03\xcf\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\x04\xe0\x00\x03\xcf\xfe\xf9\x00\x04\xe0\x00\x03\xcf\xfe\xf9\x00\x04\xe0\x00\x03\xff\xfe\xf9\x00\xfd\xff\x00\xfe\xf9\x00\xfd\xff\x00\xfe\xf9\x00\xfd\xff\x00\xfe\xf9\x00\xff\xff\x00\xf0\xf7\x00\x02\xe0\x0e\x03\xf9\xff\x04\x80\x00\xe0\x0e\x07\xf9\xff\x04\xe0\x00\xe0\x0e\x1f\xf9\xff\x04\xf0\x00\xe0\x0e0\xfa\x00\x02\x7f\xf0\x00\xff\xff\x00\xb0\xfa\x00\x02\x7f\xf0\x00\xff\xff\x00\xb0\xfa\x00\x02\x7f\xf0\x00\xff\xff\x00\xb0\xfa\x00\x02\x7f\xf0\x00\xff\xff\x00\xb0\xfa\x00\n\x7f\xf0\x00\xe0\x0e0\x00 G\xe3\xe0\xff\x00\n\x7f\xf0\x00\xe0\x0e0\x00 G\xe3\xe0\xff\x00\n\x7f\xf0\x00\xe0\x0e0\x000D\x04\x10\xff\x00\n\x7f\xf0\x00\xe0\x0e0\x000D\x04\x10\xff\x00\x02\x7f\xf0\x00\xff\xff\x04\xb0\x00(D\x04\xfe\x00\x02\x7f\xf0\x00\xff\xff\x04\xb0\x00(D\x04\xfe\x00\x02xp\x00\xff\xff\x04\xb0\x00$G\xe4\xfe\x00\x02xp\x00\xff\xff\x04\xb0\x00$G\xe4\xfe\x00\txp\x00\xe0\x0e0\x00"D\x04\xfe\x00\txp\x00\xe0\x0e0\x00"D\x04\xfe\x00\txp\x00\xe0\x0e0\x00 \xc4\x04\xfe\x00\t\x7f\xf0\x00\xe0\x0e0\x00 \xc4\x04\xfe\x00\x02\x7f\xf0\x00\xff\xff\x05\xb0\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xff\xff\x05\xb0\x00 D\x04\x10\xff\x00\x02\x7f\xf0\x00\xff\xff\x05\xb0\x00 D\x03\xe0\xff\x00\x02\x7f\xf0\x00\xff\xff\x05\xb0\x00 D\x03\xe0\xff\x00\x05\x7f\xf0\x00\xe0\x0e0\xfa\x00\x05\x7f\xf0\x00\xe0\x0e0\xfa\x00\x05\x7f\xf0\x00\xe0\x0e0\xfa\x00\x05\x7f\xf0\x00\xe0\x0e?\xf9\xff\x01\xe0\x00\xff\xff\x00\x9f\xf9\xff\x01\xc0\x00\xff\xff\x00\x8f\xf9\xff\xff\x00\x02\x7f\xff\xc0\xf7\x00\x00?\xfe\xff\x00\xf8\xfa\x00')
 
 
 # EOF
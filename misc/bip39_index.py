@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# Build shared/bip39_index.py: a prefix table for the BIP-39 English wordlist,
+# used by seed.next_char() during word entry.
+#
+#   cd misc; ./bip39_index.py
+#
+# - every word is unique by 4 letters; only shorter prefixes need a node
+# - NODES: per ambiguous prefix (in BFS order, root first), struct '<IH':
+#       bits 0..25: next letters possible, bit 26: prefix is itself a word,
+#       then index of first child in KIDS
+# - KIDS: one '<H' per next letter, in letter order: either 0x8000|node number,
+#       or the word number when only one word remains
+#
+import os, sys, struct
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), '../docs'))
+from rolls import wl
+
+PREFIX_MARKER = 1 << 26
+IS_NODE = 0x8000
+
+def build(words):
+    assert len(words) == 2048 and words == sorted(words)
+
+    def matches(pfx):
+        return [n for n, w in enumerate(words) if w.startswith(pfx)]
+
+    nodes = ['']
+    index = {'': 0}
+    i = 0
+    while i < len(nodes):
+        pfx = nodes[i]
+        for ch in sorted(set(w[len(pfx)] for w in words if w.startswith(pfx) and w != pfx)):
+            if len(matches(pfx + ch)) > 1:
+                index[pfx + ch] = len(nodes)
+                nodes.append(pfx + ch)
+        i += 1
+
+    assert len(nodes) < IS_NODE
+
+    rec = b''
+    kids = []
+    for pfx in nodes:
+        mask = 0
+        base = len(kids)
+        for ch in sorted(set(w[len(pfx)] for w in words if w.startswith(pfx) and w != pfx)):
+            mask |= 1 << (ord(ch) - 97)
+            if pfx + ch in index:
+                kids.append(IS_NODE | index[pfx + ch])
+            else:
+                kids.append(matches(pfx + ch)[0])
+
+        if pfx in words:
+            mask |= PREFIX_MARKER
+
+        rec += struct.pack('<IH', mask, base)
+
+    return rec, struct.pack('<%dH' % len(kids), *kids), len(nodes)
+
+def main():
+    nodes, kids, count = build(wl)
+
+    fn = os.path.normpath(os.path.join(os.path.dirname(__file__), '../shared/bip39_index.py'))
+    with open(fn, 'wt') as fd:
+        print("# autogen'ed. don't edit", file=fd)
+        print("#", file=fd)
+        print("# cmdline: misc/bip39_index.py", file=fd)
+        print("#", file=fd)
+        print("# %d nodes, %d kids, see misc/bip39_index.py for layout" % (count, len(kids)//2),
+                    file=fd)
+        print("#", file=fd)
+        print("NODES = %r" % nodes, file=fd)
+        print("KIDS = %r" % kids, file=fd)
+        print("\n# EOF", file=fd)
+
+    print("Wrote: %s (%d bytes of tables)" % (fn, len(nodes) + len(kids)))
+
+if __name__ == '__main__':
+    main()
+
+# EOF
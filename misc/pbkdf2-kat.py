@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# Known-answer test for stm32/COLDCARD_MK4/pbkdf2_sha512.c, on the host: builds
+# the C code as a shared library (with stub micropython headers) and compares
+# against hashlib.pbkdf2_hmac('sha512').
+#
+#   cd misc; ./pbkdf2-kat.py
+#
+# - key lengths 0..300 cover the hashed-key case (over 128 bytes)
+# - salt lengths around the padding edges of one and two blocks
+# - 1, 2 and 2048 rounds; the last is what BIP-39 uses
+#
+import os, sys, ctypes, hashlib, subprocess, tempfile
+
+SRC = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                    '../stm32/COLDCARD_MK4/pbkdf2_sha512.c')
+
+# just enough of micropython to compile, binding is not used
+STUB = '''\
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+typedef void *mp_obj_t;
+typedef intptr_t mp_int_t;
+typedef struct { void *buf; size_t len; } mp_buffer_info_t;
+#define MP_BUFFER_READ 1
+#define STATIC static
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MP_DEFINE_CONST_FUN_OBJ_3(obj, fn) void *obj = (void *)fn
+static inline void mp_get_buffer_raise(mp_obj_t o, mp_buffer_info_t *b, int f) { }
+static inline mp_int_t mp_obj_get_int(mp_obj_t o) { return 0; }
+static inline void mp_raise_ValueError(const char *m) { }
+static inline mp_obj_t mp_obj_new_bytes(const uint8_t *d, size_t n) { return 0; }
+'''
+
+WRAPPER = '''\
+#include "%s"
+
+void kat_pbkdf2_sha512(const uint8_t *pw, size_t pw_len, const uint8_t *salt,
+                        size_t salt_len, uint32_t iterations, uint8_t out[64])
+{
+    pbkdf2_sha512_block(pw, pw_len, salt, salt_len, iterations, out);
+}
+'''
+
+def build(tmp):
+    os.makedirs(os.path.join(tmp, 'py'))
+    for fn in ('obj.h', 'runtime.h'):
+        with open(os.path.join(tmp, 'py', fn), 'wt') as fd:
+            fd.write(STUB if fn == 'obj.h' else '#include "obj.h"\n')
+
+    wrap = os.path.join(tmp, 'kat.c')
+    with open(wrap, 'wt') as fd:
+        fd.write(WRAPPER % os.path.abspath(SRC))
+
+    lib = os.path.join(tmp, 'kat.so')
+    subprocess.check_call([os.environ.get('CC', 'cc'), '-O2', '-shared', '-fPIC',
+                            '-I', tmp, '-o', lib, wrap])
+
+    rv = ctypes.CDLL(lib)
+    rv.kat_pbkdf2_sha512.argtypes = [ctypes.c_char_p, ctypes.c_size_t, ctypes.c_char_p,
+                                        ctypes.c_size_t, ctypes.c_uint32, ctypes.c_char_p]
+    return rv
+
+def main():
+    with tempfile.TemporaryDirectory() as tmp:
+        lib = build(tmp)
+
+        def native(pw, salt, iterations):
+            out = ctypes.create_string_buffer(64)
+            lib.kat_pbkdf2_sha512(pw, len(pw), salt, len(salt), iterations, out)
+            return out.raw
+
+        count = 0
+        for iterations in (1, 2, 2048):
+            for pw_len in range(0, 301, 1 if iterations < 2048 else 37):
+                pw = bytes((i * 7 + pw_len) & 0xff for i in range(pw_len))
+                for salt_len in (0, 1, 8, 107, 108, 111, 112, 128, 235, 236, 240):
+                    salt = bytes((i * 3 + 1) & 0xff for i in range(salt_len))
+
+                    got = native(pw, salt, iterations)
+                    expect = hashlib.pbkdf2_hmac('sha512', pw, salt, iterations)
+                    if got != expect:
+                        print('FAIL: pw_len=%d salt_len=%d iterations=%d'
+                                    % (pw_len, salt_len, iterations))
+                        sys.exit(1)
+                    count += 1
+
+    print('%d cases ok' % count)
+
+if __name__ == '__main__':
+    main()
+
+# EOF
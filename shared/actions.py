@@ -226,8 +226,9 @@ async def microsd_upgrade(menu, label, item):
     # - reboot into bootloader, which finishes install
     from glob import dis, PSRAM
     from files import dfu_parse
-    from utils import check_firmware_hdr
-    from sigheader import FW_HEADER_OFFSET, FW_HEADER_SIZE, FW_MAX_LENGTH_MK4
+    from utils import check_firmware_hdr, check_firmware_sig, firmware_digest_more
+    from sigheader import FW_HEADER_OFFSET, FW_HEADER_SIZE, FW_MAX_LENGTH_MK4, FWH_PY_FORMAT
+    from ustruct import unpack_from
 
     force_vdisk = item.arg
     fn = await file_picker('Pick firmware image to use (.DFU)', suffix='.dfu',
@@ -253,22 +254,32 @@ async def microsd_upgrade(menu, label, item):
             failed = check_firmware_hdr(hdr, size)
 
             if not failed:
-                # copy binary into PSRAM
+                # copy binary into PSRAM: read from card straight into mapped
+                # PSRAM (no bounce buffer), and hash as we go
                 fp.seek(offset)
 
                 dis.fullscreen("Loading...")
 
-                buf = bytearray(0x20000)
+                fw_len = unpack_from(FWH_PY_FORMAT, hdr)[4]
+                h = sha256()
                 pos = 0
                 while pos < size:
                     dis.progress_bar_show(pos/size)
 
-                    here = fp.readinto(buf)
+                    ln = min(0x10000, size - pos)
+                    dest = PSRAM.write_at(pos, (ln + 3) & ~3)
+                    here = fp.readinto(dest)
                     if not here: break
 
-                    PSRAM.write(pos, buf)
+                    firmware_digest_more(h, pos, dest[0:here], fw_len)
                     pos += here
 
+                # same check bootloader will do, but fail now rather than after reboot
+                if pos < size:
+                    failed = "File is truncated."
+                else:
+                    failed = check_firmware_sig(hdr, sha256(h.digest()).digest())
+
     if failed:
         await ux_show_story(failed, title='Sorry!')
         return
@@ -941,9 +952,10 @@ async def start_login_sequence():
     # do not offer HSM if wallet is blank -> HSM needs secret
     if not pa.is_secret_blank():
         try:
-            import hsm, hsm_ux
+            from utils import hsm_policy_available
 
-            if hsm.hsm_policy_available():
+            if hsm_policy_available():
+                import hsm_ux
                 settings.put("hsmcmd", True)
                 ar = await hsm_ux.start_hsm_approval(usb_mode=False, startup_mode=True)
                 if ar:
@@ -2173,6 +2185,12 @@ async def change_virtdisk_enable(enable):
         glob.VD.shutdown()
         assert not glob.VD
 
+async def change_virtdisk_outbox(enable):
+    import glob
+
+    if glob.VD:
+        glob.VD.set_outbox(enable)
+
 async def change_seed_vault(is_enabled):
     # user has changed seed vault enable/disable flag
     from glob import settings
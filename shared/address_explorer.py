@@ -9,12 +9,14 @@ from ux import ux_show_story, the_ux, ux_enter_bip32_index
 from menu import MenuSystem, MenuItem
 from public_constants import AFC_BECH32, AF_CLASSIC, AF_P2WPKH, AF_P2WPKH_P2SH
 from multisig import MultisigWallet
+import uasyncio
 from uasyncio import sleep_ms
 from uhashlib import sha256
 from ubinascii import hexlify as b2a_hex
 from glob import settings
 from auth import write_sig_file
 from utils import addr_fmt_label
+from imptask import share_cpu
 
 def truncate_address(addr):
     # Truncates address to width of screen, replacing middle chars
@@ -151,44 +153,49 @@ class AddressListMenu(MenuSystem):
 
     def __init__(self):
         self.account_num = 0
+        self.deriver = None
+        self.waiting = False
         super().__init__([])
 
     async def render(self):
         # Choose from a truncated list of index 0 common addresses, remember
         # the last address the user selected and use it as the default
-        from glob import dis
         chain = chains.current_chain()
 
-        dis.fullscreen('Wait...')
+        # Which derivations apply: (path, addr_fmt)
+        todo = []
+        for name, path, addr_fmt in chains.CommonDerivations:
+            if '{coin_type}' in path:
+                path = path.replace('{coin_type}', str(chain.b44_cointype))
 
-        with stash.SensitiveValues() as sv:
-
-            # Create list of choices (address_index_0, path, addr_fmt)
-            choices = []
-            for name, path, addr_fmt in chains.CommonDerivations:
-                if '{coin_type}' in path:
-                    path = path.replace('{coin_type}', str(chain.b44_cointype))
-
-                if self.account_num != 0 and '{account}' not in path:
-                    # skip derivations that are not affected by account number
-                    continue
-
-                deriv = path.format(account=self.account_num, change=0, idx=0)
-                node = sv.derive_path(deriv, register=False)
-                address = chain.address(node, addr_fmt)
-                choices.append( (truncate_address(address), path, addr_fmt) )
+            if self.account_num != 0 and '{account}' not in path:
+                # skip derivations that are not affected by account number
+                continue
 
-                dis.progress_bar_show(len(choices) / len(chains.CommonDerivations))
+            todo.append((path, addr_fmt))
 
-            stash.blank_object(node)
+        # Deriving the index 0 addresses is slow, so remember them. Settings are
+        # encrypted and specific to the active seed already; xfp is a double check.
+        # - when not known, menu is shown at once and rows filled in by derive_task
+        ident = [settings.get('xfp', 0), chain.ctype, self.account_num]
+        cached = settings.get('axc', None)
+        if cached and cached[0:3] == ident and len(cached[3]) == len(todo):
+            addrs = cached[3]
+        else:
+            addrs = None
 
         items = []
-        for i, (address, path, addr_fmt) in enumerate(choices):
-            axi = address[-4:]  # last 4 address characters
-            items.append(MenuItem(addr_fmt_label(addr_fmt), f=self.pick_single,
-                                  arg=(path, addr_fmt, axi)))
-            items.append(MenuItem('↳'+address, f=self.pick_single,
-                                  arg=(path, addr_fmt, axi)))
+        rows = []
+        for i, (path, addr_fmt) in enumerate(todo):
+            address = addrs[i] if addrs else None
+            axi = address[-4:] if address else None     # last 4 address characters
+            hdr = MenuItem(addr_fmt_label(addr_fmt), f=self.pick_single,
+                                  arg=(path, addr_fmt, axi))
+            sub = MenuItem('↳'+(address or ' ...'), f=self.pick_single,
+                                  arg=(path, addr_fmt, axi))
+            items.append(hdr)
+            items.append(sub)
+            rows.append((hdr, sub))
 
         # some other choices
         if self.account_num == 0:
@@ -212,13 +219,57 @@ class AddressListMenu(MenuSystem):
         else:
             self.goto_idx(axi)
 
+        self.stop_derive()
+        if not addrs:
+            self.deriver = uasyncio.create_task(self.derive_task(chain, todo, rows, ident))
+
+    def stop_derive(self):
+        if self.deriver:
+            self.deriver.cancel()
+            self.deriver = None
+
+    async def derive_task(self, chain, todo, rows, ident):
+        # derive index 0 addresses one at a time, and show each as it's known;
+        # keys are handled in between, and secrets not held across the sleeps
+        addrs = []
+        for (path, addr_fmt), (hdr, sub) in zip(todo, rows):
+            await sleep_ms(1)
+            if settings.get('xfp', 0) != ident[0]:
+                # seed changed under us
+                return
+
+            deriv = path.format(account=self.account_num, change=0, idx=0)
+            with stash.SensitiveValues() as sv:
+                node = sv.derive_path(deriv, register=False)
+                address = truncate_address(chain.address(node, addr_fmt))
+                stash.blank_object(node)
+
+            addrs.append(address)
+            sub.label = '↳' + address
+            hdr.arg = sub.arg = (path, addr_fmt, address[-4:])
+
+            if self.waiting:
+                self.show()
+
+        self.deriver = None
+        settings.put('axc', ident + [addrs])
+
+    async def wait_choice(self):
+        # derive_task may redraw only while menu itself is on screen
+        self.waiting = True
+        try:
+            return await super().wait_choice()
+        finally:
+            self.waiting = False
+
     async def change_account(self, *a):
         self.account_num = await ux_enter_bip32_index('Account Number:') or 0
         await self.render()
 
     async def pick_single(self, _1, _2, item):
         path, addr_fmt, axi = item.arg
-        settings.put('axi', axi)  # update last clicked address
+        if axi:
+            settings.put('axi', axi)  # update last clicked address
         await self.show_n_addresses(path, addr_fmt, None)
 
     async def pick_multisig(self, _1, _2, item):
@@ -254,7 +305,7 @@ Press (3) if you really understand and accept these risks.
         from glob import dis, NFC, VD
         import version
 
-        def make_msg(change=0):
+        async def make_msg(change=0):
             export_msg = "Press (1) to save Address summary file to SD Card."
             if not ms_wallet:
                 export_msg += " Press (2) to view QR Codes."
@@ -296,21 +347,24 @@ Press (3) if you really understand and accept these risks.
                     addrs.append(addr)
                     msg += truncate_address(addr) + '\n\n'
                     dis.progress_bar_show(i/n)
+                    await share_cpu()
 
             else:
                 # single-singer wallets
 
+                make_addr = chain.address_maker(addr_fmt)
                 with stash.SensitiveValues() as sv:
 
                     for idx in range(start, start + n):
                         deriv = path.format(account=self.account_num, change=change, idx=idx)
                         node = sv.derive_path(deriv, register=False)
-                        addr = chain.address(node, addr_fmt)
+                        addr = make_addr(node)
                         addrs.append(addr)
 
                         msg += "%s =>\n%s\n\n" % (deriv, addr)
 
                         dis.progress_bar_show(idx/n)
+                        await share_cpu()
 
                     stash.blank_object(node)
 
@@ -319,7 +373,7 @@ Press (3) if you really understand and accept these risks.
 
             return msg, addrs
 
-        msg, addrs = make_msg()
+        msg, addrs = await make_msg()
         change = 0
         while 1:
             ch = await ux_show_story(msg, escape='1234679')
@@ -367,7 +421,7 @@ Press (3) if you really understand and accept these risks.
             else:
                 continue        # 3 in non-NFC mode
 
-            msg, addrs = make_msg(change)
+            msg, addrs = await make_msg(change)
 
 def generate_address_csv(path, addr_fmt, ms_wallet, account_num, n, start=0, change=0):
     # Produce CSV file contents as a generator
@@ -390,14 +444,30 @@ def generate_address_csv(path, addr_fmt, ms_wallet, account_num, n, start=0, cha
     yield '"Index","Payment Address","Derivation"\n'
     ch = chains.current_chain()
 
+    # typical: index is last component of path, so derive the parent once,
+    # and then just one more step for each address
+    tmpl = path.format(account=account_num, change=change, idx='{idx}')
+    prefix, last = tmpl.rsplit('/', 1)
+    step = last in ('{idx}', "{idx}'", '{idx}h')
+
+    make_addr = ch.address_maker(addr_fmt)
+
     with stash.SensitiveValues() as sv:
+        if step:
+            parent = sv.derive_path(prefix)
+            is_hard = (last != '{idx}')
+
         for idx in range(start, start+n):
-            deriv = path.format(account=account_num, change=change, idx=idx)
-            node = sv.derive_path(deriv, register=False)
+            deriv = tmpl.format(idx=idx)
+            if step:
+                node = parent.copy()
+                node.derive(idx, is_hard)
+            else:
+                node = sv.derive_path(deriv, register=False)
 
-            yield '%d,"%s","%s"\n' % (idx, ch.address(node, addr_fmt), deriv)
+            yield '%d,"%s","%s"\n' % (idx, make_addr(node), deriv)
 
-        stash.blank_object(node)
+            stash.blank_object(node)
 
 async def make_address_summary_file(path, addr_fmt, ms_wallet, account_num,
                                         count=250, change=0, force_vdisk=False):
@@ -407,7 +477,8 @@ async def make_address_summary_file(path, addr_fmt, ms_wallet, account_num,
     from files import CardSlot, CardMissingError, needs_microsd
 
     # simple: always set number of addresses.
-    # - takes 60 seconds to write 250 addresses on actual hardware
+    # - was 60 seconds to write 250 addresses on actual hardware, when each
+    #   address was derived from the master key
 
     dis.fullscreen('Saving 0-%d' % count)
     fname_pattern='addresses.csv'
@@ -420,16 +491,24 @@ async def make_address_summary_file(path, addr_fmt, ms_wallet, account_num,
         with CardSlot(force_vdisk=force_vdisk) as card:
             fname, nice = card.pick_filename(fname_pattern)
             h = sha256()
-            # do actual write
+            # do actual write, in larger blocks; redraw progress only when it moves
+            buf = bytearray()
             with open(fname, 'wb') as fd:
                 for idx, part in enumerate(body):
                     ep = part.encode()
-                    fd.write(ep)
+                    buf.extend(ep)
                     if not ms_wallet:
                         h.update(ep)
 
-                    if idx % 5 == 0:
-                        dis.progress_bar_show(idx / count)
+                    if len(buf) >= 4096:
+                        fd.write(buf)
+                        buf = bytearray()
+
+                    dis.progress_sofar(idx, count)
+                    await share_cpu()
+
+                if buf:
+                    fd.write(buf)
 
             sig_nice = None
             if not ms_wallet:
@@ -474,7 +553,7 @@ Press (4) to start or (6) to hide this message forever.''', escape='46')
         if ch == 'x': return
 
     m = AddressListMenu()
-    await m.render()        # slow
+    await m.render()        # rows filled in later, unless cached
 
     the_ux.push(m)
 
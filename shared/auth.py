@@ -3,7 +3,7 @@
 # Operations that require user authorization, like our core features: signing messages
 # and signing bitcoin transactions.
 #
-import stash, ure, ux, chains, sys, gc, uio, version, ngu
+import stash, ure, ux, chains, sys, gc, uio, version, ngu, memstats, ckcc
 from ubinascii import b2a_base64, a2b_base64
 from ubinascii import hexlify as b2a_hex
 from ubinascii import unhexlify as a2b_hex
@@ -12,13 +12,16 @@ from public_constants import AFC_SCRIPT, AF_CLASSIC, AFC_BECH32, AF_P2WPKH, AF_P
 from public_constants import STXN_FLAGS_MASK, STXN_FINALIZE, STXN_VISUALIZE, STXN_SIGNED
 from sffile import SFFile
 from ux import ux_aborted, ux_show_story, abort_and_goto, ux_dramatic_pause, ux_clear_keys
-from ux import show_qr_code
+from ux import show_qr_code, show_bbqr_codes
 from usb import CCBusyError
 from utils import HexWriter, xfp2str, problem_file_line, cleanup_deriv_path
 from utils import B2A, parse_addr_fmt_str, to_ascii_printable
 from psbt import psbtObject, FatalPSBTIssue, FraudulentChangeOutput
+from serializations import CTxOut
 from exceptions import HSMDenied
 from version import MAX_TXN_LEN
+from prof import PSBT_PARSE, VALIDATE, APPROVE, FINALIZE
+from imptask import share_cpu
 
 # Where in SPI flash/PSRAM the two PSBT files are (in and out)
 TXN_INPUT_OFFSET = 0
@@ -33,9 +36,16 @@ class UserAuthorizedAction:
         self.result = None
         self.ux_done = False
 
+    def finished(self):
+        # UX is over; result (or refusal, failure) is ready for USB host
+        if not self.ux_done:
+            self.ux_done = True
+            from usb import notify_action_done
+            notify_action_done()
+
     def done(self, redraw=True):
         # drop them back into menu system, but at top.
-        self.ux_done = True
+        self.finished()
         from actions import goto_top_menu
         m = goto_top_menu()
         if redraw:
@@ -47,7 +57,7 @@ class UserAuthorizedAction:
         from actions import goto_top_menu
         from ux import the_ux, restore_menu
 
-        self.ux_done = True
+        self.finished()
         if the_ux.top_of_stack() == self:
             empty = the_ux.pop()
             if empty:
@@ -172,6 +182,14 @@ def sign_message_digest(digest, subpath, prompt, addr_fmt=AF_CLASSIC, pk=None):
         addr = ch.address(node, addr_fmt)
 
     dis.progress_bar_show(.75)
+    rv = sign_with_header(ch, pk, digest, addr_fmt)
+
+    dis.progress_bar_show(1)
+
+    return rv, addr
+
+def sign_with_header(ch, pk, digest, addr_fmt):
+    # recoverable signature, with header byte to suit address format
     rv = ngu.secp256k1.sign(pk, digest, 0).to_bytes()
     # AF_CLASSIC header byte base 31 is returned by default from ngu - NOOP
     if addr_fmt != AF_CLASSIC:
@@ -181,9 +199,7 @@ def sign_message_digest(digest, subpath, prompt, addr_fmt=AF_CLASSIC, pk=None):
         new_header_byte = rec_id + ch.sig_hdr_base(addr_fmt=addr_fmt)
         rv = bytes([new_header_byte]) + rs
 
-    dis.progress_bar_show(1)
-
-    return rv, addr
+    return rv
 
 def make_signature_file_msg(content_list):
     # list of tuples consisting of (hash, file_name)
@@ -216,8 +232,21 @@ def sign_export_contents(content_list, deriv, addr_fmt, pk=None):
     gen = rfc_signature_template_gen(addr=addr, msg=msg2sign.decode(), sig=sig)
     return gen
 
+def file_digest(path, buf):
+    # SHA-256 over a file of any size, read in chunks using buf
+    from uhashlib import sha256
+    h = sha256()
+    with open(path, "rb") as f:
+        while 1:
+            n = f.readinto(buf)
+            if not n: break
+            h.update(memoryview(buf)[0:n])
+
+    return h.digest()
+
 def verify_signed_file_digest(msg):
     from files import CardSlot
+    from glob import VD
 
     parsed_msg = parse_signature_file_msg(msg)
     if not parsed_msg:
@@ -226,17 +255,21 @@ def verify_signed_file_digest(msg):
 
     try:
         err, warn = [], []
+        buf = bytearray(4096)
         with CardSlot() as card:
             for digest, fname in parsed_msg:
                 path = card.abs_path(fname)
                 if not card.exists(path):
                     warn.append((fname, None))
                     continue
-                path = card.abs_path(fname)
-                with open(path, "rb") as f:
-                    contents = f.read()
 
-                h = b2a_hex(ngu.hash.sha256s(contents)).decode().strip()
+                if VD and card.mountpt == '/vdisk' and '/' not in fname:
+                    # virtual disk: done in C over the clusters in place
+                    _, d = VD.file_sha256(path)
+                else:
+                    d = file_digest(path, buf)
+
+                h = b2a_hex(d).decode().strip()
                 if h != digest:
                     err.append((fname, h, digest))
     except:
@@ -348,11 +381,196 @@ def sign_msg(text, subpath, addr_fmt):
     # kill any menu stack, and put our thing at the top
     abort_and_goto(UserAuthorizedAction.active_request)
 
+# Batch of messages, one per line: text, then optional subpath and address
+# format, separated by tabs. Same format over USB (uploaded file) or on SD card.
+MSG_BATCH_MAX = 50
+
+def parse_msg_batch(lines):
+    # returns list of (text, subpath, addr_fmt); blank lines ignored
+    rv = []
+    for ln in lines:
+        ln = ln.rstrip('\r\n')
+        if not ln.strip(): continue
+
+        parts = ln.split('\t')
+        assert len(parts) <= 3, "msg %d: too many fields" % (len(rv)+1)
+
+        subpath = (parts[1].strip() if len(parts) >= 2 else '') or 'm'
+        addr_fmt = (parts[2].strip() if len(parts) >= 3 else '') or AF_CLASSIC
+        rv.append((parts[0], subpath, addr_fmt))
+
+        assert len(rv) <= MSG_BATCH_MAX, "too many msgs (max. %d)" % MSG_BATCH_MAX
+
+    assert rv, "no msgs"
+
+    return rv
+
+class ApproveMessageSignBatch(UserAuthorizedAction):
+    # Many messages, one approval. Result over USB is same as for PSBT signing:
+    # (len, sha256) of RFC-style signed messages, in PSRAM at TXN_OUTPUT_OFFSET.
+    def __init__(self, items, approved_cb=None):
+        super().__init__()
+        self.approved_cb = approved_cb
+        self.items = []
+
+        from glob import dis
+        dis.fullscreen('Wait...')
+
+        # siblings share parent node, via prefix cache in SensitiveValues
+        with stash.SensitiveValues() as sv:
+            for n, (text, subpath, addr_fmt) in enumerate(items):
+                try:
+                    text = validate_text_for_signing(text)
+                    subpath = cleanup_deriv_path(subpath)
+                    addr_fmt = parse_addr_fmt_str(addr_fmt)
+                except (AssertionError, ValueError) as exc:
+                    raise AssertionError("msg %d: %s" % (n+1, exc))
+
+                node = sv.derive_path(subpath)
+                addr = sv.chain.address(node, addr_fmt)
+                self.items.append((text, subpath, addr_fmt, addr))
+
+                dis.progress_bar_show((n+1) / len(items))
+
+    def summary(self):
+        msg = 'Ok to sign these %d messages?\n' % len(self.items)
+        for n, (text, subpath, _, addr) in enumerate(self.items):
+            msg += '\n%d)\n      --=--\n%s\n      --=--\n%s =>\n%s\n' % (
+                                        n+1, text, subpath, addr)
+
+        return msg + '\nPress OK to continue, otherwise X to cancel.'
+
+    async def sign_all(self):
+        # one unlock of the secrets for whole batch
+        from glob import dis
+
+        ch = chains.current_chain()
+        dis.fullscreen("Signing...")
+
+        sigs = []
+        with stash.SensitiveValues() as sv:
+            for n, (text, subpath, addr_fmt, _) in enumerate(self.items):
+                node = sv.derive_path(subpath)
+                digest = ch.hash_message(text.encode())
+                sigs.append(sign_with_header(ch, node.privkey(), digest, addr_fmt))
+
+                dis.progress_bar_show((n+1) / len(self.items))
+                await share_cpu()
+
+        return sigs
+
+    def output_gen(self, sigs):
+        # text of the result file: RFC-style blocks, blank line between
+        for n, (text, _, _, addr) in enumerate(self.items):
+            if n:
+                yield '\n'
+            sig = b2a_base64(sigs[n]).decode('ascii').strip()
+            for part in rfc_signature_template_gen(addr=addr, msg=text, sig=sig):
+                yield part
+
+    async def interact(self):
+        # Prompt user w/ summary
+        # - not in HSM mode: 'smbt' isn't whitelisted, since uploads there must be PSBT
+        ch = await ux_show_story(self.summary())
+
+        if ch != 'y':
+            self.refused = True
+        else:
+            sigs = await self.sign_all()
+
+            if self.approved_cb:
+                # for micro sd case
+                await self.approved_cb(list(self.output_gen(sigs)))
+            else:
+                # USB: stream results out into PSRAM, host uses stok + dwld
+                with SFFile(TXN_OUTPUT_OFFSET, max_size=MAX_TXN_LEN, message="Saving...") as fd:
+                    await fd.erase()
+                    for part in self.output_gen(sigs):
+                        fd.write(part.encode())
+
+                    self.result = (fd.tell(), fd.checksum.digest())
+
+        if self.approved_cb:
+            # don't kill menu depth for file case
+            UserAuthorizedAction.cleanup()
+            self.pop_menu()
+        else:
+            self.done()
+
+def sign_msg_batch(batch_len):
+    # batch of messages uploaded into PSRAM already, checksum checked
+    with SFFile(TXN_INPUT_OFFSET, length=batch_len) as fd:
+        lines = fd.read().decode().split('\n')
+
+    items = parse_msg_batch(lines)
+
+    UserAuthorizedAction.check_busy()
+    UserAuthorizedAction.active_request = ApproveMessageSignBatch(items)
+    # kill any menu stack, and put our thing at the top
+    abort_and_goto(UserAuthorizedAction.active_request)
+
+async def save_signed_msg_file(filename, parts):
+    # write out signed message(s) as new file, next to original if possible
+    from files import CardSlot, CardMissingError
+    from glob import dis
+
+    orig_path, basename = filename.rsplit('/', 1)
+    orig_path += '/'
+    base = basename.rsplit('.', 1)[0]
+    out_fn = None
+
+    while 1:
+        # try to put back into same spot
+        # add -signed to end.
+        target_fname = base+'-signed.txt'
+
+        for path in [orig_path, None]:
+            try:
+                with CardSlot(readonly=True) as card:
+                    out_full, out_fn = card.pick_filename(target_fname, path)
+                    out_path = path
+                    if out_full: break
+            except CardMissingError:
+                prob = 'Missing card.\n\n'
+                out_fn = None
+
+        if not out_fn: 
+            # need them to insert a card
+            prob = ''
+        else:
+            # attempt write-out
+            try:
+                dis.fullscreen("Saving...")
+                with CardSlot() as card:
+                    with card.open(out_full, 'wt') as fd:
+                        # save in full RFC style
+                        for i, part in enumerate(parts):
+                            fd.write(part)
+                            dis.progress_bar_show(i / len(parts))
+
+                # success and done!
+                break
+
+            except OSError as exc:
+                prob = 'Failed to write!\n\n%s\n\n' % exc
+                sys.print_exception(exc)
+                # fall through to try again
+
+        # prompt them to input another card?
+        ch = await ux_show_story(prob+"Please insert an SDCard to receive signed message, "
+                                    "and press OK.", title="Need Card")
+        if ch == 'x':
+            await ux_aborted()
+            return
+
+    # done.
+    msg = "Created new file:\n\n%s" % out_fn
+    await ux_show_story(msg, title='File Signed')
 
 async def sign_txt_file(filename):
     # sign a one-line text file found on a MicroSD card
-    # - not yet clear how to do address types other than 'classic'
-    from files import CardSlot, CardMissingError
+    # - or a batch: one message per line, with tab-separated subpath and addr_fmt
+    from files import CardSlot
 
     from ux import the_ux
 
@@ -361,9 +579,29 @@ async def sign_txt_file(filename):
     # copy message into memory
     with CardSlot() as card:
         with card.open(filename, 'rt') as fd:
-            text = fd.readline().strip()
-            subpath = fd.readline().strip()
-            addr_fmt = fd.readline().strip()
+            text = fd.readline()
+            if '\t' in text:
+                # whole file: parse_msg_batch() skips blank lines and enforces the max.
+                batch = [text] + fd.readlines()
+            else:
+                batch = None
+                text = text.strip()
+                subpath = fd.readline().strip()
+                addr_fmt = fd.readline().strip()
+
+    if batch:
+        async def done(parts):
+            await save_signed_msg_file(filename, parts)
+
+        UserAuthorizedAction.check_busy()
+        try:
+            UserAuthorizedAction.active_request = ApproveMessageSignBatch(
+                                            parse_msg_batch(batch), approved_cb=done)
+            the_ux.push(UserAuthorizedAction.active_request)
+        except AssertionError as exc:
+            await ux_show_story("Problem: %s\n\nEach line must be: message, then optional "
+                                "subpath and address format, separated by tabs." % exc)
+        return
 
     if not subpath:
         # default: top of wallet.
@@ -374,64 +612,9 @@ async def sign_txt_file(filename):
 
     async def done(signature, address, text):
         # complete. write out result
-        from glob import dis
-
-        orig_path, basename = filename.rsplit('/', 1)
-        orig_path += '/'
-        base = basename.rsplit('.', 1)[0]
-        out_fn = None
-
         sig = b2a_base64(signature).decode('ascii').strip()
-
-        while 1:
-            # try to put back into same spot
-            # add -signed to end.
-            target_fname = base+'-signed.txt'
-
-            for path in [orig_path, None]:
-                try:
-                    with CardSlot(readonly=True) as card:
-                        out_full, out_fn = card.pick_filename(target_fname, path)
-                        out_path = path
-                        if out_full: break
-                except CardMissingError:
-                    prob = 'Missing card.\n\n'
-                    out_fn = None
-
-            if not out_fn: 
-                # need them to insert a card
-                prob = ''
-            else:
-                # attempt write-out
-                try:
-                    dis.fullscreen("Saving...")
-                    with CardSlot() as card:
-                        with card.open(out_full, 'wt') as fd:
-                            # save in full RFC style
-                            # gen length is 6
-                            gen = rfc_signature_template_gen(addr=address, msg=text, sig=sig)
-                            for i, part in enumerate(gen):
-                                fd.write(part)
-                                dis.progress_bar_show(i / 6)
-
-                    # success and done!
-                    break
-
-                except OSError as exc:
-                    prob = 'Failed to write!\n\n%s\n\n' % exc
-                    sys.print_exception(exc)
-                    # fall through to try again
-
-            # prompt them to input another card?
-            ch = await ux_show_story(prob+"Please insert an SDCard to receive signed message, "
-                                        "and press OK.", title="Need Card")
-            if ch == 'x':
-                await ux_aborted()
-                return
-
-        # done.
-        msg = "Created new file:\n\n%s" % out_fn
-        await ux_show_story(msg, title='File Signed')
+        gen = rfc_signature_template_gen(addr=address, msg=text, sig=sig)
+        await save_signed_msg_file(filename, list(gen))
 
     UserAuthorizedAction.check_busy()
     try:
@@ -621,9 +804,12 @@ class ApproveTransaction(UserAuthorizedAction):
         # step 1: parse PSBT from PSRAM into in-memory objects.
 
         try:
+            ckcc.prof_start(PSBT_PARSE)
             with SFFile(TXN_INPUT_OFFSET, length=self.psbt_len, message='Reading...') as fd:
                 # NOTE: psbtObject captures the file descriptor and uses it later
                 self.psbt = psbtObject.read_psbt(fd)
+            ckcc.prof_stop(PSBT_PARSE)
+            memstats.checkpoint('parse')
         except BaseException as exc:
             if isinstance(exc, MemoryError):
                 msg = "Transaction is too complex"
@@ -637,17 +823,23 @@ class ApproveTransaction(UserAuthorizedAction):
 
         # Do some analysis/ validation
         try:
+            ckcc.prof_start(VALIDATE)
             await self.psbt.validate()      # might do UX: accept multisig import
             dis.progress_bar_show(0.10)
+            await share_cpu()
             self.psbt.consider_inputs()
 
             dis.progress_bar_show(0.33)
+            await share_cpu()
             self.psbt.consider_keys()
 
             dis.progress_bar_show(0.66)
+            await share_cpu()
             self.psbt.consider_outputs()
             self.psbt.consider_dangerous_sighash()
             dis.progress_bar_show(0.85)
+            ckcc.prof_stop(VALIDATE)
+            memstats.checkpoint('validate')
         except FraudulentChangeOutput as exc:
             print('FraudulentChangeOutput: ' + exc.args[0])
             return await self.failure(exc.args[0], title='Change Fraud')
@@ -688,7 +880,7 @@ class ApproveTransaction(UserAuthorizedAction):
                 msg.write('(%d warnings below)\n\n' % wl)
 
             self.output_summary_text(msg)
-            gc.collect()
+            memstats.collect('approve')
 
             fee = self.psbt.calculate_fee()
             if fee is not None:
@@ -696,7 +888,7 @@ class ApproveTransaction(UserAuthorizedAction):
 
             # NEW: show where all the change outputs are going
             self.output_change_text(msg)
-            gc.collect()
+            memstats.collect('approve')
 
             if self.psbt.ux_notes:
                 # currently we only have locktimes in ux_notes
@@ -720,11 +912,13 @@ class ApproveTransaction(UserAuthorizedAction):
                 return
 
             dis.progress_bar_show(1)  # finish the Validating...
+            ckcc.prof_start(APPROVE)
             if not hsm_active:
                 msg.write("\nPress OK to approve and sign transaction. X to abort.")
                 ch = await ux_show_story(msg, title="OK TO SEND?")
             else:
                 ch = await hsm_active.approve_transaction(self.psbt, self.psbt_sha, msg.getvalue())
+            ckcc.prof_stop(APPROVE)
 
         except MemoryError:
             # recovery? maybe.
@@ -751,8 +945,10 @@ class ApproveTransaction(UserAuthorizedAction):
         # do the actual signing.
         try:
             dis.fullscreen('Wait...')
-            gc.collect()           # visible delay caused by this but also sign_it() below
+            memstats.collect('sign')    # visible delay caused by this but also sign_it() below
             self.psbt.sign_it()
+            memstats.checkpoint('sign')
+            await share_cpu()
         except FraudulentChangeOutput as exc:
             return await self.failure(exc.args[0], title='Change Fraud')
         except MemoryError:
@@ -770,6 +966,7 @@ class ApproveTransaction(UserAuthorizedAction):
         txid = None
         try:
             # re-serialize the PSBT back out
+            ckcc.prof_start(FINALIZE)
             with SFFile(TXN_OUTPUT_OFFSET, max_size=MAX_TXN_LEN, message="Saving...") as fd:
                 await fd.erase()
 
@@ -778,6 +975,8 @@ class ApproveTransaction(UserAuthorizedAction):
                 else:
                     self.psbt.serialize(fd)
 
+                ckcc.prof_stop(FINALIZE)
+                memstats.checkpoint('finalize')
                 fd.close()
                 self.result = (fd.tell(), fd.checksum.digest())
 
@@ -789,20 +988,33 @@ class ApproveTransaction(UserAuthorizedAction):
         from glob import NFC
 
         if self.do_finalize and txid and not hsm_active:
+            from qrs import bbqr_parts_needed
+
             while 1:
                 # Show txid when we can; advisory
                 # - maybe even as QR, hex-encoded in alnum mode
                 tmsg = txid + '\n\nPress (1) for QR Code of TXID. '
 
+                can_qr = bbqr_parts_needed(self.result[0])
+                if can_qr:
+                    tmsg += 'Press (2) for animated QR of signed txn. '
+
                 if NFC:
                     tmsg += 'Press (3) to share signed txn via NFC.'
 
-                ch = await ux_show_story(tmsg, "Final TXID", escape='13')
+                ch = await ux_show_story(tmsg, "Final TXID", escape='123')
 
                 if ch == '1':
                     await show_qr_code(txid, True)
                     continue
 
+                if ch == '2' and can_qr:
+                    with SFFile(TXN_OUTPUT_OFFSET, length=self.result[0]) as fd:
+                        txn = fd.read(self.result[0])
+                    await show_bbqr_codes(txn, 'T')
+                    del txn
+                    continue
+
                 if ch == '3' and NFC:
                     await NFC.share_signed_txn(txid, TXN_OUTPUT_OFFSET,
                                                             self.result[0], self.result[1])
@@ -845,22 +1057,12 @@ class ApproveTransaction(UserAuthorizedAction):
         # - we don't really expect all users to verify these outputs, but just in case.
         # - show the total amount, and list addresses
         chain = chains.current_chain()
-        total = 0
-        addrs = []
-        for idx, txo in self.psbt.output_iter():
-            outp = self.psbt.outputs[idx]
-            if not outp.is_change:
-                continue
-            total += txo.nValue
-            try:
-                addrs.append(chain.render_address(txo.scriptPubKey))
-            except ValueError:
-                pass
+        addrs = [a for a in chain.render_addresses(self.psbt.change_scripts) if a]
 
         if not addrs:
             return
 
-        total_val = ' '.join(self.chain.render_value(total))
+        total_val = ' '.join(self.chain.render_value(self.psbt.change_value_out))
 
         msg.write("\nChange back:\n%s\n" % total_val)
 
@@ -875,8 +1077,7 @@ class ApproveTransaction(UserAuthorizedAction):
         # Produce text report of where their cash is going. This is what
         # they use to decide if correct transaction is being signed.
         # - does not show change outputs, by design.
-        MAX_VISIBLE_OUTPUTS = const(10)
-
+        # - outputs to show were picked by psbt.consider_outputs(); no pass over them here
         if self.psbt.consolidation_tx:
             # consolidating txn that doesn't change balance of account.
             msg.write("Consolidating\n%s %s\nwithin wallet.\n\n" %
@@ -886,61 +1087,34 @@ class ApproveTransaction(UserAuthorizedAction):
 
             return
 
-        if (self.psbt.num_outputs - self.psbt.num_change_outputs) <= MAX_VISIBLE_OUTPUTS:
+        largest = self.psbt.largest_outs
+        left = self.psbt.num_outputs - len(largest) - self.psbt.num_change_outputs
+
+        if not left:
             # simple, common case: don't sort outputs, and do show all of them
             first = True
-            for idx, tx_out in self.psbt.output_iter():
-                outp = self.psbt.outputs[idx]
-                if outp.is_change:
-                    continue
-
+            for val, idx, spk in sorted(largest, key=lambda o: o[1]):
                 if first:
                     first = False
                 else:
                     msg.write('\n')
 
-                msg.write(self.render_output(tx_out))
+                msg.write(self.render_output(CTxOut(val, spk)))
 
             return
 
-        # Too many to show them all, so
-        # find largest N outputs, and track total amount
-        largest = []
-        for idx, tx_out in self.psbt.output_iter():
-            outp = self.psbt.outputs[idx]
-            if outp.is_change:
-                continue
-
-            if len(largest) < MAX_VISIBLE_OUTPUTS:
-                largest.append( (tx_out.nValue, self.render_output(tx_out)) )
-                continue
-
-            # insertion sort
-            here = tx_out.nValue
-            for li, (nv, txt) in enumerate(largest):
-                if here > nv:
-                    keep = li
-                    break
-            else:
-                continue        # too small 
-
-            largest.pop(-1)
-            largest.insert(keep, (here, self.render_output(tx_out)))
-
-        for val, txt in largest:
-            msg.write(txt)
+        # Too many to show them all, so largest N outputs, and total of the rest
+        for val, idx, spk in largest:
+            msg.write(self.render_output(CTxOut(val, spk)))
             msg.write('\n')
 
-        left = self.psbt.num_outputs - len(largest) - self.psbt.num_change_outputs
-        if left > 0:
-            msg.write('.. plus %d smaller output(s), not shown here, which total: ' % left)
+        msg.write('.. plus %d smaller output(s), not shown here, which total: ' % left)
 
-            # calculate left over value
-            mtot = self.psbt.total_value_out - sum(v for v,t in largest)
-            mtot -= sum(o.nValue for i, o in self.psbt.output_iter() 
-                                        if self.psbt.outputs[i].is_change)
+        # calculate left over value
+        mtot = self.psbt.total_value_out - sum(v for v,i,s in largest) \
+                    - self.psbt.change_value_out
 
-            msg.write('%s %s\n' % self.chain.render_value(mtot))
+        msg.write('%s %s\n' % self.chain.render_value(mtot))
 
 
 def sign_transaction(psbt_len, flags=0x0, psbt_sha=None):
@@ -954,9 +1128,12 @@ def sign_transaction(psbt_len, flags=0x0, psbt_sha=None):
 def psbt_encoding_taster(taste, psbt_len):
     # look at first 10 bytes, and detect file encoding (binary, hex, base64)
     # - return len is upper bound on size because of unknown whitespace
+    # - and never more than what fits in PSRAM, so copying garbage stops early
     from utils import HexStreamer, Base64Streamer, HexWriter, Base64Writer
 
     if taste[0:5] == b'psbt\xff':
+        if psbt_len > MAX_TXN_LEN:
+            raise ValueError("too big")
         decoder = None
         output_encoder = lambda x: x
     elif taste[0:10] == b'70736274ff' or taste[0:10] == b'70736274FF':
@@ -970,7 +1147,9 @@ def psbt_encoding_taster(taste, psbt_len):
     else:
         raise ValueError("not psbt")
 
-    return decoder, output_encoder, psbt_len
+    # text with extra whitespace might still fit, so test that while decoding
+    # (SFFile max_size)
+    return decoder, output_encoder, min(psbt_len, MAX_TXN_LEN)
     
 async def sign_psbt_file(filename, force_vdisk=False):
     # sign a PSBT file found on a MicroSD card
@@ -979,7 +1158,7 @@ async def sign_psbt_file(filename, force_vdisk=False):
     from glob import dis
     from ux import the_ux
 
-    tmp_buf = bytearray(1024)
+    tmp_buf = bytearray(4096)
 
     # copy file into PSRAM
     # - can't work in-place on the card because we want to support writing out to different card
@@ -1020,7 +1199,7 @@ async def sign_psbt_file(filename, force_vdisk=False):
                             out.write(here)
                             total += len(here)
 
-                    dis.progress_bar_show(total / psbt_len)
+                    dis.progress_sofar(total, psbt_len)
 
             # might have been whitespace inflating initial estimate of PSBT size
             assert total <= psbt_len
@@ -1070,7 +1249,7 @@ async def sign_psbt_file(filename, force_vdisk=False):
                             # don't write signed PSBT if we'd just delete it anyway
                             out_fn = None
                         else:
-                            with output_encoder(card.open(out_full, 'wb')) as fd:
+                            with output_encoder(card.open(out_full, 'wb', buffered=True)) as fd:
                                 # save as updated PSBT
                                 psbt.serialize(fd)
 
@@ -1303,9 +1482,9 @@ class ShowPKHAddress(ShowAddressBase):
         self.subpath = subpath
         self.addr_fmt = addr_fmt
 
-        with stash.SensitiveValues() as sv:
-            node = sv.derive_path(subpath)
-            self.address = sv.chain.address(node, addr_fmt)
+        # public-only, and usually cached already
+        node = stash.SensitiveValues.public_node(subpath)
+        self.address = chains.current_chain().address(node, addr_fmt)
 
     def get_msg(self):
         return '''{addr}\n\n= {sp}''' .format(addr=self.address, sp=self.subpath)
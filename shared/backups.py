@@ -2,7 +2,7 @@
 #
 # backups.py - Save and restore backup data.
 #
-import compat7z, stash, ckcc, chains, gc, sys, bip39, uos, ngu
+import compat7z, stash, ckcc, chains, gc, sys, bip39, uos, ngu, memstats
 from ubinascii import hexlify as b2a_hex
 from ubinascii import unhexlify as a2b_hex
 from utils import pad_raw_secret
@@ -352,7 +352,7 @@ async def write_complete_backup(words, fname_pattern, write_sflash=False,
     dis.fullscreen('Encrypting...' if words else 'Generating...')
     body = render_backup_contents(bypass_tmp=bypass_tmp).encode()
 
-    gc.collect()
+    memstats.collect('backup')
 
     if words:
         # NOTE: Takes a few seconds to do the key-streching, but little actual
@@ -362,18 +362,18 @@ async def write_complete_backup(words, fname_pattern, write_sflash=False,
         zz = compat7z.Builder(password=pw, progress_fcn=dis.progress_bar_show)
         zz.add_data(body)
 
+        # plaintext no longer needed, only the size
+        filesize = len(body) + MAX_BACKUP_FILE_SIZE
+        del body
+        gc.collect()
+
         # pick random filename, but ending in .txt
         word = bip39.wordlist_en[ngu.random.uniform(2048)]
         num = ngu.random.uniform(1000)
         fname = '%s%d.txt' % (word, num)
 
         hdr, footer = zz.save(fname)
-
-        filesize = len(body) + MAX_BACKUP_FILE_SIZE
-
-        del body
-
-        gc.collect()
+        memstats.checkpoint('backup_7z')
     else:
         # cleartext dump
         zz = None
@@ -483,6 +483,55 @@ async def verify_backup_file(fname):
     await ux_show_story("Backup file CRC checks out okay.\n\nPlease note this is only a check against accidental truncation and similar. Targeted modifications can still pass this test.")
 
 
+def iter_lines(chunks):
+    # decode one line at a time, as pieces of file arrive, rather than whole file
+    # and then a list of all
+    part = b''
+    for chunk in chunks:
+        if part:
+            chunk = part + chunk
+        pos = 0
+        while 1:
+            nl = chunk.find(b'\n', pos)
+            if nl < 0:
+                break
+            yield chunk[pos:nl].decode()
+            pos = nl + 1
+        part = chunk[pos:]
+
+    if part:
+        yield part.decode()
+
+def sanity_checked(chunks):
+    # simple quick checks on decrypted file, as it goes by
+    last = b''
+    for n, chunk in enumerate(chunks):
+        if n == 0:
+            assert chunk[0:1] == b'#'
+        if chunk:
+            last = chunk
+        yield chunk
+
+    assert last[-1:] == b'\n'
+
+def parse_backup(chunks):
+    # lines of "key = json value", and comments
+    vals = {}
+    for line in iter_lines(chunks):
+        if not line: continue
+        if line[0] == '#': continue
+
+        try:
+            k,v = line.split(' = ', 1)
+            #print("%s = %s" % (k, v))
+
+            vals[k] = ujson.loads(v)
+        except:
+            print("unable to decode line: %r" % line)
+            # but keep going!
+
+    return vals
+
 async def restore_complete(fname_or_fd, temporary=False):
     from ux import the_ux
 
@@ -523,7 +572,7 @@ async def restore_complete_doit(fname_or_fd, words, file_cleanup=None, temporary
 
             try:
                 if not words:
-                    contents = fd.read()
+                    vals = parse_backup([fd.read()])
                 else:
                     try:
                         compat7z.check_file_headers(fd)
@@ -532,19 +581,25 @@ async def restore_complete_doit(fname_or_fd, words, file_cleanup=None, temporary
                                             + str(e)
 
                     dis.fullscreen("Decrypting...")
+                    chunks = None
                     try:
                         zz = compat7z.Builder()
-                        fname, contents = zz.read_file(fd, password, MAX_BACKUP_FILE_SIZE,
+                        fname, chunks = zz.open_file(fd, password, MAX_BACKUP_FILE_SIZE,
                                                 progress_fcn=dis.progress_bar_show)
 
-                        # simple quick sanity checks
+                        # decrypt, check and parse in one pass over the file; nothing
+                        # is used until CRC is confirmed at the end
                         assert fname.endswith('.txt')       # was == 'ckcc-backup.txt'
-                        assert contents[0:1] == b'#' and contents[-1:] == b'\n'
+                        vals = parse_backup(sanity_checked(chunks))
 
                     except Exception as e:
                         # assume everything here is "password wrong" errors
                         #print("pw wrong?  %s" % e)
 
+                        if chunks:
+                            # abandoned part way: runs its finally, which wipes AES key
+                            chunks.close()
+
                         return ('Unable to decrypt backup file. Incorrect password?'
                                                 '\n\nTried:\n\n' + password)
             finally:
@@ -557,20 +612,6 @@ async def restore_complete_doit(fname_or_fd, words, file_cleanup=None, temporary
         await needs_microsd()
         return
 
-    vals = {}
-    for line in contents.decode().split('\n'):
-        if not line: continue
-        if line[0] == '#': continue
-
-        try:
-            k,v = line.split(' = ', 1)
-            #print("%s = %s" % (k, v))
-
-            vals[k] = ujson.loads(v)
-        except:
-            print("unable to decode line: %r" % line)
-            # but keep going!
-
     # this leads to reboot if it works, else errors shown, etc.
     if temporary:
         return await restore_tmp_from_dict_ll(vals)
@@ -0,0 +1,10 @@
+# autogen'ed. don't edit
+#
+# cmdline: misc/bip39_index.py
+#
+# 650 nodes, 2648 kids, see misc/bip39_index.py for layout
+#
+NODES = b'\xff\xff\x7f\x03\x00\x00\xfe\xb9\xfe\x00\x19\x00\x11I\x12\x00,\x00\x91I\x12\x013\x00\x11AR\x01<\x00m\xb9\xaf\x01D\x00\x11I\x12\x00U\x00\x91I\x12\x01\\\x00\x11A\x10\x01e\x00L8.\x00k\x00\x11@\x10\x00u\x00\x11!\x00\x00y\x00\x11A\x10\x01}\x00\x11A\x10\x01\x83\x00\x11A\x10\x00\x89\x00/\xbd\xfe\x03\x8e\x00\x91I\x12\x01\xa2\x00\x00\x00\x10\x00\xab\x00\x91A\x10\x00\xac\x00\x95\xfdY\x01\xb2\x00\x91AR\x01\xc2\x00@\xb0\x0e\x00\xcb\x00\x11A\x00\x00\xd2\x00\x91A\x02\x00\xd6\x00\x11@\x00\x00\xdc\x00\x10@\x00\x00\xdf\x00\x01I\x14\x00\xe1\x00\x84A\x0b\x00\xe7\x00\t\x120\x00\xee\x00 \x00\x02\x00\xf4\x00\x11\x00\x02\x00\xf6\x00\x00\x10\x06\x00\xf9\x00\x17\xd9N\x00\xfc\x00\x01@\x10\x00\t\x01Ee\x8c\x01\x0c\x01\x01\xc0\x02\x00\x17\x01TP\n\x00\x1b\x01\x00\x84\x0c\x00"\x01\x80@\x08\x00&\x01L \x08\x00)\x01\x10@\x00\x00.\x011\x04\x00\x000\x01N8\x0e\x004\x01\xf5(\x0c\x01>\x01\x0cd\n\x00I\x01\x11A\x10\x00P\x01\tq\x9e\x01U\x01\x11A\x10\x00a\x01*)\x0e\x03f\x01F\xbc>\x00q\x01\x009\x02\x00~\x01\x11A\x12\x00\x83\x01@ *\x00\x89\x01\x11A\x10\x00\x8e\x01-\xf9>\x01\x93\x01\x11A\x10\x01\xa3\x01\x02\x88\x0e\x00\xa9\x01\x080V\x01\xaf\x01w\xb8.\x00\xb7\x01u(&\x02\xc5\x01Dx4\x00\xd0\x01\x11A\x10\x01\xd9\x01\x040\x0e\x00\xdf\x01@\x00\x06\x00\xe5\x01\x80@\x00\x00\xe8\x01@\x01\x10\x00\xea\x01@\x00\x08\x00\xed\x01\x1a\x01\x04\x00\xef\x01\x12\xc0\x00\x00\xf4\x01\xf9J.\x00\xf8\x01\x00\x00\x10\x00\x05\x02\x01@\x12\x00\x06\x02\x04\x00\x0c\x00\n\x02\x90\x00\x00\x00\r\x02\x00A\x00\x00\x0f\x02\x95\xc1\x08\x00\x11\x02\x10\x00\x00\x00\x19\x02\x0e9>\x00\x1a\x02\x1b0l\x00&\x02V(\x8e\x000\x02\x11A\x10\x01:\x02EI\x96\x00@\x02\x11A\x10\x00J\x02\x10 \n\x00O\x02\x08\x99\x1e\x02S\x02\x00 \x04\x00]\x02a "\x00_\x02\x01A\x10\x00e\x02\tHf\x00i\x02\x11A\x10\x00q\x02\x11!\x00\x00v\x02\x02\xb9j\x02z\x02\t)\x02\x00\x85\x02H\xa8\x06\x00\x8b\x02\x06\xf8>\x00\x92\x02B0\x06\x00\x9e\x02\x10@\x00\x00\xa4\x02\x10\x08\x00\x00\xa6\x02\x00\x08\x00\x00\xa8\x02\x01\x91\x00\x00\xa9\x02\xac\xb3-\x00\xad\x02\x00H\x04\x00\xba\x02D\x00\x02\x02\xbd\x02\x01\x08@\x00\xc1\x02\x02\x05\x10\x01\xc4\x02\x081\x04\x00\xc9\x02\x10\x00\x08\x01\xce\x02\x0c L\x00\xd1\x02\x10A\x00\x00\xd7\x02\n\xb4z\x03\xda\x02eq,\x00\xe7\x02gt-\x02\xf2\x02G`8\x01\x00\x03D0\x80\x00\n\x03L\xb7\x8e\x02\x0f\x03\r8\x0e\x00\x1d\x03\x088\x86\x00&\x03\np>\x00-\x03$\x08\x0c\x007\x03\x00\x00\x0c\x00<\x03\x00\x91\x0e\x00>\x03U\x81\xfe\x00D\x03D\x00\x00\x00Q\x03\x02Qn\x00S\x03\x04\x10\n\x00\\\x03\x10\n,\x00`\x03\x14\x00\x08\x00f\x03 \x00\x08\x00i\x03\x08\x01\x00\x01k\x03\x14\t\x00\x00n\x03\x10\x81\x08\x00r\x03O\x81\x00\x00v\x03\x00\x00\x08\x00}\x03\x11\x00\x00\x00~\x03\x00 \x00\x00\x80\x03L\xa9>\x01\x81\x03\x01\xe8\n\x00\x8e\x03\x00@\x02\x01\x95\x03U\xe8\x0c\x02\x98\x03\x11\x00\x10\x00\xa3\x03\x10\xe9n\x00\xa6\x03\x11A\x00\x00\xb1\x03\n\xb8\x0e\x02\xb5\x03\x11A\x00\x00\xbf\x03\x0e\xb9j\x02\xc3\x03o\xfa}\x00\xd0\x03n\xe0,\x00\xe2\x03\x07P\x1c\x01\xed\x03J(\x02\x00\xf6\x03(98\x01\xfc\x03\x91A\x02\x00\x06\x04U8.\x00\x0c\x04\x11A\x12\x01\x17\x04^8\x8e\x02\x1e\x04\x11\x01\x10\x00+\x04\x11A\x10\x00/\x04\x01A\x00\x004\x04\x01A\x00\x007\x04-x\x12\x00:\x04\x91I\x02\x01D\x04\x00\x00\x10\x00L\x04\x11A\x12\x01M\x04n\xb1\x06\x00T\x04\x11A\x00\x00_\x04\x00\x10\x06\x00c\x04F\xa9\x8e\x00f\x04\x01(\x86\x00q\x04\x11A\x12\x00w\x04L\xb8\x0e\x00}\x04[\xf5^\x01\x87\x04\x11A\x10\x01\x98\x04\x021\x02\x00\x9e\x04\x10A\x00\x00\xa3\x04\x00\x80\x00\x00\xa6\x04\xad\r8\x00\xa7\x04\xc8\xc0\x04\x00\xb2\x04B\x00\x00\x00\xb8\x04\x11\x00\x10\x00\xba\x04D\xa8\x16\x00\xbd\x04\x80(\x0e\x00\xc5\x04\x1fh.\x00\xcb\x04\x04\t\x08\x01\xd7\x04@).\x01\xdc\x04\x1b\t\x0c\x00\xe5\x04\x11\x01\x00\x00\xed\x04((\x0e\x00\xf0\x04\x00x\x02\x00\xf7\x04\x11A\x00\x00\xfc\x04\x01\x08\x00\x00\x00\x05\x00\x00\x10\x00\x02\x05\x02\x00\x02\x00\x03\x05\x00`\x00\x00\x05\x05\x00\x000\x00\x07\x05\x10@\x18\x00\t\x05\x10A\x10\x00\r\x05\x00A\x12\x04\x11\x05\x00\x01\x02\x04\x15\x05\x01\x01\x00\x00\x17\x05\x01@\x00\x00\x19\x05\x00 \x00\x04\x1b\x05\x00\x80\x00\x04\x1c\x05\x10@\x00\x04\x1d\x05\x00\x00\x08\x02\x1f\x05\x00 \x10\x00!\x05\x80\x01\x00\x00#\x05\x10\x08\x02\x00%\x05\x00@\x10\x00(\x05\x10\x01\x00\x00*\x05\x10\x08\x02\x00,\x05\x80\x00\x08\x00/\x05\x01 \x00\x001\x05\x10@\x00\x053\x05\x11A\x00\x006\x05\x10\x01@\x04:\x05\x11\x01\x10\x00=\x05\x11\x01\x02\x00A\x05\x80@\x10\x00E\x05\x04\x01\x00\x00H\x05\x00\x04\x02\x01J\x05\x80@\x00\x00M\x05\x05\x08\x00\x00O\x05\x01 \x00\x00R\x05P\x00\x02\x04T\x05\x10\x05\x00\x00W\x05\x04 \x10\x00Z\x05\x01@\x00\x00]\x05\x01\x01\x00\x00_\x05\x00A\x08\x00a\x05\x14\x00\x00\x00d\x05\x00\x00J\x00f\x05\x08\x00\x08\x00i\x05\x0c0\x04\x00k\x05\x01\x00\x04\x00p\x05\x00@\x14\x00r\x05\x10\x00\x06\x00u\x05\x00\x00\n\x00x\x05\x10\x00\x10\x00z\x05\x00\x04\x04\x00|\x05\x08\x01\x02\x00~\x05\x04!$\x00\x81\x05\x11\x00\x00\x00\x86\x05\\ \x04\x00\x88\x05\x04dH\x00\x8e\x05H\x00\x00\x00\x94\x05\x02\x0c\x00\x00\x96\x05\x08\x04\x00\x00\x99\x05H\x00\x04\x00\x9b\x05\x00\x01\x00\x05\x9e\x05\x02\t\x00\x00\xa0\x05\x00\x18\x00\x00\xa3\x05\x10\x80\x00\x00\xa5\x05\r` \x05\xa7\x05\x01\x01\x08\x00\xae\x05J\x80\n\x04\xb1\x05\x90\x01\x18\x00\xb7\x05\x15\x00\x08\x04\xbc\x05@\x00\x0c\x00\xc0\x05\x00\x00\x0c\x00\xc3\x05\x10\x00\x08\x00\xc5\x05\x00\xf9\x0e\x00\xc7\x055\x00\x06\x00\xd0\x05\x14\x18\x00\x00\xd6\x05\x00A\x00\x00\xda\x05\x04 \x02\x00\xdc\x05\x00\x01\x00\x01\xdf\x05\x00\x81B\x01\xe1\x05\x01\x00"\x00\xe6\x054\xb0\x00\x00\xe9\x05D\x00\\\x00\xef\x05\x02\x10\x0c\x00\xf5\x05\x04\x00\x04\x00\xf9\x05\x00(\x00\x00\xfb\x05\x00H\x10\x00\xfd\x052\x91\x00\x00\x00\x06l ,\x00\x06\x06\x00\x0c\x00\x00\x0e\x06\x00\x80\x00\x01\x10\x06\x11 \x02\x00\x12\x06\x04\xa0\x06\x00\x16\x06,0L\x02\x1b\x06\x19\x00@\x00$\x06\x04\x10\x0c\x00(\x06\x00\x80T\x00,\x06\x141\x04\x000\x06\x00\x00\x04\x046\x06\x02\x00\x00\x047\x06\x00\x01*\x008\x06\x80\x00\x08\x00<\x06\x01\x80\x00\x00>\x06D\x00\x00\x00@\x06\x01\x00\x02\x00B\x06\x11I\x02\x00D\x06\x10\x01\x00\x01J\x06\x01\x01\x00\x00M\x06\x01\x01\x00\x00O\x06\x00\x01\x08\x01Q\x06\x11@\x18\x00T\x06\x14\x85\x08\x00Y\x06\x11\x00\x00\x00_\x06\x10A\x00\x00a\x06@\x18\x02\x00d\x06\x00\x00\x0c\x00h\x06\x00!\x00\x00j\x06\x00`\x00\x00l\x06\x10\x00\x08\x00n\x06\x95\xd0\x08\x00p\x06\x10A\x00\x00x\x06\x00\x00\x18\x00{\x06\x00\x88\x00\x00}\x06\x01D\x00\x00\x7f\x06`\x10D\x00\x82\x06\x01\x00\x04\x00\x87\x06 \xa8 \x00\x89\x06\x04\x00\x00\x01\x8e\x06\x10\x08\x00\x00\x90\x06\x00(\x08\x00\x92\x06\x00\x01\x08\x01\x95\x06\x00(\x00\x00\x98\x06D\x90 \x00\x9a\x06\x01@\x02\x00\x9f\x06\x00H\x08\x00\xa2\x06\x06\x00\x00\x00\xa5\x06\x00H\x00\x04\xa7\x06\x00\x10\x02\x00\xa9\x06\x01\x01\x00\x00\xab\x06\x00A\x00\x00\xad\x06\x10\x01\x02\x00\xaf\x06\x01\x01\x00\x00\xb2\x06\x00\x00\x04\x04\xb4\x06\x08\x00\x04\x00\xb5\x06\x11\x00\x00\x00\xb7\x06\x08\x08\x00\x00\xb9\x06\x00\x0c\x00\x00\xbb\x06\x04\x10\x00\x00\xbd\x06\x90\t\x10\x00\xbf\x06\x04\x00\x02\x00\xc4\x06\x01\x01\x00\x00\xc6\x06\x00\x08\x0c\x00\xc8\x06\x11I\x02\x00\xcb\x06\x10\x00\x02\x00\xd1\x06\x02\x00\x00\x04\xd3\x06\x10\x00\x10\x00\xd4\x06\x00 \x08\x00\xd6\x06\x00\x08\x04\x00\xd8\x06\x10A\x00\x00\xda\x06\x04\x00\x08\x04\xdd\x06\x81\x01\x00\x04\xdf\x06\x08\x08\x00\x04\xe2\x06\x10\x10\x08\x00\xe4\x06Y\x01\x00\x00\xe7\x06\x10\x10\x04\x00\xec\x06\x84\x00\x00\x00\xef\x06\x00 \x00\x04\xf1\x06@\x10,\x00\xf2\x06@\x80\x00\x00\xf7\x06\x05@@\x00\xf9\x06\x00\x01\x04\x00\xfd\x06\x08\x08\x00\x00\xff\x06\x08\x00\x08\x00\x01\x07T\x04X\x00\x03\x07\x00\x00\x0c\x00\n\x07@\x10\x00\x00\x0c\x07\x00\x00\x05\x00\x0e\x07\x10 \x00\x00\x10\x07@ D\x02\x12\x07\x00 \x00\x04\x17\x07\x00 \x00\x01\x18\x07\x01\x08\x00\x00\x1a\x07\x0b\x18\x00\x00\x1c\x07\x00\x80\x00\x04!\x07\x90\x00\x00\x00"\x07\x10\x01\x1a\x00$\x07\x01\x08\x00\x00)\x07\x08 \x06\x00+\x07\x08\x10\x00\x00/\x07\x02@b\x001\x07\x08\x00\x04\x006\x07\x00\x80\x04\x008\x07\x06\xa1$\x00:\x07\x11\x00\x00\x00A\x07\x18\x00\x08\x00C\x07\x04\x00P\x00F\x07\x08\x08\x08\x00I\x07\x00\x10\x04\x00L\x07\n\x00$\x00N\x07\x08\x08"\x00R\x07\x00\x98\x00\x00V\x07\x18\t\x00\x00Y\x07\x00 \x06\x00]\x07\x00\x80\x08\x00`\x07\x03@\x00\x00b\x07H\x00\x08\x00e\x07\x08\x00\n\x00h\x07\x01 \x00\x00k\x07\x10 \x00\x04m\x07\x10\x00\x10\x00o\x07\x01@\x12\x00q\x07\x80H\x02\x00u\x07\x10A\x10\x00y\x07\x01H\x00\x00}\x07\x11\x00\x00\x00\x80\x07\x10\x00\x10\x00\x82\x07\x10@\x00\x00\x84\x07\x11\x81\x08\x00\x86\x07\x11@\x00\x00\x8b\x07\x10A\x00\x00\x8e\x07\x00(\x00\x00\x91\x07@\x05\x00\x00\x93\x07\x00\xa0\x00\x00\x96\x07\x00 \x00\x04\x98\x07H\x00\x00\x00\x99\x07\x14\x00\x08\x04\x9b\x07\x04\x00@\x00\x9e\x07\x10@\x00\x04\xa0\x07\x08\x00\x00\x01\xa2\x07\x10\x01\x00\x00\xa4\x07@ \x00\x00\xa6\x07\x00 \x04\x04\xa8\x07(\x00"\x00\xaa\x07\x11\x00\x00\x04\xae\x07H\x00\x04\x00\xb0\x07\x10\x00\x02\x00\xb3\x07\x10\x00\x08\x00\xb5\x07\x02\x01\x00\x00\xb7\x07\x08 \x00\x00\xb9\x07\x01\x04\x00\x00\xbb\x07P\x00\x00\x00\xbd\x07\x08 \x00\x00\xbf\x07\x05\x00\x00\x00\xc1\x07\x00!\x00\x00\xc3\x07\x08(\x00\x00\xc5\x07I\x00\x14\x04\xc8\x07F\x05\x02\x00\xcd\x07\x00\x04\x0c\x00\xd3\x07\x94\x00\n\x00\xd6\x07\x08 \x0c\x00\xdb\x07\x01\x01\x00\x00\xdf\x07\x00@\x08\x00\xe1\x07\x02@\x00\x00\xe3\x07\x00\x00\x18\x00\xe5\x07D\x01\x02\x00\xe7\x07\x80\x00\x04\x00\xeb\x07\x81\x00\x00\x00\xed\x07\x08 \x00\x00\xef\x07\x00\x0c\x00\x00\xf1\x07\x08A\x10\x00\xf3\x07\x01\x00\x02\x00\xf7\x07\x10\x00\x0c\x00\xf9\x07\x10\x00\x08\x04\xfc\x07\x10\x01\x00\x00\xfe\x07\x10\x00\x00\x04\x00\x08\x00\x05\x0c\x00\x01\x08\x11 \x00\x00\x05\x08\x80A\x00\x00\x08\x08\x00 \x04\x00\x0b\x08\x10\x01\x00\x00\r\x08\x10\x00\x08\x00\x0f\x08\x94\x01\x08\x00\x11\x08\x10\x00\x08\x00\x16\x08\x00\x01\x10\x00\x18\x08\x01\x08\x00\x00\x1a\x08\x00\x00@\x04\x1c\x08\x00\x10\x08\x00\x1d\x08\x91\x01\x00\x00\x1f\x08\x14\x00\x00\x00#\x08\x10\x01\x00\x04%\x08\x00\x01\x00\x01\'\x08\x00 \x02\x00)\x08\x10\x01\x00\x00+\x08P\x00\x00\x00-\x08\x18\x80\x04\x00/\x08\x00 \x02\x003\x08\x10\x00\x00\x045\x08\x01\x10\x00\x006\x08\x18\x01\x08\x008\x08\x11\x04\n\x00<\x08\x84\x01\n\x00A\x08\x04 \x06\x00F\x08\x05\x00\x00\x04J\x08 \x10\x04\x00L\x08\x00 \x08\x00O\x08\x00 \x08\x00Q\x08\x10\x00\x00\x04S\x08\x00H\x00\x00T\x08\x04 \x0c\x01V\x08\t\x00\x00\x00[\x08D \x00\x00]\x08\x00\x10\x08\x00`\x08\x11\x01\x00\x00b\x08\x08\x00\x00\x01e\x08\x00\x01\x0c\x00g\x08\x01\x00\x08\x00j\x08\x18\x00\x00\x00l\x08\x04\x01\x00\x00n\x08(\x80,\x00p\x08\x0cp$\x02v\x08n\xd2<\x00~\x08\x00\x88\x04\x00\x8b\x08\x00\x81\x00\x00\x8e\x08\x04\x81\x04\x00\x90\x08\x00(\x02\x00\x94\x08\x04\x00\x08\x02\x97\x08\x14\x04\x00\x00\x9a\x08\x01\x01\x00\x00\x9d\x08\x00(\x04\x00\x9f\x08L\x00\x00\x00\xa2\x08\x90\x00\x00\x00\xa5\x08\x08\x08\x04\x00\xa7\x08\x10\x00\x10\x00\xaa\x08\x11A\x00\x01\xac\x08\x00H\x10\x00\xb1\x08\x00\x01\x12\x00\xb4\x08\x11\x01\x00\x01\xb7\x08\x11A\x00\x00\xbb\x08\x18\x00\x08\x00\xbf\x08\x11H\x00\x00\xc2\x08\x14\xc1\x10\x00\xc6\x08\x00\x01\x12\x00\xcc\x08\x10\x01\x00\x00\xcf\x08\x02\x00\x00\x04\xd1\x08\x90\x00\x00\x00\xd2\x08P\x00\x00\x00\xd4\x08\x80\x01\x00\x00\xd6\x08\x11\x00\x00\x00\xd8\x08\x08\x00\x04\x00\xda\x08\x00@\x10\x00\xdc\x08 \x14\x00\x00\xde\x08@ \x08\x00\xe1\x08\x00\x00@\x04\xe4\x08\x08 \x00\x04\xe5\x08\x01P\x18\x00\xe7\x08\x10\x80\x00\x00\xec\x08\x00A\x00\x00\xee\x08\x04\x00\x04\x00\xf0\x08\x00(\n\x00\xf2\x08\x10@\x00\x00\xf6\x08\x10\x00\x04\x00\xf8\x08\x00\x00\x12\x00\xfa\x08\x11\x01\x10\x00\xfc\x08\x00\x00\x0e\x04\x00\t\x00@\x1a\x00\x03\t\x08\x04\x00\x00\x07\t\x10\x08\x00\x00\t\t\x00\x01\x0c\x00\x0b\t\x00\x01 \x00\x0e\t\x00\x00\x18\x00\x10\t(\x08\x02\x00\x12\t\x08\x08\x02\x00\x16\t0\xa0 \x00\x19\t\x14\xc02\x00\x1e\t\x00\x01\x10\x00%\t\x80 \x00\x00\'\t\x10\x0c \x00)\t\x00\x81\x00\x00-\tD\x00\x00\x00/\t\x00(\x02\x041\t\x02\x10\x00\x004\t\x10 \x00\x006\tL\x10\x00\x008\t@\x00H\x00<\t\x00\x08\x02\x00?\t\x00D\x00\x00A\t\x04\x84\x00\x00C\t\x04\x05\x00\x00F\t\t\x010\x00I\t\x00\x00\n\x00N\t\x00\xa8\n\x00P\t\x04\x00J\x00U\t\x15(\x00\x00Y\t\x0c$\x02\x00^\t\x00a\n\x00c\t\x11\x01\x00\x00h\t\x11\x01\x00\x00k\tj1\n\x01n\t\x11\x90\x02\x00x\t\x04(\x00\x00}\t\x04p"\x00\x80\t\x11A\x10\x00\x86\t(\x10\x00\x00\x8b\t\x00\x12@\x00\x8e\t\x84\x00\x00\x00\x91\tA\x00\x00\x00\x93\t\x00 \x04\x04\x95\t\x10\x80\x02\x00\x97\tp\x80"\x00\x9a\t\x00\x80\x08\x00\xa0\t\x00\x98\x02\x00\xa2\t\x11\x00\x00\x00\xa6\t 0\x08\x00\xa8\t\x02\x80\x00\x00\xac\t\x10\x04\x00\x00\xae\t\x00\x04\x08\x00\xb0\t\x04\x10\x00\x00\xb2\t\x01 \x08\x04\xb4\t\x00 \x08\x00\xb7\t\x00p\x02\x01\xb9\t\x00 \x04\x00\xbe\t\x10A\x00\x00\xc0\t\x000\x00\x00\xc3\t\x12\x00\x00\x00\xc5\t\t\x00\x00\x00\xc7\t\x01@\x00\x00\xc9\tP\x01\x00\x00\xcb\t\x00\x08\x08\x00\xce\t\x00\x81\x00\x04\xd0\t\x04 \x08\x00\xd2\t\x11 \x00\x00\xd5\tl\xa1$\x01\xd8\t\x11 \x00\x00\xe2\tG\x90\x00\x00\xe5\t\x00\x80\x10\x00\xeb\t\x14\x18\x0c\x00\xed\t\x01 \x00\x00\xf3\t\x00$\x08\x00\xf5\t\x00(\x00\x00\xf8\t\x04 \x04\x00\xfa\t\x10\x01\x00\x00\xfd\t\x02\x00@\x00\xff\t\x00H\x00\x00\x01\n\x10@\x00\x00\x03\n\x01@\x00\x00\x05\n \x00)\x00\x07\n(\x08\x00\x04\x0b\n\x01\x00\x10\x00\x0e\n\x00\t \x00\x10\n\x00\x01\x00\x04\x13\n\x08\x00\x18\x00\x14\n\x02\x01\x04\x01\x17\n\x00\x01\x08\x00\x1b\n\x00\x00\x18\x00\x1d\n\x01\x01\x10\x00\x1f\n\x0c\x00\x00\x00"\n\x04\x00\x10\x00$\n\x10@\x00\x00&\n\x00,\x00\x00(\n \x10\x02\x00+\n\x80\x80\x08\x00.\n\x00\x88\x0e\x001\n\x00\x08\x08\x006\n\x11 \x02\x008\n\x00\x80\x04\x00<\n\x10\x00\x08\x00>\n\x08\x08\x00\x00@\nX$\x08\x04B\n\x98\x00\x00\x00H\n\x08\x08\x00\x00K\n\x08\x0c\n\x00M\n\x04\x00\x04\x00R\n\x00\x00\x0c\x00T\n\x00 \x08\x04V\n'
+KIDS = b'\x01\x80\x02\x80\x03\x80\x04\x80\x05\x80\x06\x80\x07\x80\x08\x80\t\x80\n\x80\x0b\x80\x0c\x80\r\x80\x0e\x80\x0f\x80\x10\x80\x11\x80\x12\x80\x13\x80\x14\x80\x15\x80\x16\x80\x17\x80\x18\x80\x19\x80\x1a\x80\x1b\x80\x1c\x80!\x00\x1d\x80\x1e\x80)\x00\x1f\x80 \x80!\x80"\x80#\x80$\x80%\x80&\x80\'\x80(\x80)\x80\x87\x00*\x80+\x80,\x80-\x80.\x80/\x800\x801\x802\x803\x804\x805\x806\x807\x808\x80\xb6\x019\x80:\x80;\x80<\x80=\x80>\x80%\x02&\x02?\x80@\x80A\x805\x026\x02B\x80C\x80D\x80E\x80_\x02F\x80G\x80H\x80I\x80J\x80K\x80L\x80M\x80N\x80O\x80P\x80Q\x80R\x80S\x80T\x80U\x80\x0c\x03V\x80W\x80X\x80Y\x80Z\x80@\x03[\x80\\\x80]\x80^\x80_\x80\x80\x03`\x80a\x80\x86\x03b\x80c\x80d\x80\xb2\x03e\x80\xb6\x03\xb7\x03f\x80g\x80h\x80i\x80\xcc\x03j\x80k\x80l\x80m\x80n\x80o\x80p\x80q\x80+\x04r\x80s\x80t\x80u\x80v\x80w\x80x\x80y\x80z\x80{\x80|\x80\xbe\x04}\x80~\x80\xc9\x04\x7f\x80\xce\x04\xcf\x04\x80\x80\xd3\x04\x81\x80\x82\x80\x83\x80\xe7\x04\xe8\x04\x84\x80\x85\x80\x86\x80\xf2\x04\xf3\x04\xf4\x04\x87\x80\x88\x80\x89\x80\x8a\x80\x8b\x80\x8c\x80\x8d\x80\x8e\x80x\x05\x8f\x80\x90\x80\x91\x80\xc6\x05\x92\x80\x93\x80\x94\x80\x95\x80\x96\x80\x97\x80\x98\x80\x99\x80\x9a\x80\x9b\x80\x9c\x80\x9d\x80\x9e\x80\x9f\x80\xa0\x80\xa1\x80\xa2\x80\xa3\x80\xa4\x80\xa5\x80\xa6\x80\xa7\x80\xa8\x80\xa9\x80\xaa\x80\xab\x80\xac\x80\xad\x80`\x07a\x07\xae\x80\xaf\x80\xb0\x80\xb1\x80\x82\x07\xb2\x80\xb3\x80\xb4\x80\xb5\x80\xb6\x80\xb7\x80\xb8\x80\xb9\x80\xba\x80\xbb\x80\xf6\x07\xbc\x80\xbd\x80\xbe\x80\xbf\x80\x00\x00\x01\x00\x02\x00\xc0\x80\xc1\x80\t\x00\xc2\x80\x0e\x00\x0f\x00\x10\x00\x11\x00\x12\x00\xc3\x80\x18\x00\xc4\x80\x1c\x00\x1d\x00\x1e\x00\xc5\x80\xc6\x80$\x00%\x00\xc7\x80(\x00*\x00\xc8\x80-\x00.\x00/\x000\x001\x002\x00\xc9\x806\x007\x008\x009\x00:\x00;\x00<\x00\xca\x80\xcb\x80A\x00B\x00\xcc\x80\xcd\x80H\x00I\x00\xce\x80L\x00M\x00\xcf\x80P\x00Q\x00R\x00S\x00\xd0\x80W\x00\xd1\x80\xd2\x80\\\x00\xd3\x80a\x00\xd4\x80\xd5\x80j\x00k\x00\xd6\x80p\x00q\x00r\x00\xd7\x80w\x00x\x00y\x00z\x00\xd8\x80~\x00\xd9\x80\xda\x80\x84\x00\x85\x00\x86\x00\x88\x00\xdb\x80\x8b\x00\x8c\x00\xdc\x80\x90\x00\xdd\x80\xde\x80\xdf\x80\x9a\x00\xe0\x80\xe1\x80\xa0\x00\xa1\x00\xa2\x00\xe2\x80\xe3\x80\xe4\x80\xaa\x00\xe5\x80\xae\x00\xaf\x00\xb0\x00\xb1\x00\xb2\x00\xb3\x00\xe6\x80\xb6\x00\xe7\x80\xe8\x80\xbe\x00\xe9\x80\xea\x80\xeb\x80\xc7\x00\xc8\x00\xc9\x00\xec\x80\xed\x80\xee\x80\xd1\x00\xd2\x00\xd3\x00\xd4\x00\xd5\x00\xef\x80\xf0\x80\xf1\x80\xf2\x80\xe9\x00\xea\x00\xf3\x80\xed\x00\xee\x00\xf4\x80\xf5\x80\xf6\x80\xf7\x80\xfa\x00\xfb\x00\xfc\x00\xf8\x80\x00\x01\x01\x01\x02\x01\xf9\x80\xfa\x80\xfb\x80\xfc\x80\xfd\x80\xfe\x80\xff\x80\x00\x81&\x01\'\x01(\x01)\x01\x01\x81\x02\x81\x03\x81\x04\x81\x05\x81\x06\x81C\x01\x07\x81G\x01H\x01I\x01\x08\x81L\x01\t\x81\n\x81\x0b\x81\x0c\x81\r\x81\x0e\x81g\x01h\x01i\x01\x0f\x81\x10\x81\x11\x81\x12\x81\x13\x81\x14\x81\x15\x81\x85\x01\x86\x01\x16\x81\x8c\x01\x8d\x01\x17\x81\x18\x81\x19\x81\x1a\x81\x1b\x81\x1c\x81\xab\x01\xac\x01\x1d\x81\x1e\x81\x1f\x81\xb5\x01\xb7\x01 \x81!\x81\xbc\x01\xbd\x01\xbe\x01\xbf\x01\xc0\x01\xc1\x01"\x81#\x81\xca\x01$\x81\xce\x01%\x81&\x81\'\x81(\x81\xdb\x01)\x81*\x81+\x81,\x81\xeb\x01-\x81\xee\x01.\x81\xf1\x01/\x810\x811\x812\x81\x01\x023\x81\x04\x024\x81\x07\x025\x81\x0b\x02\x0c\x02\r\x02\x0e\x026\x817\x818\x81\x1b\x02\x1c\x02\x1d\x02\x1e\x02\x1f\x02 \x02!\x02"\x029\x81:\x81;\x81<\x81/\x02=\x812\x023\x024\x027\x028\x029\x02:\x02>\x81@\x02A\x02?\x81E\x02F\x02@\x81A\x81B\x81C\x81Q\x02D\x81T\x02U\x02V\x02W\x02E\x81Z\x02F\x81^\x02G\x81H\x81I\x81f\x02g\x02h\x02J\x81k\x02l\x02m\x02K\x81L\x81M\x81N\x81O\x81P\x81Q\x81\x80\x02R\x81S\x81T\x81\x8b\x02U\x81\x8e\x02V\x81W\x81X\x81Y\x81\x99\x02\x9a\x02Z\x81\x9f\x02\xa0\x02\xa1\x02\xa2\x02\xa3\x02[\x81\xa7\x02\xa8\x02\xa9\x02\xaa\x02\xab\x02\xac\x02\xad\x02\xae\x02\xaf\x02\xb0\x02\\\x81]\x81^\x81_\x81`\x81\xc0\x02a\x81\xc6\x02b\x81c\x81d\x81\xcf\x02\xd0\x02\xd1\x02\xd2\x02\xd3\x02e\x81f\x81g\x81h\x81\xe1\x02\xe2\x02i\x81j\x81k\x81l\x81\xee\x02\xef\x02m\x81n\x81\xf4\x02\xf5\x02\xf6\x02o\x81\xf9\x02\xfa\x02p\x81q\x81r\x81\x04\x03\x05\x03s\x81\x0b\x03\r\x03\x0e\x03\x0f\x03\x10\x03t\x81\x13\x03u\x81v\x81w\x81\x1f\x03 \x03!\x03"\x03x\x81%\x03y\x81(\x03)\x03z\x81{\x81|\x81}\x819\x03:\x03;\x03~\x81?\x03A\x03B\x03C\x03\x7f\x81F\x03G\x03\x80\x81L\x03M\x03N\x03O\x03\x81\x81T\x03U\x03\x82\x81Y\x03Z\x03[\x03\\\x03]\x03^\x03_\x03`\x03a\x03b\x03c\x03\x83\x81h\x03i\x03j\x03k\x03\x84\x81\x85\x81q\x03r\x03s\x03t\x03u\x03\x86\x81\x87\x81\x88\x81\x7f\x03\x81\x03\x82\x03\x89\x81\x85\x03\x8a\x81\x8a\x03\x8b\x03\x8b\x81\x8c\x81\x8d\x81\x8e\x81\x8f\x81\x90\x81\x9f\x03\x91\x81\xa2\x03\x92\x81\xa5\x03\xa6\x03\x93\x81\x94\x81\x95\x81\xb3\x03\xb4\x03\xb5\x03\xb8\x03\xb9\x03\xba\x03\xbb\x03\x96\x81\xbe\x03\xbf\x03\xc0\x03\xc1\x03\xc2\x03\xc3\x03\xc4\x03\xc5\x03\xc6\x03\xc7\x03\x97\x81\xcb\x03\x98\x81\xcf\x03\xd0\x03\xd1\x03\x99\x81\x9a\x81\xd6\x03\x9b\x81\xdb\x03\xdc\x03\xdd\x03\x9c\x81\x9d\x81\x9e\x81\xe5\x03\xe6\x03\xe7\x03\xe8\x03\xe9\x03\x9f\x81\xa0\x81\xee\x03\xa1\x81\xf2\x03\xf3\x03\xa2\x81\xf8\x03\xf9\x03\xa3\x81\xfd\x03\xfe\x03\xa4\x81\x02\x04\x03\x04\x04\x04\x05\x04\x06\x04\xa5\x81\t\x04\xa6\x81\x0c\x04\r\x04\xa7\x81\x10\x04\x11\x04\x12\x04\x13\x04\x14\x04\x15\x04\x16\x04\xa8\x81\x19\x04\xa9\x81\x1c\x04\xaa\x81\x1f\x04 \x04\xab\x81#\x04$\x04%\x04&\x04\'\x04\xac\x81*\x04,\x04-\x04\xad\x81\xae\x813\x044\x045\x04\xaf\x81<\x04\xb0\x81\xb1\x81\xb2\x81K\x04L\x04\xb3\x81Q\x04\xb4\x81\xb5\x81\xb6\x81\xb7\x81\xb8\x81\xb9\x81\xba\x81\xbb\x81\xbc\x81f\x04\xbd\x81\xbe\x81\xbf\x81\xc0\x81s\x04\xc1\x81\xc2\x81\xc3\x81|\x04\xc4\x81\x80\x04\xc5\x81\xc6\x81\xc7\x81\x88\x04\x89\x04\xc8\x81\xc9\x81\x91\x04\xca\x81\x94\x04\x95\x04\x96\x04\x97\x04\x98\x04\x99\x04\xcb\x81\x9c\x04\x9d\x04\x9e\x04\xcc\x81\xa1\x04\xa2\x04\xa3\x04\xa4\x04\xcd\x81\xa7\x04\xa8\x04\xa9\x04\xaa\x04\xab\x04\xac\x04\xad\x04\xae\x04\xaf\x04\xb0\x04\xce\x81\xb3\x04\xcf\x81\xb8\x04\xb9\x04\xba\x04\xbb\x04\xbc\x04\xbd\x04\xbf\x04\xc0\x04\xc1\x04\xd0\x81\xc4\x04\xc5\x04\xc6\x04\xc7\x04\xc8\x04\xd1\x81\xcd\x04\xd0\x04\xd1\x04\xd2\x04\xd4\x04\xd5\x04\xd6\x04\xd2\x81\xd3\x81\xdb\x04\xdc\x04\xdd\x04\xde\x04\xdf\x04\xe0\x04\xd4\x81\xe3\x04\xd5\x81\xe6\x04\xd6\x81\xed\x04\xd7\x81\xd8\x81\xf5\x04\xf6\x04\xf7\x04\xf8\x04\xd9\x81\xda\x81\xff\x04\xdb\x81\x05\x05\xdc\x81\x0b\x05\x0c\x05\r\x05\xdd\x81\x12\x05\xde\x81\x16\x05\x17\x05\xdf\x81\x1b\x05\xe0\x81\x1e\x05\x1f\x05 \x05\xe1\x81#\x05\xe2\x81\xe3\x81(\x05)\x05*\x05+\x05,\x05-\x05\xe4\x81\xe5\x81\xe6\x81\xe7\x81:\x05\xe8\x81\xe9\x81@\x05A\x05B\x05\xea\x81\xeb\x81H\x05\xec\x81\xed\x81\xee\x81\xef\x81\xf0\x81h\x05i\x05\xf1\x81m\x05n\x05\xf2\x81\xf3\x81u\x05v\x05w\x05\xf4\x81|\x05\xf5\x81\x80\x05\x81\x05\xf6\x81\xf7\x81\xf8\x81\x8a\x05\x8b\x05\xf9\x81\x8f\x05\x90\x05\xfa\x81\x93\x05\x94\x05\x95\x05\xfb\x81\xfc\x81\xfd\x81\xa0\x05\xfe\x81\xff\x81\xa7\x05\x00\x82\x01\x82\x02\x82\xb3\x05\x03\x82\xb8\x05\x04\x82\x05\x82\xc2\x05\x06\x82\xc5\x05\x07\x82\x08\x82\t\x82\xcd\x05\n\x82\xd0\x05\xd1\x05\xd2\x05\xd3\x05\xd4\x05\x0b\x82\x0c\x82\r\x82\xdb\x05\xdc\x05\x0e\x82\xe0\x05\xe1\x05\x0f\x82\xe5\x05\xe6\x05\xe7\x05\xe8\x05\xe9\x05\x10\x82\xec\x05\x11\x82\xf0\x05\xf1\x05\x12\x82\x13\x82\xf9\x05\x14\x82\x15\x82\xfe\x05\xff\x05\x16\x82\x04\x06\x17\x82\x18\x82\x19\x82\x1a\x82\x1b\x82\x1c\x82\x1d\x82\x19\x06\x1e\x82\x1c\x06\x1f\x82 \x82"\x06!\x82%\x06"\x82#\x82$\x82%\x82&\x82;\x06<\x06=\x06>\x06?\x06@\x06\'\x82(\x82)\x82*\x82K\x06L\x06M\x06N\x06O\x06P\x06Q\x06+\x82V\x06,\x82-\x82.\x82/\x82b\x060\x82e\x061\x822\x82k\x06l\x06m\x063\x82q\x06r\x064\x82x\x06y\x06z\x065\x826\x827\x828\x82\x8b\x069\x82\x91\x06:\x82;\x82\x9a\x06<\x82=\x82>\x82?\x82@\x82A\x82B\x82\xbe\x06C\x82D\x82\xc4\x06\xc5\x06E\x82\xc8\x06\xc9\x06F\x82G\x82H\x82I\x82J\x82K\x82L\x82\xe2\x06M\x82\xe5\x06\xe6\x06\xe7\x06\xe8\x06\xe9\x06\xea\x06N\x82\xed\x06\xee\x06\xef\x06O\x82\xf2\x06\xf3\x06P\x82\xf6\x06Q\x82\xfb\x06\xfc\x06\xfd\x06R\x82S\x82T\x82\x07\x07U\x82V\x82\r\x07\x0e\x07\x0f\x07\x10\x07W\x82\x13\x07\x14\x07\x15\x07\x16\x07\x17\x07\x18\x07\x19\x07X\x82\x1c\x07\x1d\x07\x1e\x07\x1f\x07Y\x82Z\x82[\x82\\\x82]\x82-\x07.\x07/\x07^\x823\x07_\x82`\x82a\x82b\x82c\x82O\x07P\x07Q\x07R\x07d\x82e\x82f\x82g\x82]\x07h\x82i\x82j\x82k\x82l\x82j\x07m\x82o\x07p\x07q\x07r\x07s\x07t\x07u\x07v\x07w\x07x\x07y\x07z\x07{\x07|\x07n\x82\x81\x07o\x82\x85\x07p\x82q\x82\x8b\x07\x8c\x07\x8d\x07\x8e\x07\x8f\x07\x90\x07r\x82s\x82\x98\x07\x99\x07\x9a\x07\x9b\x07t\x82\x9e\x07\x9f\x07\xa0\x07\xa1\x07\xa2\x07u\x82v\x82\xa8\x07\xa9\x07\xaa\x07w\x82x\x82\xaf\x07\xb0\x07y\x82\xb3\x07z\x82\xb7\x07{\x82|\x82\xbe\x07\xbf\x07\xc0\x07}\x82\xc6\x07\xc7\x07\xc8\x07\xc9\x07\xca\x07\xcb\x07\xcc\x07~\x82\x7f\x82\x80\x82\x81\x82\xd7\x07\x82\x82\x83\x82\xe1\x07\x84\x82\xe5\x07\xe6\x07\xe7\x07\xe8\x07\x85\x82\x86\x82\xf0\x07\x87\x82\x88\x82\xf5\x07\xf7\x07\xf8\x07\x89\x82\xfc\x07\xfd\x07\xfe\x07\xff\x07\x03\x00\x04\x00\x05\x00\x06\x00\x07\x00\x08\x00\n\x00\x0b\x00\x0c\x00\r\x00\x14\x00\x15\x00\x16\x00\x17\x00\x1a\x00\x1b\x00\x1f\x00 \x00"\x00#\x00\'\x00,\x004\x005\x00=\x00>\x00?\x00@\x00C\x00D\x00E\x00F\x00G\x00J\x00K\x00N\x00O\x00T\x00U\x00V\x00X\x00Y\x00Z\x00[\x00^\x00_\x00`\x00b\x00c\x00d\x00e\x00g\x00h\x00i\x00l\x00m\x00n\x00o\x00s\x00t\x00u\x00v\x00{\x00|\x00}\x00\x7f\x00\x80\x00\x81\x00\x82\x00\x83\x00\x89\x00\x8a\x00\x8d\x00\x8e\x00\x8f\x00\x91\x00\x92\x00\x94\x00\x95\x00\x96\x00\x97\x00\x98\x00\x99\x00\x9b\x00\x9c\x00\x9d\x00\x9e\x00\x9f\x00\xa3\x00\xa4\x00\xa5\x00\xa6\x00\xa7\x00\xa8\x00\xa9\x00\xab\x00\xac\x00\xad\x00\xb4\x00\xb5\x00\xb7\x00\xb8\x00\xb9\x00\xba\x00\xbb\x00\xbc\x00\xbd\x00\xbf\x00\xc0\x00\xc1\x00\xc2\x00\xc3\x00\xc4\x00\xc5\x00\xc6\x00\xca\x00\xcb\x00\xcc\x00\xcd\x00\xce\x00\xcf\x00\xd0\x00\xd6\x00\xd7\x00\xd8\x00\xd9\x00\xda\x00\xdb\x00\xdc\x00\xdd\x00\xde\x00\xdf\x00\xe0\x00\xe1\x00\xe2\x00\xe3\x00\xe4\x00\xe5\x00\xe6\x00\xe7\x00\xe8\x00\xeb\x00\xec\x00\xef\x00\xf0\x00\xf1\x00\xf2\x00\xf3\x00\xf4\x00\xf5\x00\xf6\x00\xf8\x00\xf9\x00\xfd\x00\xfe\x00\xff\x00\x03\x01\x04\x01\x05\x01\x06\x01\x08\x01\t\x01\n\x01\x0b\x01\x0c\x01\r\x01\x0e\x01\x0f\x01\x10\x01\x11\x01\x13\x01\x14\x01\x15\x01\x16\x01\x17\x01\x18\x01\x19\x01\x1a\x01\x1b\x01\x1c\x01\x1d\x01\x1f\x01 \x01!\x01"\x01#\x01$\x01%\x01*\x01+\x01,\x01-\x01.\x01/\x010\x011\x012\x013\x014\x015\x016\x017\x018\x019\x01:\x01;\x01<\x01=\x01>\x01?\x01@\x01A\x01B\x01D\x01E\x01F\x01J\x01K\x01M\x01N\x01O\x01P\x01Q\x01R\x01S\x01T\x01U\x01V\x01W\x01X\x01Y\x01Z\x01[\x01\\\x01]\x01^\x01_\x01`\x01a\x01b\x01c\x01d\x01e\x01f\x01j\x01k\x01l\x01m\x01n\x01o\x01p\x01q\x01r\x01s\x01t\x01u\x01v\x01w\x01x\x01y\x01z\x01{\x01|\x01}\x01~\x01\x7f\x01\x80\x01\x81\x01\x82\x01\x83\x01\x84\x01\x87\x01\x88\x01\x89\x01\x8a\x01\x8b\x01\x8e\x01\x8f\x01\x90\x01\x91\x01\x92\x01\x93\x01\x94\x01\x95\x01\x96\x01\x97\x01\x98\x01\x99\x01\x9a\x01\x9b\x01\x9c\x01\x9d\x01\x9e\x01\x9f\x01\xa0\x01\xa1\x01\xa2\x01\xa3\x01\xa4\x01\xa5\x01\xa6\x01\xa7\x01\xa8\x01\xaa\x01\xae\x01\xaf\x01\xb0\x01\xb1\x01\xb2\x01\xb3\x01\xb4\x01\xb8\x01\xb9\x01\xba\x01\xbb\x01\xc2\x01\xc3\x01\xc4\x01\xc5\x01\xc6\x01\xc7\x01\xc8\x01\xc9\x01\xcb\x01\xcc\x01\xcd\x01\xcf\x01\xd0\x01\xd1\x01\xd2\x01\xd3\x01\xd4\x01\xd5\x01\xd6\x01\xd7\x01\xd8\x01\xd9\x01\xda\x01\xdc\x01\xdd\x01\xde\x01\xdf\x01\xe0\x01\xe1\x01\xe2\x01\xe3\x01\xe4\x01\xe5\x01\xe6\x01\xe7\x01\xe8\x01\xe9\x01\xea\x01\xec\x01\xed\x01\xef\x01\xf0\x01\xf2\x01\xf3\x01\xf4\x01\xf5\x01\xf6\x01\xf7\x01\xf8\x01\xf9\x01\xfa\x01\xfb\x01\xfc\x01\xfd\x01\xfe\x01\xff\x01\x00\x02\x02\x02\x03\x02\x05\x02\x06\x02\x08\x02\t\x02\n\x02\x0f\x02\x10\x02\x11\x02\x12\x02\x13\x02\x14\x02\x15\x02\x16\x02\x17\x02\x18\x02\x19\x02\x1a\x02#\x02$\x02\'\x02(\x02)\x02*\x02+\x02,\x02-\x02.\x020\x021\x02;\x02<\x02=\x02>\x02?\x02B\x02C\x02D\x02G\x02H\x02I\x02J\x02K\x02M\x02N\x02O\x02P\x02R\x02S\x02X\x02Y\x02[\x02\\\x02]\x02`\x02a\x02c\x02d\x02e\x02i\x02j\x02n\x02o\x02p\x02q\x02r\x02s\x02t\x02u\x02v\x02w\x02x\x02y\x02z\x02{\x02|\x02}\x02~\x02\x7f\x02\x81\x02\x82\x02\x83\x02\x84\x02\x85\x02\x86\x02\x87\x02\x88\x02\x8a\x02\x8c\x02\x8d\x02\x8f\x02\x90\x02\x91\x02\x92\x02\x93\x02\x94\x02\x95\x02\x97\x02\x98\x02\x9c\x02\x9d\x02\x9e\x02\xa5\x02\xa6\x02\xb1\x02\xb2\x02\xb3\x02\xb4\x02\xb5\x02\xb6\x02\xb7\x02\xb8\x02\xb9\x02\xba\x02\xbb\x02\xbc\x02\xbd\x02\xbf\x02\xc1\x02\xc2\x02\xc3\x02\xc4\x02\xc5\x02\xc7\x02\xc8\x02\xc9\x02\xca\x02\xcb\x02\xcc\x02\xcd\x02\xce\x02\xd4\x02\xd5\x02\xd6\x02\xd7\x02\xd8\x02\xd9\x02\xda\x02\xdb\x02\xdc\x02\xdd\x02\xde\x02\xdf\x02\xe0\x02\xe3\x02\xe4\x02\xe5\x02\xe6\x02\xe7\x02\xe8\x02\xe9\x02\xea\x02\xeb\x02\xec\x02\xed\x02\xf1\x02\xf2\x02\xf3\x02\xf7\x02\xf8\x02\xfb\x02\xfc\x02\xfd\x02\xfe\x02\xff\x02\x01\x03\x02\x03\x03\x03\x06\x03\x07\x03\x08\x03\t\x03\n\x03\x11\x03\x12\x03\x14\x03\x15\x03\x16\x03\x17\x03\x18\x03\x19\x03\x1a\x03\x1b\x03\x1c\x03\x1d\x03\x1e\x03#\x03$\x03&\x03\'\x03*\x03+\x03,\x03-\x03.\x03/\x030\x031\x032\x033\x034\x035\x036\x037\x038\x03<\x03=\x03>\x03D\x03E\x03H\x03I\x03J\x03K\x03P\x03Q\x03R\x03S\x03V\x03W\x03X\x03d\x03e\x03f\x03g\x03l\x03m\x03n\x03o\x03p\x03v\x03w\x03x\x03y\x03z\x03{\x03|\x03}\x03~\x03\x83\x03\x84\x03\x88\x03\x89\x03\x8c\x03\x8d\x03\x8e\x03\x8f\x03\x90\x03\x91\x03\x92\x03\x93\x03\x94\x03\x95\x03\x96\x03\x97\x03\x98\x03\x99\x03\x9a\x03\x9b\x03\x9c\x03\x9d\x03\x9e\x03\xa0\x03\xa1\x03\xa3\x03\xa4\x03\xa7\x03\xa8\x03\xa9\x03\xaa\x03\xab\x03\xac\x03\xad\x03\xae\x03\xaf\x03\xb0\x03\xb1\x03\xbc\x03\xbd\x03\xc8\x03\xc9\x03\xca\x03\xcd\x03\xce\x03\xd3\x03\xd4\x03\xd5\x03\xd8\x03\xd9\x03\xda\x03\xde\x03\xdf\x03\xe1\x03\xe2\x03\xe3\x03\xe4\x03\xea\x03\xeb\x03\xec\x03\xed\x03\xf0\x03\xf1\x03\xf4\x03\xf5\x03\xf6\x03\xf7\x03\xfb\x03\xfc\x03\xff\x03\x00\x04\x01\x04\x07\x04\x08\x04\n\x04\x0b\x04\x0e\x04\x0f\x04\x17\x04\x18\x04\x1a\x04\x1b\x04\x1d\x04\x1e\x04!\x04"\x04(\x04)\x04.\x04/\x040\x041\x042\x047\x048\x049\x04:\x04;\x04=\x04>\x04?\x04@\x04A\x04B\x04C\x04D\x04E\x04F\x04G\x04H\x04I\x04J\x04M\x04N\x04O\x04P\x04R\x04S\x04T\x04U\x04V\x04W\x04X\x04Y\x04Z\x04[\x04\\\x04]\x04^\x04_\x04`\x04a\x04b\x04c\x04d\x04e\x04g\x04h\x04i\x04j\x04k\x04l\x04m\x04n\x04o\x04q\x04r\x04t\x04u\x04w\x04x\x04y\x04z\x04{\x04}\x04~\x04\x7f\x04\x81\x04\x82\x04\x83\x04\x84\x04\x85\x04\x86\x04\x87\x04\x8a\x04\x8b\x04\x8c\x04\x8d\x04\x8e\x04\x8f\x04\x90\x04\x92\x04\x93\x04\x9a\x04\x9b\x04\x9f\x04\xa0\x04\xa6\x04\xb1\x04\xb2\x04\xb4\x04\xb5\x04\xb6\x04\xb7\x04\xc2\x04\xc3\x04\xcb\x04\xcc\x04\xd7\x04\xd8\x04\xd9\x04\xda\x04\xe1\x04\xe2\x04\xe4\x04\xe5\x04\xe9\x04\xea\x04\xeb\x04\xec\x04\xee\x04\xef\x04\xf1\x04\xf9\x04\xfa\x04\xfb\x04\xfc\x04\xfd\x04\xfe\x04\x00\x05\x01\x05\x02\x05\x03\x05\x04\x05\x06\x05\x07\x05\x08\x05\t\x05\n\x05\x0e\x05\x0f\x05\x10\x05\x11\x05\x14\x05\x15\x05\x18\x05\x19\x05\x1a\x05\x1c\x05\x1d\x05!\x05"\x05%\x05&\x05\'\x05.\x05/\x050\x051\x052\x053\x054\x055\x056\x057\x058\x059\x05;\x05<\x05=\x05>\x05?\x05C\x05D\x05E\x05F\x05G\x05I\x05J\x05K\x05L\x05M\x05N\x05O\x05P\x05Q\x05R\x05S\x05T\x05U\x05V\x05W\x05X\x05Y\x05Z\x05[\x05\\\x05]\x05^\x05_\x05`\x05a\x05b\x05c\x05d\x05e\x05f\x05g\x05j\x05k\x05l\x05o\x05p\x05q\x05r\x05s\x05t\x05y\x05z\x05{\x05}\x05~\x05\x7f\x05\x82\x05\x83\x05\x84\x05\x85\x05\x86\x05\x87\x05\x88\x05\x89\x05\x8c\x05\x8d\x05\x8e\x05\x91\x05\x92\x05\x96\x05\x97\x05\x98\x05\x99\x05\x9a\x05\x9b\x05\x9c\x05\x9d\x05\x9e\x05\x9f\x05\xa1\x05\xa2\x05\xa3\x05\xa4\x05\xa5\x05\xa6\x05\xa8\x05\xa9\x05\xaa\x05\xab\x05\xac\x05\xad\x05\xae\x05\xaf\x05\xb0\x05\xb1\x05\xb2\x05\xb4\x05\xb5\x05\xb6\x05\xb7\x05\xb9\x05\xba\x05\xbb\x05\xbc\x05\xbd\x05\xbe\x05\xbf\x05\xc0\x05\xc1\x05\xc3\x05\xc4\x05\xc8\x05\xc9\x05\xca\x05\xcb\x05\xcc\x05\xce\x05\xcf\x05\xd5\x05\xd6\x05\xd7\x05\xd8\x05\xd9\x05\xda\x05\xdd\x05\xde\x05\xdf\x05\xe2\x05\xe3\x05\xe4\x05\xeb\x05\xee\x05\xef\x05\xf2\x05\xf3\x05\xf4\x05\xf5\x05\xf6\x05\xf7\x05\xf8\x05\xfa\x05\xfb\x05\xfc\x05\xfd\x05\x00\x06\x01\x06\x02\x06\x03\x06\x05\x06\x06\x06\x07\x06\x08\x06\t\x06\n\x06\x0b\x06\x0c\x06\r\x06\x0e\x06\x10\x06\x11\x06\x12\x06\x13\x06\x14\x06\x15\x06\x16\x06\x17\x06\x18\x06\x1a\x06\x1b\x06\x1d\x06\x1e\x06\x1f\x06 \x06!\x06#\x06$\x06&\x06\'\x06(\x06)\x06*\x06+\x06,\x06-\x06.\x06/\x060\x061\x062\x063\x064\x065\x066\x067\x068\x069\x06:\x06A\x06B\x06C\x06D\x06E\x06F\x06G\x06H\x06I\x06J\x06S\x06T\x06U\x06W\x06X\x06Y\x06Z\x06[\x06\\\x06]\x06^\x06_\x06`\x06a\x06c\x06d\x06f\x06g\x06h\x06i\x06j\x06n\x06o\x06p\x06s\x06t\x06u\x06v\x06w\x06{\x06|\x06}\x06~\x06\x7f\x06\x80\x06\x81\x06\x82\x06\x83\x06\x84\x06\x85\x06\x86\x06\x87\x06\x88\x06\x89\x06\x8a\x06\x8c\x06\x8d\x06\x8e\x06\x8f\x06\x90\x06\x92\x06\x93\x06\x94\x06\x95\x06\x96\x06\x97\x06\x98\x06\x99\x06\x9b\x06\x9c\x06\x9d\x06\x9e\x06\x9f\x06\xa0\x06\xa1\x06\xa2\x06\xa3\x06\xa4\x06\xa5\x06\xa6\x06\xa7\x06\xa8\x06\xa9\x06\xaa\x06\xab\x06\xac\x06\xad\x06\xae\x06\xaf\x06\xb0\x06\xb1\x06\xb2\x06\xb3\x06\xb4\x06\xb5\x06\xb6\x06\xb7\x06\xb8\x06\xb9\x06\xba\x06\xbb\x06\xbc\x06\xbd\x06\xbf\x06\xc0\x06\xc1\x06\xc2\x06\xc3\x06\xc6\x06\xc7\x06\xcb\x06\xcc\x06\xcd\x06\xce\x06\xcf\x06\xd0\x06\xd1\x06\xd2\x06\xd3\x06\xd4\x06\xd5\x06\xd6\x06\xd7\x06\xd8\x06\xd9\x06\xda\x06\xdb\x06\xdc\x06\xdd\x06\xde\x06\xdf\x06\xe0\x06\xe1\x06\xe3\x06\xe4\x06\xeb\x06\xec\x06\xf0\x06\xf1\x06\xf4\x06\xf5\x06\xf8\x06\xf9\x06\xfa\x06\xfe\x06\xff\x06\x00\x07\x01\x07\x02\x07\x03\x07\x04\x07\x05\x07\x06\x07\x08\x07\t\x07\n\x07\x0b\x07\x0c\x07\x11\x07\x12\x07\x1a\x07\x1b\x07 \x07!\x07"\x07#\x07$\x07%\x07&\x07(\x07)\x07*\x07+\x07,\x070\x071\x072\x074\x075\x076\x077\x078\x079\x07:\x07;\x07<\x07=\x07>\x07?\x07@\x07A\x07B\x07C\x07D\x07E\x07F\x07G\x07H\x07I\x07J\x07K\x07L\x07M\x07N\x07S\x07T\x07U\x07V\x07W\x07X\x07Y\x07Z\x07[\x07\\\x07^\x07_\x07b\x07c\x07d\x07e\x07f\x07g\x07h\x07i\x07k\x07l\x07m\x07n\x07~\x07\x7f\x07\x80\x07\x83\x07\x84\x07\x86\x07\x87\x07\x88\x07\x8a\x07\x91\x07\x92\x07\x93\x07\x94\x07\x95\x07\x96\x07\x97\x07\x9c\x07\x9d\x07\xa3\x07\xa4\x07\xa5\x07\xa6\x07\xa7\x07\xab\x07\xac\x07\xad\x07\xae\x07\xb1\x07\xb2\x07\xb4\x07\xb5\x07\xb6\x07\xb8\x07\xb9\x07\xba\x07\xbb\x07\xbc\x07\xbd\x07\xc1\x07\xc2\x07\xc3\x07\xc4\x07\xc5\x07\xcd\x07\xce\x07\xcf\x07\xd0\x07\xd1\x07\xd2\x07\xd3\x07\xd4\x07\xd5\x07\xd6\x07\xd8\x07\xd9\x07\xdb\x07\xdc\x07\xdd\x07\xde\x07\xdf\x07\xe0\x07\xe2\x07\xe3\x07\xe4\x07\xe9\x07\xea\x07\xeb\x07\xec\x07\xed\x07\xee\x07\xef\x07\xf1\x07\xf2\x07\xf3\x07\xf4\x07\xfa\x07\xfb\x07'
+
+# EOF
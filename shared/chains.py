@@ -107,6 +107,11 @@ class ChainsBase:
     def pubkey_to_address(cls, pubkey, addr_fmt):
         # - renders a pubkey to an address
         # - works only with single-key addresses
+        return cls.render_address(cls.pubkey_to_script(pubkey, addr_fmt))
+
+    @classmethod
+    def pubkey_to_script(cls, pubkey, addr_fmt):
+        # - scriptPubKey paying to a pubkey, for single-key addresses
         assert not addr_fmt & AFC_SCRIPT
 
         keyhash = ngu.hash.hash160(pubkey)
@@ -121,16 +126,23 @@ class ChainsBase:
         else:
             raise ValueError('bad address template: %s' % addr_fmt)
 
-        return cls.render_address(script)
+        return script
 
     @classmethod
     def address(cls, node, addr_fmt):
         # return a human-readable, properly formatted address
+        return cls.address_maker(addr_fmt)(node)
+
+    @classmethod
+    def address_maker(cls, addr_fmt):
+        # Returns function: node => address, for many nodes of the same format.
+        # - checks and lookups are done once here, not per address
 
         if addr_fmt == AF_CLASSIC:
             # olde fashioned P2PKH
             assert len(cls.b58_addr) == 1
-            return node.addr_help(cls.b58_addr[0])
+            ver = cls.b58_addr[0]
+            return lambda node: node.addr_help(ver)
 
         if addr_fmt & AFC_SCRIPT:
             # use p2sh_address() instead.
@@ -138,19 +150,18 @@ class ChainsBase:
 
         # so must be P2PKH, fetch it.
         assert addr_fmt & AFC_PUBKEY
-        raw = node.addr_help()
-        assert len(raw) == 20
 
         if addr_fmt & AFC_BECH32:
             # bech32 encoded segwit p2pkh
-            return ngu.codecs.segwit_encode(cls.bech32_hrp, 0, raw)
+            hrp, encode = cls.bech32_hrp, ngu.codecs.segwit_encode
+            return lambda node: encode(hrp, 0, node.addr_help())
 
         # see BIP-141, "P2WPKH nested in BIP16 P2SH" section
         assert addr_fmt == AF_P2WPKH_P2SH
         assert len(cls.b58_script) == 1
-        digest = hash160(b'\x00\x14' + raw)
+        ver, encode = cls.b58_script, ngu.codecs.b58_encode
 
-        return ngu.codecs.b58_encode(cls.b58_script + digest)
+        return lambda node: encode(ver + hash160(b'\x00\x14' + node.addr_help()))
 
     @classmethod
     def privkey(cls, node):
@@ -239,6 +250,49 @@ class ChainsBase:
 
         raise ValueError('Unknown payment script', repr(script))
 
+    @classmethod
+    def render_addresses(cls, scripts):
+        # render_address() over a list of scriptPubKeys; None for any we can't render
+        rv = []
+        for script in scripts:
+            try:
+                rv.append(cls.render_address(script))
+            except ValueError:
+                rv.append(None)
+
+        return rv
+
+    @classmethod
+    def script_from_address(cls, addr):
+        # inverse of render_address(): payment address => scriptPubKey
+        # - raise ValueError if it's not an address on this chain, in the exact form
+        #   we'd render it (case, encoding)
+        try:
+            raw = ngu.codecs.b58_decode(addr)
+        except:
+            raw = None
+
+        if raw is not None:
+            if len(raw) != 21:
+                raise ValueError(addr)
+            if raw[0:1] == cls.b58_addr:
+                script = b'\x76\xA9\x14' + raw[1:] + b'\x88\xAC'
+            elif raw[0:1] == cls.b58_script:
+                script = b'\xA9\x14' + raw[1:] + b'\x87'
+            else:
+                raise ValueError(addr)
+        else:
+            try:
+                _, version, prog = ngu.codecs.segwit_decode(addr)
+            except:
+                raise ValueError(addr)
+            script = bytes([(OP_1 - 1 + version) if version else 0, len(prog)]) + prog
+
+        if cls.render_address(script) != addr:
+            raise ValueError(addr)
+
+        return script
+
     @classmethod
     def op_return(cls, script):
         """Returns decoded string op return data if script is op return otherwise None"""
@@ -14,6 +14,9 @@ from ustruct import unpack, pack, calcsize
 from ucollections import namedtuple
 from uhashlib import sha256
 from uio import BytesIO
+
+# ciphertext read from card at once, during decrypt; multiple of AES block size
+READ_CHUNK = const(1024)
         
 def masked_crc(bits):
     return crc32(bits) & 0xffffffff
@@ -194,18 +197,21 @@ class SectionHeader(namedtuple('SectionHeader', ['offset', 'size', 'crc' ])):
         return rv
 
     @classmethod
-    def read_iter(cls, f, expect_crc=None):
-        # read only next one; ftell has to be on first byte already
+    def read_meta(cls, f, expect_crc=None):
+        # read next header, and the metadata (trailer) it points at, but not the
+        # body between them; file pointer is left on first byte of body
         rv = cls.read(f)
+        assert rv               # read past end
 
         if expect_crc != None:
-            assert rv           # read past end
             assert masked_crc(rv.bits) == expect_crc
 
-        section = f.read(rv.offset)
-        hdr = f.read(rv.size)
+        body_pos = f.tell()
+        f.seek(rv.offset, 1)
+        meta = f.read(rv.size)
+        f.seek(body_pos)
 
-        yield rv, hdr, section
+        return rv, meta
 
     def write(self):
         return pack('<QQL', self.offset, self.size, self.crc)
@@ -245,62 +251,82 @@ class Builder(object):
 
         return self
 
-    def read_file(self, fd, password, max_size, progress_fcn=None):
+    def open_file(self, fd, password, max_size, progress_fcn=None):
         # read a file we wrote; unlikely to work on anything else.
         # assuming single file contained inside
+        # - returns name, and iterator of plaintext pieces, decrypted as read from fd
+        # - CRC is only known after last piece: iterator raises ValueError then,
+        #   so caller must not act on anything before it's exhausted
         fhdr = FileHeader.read(fd)
         assert fhdr.has_good_magic()
 
-        for shdr, meta, body in SectionHeader.read_iter(fd):
-            # read out salt data, fname, sizes
-            fname, body_size, unpacked_size, expect_crc = self.parse_section_hdr(meta)
+        shdr, meta = SectionHeader.read_meta(fd)
+
+        # read out salt data, fname, sizes
+        fname, body_size, unpacked_size, expect_crc = self.parse_section_hdr(meta)
+
+        assert shdr.offset == body_size
+        assert unpacked_size <= max_size, 'too big'
+        assert body_size <= unpacked_size+16, 'too big, encoded'
+        assert body_size % 16 == 0, 'not blocked'
+
+        # figure out key to be used
+        key = self.calculate_key(password, progress_fcn)
+
+        return fname, self._decrypt_iter(fd, key, body_size, unpacked_size, expect_crc)
 
-            assert len(body) == body_size
-            assert unpacked_size <= max_size, 'too big'
-            assert len(body) <= unpacked_size+16, 'too big, encoded'
-            assert len(body) % 16 == 0, 'not blocked'
+    def _decrypt_iter(self, fd, key, body_size, unpacked_size, expect_crc):
+        aes = ngu.aes.CBC(False, key, self.iv)
+        left = unpacked_size
+        crc = 0
 
-            # figure out key to be used
-            key = self.calculate_key(password, progress_fcn)
+        try:
+            while body_size:
+                ct = fd.read(min(body_size, READ_CHUNK))
+                if not ct or (len(ct) % 16):
+                    raise ValueError("Truncated")
+                body_size -= len(ct)
 
-            aes = ngu.aes.CBC(False, key, self.iv)
+                pt = aes.cipher(ct)
+                del ct
 
-            out = b''
-            for blk in range(0, len(body), 16):
-                out += aes.cipher(body[blk:blk+16])
+                # trim padding
+                if len(pt) > left:
+                    pt = pt[0:left]
 
+                left -= len(pt)
+                crc = crc32(pt, crc)
+
+                yield pt
+        finally:
             aes.blank()
 
-            # trim padding, check CRC
-            out = out[0:unpacked_size]
-            if masked_crc(out) != expect_crc:
-                raise ValueError("Wrong password given, or damaged file.")
+        if left or (crc & 0xffffffff) != expect_crc:
+            raise ValueError("Wrong password given, or damaged file.")
 
-            # done. return contents
-            return fname, out
-            
     def verify_file_crc(self, fd, max_size, expected_sections=3):
-        # Read each section, and check CRC of headers, return list of files & sizes.
+        # Check CRC of headers, return list of files & sizes. Body is not read.
         fhdr = FileHeader.read(fd)
         assert fhdr.has_good_magic()
 
-        expect_crc = fhdr.crc
         files = []
-        for shdr, meta, body in SectionHeader.read_iter(fd, expect_crc=expect_crc):
-            # read out salt data, fname, sizes
-            # note: unpacked_size, expect_crc are of the plaintext (so w/o key, we can't confirm)
-            fname, body_size, unpacked_size, expect_crc = self.parse_section_hdr(meta)
+        shdr, meta = SectionHeader.read_meta(fd, expect_crc=fhdr.crc)
+
+        # read out salt data, fname, sizes
+        # note: unpacked_size, expect_crc are of the plaintext (so w/o key, we can't confirm)
+        fname, body_size, unpacked_size, expect_crc = self.parse_section_hdr(meta)
 
-            assert len(body) == body_size
-            assert unpacked_size <= max_size        # 'too big'
-            assert len(body) <= unpacked_size+16    # 'too big, encoded'
-            assert len(body) % 16 == 0              # 'not blocked'
+        assert shdr.offset == body_size
+        assert unpacked_size <= max_size        # 'too big'
+        assert body_size <= unpacked_size+16    # 'too big, encoded'
+        assert body_size % 16 == 0              # 'not blocked'
 
-            #print("Section ok: '%s' of %d bytes =>  %r" % (fname, unpacked_size, shdr))
+        #print("Section ok: '%s' of %d bytes =>  %r" % (fname, unpacked_size, shdr))
 
-            files.append((fname, unpacked_size))
+        files.append((fname, unpacked_size))
 
         # should be at end of file now.
+        fd.seek(shdr.offset + shdr.size, 1)
         assert not fd.read(10)
 
         return files
@@ -313,16 +339,24 @@ class Builder(object):
         here = len(raw)
         self.pt_crc = crc32(raw, self.pt_crc)
 
-        padded_len = (here + 15) & ~15
-        if padded_len != here:
+        # encrypt whole blocks directly from caller's buffer, and only
+        # the runt at end needs a (small) padded copy
+        whole = here & ~15
+        if whole != here:
             if self.padding != None:
                 raise ValueError()          # "can't do less than a block except at end"
-            self.padding =  (padded_len - here)
-            raw += bytes(self.padding)
+            self.padding = 16 - (here - whole)
         self.unpacked_size += here
 
-        assert len(raw) % 16 == 0
-        self.body += self.aes.cipher(raw)
+        mv = memoryview(raw)
+        ct = self.aes.cipher(mv[0:whole]) if whole else b''
+        if self.padding and whole != here:
+            ct += self.aes.cipher(bytes(mv[whole:]) + bytes(self.padding))
+
+        if self.body:
+            self.body += ct
+        else:
+            self.body = ct
 
 
     def calculate_key(self, password, progress_fcn=None):
@@ -332,6 +366,10 @@ class Builder(object):
 
         password = encode_utf_16_le(password)
 
+        if hasattr(ckcc, 'kdf_7zaes'):
+            # Mk4: same thing, in C using hash hardware
+            return ckcc.kdf_7zaes(self.salt, password, self.rounds_pow, progress_fcn)
+
         result = sha256()
 
         for i in range(rounds):
@@ -49,6 +49,13 @@ except ModuleNotFoundError:
         return struct.unpack('<I', a2b_hex(txt))[0]
 
 
+try:
+    # native version on Mk4; but might be ckcc-protocol when not micropython
+    from ckcc import descriptor_checksum as _native_checksum
+except ImportError:
+    _native_checksum = None
+
+
 class WrongCheckSumError(Exception):
     pass
 
@@ -70,6 +77,9 @@ def polymod(c, val):
     return c
 
 def descriptor_checksum(desc):
+    if _native_checksum:
+        return _native_checksum(desc)
+
     c = 1
     cls = 0
     clscount = 0
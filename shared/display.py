@@ -13,6 +13,34 @@ from zevvpeep import FontSmall, FontLarge, FontTiny
 FontFixed = object()    # ugly 8x8 PET font
 display2_buf = bytearray(1024)
 
+# rendered glyphs kept, before we start over: ascii for a few fonts, both polarities
+GLYPH_CACHE_SIZE = const(600)
+
+# decoded icons kept, before we start over: total bytes of bitmaps
+ICON_CACHE_BYTES = const(4096)
+
+def unpack_rle(data, size, invert=0):
+    # decode packbits RLE from graphics/build.py into new bitmap
+    rv = bytearray(size)
+    pos = 0
+    i = 0
+    while i < len(data):
+        n = data[i]
+        i += 1
+        if n < 128:
+            for b in data[i:i+n+1]:
+                rv[pos] = b ^ invert
+                pos += 1
+            i += n+1
+        else:
+            b = data[i] ^ invert
+            for _ in range(257-n):
+                rv[pos] = b
+                pos += 1
+            i += 1
+
+    return rv
+
 
 class Display:
 
@@ -38,6 +66,10 @@ class Display:
             raise
 
         self.last_bar_update = 0
+        self.glyphs = {}        # (font, ch, invert) => (FrameBuffer, width)
+        self.icons = {}         # (name, invert) => FrameBuffer
+        self.icons_size = 0
+        self.last_bar_width = -1
         self.clear()
         self.show()
 
@@ -45,7 +77,32 @@ class Display:
         if font == FontFixed:
             return len(msg) * 8
         else:
-            return sum(font.lookup(ord(ch)).w for ch in msg)
+            return sum(self.glyph(font, ch, 0)[1] for ch in msg)
+
+    def glyph(self, font, ch, invert):
+        # get a single character, as a FrameBuffer ready to blit, and its width
+        key = (font, ch, invert)
+        rv = self.glyphs.get(key)
+        if rv:
+            return rv
+
+        fn = font.lookup(ord(ch))
+        if fn is None:
+            # use last char in font as error char for junk we don't
+            # know how to render
+            fn = font.lookup(font.code_range.stop)
+        bits = bytearray(((fn.w + 7) // 8) * fn.h)
+        bits[0:len(fn.bits)] = fn.bits
+        if invert:
+            bits = bytearray(i^0xff for i in bits)
+
+        rv = (framebuf.FrameBuffer(bits, fn.w, fn.h, framebuf.MONO_HLSB), fn.w)
+
+        if len(self.glyphs) >= GLYPH_CACHE_SIZE:
+            self.glyphs.clear()
+        self.glyphs[key] = rv
+
+        return rv
 
     def icon(self, x, y, name, invert=0):
         if isinstance(name, tuple):
@@ -54,13 +111,27 @@ class Display:
             # see graphics.py (auto generated file) for names
             w,h, bw, wbits, data = getattr(Graphics, name)
 
-        if wbits:
-            data = uzlib.decompress(data, wbits)
+        key = (name, invert)
+        gly = self.icons.get(key)
+        if not gly:
+            if wbits == 1:
+                bits = unpack_rle(data, bw*h, 0xff if invert else 0)
+            else:
+                if wbits:
+                    data = uzlib.decompress(data, wbits)
+                if invert:
+                    bits = bytearray(i^0xff for i in data)
+                else:
+                    bits = bytearray(data)
 
-        if invert:
-            data = bytearray(i^0xff for i in data)
+            gly = framebuf.FrameBuffer(bits, w, h, framebuf.MONO_HLSB)
+
+            if self.icons_size + len(bits) > ICON_CACHE_BYTES:
+                self.icons.clear()
+                self.icons_size = 0
+            self.icons[key] = gly
+            self.icons_size += len(bits)
 
-        gly = framebuf.FrameBuffer(bytearray(data), w, h, framebuf.MONO_HLSB)
         self.dis.blit(gly, x, y, invert)
 
         return (w, h)
@@ -88,24 +159,17 @@ class Display:
 
             return x + (len(msg) * 8)
 
+        blit = self.dis.blit
         for ch in msg:
-            fn = font.lookup(ord(ch))
-            if fn is None:
-                # use last char in font as error char for junk we don't
-                # know how to render
-                fn = font.lookup(font.code_range.stop)
-            bits = bytearray(fn.w * fn.h)
-            bits[0:len(fn.bits)] = fn.bits
-            if invert:
-                bits = bytearray(i^0xff for i in bits)
-            gly = framebuf.FrameBuffer(bits, fn.w, fn.h, framebuf.MONO_HLSB)
-            self.dis.blit(gly, x, y, invert)
-            x += fn.w
+            gly, w = self.glyph(font, ch, invert)
+            blit(gly, x, y, invert)
+            x += w
 
         return x
 
     def clear(self):
         self.dis.fill(0x0)
+        self.last_bar_width = -1
 
     def clear_rect(self, x,y, w,h):
         self.dis.fill_rect(x,y, w,h, 0)
@@ -176,11 +240,19 @@ class Display:
         self.dis.hline(0, self.HEIGHT-1, int(self.WIDTH * percent), 1)
 
     def progress_sofar(self, done, total):
-        # Update progress bar, but only if it's been a while since last update
-        if utime.ticks_diff(utime.ticks_ms(), self.last_bar_update) < 100:
+        # Update progress bar, but only if it would visibly change, and it's been
+        # a while since last update. For use inside loops.
+        w = min(self.WIDTH, (self.WIDTH * done) // total)
+        if w == self.last_bar_width:
             return
-        self.last_bar_update = utime.ticks_ms()
-        self.progress_bar(done / total)
+
+        now = utime.ticks_ms()
+        if w < self.WIDTH and utime.ticks_diff(now, self.last_bar_update) < 100:
+            return
+
+        self.last_bar_update = now
+        self.last_bar_width = w
+        self.progress_bar(w / self.WIDTH)
         self.show()
 
     def progress_bar_show(self, percent):
@@ -243,13 +315,14 @@ class Display:
                 self.dis.write_data(data)
                 self.write_cmds(animate)
 
+                # bottom lines are scrolling now; won't match framebuffer
+                self.dis.forget()
+
     def write_cmds(self, cmds):
-        for c in cmds:
-            self.dis.write_cmd(c)
+        self.dis.write_cmds(cmds)
 
     def set_brightness(self, val):
         # normal = 0x7f, brightness=0xff, dim=0x00 (but they are all very similar)
-        self.dis.write_cmd(0x81)        # Set Contrast Control
-        self.dis.write_cmd(val)
+        self.dis.write_cmds(bytes([0x81, val]))        # Set Contrast Control
 
 # EOF
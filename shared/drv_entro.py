@@ -7,7 +7,8 @@
 # wallet systems, which may expect seed phrases, XPRV, or other entropy.
 #
 import stash, seed, ngu, chains, bip39, version, glob
-from ux import ux_show_story, ux_enter_bip32_index, the_ux, ux_confirm, ux_dramatic_pause
+from ux import ux_show_story, ux_enter_bip32_index, ux_enter_number, the_ux, ux_confirm
+from ux import ux_dramatic_pause
 from menu import MenuItem, MenuSystem
 from ubinascii import hexlify as b2a_hex
 from ubinascii import b2a_base64
@@ -17,6 +18,12 @@ from utils import chunk_writer, xfp2str
 
 BIP85_PWD_LEN = 21
 
+# most values written by one batch export
+BIP85_BATCH_MAX = 100
+
+CHOICES = [ '12 words', '18 words', '24 words', 'WIF (privkey)',
+            'XPRV (BIP-32)', '32-bytes hex', '64-bytes hex', 'Passwords']
+
 async def drv_entro_start(*a):
     from pincodes import pa
 
@@ -47,14 +54,15 @@ still backed-up.''')
         if not await ux_confirm(msg):
             return
 
-    choices = [ '12 words', '18 words', '24 words', 'WIF (privkey)',
-                'XPRV (BIP-32)', '32-bytes hex', '64-bytes hex', 'Passwords']
-
-    m = MenuSystem([MenuItem(c, f=drv_entro_step2) for c in choices])
+    m = MenuSystem([MenuItem(c, f=drv_entro_step2) for c in CHOICES]
+                    + [MenuItem('Batch Export', menu=batch_menu)])
     the_ux.push(m)
 
-def bip85_derive(picked, index):
-    # implement the core step of BIP85 from our master secret
+async def batch_menu(*a):
+    return MenuSystem([MenuItem(c, f=drv_entro_batch) for c in CHOICES])
+
+def bip85_path(picked, index):
+    # BIP-85 path, width of entropy, and our name for application
 
     if picked in (0,1,2):
         # BIP-39 seed phrases (we only support English)
@@ -85,17 +93,45 @@ def bip85_derive(picked, index):
     else:
         raise ValueError(picked)
 
-    with stash.SensitiveValues() as sv:
-        node = sv.derive_path(path)
-        entropy = ngu.hmac.hmac_sha512(b'bip-entropy-from-k', node.privkey())
-    
-        sv.register(entropy)
-
-        # truncate for this application
-        new_secret = entropy[0:width]
-            
+    return path, width, s_mode
+
+def bip85_derive(picked, index, sv=None):
+    # implement the core step of BIP85 from our master secret
+    # - give sv when doing many: parent of path is derived only once, see derive_path()
+    path, width, s_mode = bip85_path(picked, index)
+
+    if sv is None:
+        with stash.SensitiveValues() as sv:
+            return bip85_derive(picked, index, sv)
+
+    node = sv.derive_path(path)
+    entropy = ngu.hmac.hmac_sha512(b'bip-entropy-from-k', node.privkey())
+
+    sv.register(entropy)
+
+    # truncate for this application
+    new_secret = entropy[0:width]
+
     return new_secret, width, s_mode, path
 
+def bip85_text(s_mode, new_secret, chain):
+    # one-line text version of derived value, for batch export
+    if s_mode == 'pw':
+        return bip85_pwd(new_secret)
+    elif s_mode == 'words':
+        return bip39.b2a_words(new_secret)
+    elif s_mode == 'wif':
+        return ngu.codecs.b58_encode(chain.b58_privkey + new_secret + b'\x01')
+    elif s_mode == 'xprv':
+        node = ngu.hdnode.HDNode().from_chaincode_privkey(new_secret[0:32], new_secret[32:64])
+        rv = chain.serialize_private(node)
+        node.blank()
+        return rv
+    elif s_mode == 'hex':
+        return str(b2a_hex(new_secret), 'ascii')
+
+    raise ValueError(s_mode)
+
 
 def bip85_pwd(secret):
     # Convert raw secret (64 bytes) into type-able password text.
@@ -268,6 +304,69 @@ async def drv_entro_step2(_1, picked, _2):
         stash.blank_object(encoded)
 
 
+async def drv_entro_batch(_1, picked, _2):
+    # write a range of indices for one application into a single (signed) file
+    from glob import dis, settings
+    from files import CardSlot, CardMissingError, needs_microsd
+
+    start = await ux_enter_bip32_index("Start Index?")
+    if start is None:
+        return
+    count = await ux_enter_number("How many?", BIP85_BATCH_MAX)
+    if not count:
+        return
+
+    prompt = 'Press (1) to save %d values to MicroSD card' % count
+    if glob.VD:
+        prompt += ", (6) to save to Virtual Disk"
+    ch = await ux_show_story(prompt + '.', escape='16')
+    if ch not in '16':
+        return
+
+    chain = chains.current_chain()
+    xfp_str = xfp2str(settings.get("xfp", 0))
+    first_path = bip85_path(picked, start)[0]
+
+    lines = ['BIP-85 derived values: %s' % CHOICES[picked],
+             'Master key fingerprint: %s' % xfp_str, '']
+
+    dis.fullscreen("Working...")
+    with stash.SensitiveValues() as sv:
+        for n in range(count):
+            dis.progress_bar_show(n / count)
+
+            new_secret, _, s_mode, path = bip85_derive(picked, start+n, sv)
+            lines.append('%s => %s' % (path, bip85_text(s_mode, new_secret, chain)))
+            stash.blank_object(new_secret)
+
+    body = '\n'.join(lines) + '\n'
+    for ln in lines:
+        stash.blank_object(ln)
+    del lines
+
+    try:
+        with CardSlot(force_vdisk=(ch == '6')) as card:
+            fname, out_fn = card.pick_filename('drv-%s-idx%d-%d.txt'
+                                                    % (s_mode, start, start+count-1))
+            with open(fname, 'wt') as fp:
+                chunk_writer(fp, body)
+
+            h = ngu.hash.sha256s(body.encode())
+            sig_nice = write_sig_file([(h, fname)], derive=first_path)
+
+    except CardMissingError:
+        await needs_microsd()
+        return
+    except Exception as e:
+        await ux_show_story('Failed to write!\n\n\n'+str(e))
+        return
+    finally:
+        stash.blank_object(body)
+
+    story = "Filename is:\n\n%s" % out_fn
+    story += "\n\nSignature filename is:\n\n%s" % sig_nice
+    await ux_show_story(story, title='Saved')
+
 async def password_entry(*args, **kwargs):
     from glob import dis
     from usb import EmulatedKeyboard
@@ -3,7 +3,7 @@
 # export.py - Export and share various semi-public data
 #
 import stash, chains, version, ujson, ngu
-from uio import StringIO
+from uhashlib import sha256
 from ucollections import OrderedDict
 from utils import xfp2str, swab32, export_prompt_builder, chunk_writer
 from ux import ux_show_story
@@ -24,11 +24,11 @@ def generate_public_contents():
 
     chain = chains.current_chain()
 
-    with stash.SensitiveValues() as sv:
-
-        xfp = xfp2str(swab32(sv.node.my_fp()))
+    # public-only nodes, cached per seed: no need for secrets here
+    master = stash.SensitiveValues.public_node('m')
+    xfp = xfp2str(swab32(master.my_fp()))
 
-        yield ('''\
+    yield ('''\
 # Coldcard Wallet Summary File
 ## For wallet with master key fingerprint: {xfp}
 
@@ -50,108 +50,114 @@ What follows are derived public keys and payment addresses, as may
 be needed for different systems.
 
 
-'''.format(nb=chain.name, xpub=chain.serialize_public(sv.node), 
-            sym=chain.ctype, ct=chain.b44_cointype, xfp=xfp))
-
-        for name, path, addr_fmt in chains.CommonDerivations:
+'''.format(nb=chain.name, xpub=chain.serialize_public(master), 
+        sym=chain.ctype, ct=chain.b44_cointype, xfp=xfp))
 
-            if '{coin_type}' in path:
-                path = path.replace('{coin_type}', str(chain.b44_cointype))
+    for name, path, addr_fmt in chains.CommonDerivations:
 
-            if '{' in name:
-                name = name.format(core_name=chain.core_name)
+        if '{coin_type}' in path:
+            path = path.replace('{coin_type}', str(chain.b44_cointype))
 
-            show_slip132 = ('Core' not in name)
+        if '{' in name:
+            name = name.format(core_name=chain.core_name)
 
-            yield ('''## For {name}: {path}\n\n'''.format(name=name, path=path))
-            yield ('''First %d receive addresses (account=0, change=0):\n\n''' % num_rx)
+        show_slip132 = ('Core' not in name)
 
-            submaster = None
-            for i in range(num_rx):
-                subpath = path.format(account=0, change=0, idx=i)
+        yield ('''## For {name}: {path}\n\n'''.format(name=name, path=path))
+        yield ('''First %d receive addresses (account=0, change=0):\n\n''' % num_rx)
 
-                # find the prefix of the path that is hardneded
-                if "'" in subpath:
-                    hard_sub = subpath.rsplit("'", 1)[0] + "'"
-                else:
-                    hard_sub = 'm'
+        submaster = None
+        for i in range(num_rx):
+            subpath = path.format(account=0, change=0, idx=i)
 
-                if hard_sub != submaster:
-                    # dump the xpub needed
-
-                    if submaster:
-                        yield "\n"
+            # find the prefix of the path that is hardneded
+            if "'" in subpath:
+                hard_sub = subpath.rsplit("'", 1)[0] + "'"
+            else:
+                hard_sub = 'm'
 
-                    node = sv.derive_path(hard_sub, register=False)
-                    yield ("%s => %s\n" % (hard_sub, chain.serialize_public(node)))
-                    if show_slip132 and addr_fmt != AF_CLASSIC and (addr_fmt in chain.slip132):
-                        yield ("%s => %s   ##SLIP-132##\n" % (
-                                    hard_sub, chain.serialize_public(node, addr_fmt)))
+            if hard_sub != submaster:
+                # dump the xpub needed
 
-                    submaster = hard_sub
-                    node.blank()
-                    del node
+                if submaster:
+                    yield "\n"
 
-                # show the payment address
-                node = sv.derive_path(subpath, register=False)
-                yield ('%s => %s\n' % (subpath, chain.address(node, addr_fmt)))
+                node = stash.SensitiveValues.public_node(hard_sub)
+                yield ("%s => %s\n" % (hard_sub, chain.serialize_public(node)))
+                if show_slip132 and addr_fmt != AF_CLASSIC and (addr_fmt in chain.slip132):
+                    yield ("%s => %s   ##SLIP-132##\n" % (
+                                hard_sub, chain.serialize_public(node, addr_fmt)))
 
+                submaster = hard_sub
                 node.blank()
                 del node
 
-            yield ('\n\n')
+            # show the payment address
+            node = stash.SensitiveValues.public_node(subpath)
+            yield ('%s => %s\n' % (subpath, chain.address(node, addr_fmt)))
+
+            node.blank()
+            del node
+
+        yield ('\n\n')
 
     from multisig import MultisigWallet
     if MultisigWallet.exists():
         yield '\n# Your Multisig Wallets\n\n'
 
         for ms in MultisigWallet.get_all():
-            fp = StringIO()
-
-            ms.render_export(fp)
-            print("\n---\n", file=fp)
-
-            yield fp.getvalue()
-            del fp
+            yield from ms.render_export_lines()
+            yield "\n---\n\n"
 
 async def write_text_file(fname_pattern, body, title, derive, addr_fmt):
-    # - total_parts does need not be precise
+    # - body can be a string, or a generator of strings which is streamed to the file
     from glob import dis, NFC
     from files import CardSlot, CardMissingError, needs_microsd
 
-    force_vdisk = False
-    prompt, escape = export_prompt_builder("%s file" % title)
-    if prompt:
-        ch = await ux_show_story(prompt, escape=escape)
-        if ch == '3':
-            await NFC.share_text(body)
-            return
-        elif ch == "2":
-            force_vdisk = True
-        elif ch == '1':
-            force_vdisk = False
-        else:
-            return
+    if isinstance(body, str):
+        body = [body]
 
-    # choose a filename
     try:
-        dis.fullscreen("Saving...")
-        with CardSlot(force_vdisk=force_vdisk) as card:
-            fname, nice = card.pick_filename(fname_pattern)
-
-            # do actual write
-            with open(fname, 'wb') as fd:
-                chunk_writer(fd, body)
-
-            h = ngu.hash.sha256s(body.encode())
-            sig_nice = write_sig_file([(h, fname)], derive, addr_fmt)
-
-    except CardMissingError:
-        await needs_microsd()
-        return
-    except Exception as e:
-        await ux_show_story('Failed to write!\n\n\n'+str(e))
-        return
+        force_vdisk = False
+        prompt, escape = export_prompt_builder("%s file" % title)
+        if prompt:
+            ch = await ux_show_story(prompt, escape=escape)
+            if ch == '3':
+                await NFC.share_text(''.join(body))
+                return
+            elif ch == "2":
+                force_vdisk = True
+            elif ch == '1':
+                force_vdisk = False
+            else:
+                return
+
+        # choose a filename
+        try:
+            dis.fullscreen("Saving...")
+            with CardSlot(force_vdisk=force_vdisk) as card:
+                fname, nice = card.pick_filename(fname_pattern)
+
+                # do actual write, hashing as we go
+                h = sha256()
+                with card.open(fname, 'wb', buffered=True) as fd:
+                    for part in body:
+                        part = part.encode()
+                        h.update(part)
+                        fd.write(part)
+
+                sig_nice = write_sig_file([(h.digest(), fname)], derive, addr_fmt)
+
+        except CardMissingError:
+            await needs_microsd()
+            return
+        except Exception as e:
+            await ux_show_story('Failed to write!\n\n\n'+str(e))
+            return
+    finally:
+        # generators can hold SensitiveValues open; make sure that is cleaned up
+        if hasattr(body, 'close'):
+            body.close()
 
     msg = '%s file written:\n\n%s\n\n%s signature file written:\n\n%s' % (title, nice, title,
                                                                           sig_nice)
@@ -163,8 +169,8 @@ async def make_summary_file(fname_pattern='public.txt'):
     # record **public** values and helpful data into a text file
     dis.fullscreen('Generating...')
 
-    # generator function:
-    body = "".join(list(generate_public_contents()))
+    # generator function: streamed to file, not rendered in memory first
+    body = generate_public_contents()
     ch = chains.current_chain()
     await write_text_file(fname_pattern, body, 'Summary', "m/44'/%d'/0'/0/0" % ch.b44_cointype,
                           AF_CLASSIC)
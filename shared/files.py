@@ -3,8 +3,15 @@
 # files.py - MicroSD and related functions.
 #
 import pyb, ckcc, os, sys, utime, glob
+from prof import SD_IO
 from uerrno import ENOENT
 
+# FAT sector, what the card does all writes in
+SECTOR_SIZE = const(512)
+
+# (ms) keep SD card mounted this long after last use, for the next one
+SESSION_IDLE_MS = const(1500)
+
 async def needs_microsd():
     # Standard msg shown if no SD card detected when we need one.
     from ux import ux_show_story
@@ -76,7 +83,7 @@ def wipe_flash_filesystem():
     for n in range(bcount):
         fl.writeblocks(n, blk)
         ckcc.rng_bytes(blk)
-        dis.progress_bar_show(n/bcount)
+        dis.progress_sofar(n, bcount)
         
     # rebuild and mount /flash
     dis.fullscreen('Rebuilding...')
@@ -111,13 +118,14 @@ def wipe_microsd_card():
     sd.power(1)
 
     dis.fullscreen('Part Erase...')
-    cutoff = 1024       # arbitrary
-    blk = bytearray(512)
+    cutoff = 4096       # arbitrary, but multi-block writes make it affordable
+    per_write = 16      # blocks
+    blk = bytearray(512 * per_write)
 
-    for  bnum in range(cutoff):
+    for bnum in range(0, cutoff, per_write):
         ckcc.rng_bytes(blk)
         sd.writeblocks(bnum, blk)
-        dis.progress_bar_show(bnum/cutoff)
+        dis.progress_sofar(bnum, cutoff)
 
     dis.fullscreen('Formatting...')
 
@@ -181,11 +189,65 @@ def dfu_parse(fd):
 class CardMissingError(RuntimeError):
     pass
 
+class BufferedWriter:
+    # Collect many small writes (ie. PSBT serialization) into whole-sector writes.
+    # - write-only, sequential use; seek/tell work but flush first
+    # - not a stream for print(file=...), so only use where .write() is called
+
+    def __init__(self, fd, size=8192):
+        self.fd = fd
+        self.size = size
+        self.buf = bytearray()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *a, **k):
+        self.close()
+        return False
+
+    def write(self, b):
+        ln = len(b)
+        if not self.buf and ln >= self.size:
+            # big enough already; skip the copy
+            return self.fd.write(b)
+
+        self.buf.extend(b)
+        if len(self.buf) >= self.size:
+            # write whole sectors, keep remainder
+            here = len(self.buf) & ~(SECTOR_SIZE-1)
+            self.fd.write(memoryview(self.buf)[0:here])
+            self.buf = self.buf[here:]
+
+        return ln
+
+    def flush(self):
+        if self.buf:
+            self.fd.write(self.buf)
+            self.buf = bytearray()
+
+    def tell(self):
+        return self.fd.tell() + len(self.buf)
+
+    def seek(self, offset, whence=0):
+        self.flush()
+        return self.fd.seek(offset, whence)
+
+    def close(self):
+        self.flush()
+        self.fd.close()
+
 class CardSlot:
     # Manage access to the SDCard h/w resources
     last_change = None
     active_led = None
 
+    # Mount session: card stays mounted while any instance is using it, and for
+    # a little while after, so multi-step operations mount only once.
+    _users = 0
+    _session = 0                # bumped on each use; stale idle timers do nothing
+    _mounted_change = None      # value of last_change when we mounted, else None
+
     @classmethod
     def setup(cls):
         # Watch the SD card-detect signal line... but very noisy
@@ -217,11 +279,17 @@ class CardSlot:
         self.wrote_files = set()
 
     def __enter__(self):
+        ckcc.prof_start(SD_IO)
+
         # Mk4: maybe use our virtual disk in preference to SD Card
         if glob.VD and (_is_ejected() or self.force_vdisk):
             self.mountpt = glob.VD.mount(self.readonly)
             return self
 
+        if CardSlot._mounted_change not in (None, self.last_change):
+            # card was removed or changed since we mounted it, start over
+            self._recover()
+
         # Get ready!
         self.active_led.on()
 
@@ -232,7 +300,7 @@ class CardSlot:
                 break
             utime.sleep_ms(5)
 
-        # attempt to use micro SD
+        # attempt to use micro SD; fast if still mounted from recent use
         ok = _try_microsd()
 
         if not ok:
@@ -240,34 +308,59 @@ class CardSlot:
 
             raise CardMissingError
 
+        if CardSlot._mounted_change is None:
+            CardSlot._mounted_change = self.last_change
+
+        CardSlot._users += 1
+        CardSlot._session += 1
+
         self.mountpt = self.get_sd_root()       # probably /sd
 
         return self
 
     def __exit__(self, *a):
-        if self.mountpt == '/sd':
-            self._recover()
+        if self.mountpt == self.get_sd_root():
+            CardSlot._users -= 1
+            if not CardSlot._users:
+                # unmount later, unless used again by then
+                from utils import call_later_ms
+                call_later_ms(SESSION_IDLE_MS, CardSlot._idle_done, CardSlot._session)
         elif glob.VD:
             glob.VD.unmount(self.wrote_files)
 
         self.mountpt = None
+
+        ckcc.prof_stop(SD_IO)
         return False
 
-    def open(self, fname, mode='r', **kw):
+    def open(self, fname, mode='r', buffered=False, **kw):
         # open a file for read/write
         # - track new files for virtdisk case
+        # - buffered: for write-only files getting lots of small writes
         if 'w' in mode:
             assert not self.readonly
             self.wrote_files.add(fname)
 
-        return open(fname, mode, **kw)
+        fd = open(fname, mode, **kw)
+        if buffered:
+            assert '+' not in mode and 'r' not in mode
+            return BufferedWriter(fd)
+
+        return fd
         
-    def _recover(self):
+    @classmethod
+    async def _idle_done(cls, session):
+        # end of mount session, if not in use since
+        if not cls._users and session == cls._session:
+            cls._recover()
+
+    @classmethod
+    def _recover(cls):
         # done using the microSD -- unpower it
-        self.active_led.off()
+        cls._mounted_change = None
+        cls.active_led.off()
 
         try:
-            assert self.mountpt == '/sd'
             os.umount('/sd')
         except: pass
 
@@ -286,6 +379,9 @@ class CardSlot:
         # (full) paths to check on the card
         #root = self.get_sd_root()
         #return [root]
+        if self.mountpt == '/vdout':
+            # virtdisk outbox mode: host's files are still in the inbox
+            return [self.mountpt, '/vdisk']
         return [self.mountpt]
 
     def is_dir(self, fname):
@@ -372,15 +468,18 @@ class CardSlot:
         path, basename = full_path.rsplit('/', 1)
 
         try:
-            blk = bytes(64)
-
             with open(full_path, 'r+b') as fd:
                 size = fd.seek(0, 2)
                 fd.seek(0)
 
-                # blank it
-                for i in range((size // len(blk)) + 1):
-                    fd.write(blk)
+                # blank it; large sector-aligned writes, so FAT can do many sectors
+                # per call, but don't allocate more zeros than the file needs
+                blk = bytes(min(8 * SECTOR_SIZE, size))
+                left = size
+                while left > 0:
+                    here = min(left, len(blk))
+                    fd.write(blk if here == len(blk) else memoryview(blk)[0:here])
+                    left -= here
 
                 assert fd.seek(0, 1) >= size
 
@@ -10,16 +10,18 @@ from choosers import *
 from mk4 import dev_enable_repl
 from multisig import make_multisig_menu, import_multisig_nfc
 from seed import make_ephemeral_seed_menu, make_seed_vault_menu
-from address_explorer import address_explore
 from users import make_users_menu
-from drv_entro import drv_entro_start, password_entry
 from backups import clone_start, clone_write_data
 from xor_seed import xor_split_start, xor_restore_start
 from countdowns import countdown_chooser
-from hsm import hsm_policy_available
-from paper import make_paper_wallet
+from utils import lazy_import, hsm_policy_available
 from trick_pins import TrickPinMenu
 
+# rarely used, so not imported until needed
+address_explore = lazy_import('address_explorer', 'address_explore')
+drv_entro_start = lazy_import('drv_entro', 'drv_entro_start')
+password_entry = lazy_import('drv_entro', 'password_entry')
+make_paper_wallet = lazy_import('paper', 'make_paper_wallet')
 
 trick_pin_menu = TrickPinMenu.make_menu
 
@@ -66,6 +68,11 @@ Blocks any data over USB port. Useful when your plan is air-gap usage.'''),
         story='''Coldcard can emulate a virtual disk drive (4MB) where new PSBT files \
 can be saved. Signed PSBT files (transactions) will also be saved here. \n\
 In "auto" mode, selects PSBT as soon as written.'''),
+    ToggleMenuItem('Outbox Disk', 'vdout', ['Default Off', 'Enable'],
+        on_change=change_virtdisk_outbox, predicate=vdisk_enabled,
+        story='''Virtual disk is split into two drives: one where you save PSBT files \
+and a second, read-only drive of 1MB where signed results appear, without \
+the whole disk going away and returning.'''),
     ToggleMenuItem('NFC Sharing', 'nfc', ['Default Off', 'Enable NFC'], on_change=change_nfc_enable,
         story='''\
 NFC (Near Field Communications) allows a phone to "tap" to send and receive data \
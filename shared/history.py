@@ -37,10 +37,14 @@ class OutptValueCache:
     runtime_cache = []
     _cache_loaded = False
 
+    # index into runtime_cache: binary hashed key => entry (as stored)
+    _index = {}
+
     @classmethod
     def clear(cls):
         # user action in danger zone menu
         cls.runtime_cache.clear()
+        cls._index.clear()
         cls._cache_loaded = True
         settings.remove_key(cls.KEY)
         settings.save()
@@ -50,18 +54,25 @@ class OutptValueCache:
         # first time: read saved value, but rest of time; use what's in memory
         if not cls._cache_loaded:
             saved = settings.get(cls.KEY) or []
+            for entry in saved:
+                cls._index[a2b_base64(entry[0:ENCKEY_LEN])] = entry
             cls.runtime_cache.extend(saved)
             cls._cache_loaded = True
-    
+
 
     @classmethod
-    def encode_key(cls, prevout):
-        # hash up the txid and output number, truncate, and encode as base64
-        # - truncating at (mod3) bytes so no padding on b64 output
+    def hash_key(cls, prevout):
+        # hash up the txid and output number, truncate
         # - expects a COutPoint
         md = sha256('OutptValueCache')
         md.update(prevout.serialize())
-        return b2a_base64(md.digest()[:15])[:-1].decode()
+        return md.digest()[:15]
+
+    @classmethod
+    def encode_key(cls, prevout, hkey=None):
+        # encode hashed key as base64, for storage
+        # - truncated at (mod3) bytes so no padding on b64 output
+        return b2a_base64(hkey or cls.hash_key(prevout))[:-1].decode()
 
     @classmethod
     def encode_value(cls, prevout, amt):
@@ -88,12 +99,11 @@ class OutptValueCache:
         if not cls.runtime_cache:
             return None
 
-        key = cls.encode_key(prevout)
-        for v in cls.runtime_cache:
-            if v[0:ENCKEY_LEN] == key:
-                return cls.decode_value(prevout, v[ENCKEY_LEN:])
+        v = cls._index.get(cls.hash_key(prevout))
+        if v is None:
+            return None
 
-        return None
+        return cls.decode_value(prevout, v[ENCKEY_LEN:])
 
     @classmethod
     def verify_amount(cls, prevout, amount, in_idx):
@@ -119,22 +129,29 @@ class OutptValueCache:
     @classmethod
     def add(cls, prevout, amount):
         # protect privacy, compress a little, and save it.
-        # - we know it's not yet in our lists
-        key = cls.encode_key(prevout)
+        # - usually not yet in our lists, but replace if so (keeps index simple)
+        hkey = cls.hash_key(prevout)
+        key = cls.encode_key(prevout, hkey)
 
         # memory management: can't store very much, so trim as needed
         depth = HISTORY_SAVED
 
         # also limit in-memory use
         cls.load_cache()
+        old = cls._index.pop(hkey, None)
+        if old is not None:
+            cls.runtime_cache.remove(old)
+
         if len(cls.runtime_cache) >= HISTORY_MAX_MEM:
-            del cls.runtime_cache[0]
+            dropped = cls.runtime_cache.pop(0)
+            cls._index.pop(a2b_base64(dropped[0:ENCKEY_LEN]), None)
 
         # save new addition
         assert len(key) == ENCKEY_LEN
         assert amount > 0
         entry = key + cls.encode_value(prevout, amount)
         cls.runtime_cache.append(entry)
+        cls._index[hkey] = entry
 
         # update what we're going to save long-term
         settings.set(cls.KEY, cls.runtime_cache[-depth:])
@@ -7,6 +7,7 @@
 import stash, ustruct, chains, sys, gc, uio, ujson, uos, utime, ckcc, ngu, version
 from sffile import SFFile
 from utils import problem_file_line, cleanup_deriv_path, match_deriv_path
+from utils import HSM_POLICY_FNAME, hsm_policy_available
 from pincodes import AE_LONG_SECRET_LEN
 from stash import blank_object
 from users import Users, MAX_NUMBER_USERS, calc_local_pincode
@@ -20,7 +21,7 @@ from files import CardSlot, CardMissingError
 from serializations import CTxOut
 
 # where we save policy/config
-POLICY_FNAME = '/flash/hsm-policy.json'
+POLICY_FNAME = HSM_POLICY_FNAME
 
 # number of digits in our "local confirmation" pin
 LOCAL_PIN_LENGTH = 6
@@ -42,14 +43,6 @@ TX_PATTERNS = {
     "EQ_OUT_AMOUNTS": "all outputs must have equal amounts"
 }
 
-def hsm_policy_available():
-    # Is there an HSM policy ready to go? Offer the menu item then.
-    try:
-        uos.stat(POLICY_FNAME)
-        return True
-    except:
-        return False
-
 def hsm_delete_policy():
     # un-install HSM policy file.
     try:
@@ -186,6 +179,39 @@ class WhitelistOpts:
                 rv[f] = val
         return rv
 
+class TxnSummary:
+    # Everything the rules need to know about a PSBT's inputs/outputs, found
+    # in a single pass, and shared by all rules; see ApprovalRule.matches_transaction
+    def __init__(self, psbt):
+        self.num_ins = len(psbt.inputs)
+        self.num_outs = len(psbt.outputs)
+
+        self.own_ins = 0
+        self.own_in_value = 0
+        for i in psbt.inputs:
+            if i.num_our_keys:
+                self.own_ins += 1
+                self.own_in_value += i.amount
+
+        # (idx, nValue, scriptPubKey, is_change) for each output
+        # - output_iter() may reuse its CTxOut, so copy out the values
+        self.outs = []
+        self.total_out = 0          # foreign outputs only (non-change)
+        self.own_outs = 0
+        self.own_out_value = 0
+        self.out_amounts = set()
+
+        for idx, txo in psbt.output_iter():
+            o = psbt.outputs[idx]
+            self.outs.append((idx, txo.nValue, bytes(txo.scriptPubKey), o.is_change))
+            self.out_amounts.add(txo.nValue)
+
+            if not o.is_change:
+                self.total_out += txo.nValue
+            if o.num_our_keys:
+                self.own_outs += 1
+                self.own_out_value += txo.nValue
+
 class ApprovalRule:
     # A rule which describes transactions we are okay with approving. It documents:
     # - whitelist: list of destination addresses allowed (or None=any)
@@ -247,6 +273,21 @@ class ApprovalRule:
 
         assert_empty_dict(j)
 
+        # whitelist, as scriptPubKeys: so we don't need to encode each output/attest key
+        self.compile_whitelist(chains.current_chain())
+
+    def compile_whitelist(self, chain):
+        # Addresses for some other chain (or unusual forms) could never match a
+        # rendered output address, so they are simply left out here.
+        self.wl_chain = chain.ctype
+        self.wl_scripts = set()
+
+        for addr in (self.whitelist or []):
+            try:
+                self.wl_scripts.add(chain.script_from_address(addr))
+            except ValueError:
+                pass
+
     @property
     def has_velocity(self):
         return self.per_period is not None
@@ -322,8 +363,27 @@ class ApprovalRule:
 
         return rv
 
-    def matches_transaction(self, psbt, users, total_out, local_oked, chain):
+    def quick_reject(self, psbt, total_out):
+        # Cheap checks, done without exceptions: return the reason this rule
+        # can't apply, or None if a full matches_transaction() is needed.
+        # - must be the same checks, in same order, as start of matches_transaction
+        if self.wallet:
+            if psbt.active_multisig:
+                if self.wallet != psbt.active_multisig.name:
+                    return 'wrong wallet'
+            elif self.wallet != '1':
+                return 'not multisig'
+
+        if self.max_amount is not None and total_out > self.max_amount:
+            return 'amount exceeded'
+
+        return None
+
+    def matches_transaction(self, psbt, users, summ, local_oked, chain):
         # Does this rule apply to this PSBT file? 
+        # - summ is TxnSummary for the same psbt
+        total_out = summ.total_out
+
         if self.wallet:
             # rule limited to one wallet
             if psbt.active_multisig:
@@ -341,37 +401,42 @@ class ApprovalRule:
 
         # check all destinations are in the whitelist if mode is basic
         if self.whitelist and not attest_mode:
-            dests = set()
-            for idx, txo in psbt.output_iter():
-                o = psbt.outputs[idx]
-                if o.is_change or (txo.nValue == 0 and allow_zeroval):
+            if self.wl_chain != chain.ctype:
+                self.compile_whitelist(chain)
+
+            for idx, value, spk, is_change in summ.outs:
+                if is_change or (value == 0 and allow_zeroval):
+                    continue
+
+                if spk in self.wl_scripts:
                     continue
 
+                # only need the address text for the error message
                 try:
-                    address = chain.render_address(txo.scriptPubKey)
+                    address = chain.render_address(spk)
                 except ValueError:
-                    address = str(b2a_hex(txo.scriptPubKey), 'ascii')
+                    address = str(b2a_hex(spk), 'ascii')
 
-                dests.add(address)
-
-            diff = dests - set(self.whitelist)
-            assert not diff, "non-whitelisted address: " + diff.pop()
+                raise AssertionError("non-whitelisted address: " + address)
 
         # check all foreign outputs are attested if mode is attest
         if self.whitelist and attest_mode:
-            for idx, txo in psbt.output_iter():
-                o = psbt.outputs[idx]
-                if o.is_change or (txo.nValue == 0 and allow_zeroval):
+            if self.wl_chain != chain.ctype:
+                self.compile_whitelist(chain)
+
+            for idx, value, spk, is_change in summ.outs:
+                if is_change or (value == 0 and allow_zeroval):
                     continue
+                o = psbt.outputs[idx]
                 assert o.attestation, "missing attestation for output %i" % idx
                 # we are verifying the whole consensus-encoded txout
-                txo_bytes = CTxOut(txo.nValue, txo.scriptPubKey).serialize()
+                txo_bytes = CTxOut(value, spk).serialize()
                 digest = chain.hash_message(txo_bytes)
                 addr_fmt, pubkey = chains.verify_recover_pubkey(o.attestation, digest)
                 # we have extracted a valid pubkey from the sig, but is it
-                # a whitelisted pubkey or something else?
-                ver_addr = chain.pubkey_to_address(pubkey, addr_fmt)
-                assert ver_addr in self.whitelist, 'non-whitelisted attestation key for output %i' % idx
+                # a whitelisted pubkey or something else? (compare as scripts, no encoding)
+                ver_script = chain.pubkey_to_script(pubkey, addr_fmt)
+                assert ver_script in self.wl_scripts, 'non-whitelisted attestation key for output %i' % idx
 
         if self.local_conf:
             # local user must approve
@@ -390,34 +455,26 @@ class ApprovalRule:
 
         # check the self-transfer percentage
         if self.min_pct_self_transfer:
-            own_in_value = sum([i.amount for i in psbt.inputs if i.num_our_keys])
-            own_out_value = 0
-            for idx, txo in psbt.output_iter():
-                o = psbt.outputs[idx]
-                if o.num_our_keys:
-                    own_out_value += txo.nValue
-            percentage = (float(own_out_value) / own_in_value) * 100.0
+            percentage = (float(summ.own_out_value) / summ.own_in_value) * 100.0
             assert percentage >= self.min_pct_self_transfer, 'does not meet self transfer threshold, expected: %.2f, actual: %.2f' % (self.min_pct_self_transfer, percentage)
 
         # check various patterns
 
         if "EQ_NUM_INS_OUTS" in self.patterns:
-            assert len(psbt.inputs) == len(psbt.outputs), 'unequal number of inputs and outputs'
+            assert summ.num_ins == summ.num_outs, 'unequal number of inputs and outputs'
 
         if "EQ_NUM_OWN_INS_OUTS" in self.patterns:
-            own_ins = sum([1 for i in psbt.inputs if i.num_our_keys])
-            own_outs = sum([1 for o in psbt.outputs if o.num_our_keys])
-            assert own_ins == own_outs, 'unequal number of own inputs and outputs'
+            assert summ.own_ins == summ.own_outs, 'unequal number of own inputs and outputs'
 
         if "EQ_OUT_AMOUNTS" in self.patterns:
-            _, txo = next(psbt.output_iter())
-            wanted = txo.nValue
-            for _, txo in psbt.output_iter():
-                assert txo.nValue == wanted, 'not all output amounts are equal'
+            assert len(summ.out_amounts) == 1, 'not all output amounts are equal'
 
         return True
 
 class AuditLogger:
+    # directories known to exist already, so we can skip stat/mkdir
+    dirs_made = set()
+
     def __init__(self, dirname, digest, never_log):
         self.dirname = dirname
         self.digest = digest
@@ -431,15 +488,26 @@ class AuditLogger:
             self.card = CardSlot().__enter__()
 
             d = self.card.get_sd_root() + '/' + self.dirname
-
-            # mkdir if needed
-            try: uos.stat(d)
-            except: uos.mkdir(d)
-                
             self.fname = d + '/' + b2a_hex(self.digest[-8:]).decode('ascii') + '.log'
-            self.fd = open(self.fname, 'a+t')       # append mode
+
+            try:
+                if d not in self.dirs_made:
+                    raise OSError
+                self.file = open(self.fname, 'a+t')       # append mode
+            except OSError:
+                # mkdir if needed (maybe a different card now)
+                try: uos.stat(d)
+                except: uos.mkdir(d)
+                self.file = open(self.fname, 'a+t')
+
+            self.dirs_made.add(d)
+
+            # collect lines in memory, and write them all at once when done
+            self.fd = uio.StringIO()
         except (CardMissingError, OSError, NotImplementedError):
             # may be fatal or not, depending on configuration
+            if getattr(self, 'card', None):
+                self.card.__exit__()
             self.fname = self.card = None
             self.fd = sys.stdout
 
@@ -454,8 +522,12 @@ class AuditLogger:
 
         if self.card:
             assert self.fd != sys.stdout
-            self.fd.close()
-            self.card.__exit__(exc_type, exc_value, traceback)
+            try:
+                self.file.write(self.fd.getvalue())
+                self.file.close()
+            finally:
+                self.fd = None
+                self.card.__exit__(exc_type, exc_value, traceback)
 
     @property
     def is_unsaved(self):
@@ -900,13 +972,10 @@ class HSMPolicy:
                         raise ValueError("has %d warning(s)" % len(psbt.warnings))
 
                 # See who has entered creditials already (all must be valid).
-                users = []
-                for u, (token, counter) in auth.items():
-                    problem = Users.auth_okay(u, token, totp_time=counter, psbt_hash=psbt_sha)
-                    if problem:
-                        self.refuse(log, "User '%s' gave wrong auth value: %s" % (u, problem))
-                        return 'x'
-                    users.append(u)
+                users, bad = Users.auth_all(auth, psbt_hash=psbt_sha)
+                if bad:
+                    self.refuse(log, "User '%s' gave wrong auth value: %s" % bad)
+                    return 'x'
 
                 # was right code provided locally? (also resets for next attempt)
                 if local_ok:
@@ -914,18 +983,23 @@ class HSMPolicy:
                 if users:
                     log.info("These users gave correct auth codes: " + ', '.join(users))
 
-                # Totals (applies to foreign)
-                total_out = 0
-                for idx, txo in psbt.output_iter():
-                    outp = psbt.outputs[idx]
-                    if not outp.is_change:
-                        total_out += txo.nValue
+                # Totals (applies to foreign), and other details for the rules: one pass
+                summ = TxnSummary(psbt)
+                total_out = summ.total_out
 
                 # Pick a rule to apply to this specific txn
                 reasons = []
                 for rule in self.rules:
+                    r = rule.quick_reject(psbt, total_out)
+                    if r:
+                        # same reason text as matches_transaction() would give
+                        r = "rule #%d: %s" % (rule.index, r)
+                        reasons.append(r)
+                        print(r)
+                        continue
+
                     try:
-                        if rule.matches_transaction(psbt, users, total_out, local_ok, chain):
+                        if rule.matches_transaction(psbt, users, summ, local_ok, chain):
                             break
                     except BaseException as exc:
                         # let's not share these details, except for debug; since
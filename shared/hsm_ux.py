@@ -70,7 +70,7 @@ Press %s to save policy and enable HSM mode.''' % (self.policy.hash(), confirm_c
             sys.print_exception(exc)
             self.refused = True
 
-        self.ux_done = True
+        self.finished()
         UserAuthorizedAction.cleanup()
 
         # cleanup already done, and nothing more here ... return
@@ -3,6 +3,22 @@
 # imptask.py -- important async tasks that shouldn't die
 # 
 import sys, uasyncio, ckcc
+from utime import ticks_ms, ticks_diff
+
+# longest we'd like CPU-bound work to keep others (ie. USB) waiting, in ms
+YIELD_BUDGET_MS = const(20)
+_last_yield = 0
+
+async def share_cpu():
+    # Call at safe points in long CPU-bound work inside async code. Gives other
+    # tasks a turn once our budget is used up, so that USB requests are
+    # serviced promptly; costs nothing otherwise.
+    # - must sleep past current tick: a task woken by I/O is queued for "now",
+    #   and sleep_ms(0) would put us back ahead of it
+    global _last_yield
+    if ticks_diff(ticks_ms(), _last_yield) >= YIELD_BUDGET_MS:
+        await uasyncio.sleep_ms(2)
+        _last_yield = ticks_ms()
 
 def die_with_debug(exc):
     try:
@@ -161,9 +161,9 @@ class LoginUX:
 
             if ch == 'x':
                 if not self.pin and self.pin_prefix:
-                    # cancel on empty 2nd-stage: start over
+                    # cancel on empty 2nd-stage: start over; prompt changes
                     self.reset()
-                    self.show_pin()
+                    self.show_pin(True)
                     continue
 
                 if not self.pin and not self.pin_prefix:
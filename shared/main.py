@@ -30,11 +30,16 @@ import version
 datestamp,vers,_ = version.get_mpy_version()
 print("Version: %s / %s\n" % (vers, datestamp))
 
+# boot phase timing, see prof.report()
+from prof import boot_mark
+boot_mark('start')
+
 # Setup OLED and get something onto it.
 from display import Display
 dis = Display()
 dis.splash()
 glob.dis = dis
+boot_mark('splash')
 
 # slowish imports, some with side-effects
 import ckcc, uasyncio
@@ -51,6 +56,8 @@ except BaseException as exc:
     sys.print_exception(exc)
     # continue tho
 
+boot_mark('hw_init')
+
 # Setup membrane numpad (mark 2+)
 from mempad import MembraneNumpad
 numpad = MembraneNumpad()
@@ -61,6 +68,7 @@ from nvstore import SettingsObject
 settings = SettingsObject()
 settings.load(glob.dis)
 glob.settings = settings
+boot_mark('settings')
 
 async def more_setup():
     # Boot up code; splash screen is being shown
@@ -101,10 +109,15 @@ async def more_setup():
         # based on contents of secure chip (ie. is there
         # a wallet defined)
         from actions import start_login_sequence
+        boot_mark('pin_prompt')
         await start_login_sequence()
     except BaseException as exc:
         die_with_debug(exc)
 
+    boot_mark('logged_in')
+    import memstats
+    memstats.checkpoint('boot')
+
     IMPT.start_task('mainline', mainline())
 
 async def mainline():
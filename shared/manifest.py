@@ -28,6 +28,7 @@ freeze_as_mpy('', [
 	'login.py',
 	'main.py',
 	'mempad.py',
+	'memstats.py',
 	'menu.py',
 	'multisig.py',
 	'numpad.py',
@@ -35,6 +36,7 @@ freeze_as_mpy('', [
 	'opcodes.py',
 	'paper.py',
 	'pincodes.py',
+	'prof.py',
 	'psbt.py',
 	'pwsave.py',
 	'queues.py',
@@ -57,6 +59,7 @@ freeze_as_mpy('', [
 # Optimize data-like files, since no need to debug them.
 freeze_as_mpy('', [
 	'sigheader.py',
+	'bip39_index.py',
 	'graphics.py',
 	'zevvpeep.py',
 	'public_constants.py',
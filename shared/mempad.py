@@ -2,18 +2,19 @@
 #
 # mempad.py - Numeric keypad implemented with membrane metal-dome, not touch.
 #
-import array, utime, pyb
+import array, pyb
 from ucollections import deque
 from machine import Pin
 from random import shuffle
 from numpad import NumpadBase
-from utils import call_later_ms
+from uasyncio import ThreadSafeFlag
+from imptask import IMPT
 
 NUM_ROWS = const(4)
 NUM_COLS = const(3)         
 SAMPLE_FREQ = const(60)         # (Hz) how fast to do each scan
 NUM_SAMPLES = const(3)          # this many matching samples required for debounce
-Q_CHECK_RATE = const(5)         # (ms) how fast to check event Q
+IDLE_SCANS = const(5)           # stop scanning after this many all-up results (250ms)
 
 # (row, col) => keycode
 DECODER = 'y0x987654321'
@@ -37,18 +38,21 @@ class MembraneNumpad(NumpadBase):
         # - complete scan is done before acting on what was measured
         self.scan_order = array.array('b', list(range(NUM_ROWS)))
 
-        # each full scan is pushed onto this, only last one kept if overflow
+        # each change in debounced state is pushed onto this, only last one kept
+        # if overflow; irq sets flag when it does so
         self.scans = deque((), 50, 0)
+        self._changed = ThreadSafeFlag()
 
         # internal to timer irq handler
-        self._history = None        # see _start_scan
+        self._history = bytearray(NUM_ROWS * NUM_COLS)
         self._scan_count = 0
-        self._cycle = 0
+        self._last_scan = -1        # last result pushed onto self.scans
+        self._idle = 0              # number of all-up results in a row
 
         self.waiting_for_any = True
 
-        # time of last press
-        self.lp_time = 0
+        # handles results of scanning, only woken when they change
+        IMPT.start_task('keypad', self._scanner())
 
         for c in self.cols:
             c.irq(self.anypress_irq, Pin.IRQ_FALLING|Pin.IRQ_RISING)
@@ -67,23 +71,34 @@ class MembraneNumpad(NumpadBase):
 
     def _wait_any(self):
         # wait for any press.
+        # - also called from timer irq, so no allocation
         self.timer.deinit()
 
-        for r in self.rows:
-            r.off()
+        self.rows[0].off()
+        self.rows[1].off()
+        self.rows[2].off()
+        self.rows[3].off()
         self.waiting_for_any = True
 
     def _start_scan(self):
         # reset and re-start scanning keys
         self.waiting_for_any = False
-        self.lp_time = utime.ticks_ms()
         shuffle(self.scan_order)
 
         self._scan_count = 0
-        self._history = bytearray(NUM_ROWS * NUM_COLS)
+        self._idle = 0
+        self._last_scan = -1
+        for i in range(NUM_ROWS * NUM_COLS):
+            self._history[i] = 0
 
         self.timer.init(freq=SAMPLE_FREQ, callback=self._measure_irq)
-        call_later_ms(Q_CHECK_RATE, self._finish_scan)
+
+    def _report(self, event):
+        # from timer irq: note debounced result, but only wake the scanner if changed
+        if event != self._last_scan:
+            self._last_scan = event
+            self.scans.append(event)
+            self._changed.set()
 
     def _measure_irq(self, _timer):
         # CHALLENGE: Called at high rate, and cannot do memory alloc.
@@ -124,36 +139,38 @@ class MembraneNumpad(NumpadBase):
             # - only handling single key-down at a time.
             if sum(self._history) == 0:
                 # all are up, and debounced as such
-                self.scans.append(0xff)
+                self._report(0xff)
+                self._idle += 1
+            else:
+                self._idle = 0
 
             for i in range(NUM_ROWS * NUM_COLS):
                 if self._history[i] == NUM_SAMPLES:
                     # down
-                    self.scans.append(i)
+                    self._report(i)
 
                 self._history[i] = 0
 
-    async def _finish_scan(self):
-        # we're done a full scan (mulitple times: NUM_SAMPLES)
-        # - not trying to support multiple presses, just one
-        while self.scans:
-            event = self.scans.popleft()
+            if self._idle >= IDLE_SCANS:
+                # stop scanning now... nothing happening
+                self._wait_any()
 
-            if event == 0xff:
-                # all keys are now up
-                if self.key_pressed:
-                    self._key_event('')
-            else:
-                # indicated key was found to be down
-                key = DECODER[event]
-                self._key_event(key)
-
-                self.lp_time = utime.ticks_ms()
-
-        if not self.key_pressed and utime.ticks_diff(utime.ticks_ms(), self.lp_time) > 250:
-            # stop scanning now... nothing happening
-            self._wait_any()
-        else:
-            call_later_ms(Q_CHECK_RATE, self._finish_scan)
+    async def _scanner(self):
+        # handle results of full scans (mulitple times: NUM_SAMPLES), when changed
+        # - not trying to support multiple presses, just one
+        while 1:
+            await self._changed.wait()
+
+            while self.scans:
+                event = self.scans.popleft()
+
+                if event == 0xff:
+                    # all keys are now up
+                    if self.key_pressed:
+                        self._key_event('')
+                else:
+                    # indicated key was found to be down
+                    key = DECODER[event]
+                    self._key_event(key)
     
 # EOF
@@ -0,0 +1,55 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# memstats.py - record heap usage at named checkpoints of big jobs.
+#
+# - only active on debug builds (and so the simulator); otherwise calls return at once
+# - read back over USB with the 'MEMS' test command, or EVAL of memstats.report()
+# - MicroPython doesn't count collections, so num_gc only covers those done via collect()
+# - with reset(live=True), each checkpoint collects first: numbers are then what is
+#   retained at that point, not how much garbage built up since the last collection
+#
+import gc
+from version import is_devmode
+
+# label => [hits, min_free, max_used, num_gc]
+_stats = dict()
+
+# collect before each checkpoint, see reset()
+_live = False
+
+def checkpoint(label):
+    # note heap state here; keep worst case seen
+    if not is_devmode: return
+
+    if _live:
+        gc.collect()
+
+    free = gc.mem_free()
+    used = gc.mem_alloc()
+
+    s = _stats.get(label)
+    if s is None:
+        _stats[label] = [1, free, used, 0]
+    else:
+        s[0] += 1
+        s[1] = min(s[1], free)
+        s[2] = max(s[2], used)
+
+def collect(label):
+    # gc.collect() with a checkpoint just before, so we see the peak
+    checkpoint(label)
+    gc.collect()
+
+    if is_devmode:
+        _stats[label][3] += 1
+
+def report():
+    # label => (hits, min_free, max_used, num_gc)
+    return dict((k, tuple(v)) for k, v in _stats.items())
+
+def reset(live=False):
+    global _live
+    _live = live
+    _stats.clear()
+
+# EOF
@@ -141,6 +141,8 @@ class ToggleMenuItem(MenuItem):
 
 
 class MenuSystem:
+    # item lists made by construct(), by subclass: (data_version, items)
+    built = {}
 
     def __init__(self, menu_items, chosen=None, should_cont=None, space_indicators=False):
         self.should_continue = should_cont or (lambda: True)
@@ -161,12 +163,36 @@ class MenuSystem:
         # something changed in system state; maybe re-construct menu contents
         pass
 
+    @classmethod
+    def data_version(cls):
+        # for subclasses with construct(): return a value which changes whenever
+        # the data behind the menu does. None means unknown, so always rebuild.
+        return None
+
+    @classmethod
+    def cached_construct(cls):
+        # same as construct(), but reuse the last list made if data hasn't changed
+        # - avoids settings parsing and SD card access on each visit
+        ver = cls.data_version()
+        b = MenuSystem.built.get(cls)
+        if ver is None or not b or b[0] != ver:
+            b = (ver, cls.construct())
+            MenuSystem.built[cls] = b
+        return b[1]
+
+    def rebuild(self):
+        # for update_contents(): replace items only if data has changed
+        tmp = self.cached_construct()
+        if tmp is not self.source:
+            self.replace_items(tmp)
+
     def replace_items(self, menu_items, keep_position=False):
         # only safe to keep position if you know number of items isn't changing
         if not keep_position:
             self.cursor = 0
             self.ypos = 0
 
+        self.source = menu_items
         self.items = [m for m in menu_items if not getattr(m, 'predicate', None) or m.predicate()]
         self.count = len(self.items)
 
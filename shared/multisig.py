@@ -20,6 +20,12 @@ TRUST_VERIFY = const(0)
 TRUST_OFFER = const(1)
 TRUST_PSBT = const(2)
 
+# max number of derived cosigner nodes kept per wallet (see cosigner_node)
+NODE_CACHE_SIZE = const(64)
+
+# max number of validated cosigner xpubs remembered (see check_xpub)
+XPUB_CACHE_SIZE = const(32)
+
 
 class MultisigOutOfSpace(RuntimeError):
     pass
@@ -92,17 +98,15 @@ def make_redeem_script(M, nodes, subkey_idx):
     for n in nodes:
         copy = n.copy()
         copy.derive(subkey_idx, False)
-        # 0x21 = 33 = len(pubkey) = OP_PUSHDATA(33)
-        pubkeys.append(b'\x21' + copy.pubkey())
+        pubkeys.append(copy.pubkey())
         del copy
 
     pubkeys.sort()
 
     # serialize redeem script
-    pubkeys.insert(0, bytes([80 + M]))
-    pubkeys.append(bytes([80 + N, OP_CHECKMULTISIG]))
-
-    return b''.join(pubkeys)
+    # 0x21 = 33 = len(pubkey) = OP_PUSHDATA(33)
+    return bytes([80 + M, 0x21]) + b'\x21'.join(pubkeys) \
+                + bytes([80 + N, OP_CHECKMULTISIG])
 
 class MultisigWallet:
     # Capture the info we need to store long-term in order to participate in a
@@ -124,6 +128,14 @@ class MultisigWallet:
 
     # optional: user can short-circuit many checks (system wide, one power-cycle only)
     disable_checks = False
+    _xpub_cache = {}        # see check_xpub()
+
+    # for the list in settings, see _get_index():
+    # - (N, sorted xfps) => [storage_idx, ...]
+    # - set of (M, N, xor of xfps), for quick_check()
+    _index = None
+    _index_of = None
+    _xors = None
 
     def __init__(self, name, m_of_n, xpubs, addr_fmt=AF_P2SH, chain_type='BTC'):
         self.storage_idx = -1
@@ -143,6 +155,9 @@ class MultisigWallet:
 
         assert len(self.xfp_paths) == self.N, 'dup XFP'         # not supported
 
+        # (xp_idx, subpath) => BIP-32 node; see cosigner_node()
+        self._node_cache = {}
+
     @classmethod
     def render_addr_fmt(cls, addr_fmt):
         for k, v in cls.FORMAT_NAMES:
@@ -238,6 +253,51 @@ class MultisigWallet:
                 
             yield cls.deserialize(rec, idx)
 
+    @classmethod
+    def _get_index(cls):
+        # built from raw records, no deserialize needed; returns the list indexed
+        lst = settings.get('multisig', [])
+        if cls._index is None or cls._index_of is not lst:
+            # rebuild: first use, or settings reloaded (different seed, etc)
+            index = {}
+            xors = set()
+            for idx, rec in enumerate(lst):
+                M, N = rec[1]
+                xfps = [xp[0] for xp in rec[2]]
+                index.setdefault((N, tuple(sorted(xfps))), []).append(idx)
+
+                # like xfp_paths.keys() after deserialize: no dups
+                x = 0
+                for xfp in set(xfps):
+                    x ^= xfp
+                xors.add((M, N, x))
+
+            cls._index = index
+            cls._xors = xors
+            cls._index_of = lst
+
+        return lst
+
+    @classmethod
+    def _by_xfps(cls, xfp_paths, M=None, addr_fmt=None):
+        # same as iter_wallets(), but only those using exactly the xfp values in
+        # xfp_paths, found by index so we don't deserialize the others
+        N = len(xfp_paths)
+        xfps = tuple(sorted(set(x[0] for x in xfp_paths)))
+        if len(xfps) != N:
+            # dup xfp given: unusual, do it the slow way
+            yield from cls.iter_wallets(M, N, addr_fmt=addr_fmt)
+            return
+
+        lst = cls._get_index()
+
+        for idx in cls._index.get((N, xfps), []):
+            rec = lst[idx]
+            if M is not None and rec[1][0] != M: continue
+            if addr_fmt is not None and rec[3].get('ft', AF_P2SH) != addr_fmt: continue
+
+            yield cls.deserialize(rec, idx)
+
     def get_xfp_paths(self):
         # return list of lists [xfp, *deriv]
         return list(self.xfp_paths.values())
@@ -248,7 +308,10 @@ class MultisigWallet:
         # - xfp_paths is list of lists: [xfp, *path] like in psbt files
         # - M and N must be known
         # - returns instance, or None if not found
-        for rv in cls.iter_wallets(M, N, addr_fmt=addr_fmt):
+        if len(xfp_paths) != N:
+            return None
+
+        for rv in cls._by_xfps(xfp_paths, M, addr_fmt=addr_fmt):
             if rv.matching_subpaths(xfp_paths):
                 return rv
 
@@ -264,7 +327,7 @@ class MultisigWallet:
         N = len(xfp_paths)
         
         matches = []
-        for rv in cls.iter_wallets(M=M, addr_fmt=addr_fmt):
+        for rv in cls._by_xfps(xfp_paths, M, addr_fmt=addr_fmt):
             if rv.matching_subpaths(xfp_paths):
                 matches.append(rv)
 
@@ -308,7 +371,10 @@ class MultisigWallet:
     @classmethod
     def quick_check(cls, M, N, xfp_xor):
         # quicker? USB method.
-        rv = []
+        if M and N:
+            cls._get_index()
+            return (M, N, xfp_xor) in cls._xors
+
         for ms in cls.iter_wallets(M, N):
             x = 0
             for xfp in ms.xfp_paths.keys():
@@ -356,6 +422,7 @@ class MultisigWallet:
             v[self.storage_idx] = obj
 
         settings.set('multisig', v)
+        MultisigWallet._index = None
 
         # save now, rather than in background, so we can recover
         # from out-of-space situation
@@ -424,6 +491,7 @@ class MultisigWallet:
         lst = settings.get('multisig', [])
         del lst[self.storage_idx]
         settings.set('multisig', lst)
+        MultisigWallet._index = None
         settings.save()
 
         self.storage_idx = -1
@@ -450,8 +518,8 @@ class MultisigWallet:
             # load bip32 node for each cosigner
             node = ch.deserialize_node(xpub, AF_P2SH)
             node.derive(change_idx, False)
-            # indicate path used (for UX)
-            path = "[%s/%s/%d/{idx}]" % (xfp2str(xfp), deriv[2:], change_idx)
+            # indicate path used (for UX); index and "]" added below
+            path = "[%s/%s/%d/" % (xfp2str(xfp), deriv[2:], change_idx)
             nodes.append(node)
             paths.append(path)
 
@@ -462,11 +530,34 @@ class MultisigWallet:
             addr = ch.p2sh_address(self.addr_fmt, script)
             addr = addr[0:12] + '___' + addr[12+3:]
 
-            yield idx, [p.format(idx=idx) for p in paths], addr, script
+            tail = '%d]' % idx
+            yield idx, [p + tail for p in paths], addr, script
 
             idx += 1
             count -= 1
 
+    def cosigner_node(self, xp_idx, subpath=()):
+        # BIP-32 node for a cosigner's xpub, derived down the (non-hardened) subpath.
+        # - caches result, since same change/receive branch is used over and over
+        # - shared object: copy it before any further derivation
+        key = (xp_idx, subpath)
+        rv = self._node_cache.get(key)
+        if rv is not None:
+            return rv
+
+        if subpath:
+            rv = self.cosigner_node(xp_idx, subpath[:-1]).copy()
+            rv.derive(subpath[-1], False)
+        else:
+            rv = self.chain.deserialize_node(self.xpubs[xp_idx][-1], AF_P2SH)
+            assert rv
+
+        if len(self._node_cache) >= NODE_CACHE_SIZE:
+            self._node_cache.clear()
+        self._node_cache[key] = rv
+
+        return rv
+
     def validate_script(self, redeem_script, subpaths=None, xfp_paths=None):
         # Check we can generate all pubkeys in the redeem script, raise on errors.
         # - working from pubkeys in the script, because duplicate XFP can happen
@@ -478,7 +569,6 @@ class MultisigWallet:
 
         subpath_help = []
         used = set()
-        ch = self.chain
 
         M, N, pubkeys = disassemble_multisig(redeem_script)
         assert M==self.M and N == self.N, 'wrong M/N in script'
@@ -514,9 +604,7 @@ class MultisigWallet:
             too_shallow = False
             for xp_idx, path in check_these:
                 # matched fingerprint, try to make pubkey that needs to match
-                xpub = self.xpubs[xp_idx][-1]
-
-                node = ch.deserialize_node(xpub, AF_P2SH); assert node
+                node = self.cosigner_node(xp_idx)
                 dp = node.depth()
 
                 #print("%s => deriv=%s dp=%d len(path)=%d path=%s" %
@@ -528,9 +616,14 @@ class MultisigWallet:
                     too_shallow = True
                     continue
 
-                for sp in path[dp:]:
+                sub = tuple(path[dp:])
+                for sp in sub:
                     assert not (sp & 0x80000000), 'hard deriv'
-                    node.derive(sp, False)     # works in-place
+
+                if sub:
+                    # branch node is cached, so just one derivation here, typically
+                    node = self.cosigner_node(xp_idx, sub[:-1]).copy()
+                    node.derive(sub[-1], False)     # works in-place
 
                 found_pk = node.pubkey()
 
@@ -741,7 +834,23 @@ class MultisigWallet:
         # - deriv can be None, and in very limited cases can recover derivation path
         # - could enforce all same depth, and/or all depth >= 1, but
         #   seems like more restrictive than needed, so "m" is allowed
+        # - results are remembered: every PSBT from a wallet repeats the same xpubs
+        key = (xfp, xpub, deriv, expect_chain, my_xfp, cls.disable_checks)
+        rv = cls._xpub_cache.get(key)
+        if rv is None:
+            rv = cls._check_xpub(xfp, xpub, deriv, expect_chain, my_xfp)
 
+            if len(cls._xpub_cache) >= XPUB_CACHE_SIZE:
+                cls._xpub_cache.clear()
+            cls._xpub_cache[key] = rv
+
+        xpubs.append(rv)
+
+        return (rv[0] == my_xfp)
+
+    @classmethod
+    def _check_xpub(cls, xfp, xpub, deriv, expect_chain, my_xfp):
+        # does work for check_xpub(), returns (xfp, deriv, xpub) or fails assertion
         try:
             # Note: addr fmt detected here via SLIP-132 isn't useful
             node, chain, _ = parse_extended_key(xpub)
@@ -806,9 +915,7 @@ class MultisigWallet:
 
         # serialize xpub w/ BIP-32 standard now.
         # - this has effect of stripping SLIP-132 confusion away
-        xpubs.append((xfp, deriv, chain.serialize_public(node, AF_P2SH)))
-
-        return (xfp == my_xfp)
+        return (xfp, deriv, chain.serialize_public(node, AF_P2SH))
 
     def make_fname(self, prefix, suffix='txt'):
         rv = '%s-%s.%s' % (prefix, self.name, suffix)
@@ -871,10 +978,8 @@ class MultisigWallet:
         if prompt:
             ch = await ux_show_story(prompt, escape=escape)
             if ch == "3":
-                with uio.StringIO() as fp:
-                    self.render_export(fp, hdr_comment=hdr, descriptor=descriptor,
-                                       core=core, desc_pretty=desc_pretty)
-                    await NFC.share_text(fp.getvalue())
+                await NFC.share_text(''.join(self.render_export_lines(hdr_comment=hdr,
+                                    descriptor=descriptor, core=core, desc_pretty=desc_pretty)))
                 return
             elif ch == "1":
                 force_vdisk = False
@@ -887,16 +992,15 @@ class MultisigWallet:
             with CardSlot(force_vdisk=force_vdisk) as card:
                 fname, nice = card.pick_filename(fname_pattern)
 
-                # do actual write
-                with open(fname, 'w+') as fp:
-                    self.render_export(fp, hdr_comment=hdr, descriptor=descriptor,
-                                       core=core, desc_pretty=desc_pretty)
-                #     fp.seek(0)
-                #     contents = fp.read()
+                # do actual write, streamed
+                with card.open(fname, 'wb', buffered=True) as fp:
+                    for part in self.render_export_lines(hdr_comment=hdr, descriptor=descriptor,
+                                                         core=core, desc_pretty=desc_pretty):
+                        fp.write(part.encode())
                 # TODO re-enable once we know how to proceed with regards to with which key to sign
+                # - hash each part above, as in export.write_text_file()
                 # from auth import write_sig_file
-                # h = ngu.hash.sha256s(contents.encode())
-                # sig_nice = write_sig_file([(h, fname)])
+                # sig_nice = write_sig_file([(h.digest(), fname)])
 
             msg = '%s file written:\n\n%s' % (label, nice)
             # msg += '\n\nColdcard multisig signature file written:\n\n%s' % sig_nice
@@ -912,36 +1016,43 @@ class MultisigWallet:
             await ux_show_story('Failed to write!\n\n\n'+str(e))
             return
 
-    def render_export(self, fp, hdr_comment=None, descriptor=False, core=False, desc_pretty=True):
+    def render_export(self, fp, **kws):
+        # write whole export into fp; see render_export_lines() for args
+        for part in self.render_export_lines(**kws):
+            fp.write(part)
+
+    def render_export_lines(self, hdr_comment=None, descriptor=False, core=False,
+                            desc_pretty=True):
+        # generator: text of the export file, a line (or so) at a time
         if descriptor:
             # serialize descriptor
             desc_obj = self.to_descriptor()
             if core:
                 core_obj = desc_obj.bitcoin_core_serialize()
                 core_str = ujson.dumps(core_obj)
-                print("importdescriptors '%s'\n" % core_str, file=fp)
+                yield "importdescriptors '%s'\n\n" % core_str
             else:
                 if desc_pretty:
                     desc = desc_obj.pretty_serialize()
                 else:
                     desc = desc_obj.serialize()
-                print("%s\n" % desc, file=fp)
+                yield "%s\n\n" % desc
         else:
             if hdr_comment:
-                print("# Coldcard Multisig setup file (%s)\n#" % hdr_comment, file=fp)
+                yield "# Coldcard Multisig setup file (%s)\n#\n" % hdr_comment
 
-            print("Name: %s\nPolicy: %d of %d" % (self.name, self.M, self.N), file=fp)
+            yield "Name: %s\nPolicy: %d of %d\n" % (self.name, self.M, self.N)
 
             if self.addr_fmt != AF_P2SH:
-                print("Format: " + self.render_addr_fmt(self.addr_fmt), file=fp)
+                yield "Format: " + self.render_addr_fmt(self.addr_fmt) + "\n"
 
             last_deriv = None
             for xfp, deriv, val in self.xpubs:
                 if last_deriv != deriv:
-                    print("\nDerivation: %s\n" % deriv, file=fp)
+                    yield "\nDerivation: %s\n\n" % deriv
                     last_deriv = deriv
 
-                print('%s: %s' % (xfp2str(xfp), val), file=fp)
+                yield '%s: %s\n' % (xfp2str(xfp), val)
 
     @classmethod
     def guess_addr_fmt(cls, npath):
@@ -1063,6 +1174,9 @@ class MultisigWallet:
 
     async def confirm_import(self):
         # prompt them about a new wallet, let them see details and then commit change.
+        import memstats
+        memstats.checkpoint('ms_import')
+
         M, N = self.M, self.N
 
         if M == N == 1:
@@ -1256,11 +1370,16 @@ class MultisigMenu(MenuSystem):
 
         return rv
 
+    @classmethod
+    def data_version(cls):
+        # wallets are all held in settings
+        from nvstore import SettingsObject
+        return SettingsObject.version
+
     def update_contents(self):
         # Reconstruct the list of wallets on this dynamic menu, because
         # we added or changed them and are showing that same menu again.
-        tmp = self.construct()
-        self.replace_items(tmp)
+        self.rebuild()
 
 
 async def make_multisig_menu(*a):
@@ -1271,7 +1390,7 @@ async def make_multisig_menu(*a):
         await ux_show_story("You must have wallet seed before creating multisig wallets.")
         return
 
-    rv = MultisigMenu.construct()
+    rv = MultisigMenu.cached_construct()
     return MultisigMenu(rv)
 
 async def make_ms_wallet_menu(menu, label, item):
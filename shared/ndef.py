@@ -41,11 +41,10 @@ class ndefMaker:
 
     def add_large_object(self, ext_type, offset, obj_len):
         # zero-copy a binary file from PSRAM into NFC flash
+        # - only the offset is kept, PSRAM is read as the bytes go out
         # - or accept bytes
         if isinstance(offset, int):
-            from glob import PSRAM
-            self.lst.append( (obj_len, 0x4, ext_type.encode(),
-                                                PSRAM.read_at(offset, obj_len)) )
+            self.lst.append( (obj_len, 0x4, ext_type.encode(), offset) )
         else:
             self.add_custom(ext_type, offset)
 
@@ -57,15 +56,16 @@ class ndefMaker:
         # "image/png" or other RFC mime types, including application/json
         self.lst.append( (len(payload), 0x2, mime_type.encode(), payload) )
 
-    def bytes(self):
-        # Walk list of records, and set various framing bits to first bytes of each
-        # and concat.
-        # - resist urge to make this a generator, it's not worth it.
+    def chunks(self):
+        # Walk list of records, and set various framing bits to first bytes of each,
+        # yielding headers and payloads as we go.
+        # - large objects come straight from PSRAM, without a copy on the heap
         rv = bytearray(CC_FILE)
 
         # calc total length of all records
-        ln = sum((3 if ln <= 255 else 6) + len(ntype) + len(rec) 
-                            for (ln, _, ntype, rec) in self.lst)
+        ln = sum((3 if ln <= 255 else 6) + len(ntype)
+                            + (ln if isinstance(rec, int) else len(rec))
+                                for (ln, _, ntype, rec) in self.lst)
         if ln <= 0xfe:
             rv.append(ln)
         else:
@@ -97,10 +97,26 @@ class ndefMaker:
             else:
                 rv.extend(pack('>I', ln))
             rv.extend(ntype)
-            rv.extend(rec)
+
+            if isinstance(rec, int):
+                # offset into PSRAM
+                from glob import PSRAM
+                yield rv
+                yield PSRAM.read_view(rec, ln)
+                rv = bytearray()
+            else:
+                rv.extend(rec)
 
         rv.append(0xfe)          # Terminator TLV
 
+        yield rv
+
+    def bytes(self):
+        # whole message as one buffer; prefer chunks() for big stuff
+        rv = bytearray()
+        for ch in self.chunks():
+            rv.extend(ch)
+
         return rv
 
 def ccfile_decode(taste):
@@ -145,10 +161,18 @@ def record_parser(msg):
     # - bytes of body
     # - dict of meta data, appropriate to type
     # - we gag on chunks
+    fetch = lambda pos, ln: msg[pos:pos+ln]
+
+    for urn, pos, pl_len, meta in record_walker(fetch, len(msg)):
+        yield urn, memoryview(msg)[pos:pos+pl_len], meta
+
+def record_walker(fetch, msg_len):
+    # Like record_parser, but yields offset and length of each body, instead of bytes.
+    # - fetch(pos, ln) provides bytes of message, so it doesn't need to be in memory
     pos = 0
     while 1:
         meta = {}
-        hdr = msg[pos]
+        hdr, ty_len = fetch(pos, 2)
 
         MB = hdr & 0x80
         ME = hdr & 0x40
@@ -160,25 +184,24 @@ def record_parser(msg):
         assert not CF, "no chunks please"
         assert (pos == 0) == bool(MB), "first needs MB set"
 
-        ty_len = msg[pos+1]
         pos += 2
 
         if SR:      # short record: one byte for payload length
-            pl_len = msg[pos] 
+            pl_len = fetch(pos, 1)[0]
             pos += 1
         else:
-            pl_len = unpack('>I', msg[pos:pos+4])[0]
+            pl_len = unpack('>I', fetch(pos, 4))[0]
             pos += 4
 
         id_len = 0 
         if IL:
-            id_len = msg[pos]
+            id_len = fetch(pos, 1)[0]
             pos += 1
 
         urn = None
         
         # type is next
-        ty = msg[pos:pos+ty_len]
+        ty = bytes(fetch(pos, ty_len))
         pos += ty_len
 
         if TNF == 0x0:      # empty
@@ -190,18 +213,18 @@ def record_parser(msg):
 
             if ty == b'T':
                 # unwrap Text
-                hdr2 = msg[pos]
+                hdr2 = fetch(pos, 1)[0]
                 assert hdr2 & 0xc0 == 0x00, "only UTF supported"
                 lang_len = hdr2 & 0x3f
 
-                meta['lang'] = msg[pos+1:pos+1 + lang_len].decode()
+                meta['lang'] = bytes(fetch(pos+1, lang_len)).decode()
                 skip = 1 + lang_len
                 pl_len -= skip
                 pos += skip
 
             if ty == b'U':
                 # limited URL support
-                meta['prefix'] = msg[pos]
+                meta['prefix'] = fetch(pos, 1)[0]
                 pos += 1
                 pl_len -= 1
 
@@ -216,15 +239,15 @@ def record_parser(msg):
             raise ValueError("TNF")     # unknown/reserved/not handled.
 
         if IL:
-            meta['ident'] = bytes(msg[pos:pos+id_len])
+            meta['ident'] = bytes(fetch(pos, id_len))
             pos += id_len
 
-        yield urn, memoryview(msg)[pos:pos+pl_len], meta
+        yield urn, pos, pl_len, meta
 
         if ME: return
 
         pos += pl_len
-        assert pos < len(msg), "missing ME/truncated"
+        assert pos < msg_len, "missing ME/truncated"
 
 
 # EOF
@@ -21,6 +21,12 @@ from public_constants import AF_CLASSIC
 # practical limit for things to share: 8k part, minus overhead
 MAX_NFC_SIZE = const(8000)
 
+# user memory of the tag, and its programming unit
+TAG_SIZE = const(8192)
+ROW_SIZE = const(16)
+PAGE_SIZE = const(256)      # max we send in one i2c write
+RX_BLOCK_SIZE = const(1024) # how much we read at once, when streaming from tag
+
 # i2c address (7-bits) is not simple...
 # - assume defaults of E0=1 and I2C_DEVICE_CODE=0xa 
 # - also 0x2d which isn't documented and no idea what it is
@@ -52,6 +58,9 @@ class NFCHandler:
         self.last_edge = 0
         self.pin_ed = Pin('NFC_ED', mode=Pin.IN, pull=Pin.PULL_UP)
 
+        # copy of tag's user memory, so we only program rows that change; None if unknown
+        self.shadow = None
+
         # track time of last edge
         def _irq(x):
             self.last_edge = utime.ticks_ms()
@@ -84,30 +93,100 @@ class NFCHandler:
         # various limits in place here? Not clear
         self.i2c.writeto_mem(I2C_ADDR_USER, offset, data, addrsize=16)
 
-    async def big_write(self, data):
-        # write lots to start of flash (new ndef records)
-        for pos in range(0, len(data), 256):
-            here = memoryview(data)[pos:pos+256]
-            self.i2c.writeto_mem(I2C_ADDR_USER, pos, here, addrsize=16)
-            # 6ms per 16 byte row, worst case, so ~100ms here!
+    async def program(self, chunks, progress=0, final_wait=True):
+        # write data to start of flash, but only the 16-byte rows which differ
+        # from what we know is there already
+        # - chunks: one buffer, or an iterable of buffers of any size; they are
+        #   regrouped into pages here, so caller needn't hold it all at once
+        # - progress: total length expected, if bar wanted
+        if isinstance(chunks, (bytes, bytearray, memoryview)):
+            chunks = [chunks]
+
+        if self.shadow is None:
+            # learn what is there now: reading is quick, unlike writing
+            self.shadow = bytearray(self.read(0, TAG_SIZE))
+
+        page = bytearray(PAGE_SIZE)
+        pos = 0         # flash offset of page
+        used = 0
+        busy = False
+
+        for ch in chunks:
+            mv = memoryview(ch)
+            while len(mv):
+                here = min(len(mv), PAGE_SIZE - used)
+                page[used:used+here] = mv[0:here]
+                used += here
+                mv = mv[here:]
+
+                if used == PAGE_SIZE:
+                    busy = await self.program_page(pos, page, used, busy)
+                    pos += used
+                    used = 0
+
+                    if progress:
+                        from glob import dis
+                        dis.progress_bar_show(pos / progress)
+
+        if used:
+            busy = await self.program_page(pos, page, used, busy)
+
+        if busy and final_wait:
             await self.wait_ready()
 
+    async def program_page(self, pos, page, ln, busy):
+        # write rows of one page which differ from shadow; returns True if the
+        # chip is still busy with a write
+        # - 6ms per 16 byte row, worst case, so ~100ms per 256 bytes written
+        assert pos + ln <= TAG_SIZE
+
+        sh = memoryview(self.shadow)[pos:pos+ln]
+        mv = memoryview(page)[0:ln]
+
+        st = 0
+        while st < ln:
+            if sh[st:st+ROW_SIZE] == mv[st:st+ROW_SIZE]:
+                st += ROW_SIZE
+                continue
+
+            # run of rows that differ
+            run = st + ROW_SIZE
+            while run < ln and sh[run:run+ROW_SIZE] != mv[run:run+ROW_SIZE]:
+                run += ROW_SIZE
+            run = min(run, ln)
+
+            if busy:
+                await self.wait_ready()
+
+            try:
+                self.i2c.writeto_mem(I2C_ADDR_USER, pos+st, mv[st:run], addrsize=16)
+            except:
+                # not sure what happened to those rows now
+                self.shadow = None
+                raise
+            sh[st:run] = mv[st:run]
+            busy = True
+
+            st = run
+
+        return busy
+
+    async def big_write(self, chunks):
+        # write lots to start of flash (new ndef records)
+        await self.program(chunks)
+
     async def wipe(self, full_wipe):
         # Tag value is stored in flash cells, so want to clear
         # once we're done in case it's sensitive. But too slow to
         # clear entire chip most of time, just do first 512 bytes,
         # and dont wait for last to complete
-        from glob import dis
-        here = bytes(256)
-        end = 8196
-        for pos in range(0, end, 256) :
-            self.i2c.writeto_mem(I2C_ADDR_USER, pos, here, addrsize=16)
-            if pos == 256 and not full_wipe: break
-
-            # 6ms per 16 byte row, worst case, so ~100ms here per iter! 3.2seconds total
-            if full_wipe:
-                dis.progress_bar_show(pos / end)
-            await self.wait_ready()
+        # - rows already blank are skipped, so full wipe is quick if mostly unused
+        if full_wipe:
+            zeros = bytes(PAGE_SIZE)
+            await self.program((zeros for _ in range(TAG_SIZE // PAGE_SIZE)),
+                                    progress=TAG_SIZE)
+        else:
+            await self.program(bytes(512), final_wait=False)
 
     # system config area (flash cells, but affect operation): table 12
     def read_config(self, offset, count):
@@ -330,6 +409,10 @@ class NFCHandler:
                     # 0x2 = RF activity
                     last_activity = utime.ticks_ms()
 
+                if events & 0x80:
+                    # 0x80 = RF write: our copy of tag contents is out of date
+                    self.shadow = None
+
             # X or OK to quit, with slightly different meanings
             ch = ux_poll_key()
             if ch and ch in 'xy': 
@@ -355,16 +438,32 @@ class NFCHandler:
         # - assumpting is people know what they are scanning
         # - x key to abort early, but also self-clears
 
-        await self.big_write(ndef_obj.bytes())
+        await self.big_write(ndef_obj.chunks())
 
         return await self.ux_animation(False)
 
     async def start_nfc_rx(self):
+        # wait for tag to be written, and return a copy of the NDEF records
+        where = await self.wait_for_ndef()
+        if not where: return
+
+        # copy to ram, wipe
+        st, ll = where
+        rv = self.read(st, ll)
+        await self.wipe(False)
+        return rv
+
+    async def wait_for_ndef(self):
         # Pretend to be a big warm empty tag ready to be stuffed with data
+        # - returns offset and length of NDEF records written, still in tag
         await self.big_write(ndef.CC_WR_FILE)
 
         # wait until something is written
         aborted = await self.ux_animation(True)
+
+        # they may have written anything, anywhere
+        self.shadow = None
+
         if aborted: return
 
         # read CCFILE area (header)
@@ -387,10 +486,7 @@ class NFCHandler:
             await ux_show_story(msg, title="Sorry!")
             return
 
-        # copy to ram, wipe
-        rv = self.read(st, ll)
-        await self.wipe(False)
-        return rv
+        return st, ll
 
 
     async def start_psbt_rx(self):
@@ -399,42 +495,58 @@ class NFCHandler:
         from ux import the_ux
         from sffile import SFFile
 
-        data = await self.start_nfc_rx()
-        if not data: return
+        where = await self.wait_for_ndef()
+        if not where: return
+
+        # parse records in place, and copy PSBT directly from tag into PSRAM,
+        # so the size that can be received isn't limited by free heap
+        st, ll = where
+        def fetch(pos, ln):
+            assert pos + ln <= ll, "truncated"
+            return self.read(st+pos, ln)
 
-        psbt_in = None
-        psbt_sha = None
         try:
-            for urn, msg, meta in ndef.record_parser(data):
-                if len(msg) > 100:
-                    # attempt to decode any large object, ignore type for max compat
-                    try:
-                        decoder, output_encoder, psbt_len = \
-                            psbt_encoding_taster(msg[0:10], len(msg))
-                        psbt_in = msg
-                    except ValueError:
-                        continue
-
-                if urn == 'urn:nfc:ext:bitcoin.org:sha256' and len(msg) == 32:
-                    # probably produced by another Coldcard: SHA256 over expected contents
-                    psbt_sha = bytes(msg)
-        except Exception as e:
-            # dont crash when given garbage
-            import sys; sys.print_exception(e)
-            pass
+            psbt_at = None
+            psbt_sha = None
+            try:
+                for urn, pos, pl_len, meta in ndef.record_walker(fetch, ll):
+                    if pl_len > 100:
+                        # attempt to decode any large object, ignore type for max compat
+                        try:
+                            decoder, output_encoder, psbt_len = \
+                                psbt_encoding_taster(fetch(pos, 10), pl_len)
+                            psbt_at = (pos, pl_len)
+                        except ValueError:
+                            continue
+
+                    if urn == 'urn:nfc:ext:bitcoin.org:sha256' and pl_len == 32:
+                        # probably produced by another Coldcard: SHA256 over expected contents
+                        psbt_sha = bytes(fetch(pos, 32))
+            except Exception as e:
+                # dont crash when given garbage
+                import sys; sys.print_exception(e)
+                pass
 
-        if psbt_in is None:
-            await ux_show_story("Could not find PSBT in what was written.", title="Sorry!")
-            return
+            if psbt_at is None:
+                await ux_show_story("Could not find PSBT in what was written.", title="Sorry!")
+                return
 
-        # decode into PSRAM
-        total = 0
-        with SFFile(TXN_INPUT_OFFSET, max_size=psbt_len) as out:
-            if not decoder:
-                total = out.write(psbt_in)
-            else:
-                for here in decoder.more(psbt_in):
-                    total += out.write(here)
+            # decode into PSRAM, a block at a time
+            pos, left = psbt_at
+            total = 0
+            with SFFile(TXN_INPUT_OFFSET, max_size=psbt_len) as out:
+                while left:
+                    here = fetch(pos, min(left, RX_BLOCK_SIZE))
+                    pos += len(here)
+                    left -= len(here)
+
+                    if not decoder:
+                        total += out.write(here)
+                    else:
+                        for dec in decoder.more(here):
+                            total += out.write(dec)
+        finally:
+            await self.wipe(False)
 
         # might have been whitespace inflating initial estimate of PSBT size, adjust
         assert total <= psbt_len
@@ -25,6 +25,10 @@ class NumpadBase:
         # Get keypad events. Single-character strings.
         return await self._changes.get()
 
+    async def wait(self):
+        # Wait until an event is ready, but leave it queued.
+        await self._changes.wait()
+
     def get_nowait(self):
         # Poll if anything ready: not async!
         return self._changes.get_nowait()
@@ -20,6 +20,7 @@ import os, ujson, ustruct, ckcc, gc, ngu, aes256ctr
 from uhashlib import sha256
 from random import randbelow
 from utils import call_later_ms
+from utime import ticks_ms, ticks_diff
 from version import mk_num, is_devmode
 
 # TODO fs.sync
@@ -36,6 +37,7 @@ from version import mk_num, is_devmode
 #   multisig = list of defined multisig wallets (complex)
 #   pms = trust/import/distrust xpubs found in PSBT files
 #   axi = index of last selected address in explorer
+#   axc = (list) cached preview addresses for explorer: [xfp, chain, account, [addrs]]
 #   lgto = (minutes) how long to wait for Login Countdown feature [pre v4.0.2]
 #   usr = (dict) map from username to their secret, as base32
 #   ovc = (list) "outpoint value cache"; only for segwit UTXO inputs (see history.py)
@@ -47,6 +49,7 @@ from version import mk_num, is_devmode
 #   nfc = (bool) if set, enable the NFC feature; default is OFF=>DISABLED (mk4+)
 #   vdsk = (bool) if set, enable the Virtual Disk features in pre 5.0.6 version; [OBSOLETE]
 #   vidsk = (bool) if set, enable the Virtual Disk features after v5.0.6
+#   vdout = (bool) if set, Virtual Disk is split: host writes inbox, we write read-only outbox
 #   emu = (bool) if set, enables the USB Keyboard emulation (BIP-85 password entry)
 #   wa = (bool) if set, enables menu wraparound
 #   hsmcmd = (bool) if set, enables all user management and hsm-only USB commands
@@ -70,7 +73,7 @@ from version import mk_num, is_devmode
 # settings linked to seed
 # LINKED_SETTINGS = ["multisig", "tp", "ovc", "xfp", "xpub", "words"]
 # settings that does not make sense to copy to temporary secret
-# LINKED_SETTINGS += ["sd2fa", "usr", "axi", "hsmcmd"]
+# LINKED_SETTINGS += ["sd2fa", "usr", "axi", "axc", "hsmcmd"]
 # prelogin settings - do not need to be part of other saved settings
 # PRELOGIN_SETTINGS = ["_skip_pin", "nick", "rngk", "lgto", "kbtn", "terms_ok"]
 # keep these settings only if unspecified on the other end
@@ -83,6 +86,11 @@ NUM_SLOTS = const(100)
 SLOTS = range(NUM_SLOTS)
 MK4_WORKDIR = '/flash/settings/'
 
+# delayed writes: wait for changes to stop for a moment (ie. a batch of PSBT),
+# but never hold them back for too long. Use save() when it must be on flash now.
+WRITE_QUIET_MS = const(1000)
+WRITE_MAX_DELAY_MS = const(5000)
+
 
 # for mk4: we store binary files on LFS2 filesystem
 def MK4_FILENAME(slot):
@@ -94,6 +102,12 @@ class SettingsObject:
     master_sv_data = {}
     master_nvram_key = None
 
+    # slot last seen holding settings, by key tag; this power-up only, never stored
+    known_slots = {}
+
+    # bumped on any change or (re)load, in any instance; see MenuSystem.data_version
+    version = 0
+
     def __init__(self, nvram_key=None):
         # NOTE: constructor no longer loads the values by default (too slow).
         self.is_dirty = 0
@@ -128,6 +142,10 @@ class SettingsObject:
 
         return s.digest()
 
+    def key_tag(self):
+        # short, irreversible, name for our key; for known_slots
+        return ngu.hash.sha256s(self.nvram_key)[0:8]
+
     def set_key(self, new_secret=None):
         # System settings (not secrets) are stored in flash, encrypted with this
         # key that is derived from main wallet secret. Call this method when the secret
@@ -226,10 +244,12 @@ class SettingsObject:
             chk.update(d)
             del d
 
+            # few large writes of padding, not lots of tiny ones
+            zeros = bytes(min(512, max(pad_len, 0)))
             while pad_len > 0:
-                here = min(32, pad_len)
+                here = min(512, pad_len)
+                pad = zeros if here == len(zeros) else zeros[0:here]
 
-                pad = bytes(here)
                 fd.write(aes(pad))
                 chk.update(pad)
 
@@ -237,6 +257,17 @@ class SettingsObject:
 
             fd.write(aes(chk.digest()))
 
+    def _decode_slot(self, pos, aes):
+        # read, verify checksum in last 32 bytes, and parse; None if not ours
+        try:
+            json_data, expect, actual = self._read_slot(pos, aes.cipher)
+            assert expect == actual
+
+            return ujson.loads(json_data)
+        except:
+            # Good chance to come here w/ garbage decoded, so not an error.
+            return None
+
     def _used_slots(self):
         # mk4: faster list of slots in use; doesn't open them
         files = os.listdir(MK4_WORKDIR)
@@ -251,7 +282,7 @@ class SettingsObject:
 
         for i, pos in enumerate(files):
             if dis:
-                dis.progress_bar_show(i / len(files))
+                dis.progress_sofar(i, len(files))
 
             if self._slot_is_blank(pos, taste):
                 # unlikely case, but easy to handle
@@ -322,10 +353,25 @@ class SettingsObject:
         # and pick the newest one (in unlikely case of dups)
         # reset
         self.current.clear()
+        SettingsObject.version += 1
         self.my_pos = None
         self.is_dirty = 0
         nonempty = set()
 
+        # fast path: we saved or loaded this key earlier, and nobody else can write
+        # to flash, so that slot is the newest one, if still intact.
+        tag = self.key_tag()
+        pos = SettingsObject.known_slots.get(tag, None)
+        if pos is not None:
+            d = self._decode_slot(pos, self.get_aes(pos))
+            if d is not None:
+                self.current = d
+                self.my_pos = pos
+                return
+
+            # slot was wiped or reused: do full search
+            del SettingsObject.known_slots[tag]
+
         for pos, taste in self._nonempty_slots(dis):
             # check if first 2 bytes makes sense for JSON
             aes = self.get_aes(pos)
@@ -337,14 +383,8 @@ class SettingsObject:
                 continue
 
             # probably good, read it
-            try:
-                json_data, expect, actual = self._read_slot(pos, aes.cipher)
-                # verify checksum in last 32 bytes
-                assert expect == actual
-
-                d = ujson.loads(json_data)
-            except:
-                # Good chance to come here w/ garbage decoded, so not an error.
+            d = self._decode_slot(pos, aes)
+            if d is None:
                 continue
 
             got_age = d.get('_age', 0)
@@ -362,6 +402,7 @@ class SettingsObject:
 
         # done, if we found something
         if self.my_pos is not None:
+            SettingsObject.known_slots[tag] = self.my_pos
             return
 
         # nothing found, use defaults
@@ -376,9 +417,12 @@ class SettingsObject:
         return self.current.get(kn, default)
 
     def changed(self):
+        SettingsObject.version += 1
         self.is_dirty += 1
+        self.last_change = ticks_ms()
         if self.is_dirty < 2:
-            call_later_ms(250, self.write_out)
+            self.first_change = self.last_change
+            call_later_ms(WRITE_QUIET_MS, self.write_out)
 
     def save_if_dirty(self):
         # call when system is about to stop
@@ -448,6 +492,14 @@ class SettingsObject:
             # someone beat me to it
             return
 
+        # still changing? come back later, unless we've waited long enough
+        now = ticks_ms()
+        quiet = ticks_diff(now, self.last_change)
+        if quiet < WRITE_QUIET_MS and \
+                ticks_diff(now, self.first_change) < WRITE_MAX_DELAY_MS:
+            call_later_ms(WRITE_QUIET_MS - quiet, self.write_out)
+            return
+
         # Was sometimes running low on memory in this area: recover
         try:
             gc.collect()
@@ -488,16 +540,19 @@ class SettingsObject:
 
         self.my_pos = pos
         self.is_dirty = 0
+        SettingsObject.known_slots[self.key_tag()] = pos
 
     def blank(self):
         # erase current copy of values in nvram; older ones may exist still
         # - use when clearing the seed value
+        SettingsObject.known_slots.pop(self.key_tag(), None)
         if self.my_pos is not None:
             self._wipe_slot(self.my_pos)
             self.my_pos = 0
 
         # act blank too, just in case.
         self.current.clear()
+        SettingsObject.version += 1
         self.is_dirty = 0
 
     @staticmethod
@@ -6,6 +6,7 @@
 import ujson
 from ubinascii import hexlify as b2a_hex
 from utils import imported
+from uhashlib import sha256
 from public_constants import AF_CLASSIC, AF_P2WPKH
 from ux import ux_show_story, ux_dramatic_pause
 from files import CardSlot, CardMissingError, needs_microsd
@@ -41,6 +42,28 @@ class placeholders:
     # rather than Tokyo, I chose Chiba Prefecture in ShiftJIS encoding...
     header = b'%PDF-1.3\n%\x90\xe7\x97t\x8c\xa7 Coldcard Paper Wallet Template\n'
 
+class HashedOutput:
+    # Hash everything written on the way through to (buffered) file, so it
+    # never has to be read back for the signature. Text is written as utf-8.
+    def __init__(self, fd):
+        self.fd = fd
+        self.checksum = sha256()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *a, **k):
+        return self.fd.__exit__(*a, **k)
+
+    def write(self, b):
+        if isinstance(b, str):
+            b = b.encode()
+        self.checksum.update(b)
+        return self.fd.write(b)
+
+    def digest(self):
+        return self.checksum.digest()
+
 def template_taster(fn):
     # check if file looks like our special PDF templates... must have right header bits
     hdr = open(fn, 'rb').read(len(placeholders.header))
@@ -116,6 +139,7 @@ class PaperWalletMaker:
 
             with imported('uqr') as uqr:
                 # make the QR's now, since it's slow
+                # - version 4 codes: 33x33 pixels each, so small
                 is_alnum = self.is_segwit
                 qr_addr = uqr.make(addr if not is_alnum else addr.upper(),
                             min_version=4, max_version=4,
@@ -146,22 +170,18 @@ class PaperWalletMaker:
                 fname, nice_txt = card.pick_filename(basename + 
                                         ('-note.txt' if self.template_fn else '.txt'))
                 sig_cont = []
-                with card.open(fname, 'wt+') as fp:
+
+                # hashed as written, so files are never read back
+                with HashedOutput(card.open(fname, 'wb', buffered=True)) as fp:
                     self.make_txt(fp, addr, wif, privkey, qr_addr, qr_wif)
-                    fp.seek(0)
-                    contents0 = fp.read()
+                sig_cont.append((fp.digest(), fname))
 
-                h = ngu.hash.sha256s(contents0.encode())
-                sig_cont.append((h, fname))
                 if self.template_fn:
                     fname, nice_pdf = card.pick_filename(basename + '.pdf')
 
-                    with open(fname, 'wb+') as fp:
+                    with HashedOutput(card.open(fname, 'wb', buffered=True)) as fp:
                         self.make_pdf(fp, addr, wif, qr_addr, qr_wif)
-                        fp.seek(0)
-                        contents1 = fp.read()
-                    h = ngu.hash.sha256s(contents1)
-                    sig_cont.append((h, fname))
+                    sig_cont.append((fp.digest(), fname))
                 else:
                     nice_pdf = ''
 
@@ -241,10 +261,13 @@ class PaperWalletMaker:
         # render QR as binary data: 1 bit per pixel 33x33
         # - aways 8:1 expansion ratio here
         assert qr.width() == width == 33        # only version==4 supported
+        ln = bytearray(2*width + 1)
+        ln[-1] = 0x0a
         for y in range(width):
-            ln = b''.join(b'00' if qr.get(x,y) else b'FF' for x in range(width))
-            ln += b'\n'
-            out_fp.write(ln * 8)
+            for x in range(width):
+                ln[2*x:2*x+2] = b'00' if qr.get(x,y) else b'FF'
+            for _ in range(8):
+                out_fp.write(ln)
         
     def make_pdf(self, out_fp, addr, wif, qr_addr, qr_wif):
         qr_armed, qr_skip = False, False
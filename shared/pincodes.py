@@ -249,12 +249,14 @@ class PinAttempt:
 
     def roundtrip(self, method_num, after_buf=None, **kws):
 
-        buf = bytearray(PIN_ATTEMPT_SIZE if version.has_608 else PIN_ATTEMPT_SIZE_V1)
+        # one allocation at final size; growing it would leave copies behind in heap
+        base = PIN_ATTEMPT_SIZE if version.has_608 else PIN_ATTEMPT_SIZE_V1
+        buf = bytearray(base + (len(after_buf) if after_buf is not None else 0))
 
         self.marshal(buf, **kws)
 
         if after_buf is not None:
-            buf.extend(after_buf)
+            buf[base:] = after_buf
 
         #print("> tx: %s" % b2a_hex(buf))
 
@@ -272,9 +274,14 @@ class PinAttempt:
             raise RuntimeError(err)
 
         if after_buf is not None:
-            return buf[PIN_ATTEMPT_SIZE:]
+            rv = buf[PIN_ATTEMPT_SIZE:]
         else:
-            return self.unmarshal(buf)
+            rv = self.unmarshal(buf)
+
+        # holds pin, hmac and maybe secrets; results above are copies
+        stash.blank_object(buf)
+
+        return rv
 
     @staticmethod
     def prefix_words(pin_prefix):
@@ -517,18 +524,21 @@ class PinAttempt:
 
     def trick_request(self, method_num, data):
         # send/recv a trick-pin related request (mk4 only)
-        buf = bytearray(PIN_ATTEMPT_SIZE)
+        buf = bytearray(PIN_ATTEMPT_SIZE + len(data))
         self.marshal(buf)
-        buf.extend(data)
+        buf[PIN_ATTEMPT_SIZE:] = data
 
         err = ckcc.gate(22, buf, method_num)
 
         #print("[%d] rx: %s" % (err, b2a_hex(buf)))
-        
+
+        rv = buf[PIN_ATTEMPT_SIZE:]
+        stash.blank_object(buf)
+
         if err <= -100:
             raise BootloaderError(PA_ERROR_CODES[err], err)
 
-        return err, buf[PIN_ATTEMPT_SIZE:]
+        return err, rv
 
     def is_deltamode(self):
         # (mk4 only) are we operating w/ a slightly wrong PIN code?
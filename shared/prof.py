@@ -0,0 +1,46 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# prof.py - names for the cycle counter slots of cycle_prof.c
+#
+# - bracket a phase with ckcc.prof_start(SLOT) / ckcc.prof_stop(SLOT)
+# - read back over USB with the 'PROF' test command, or EVAL of prof.report()
+# - also: boot_mark(label) for ms since reset at each phase of startup, see main.py
+#
+import ckcc, utime
+
+USB_RX = const(0)
+PSBT_PARSE = const(1)
+VALIDATE = const(2)
+APPROVE = const(3)
+SIGHASH = const(4)
+SIGN = const(5)
+FINALIZE = const(6)
+SD_IO = const(7)
+
+NAMES = ['usb_rx', 'psbt_parse', 'validate', 'approve', 'sighash', 'sign', 'finalize', 'sd_io']
+
+# (label, ms since reset) in order reached; kept across reset()
+BOOT = []
+
+def boot_mark(label):
+    BOOT.append((label, utime.ticks_ms()))
+
+def report():
+    # text summary: name, milliseconds total, number of times
+    hz, slots = ckcc.prof_report()
+
+    rv = []
+    for idx, (total, count) in enumerate(slots):
+        if not count: continue
+        name = NAMES[idx] if idx < len(NAMES) else str(idx)
+        rv.append('%s: %d ms (%d)' % (name, (total * 1000) // hz, count))
+
+    for label, ms in BOOT:
+        rv.append('boot %s: @%d ms' % (label, ms))
+
+    return '\n'.join(rv)
+
+def reset():
+    ckcc.prof_reset()
+
+# EOF
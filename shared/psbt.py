@@ -7,9 +7,10 @@ from ubinascii import hexlify as b2a_hex
 from utils import xfp2str, B2A, keypath_to_str, problem_file_line
 from utils import seconds2human_readable, datetime_from_timestamp, datetime_to_str
 import stash, gc, history, sys, ngu, ckcc, chains
-from uhashlib import sha256
+from prof import SIGHASH, SIGN
+from array import array
 from uio import BytesIO
-from sffile import SizerFile
+from sffile import SizerFile, sha256
 from multisig import MultisigWallet, disassemble_multisig, disassemble_multisig_mn
 from exceptions import FatalPSBTIssue, FraudulentChangeOutput
 from serializations import ser_compact_size, deser_compact_size, hash160, hash256
@@ -31,7 +32,8 @@ from public_constants import (
     PSBT_IN_REQUIRED_HEIGHT_LOCKTIME, MAX_PATH_DEPTH, MAX_SIGNERS
 )
 
-psbt_tmp256 = bytearray(256)
+# when streaming values from files (not PSRAM views), read this much at a time
+psbt_tmp_buf = bytearray(2048)
 
 # PSBT proprietary keytype
 PSBT_PROPRIETARY = const(0xFC)
@@ -46,6 +48,16 @@ PSBT_ATTESTATION_SUBTYPE = const(0)
 # Amounts over 5% are warned regardless.
 DEFAULT_MAX_FEE_PERCENTAGE = const(10)
 
+# serialized size of CTxIn with empty scriptSig: outpoint + zero-length script + nSequence
+LEGACY_BLANK_TXIN = const(32+4+1+4)
+
+# PSBT with more inputs+outputs than this: keep only a few proxy objects in memory at once
+LAZY_PROXY_COUNT = const(200)
+LAZY_CACHE_SIZE = const(4)
+
+# approval screen shows at most this many non-change outputs, see consider_outputs()
+MAX_VISIBLE_OUTPUTS = const(10)
+
 # print some things, sometimes
 DEBUG = ckcc.is_simulator()
 
@@ -82,6 +94,13 @@ def _skip_n_objs(fd, n, cls):
         raise ValueError(cls)
 
     rv = fd.tell()
+
+    scanned = _native_txn_scan(fd, rv, n, (cls == 'CTxIn'), False)
+    if scanned:
+        _, end = scanned
+        fd.seek(end)
+        return rv
+
     for i in range(n):
         for p in pat:
             if p is None:
@@ -135,19 +154,47 @@ def calc_txid(fd, poslen, body_poslen=None):
 
     return ngu.hash.sha256s(rv.digest())
 
+def _zero_copy_view(fd):
+    # if file supports direct access to its contents, return method for that
+    # - SFFile in read mode, over PSRAM, does; but not during writes, nor BytesIO
+    if getattr(fd, 'readonly', False):
+        return getattr(fd, 'view', None)
+    return None
+
+def _native_txn_scan(fd, pos, n, is_input, want_list=True):
+    # Find offsets of N CTxIn/CTxOut objects starting at pos, using C code.
+    # - returns (buffer view, [(obj_pos, script_pos, script_len), ...]) or None if not possible
+    # - returns (None, end_pos) if not want_list
+    view = _zero_copy_view(fd)
+    if not view or not hasattr(ckcc, 'txn_vector_scan'):
+        return None
+
+    buf = view(0, fd.length)
+    if not want_list:
+        return None, ckcc.txn_vector_scan(buf, pos, n, is_input, False)
+
+    recs, _ = ckcc.txn_vector_scan(buf, pos, n, is_input, True)
+
+    return buf, recs
+
 def get_hash256(fd, poslen, hasher=None):
     # return the double-sha256 of a value, without loading it into memory
     pos, ll = poslen
     rv = hasher or sha256()
 
-    fd.seek(pos)
-    while ll:
-        here = fd.readinto(psbt_tmp256)
-        if not here: break
-        if here > ll:
-            here = ll
-        rv.update(memoryview(psbt_tmp256)[0:here])
-        ll -= here
+    view = _zero_copy_view(fd)
+    if view:
+        # direct from PSRAM, no copies needed
+        rv.update(view(pos, ll))
+    else:
+        fd.seek(pos)
+        while ll:
+            here = fd.readinto(psbt_tmp_buf)
+            if not here: break
+            if here > ll:
+                here = ll
+            rv.update(memoryview(psbt_tmp_buf)[0:here])
+            ll -= here
 
     if hasher:
         return
@@ -175,13 +222,30 @@ def encode_prop_key(identifier, subtype, keydata = b''):
     key += keydata
     return key
 
+def sign_low_r(pk, digest, sighash):
+    # Sign and return DER-encoded signature, with sighash byte appended.
+    #
+    # We need to grind sometimes to get a positive R
+    # value that will encode (after DER) into a shorter string.
+    # - saves on miner's fee (which might be expected/required)
+    # - blends in with Bitcoin Core signatures which do this
+    # - S is always low, so only need to look at MSB of R to know DER length (<= 71)
+    # - odds of needing retry: just under 50%
+    for retry in range(10):
+        result = ngu.secp256k1.sign(pk, digest, retry).to_bytes()
+        #assert len(result) == 65
+        if not (result[1] & 0x80):
+            break
+
+    return ser_sig_der(result[1:33], result[33:65], sighash)
+
 class psbtProxy:
     # store offsets to values, but track the keys in-memory.
     short_values = ()
     no_keys = ()
 
     # these fields will return None but are not stored unless a value is set
-    blank_flds = ('unknown', )
+    blank_flds = ('unknown', 'span')
 
     def __init__(self):
         self.fd = None
@@ -194,10 +258,19 @@ class psbtProxy:
     def parse(self, fd):
         self.fd = fd
 
+        if getattr(ckcc, 'psbt_map_scan', None) and _zero_copy_view(fd):
+            # much faster, when PSBT is sitting in PSRAM
+            return self.parse_native(fd)
+
+        start = fd.tell()
         while 1:
+            here = fd.tell()
             ks = deser_compact_size(fd)
             if ks is None: break
-            if ks == 0: break
+            if ks == 0:
+                # remember where our records are, not including terminator
+                self.span = (start, here - start)
+                break
 
             key = fd.read(ks)
             vs = deser_compact_size(fd)
@@ -221,6 +294,34 @@ class psbtProxy:
 
                 self.store(kt, bytes(key), proxy)
 
+    def parse_native(self, fd):
+        # Same as parse() but uses C code to find all the records first,
+        # then works from offsets into the PSRAM copy of file.
+        buf = fd.view(0, fd.length)
+        start = fd.tell()
+        recs, end = ckcc.psbt_map_scan(buf, start)
+
+        for kt, k_pos, k_len, v_pos, v_len in recs:
+            if kt in self.no_keys:
+                assert k_len == 1        # not expecting key
+
+            key = bytes(buf[k_pos:k_pos+k_len])
+
+            # storing offset and length only! Mostly.
+            if kt in self.short_values:
+                self.store(kt, key, bytes(buf[v_pos:v_pos+v_len]))
+            else:
+                self.store(kt, key, (v_pos, v_len))
+
+        if end is None:
+            # EOF before terminator: like parse(), just stop there
+            fd.seek(len(buf))
+            return
+
+        # end is past the terminator
+        self.span = (start, end - 1 - start)
+        fd.seek(end)
+
     def write(self, out_fd, ktype, val, key=b''):
         # serialize helper: write w/ size and key byte
         out_fd.write(ser_compact_size(1 + len(key)))
@@ -245,12 +346,31 @@ class psbtProxy:
             out_fd.write(ser_compact_size(len(val)))
             out_fd.write(val)
 
+    def copy_span(self, out_fd):
+        # serialize helper: copy all our records, exactly as found in the original
+        # file, in a few big chunks. Only valid if nothing was changed since parse.
+        pos, ll = self.span
+        while ll:
+            here = min(ll, 1024)
+            out_fd.write(self.get_view((pos, here)))
+            pos += here
+            ll -= here
+
     def get(self, val):
         # get the raw bytes for a value.
         pos, ll = val
         self.fd.seek(pos)
         return self.fd.read(ll)
 
+    def get_view(self, val):
+        # like get(), but no copy if possible: a memoryview into PSRAM
+        # - only for short-term use (hashing, unpacking); never keep or modify result
+        view = _zero_copy_view(self.fd)
+        if not view:
+            return self.get(val)
+
+        return view(*val)
+
     def parse_subpaths(self, my_xfp, warnings):
         # Reformat self.subpaths into a more useful form for us; return # of them
         # that are ours (and track that as self.num_our_keys)
@@ -265,41 +385,56 @@ class psbtProxy:
             # already been here once
             return self.num_our_keys
 
-        num_ours = 0
-        for pk in self.subpaths:
+        for pk, val in self.subpaths.items():
             assert len(pk) in {33, 65}, "hdpath pubkey len"
             if len(pk) == 33:
                 assert pk[0] in {0x02, 0x03}, "uncompressed pubkey"
 
-            vl = self.subpaths[pk][1]
+            vl = val[1]
 
             # force them to use a derived key, never the master
             assert vl >= 8, 'too short key path'
             assert (vl % 4) == 0, 'corrupt key path'
             assert (vl//4) <= MAX_PATH_DEPTH, 'too deep'
 
-            # promote to a list of ints
-            v = self.get(self.subpaths[pk])
-            here = list(unpack_from('<%dI' % (vl//4), v))
+        view = _zero_copy_view(self.fd)
+        if view and hasattr(ckcc, 'bip32_paths_unpack'):
+            # C code unpacks them all, and checks each xfp, in one call
+            pks = list(self.subpaths)
+            paths, num_ours, num_zero = ckcc.bip32_paths_unpack(view(0, self.fd.length),
+                                            [self.subpaths[pk] for pk in pks], my_xfp)
+            for pk, here in zip(pks, paths):
+                self.subpaths[pk] = here
+        else:
+            num_ours = num_zero = 0
+            for pk in self.subpaths:
+                # promote to a list of ints
+                vl = self.subpaths[pk][1]
+                v = self.get_view(self.subpaths[pk])
+                here = list(unpack_from('<%dI' % (vl//4), v))
+
+                if here[0] == 0:
+                    here[0] = my_xfp
+                    num_zero += 1
+
+                # update in place
+                self.subpaths[pk] = here
+
+                if here[0] == my_xfp:
+                    num_ours += 1
+                else:
+                    # Address that isn't based on my seed; might be another leg in a p2sh,
+                    # or an input we're not supposed to be able to sign... and that's okay.
+                    pass
 
+        if num_zero:
             # Tricky & Useful: if xfp of zero is observed in file, assume that's a 
-            # placeholder for my XFP value. Replace on the fly. Great when master
+            # placeholder for my XFP value. Replaced on the fly. Great when master
             # XFP is unknown because PSBT built from derived XPUB only. Also privacy.
-            if here[0] == 0:
-                here[0] = my_xfp
-                if not any(True for k,_ in warnings if 'XFP' in k):
-                    warnings.append(('Zero XFP',
-                            'Assuming XFP of zero should be replaced by correct XFP'))
-
-            # update in place
-            self.subpaths[pk] = here
-
-            if here[0] == my_xfp:
-                num_ours += 1
-            else:
-                # Address that isn't based on my seed; might be another leg in a p2sh,
-                # or an input we're not supposed to be able to sign... and that's okay.
-                pass
+            self.span = None        # need to re-encode, cannot copy as-is
+            if not any(True for k,_ in warnings if 'XFP' in k):
+                warnings.append(('Zero XFP',
+                        'Assuming XFP of zero should be replaced by correct XFP'))
 
         self.num_our_keys = num_ours
         return num_ours
@@ -311,9 +446,14 @@ class psbtProxy:
 class psbtOutputProxy(psbtProxy):
     no_keys = { PSBT_OUT_REDEEM_SCRIPT, PSBT_OUT_WITNESS_SCRIPT }
 
-    blank_flds = ('unknown', 'subpaths', 'redeem_script', 'witness_script',
+    blank_flds = ('unknown', 'span', 'subpaths', 'redeem_script', 'witness_script',
                   'is_change', 'num_our_keys', 'amount', 'script', 'attestation')
 
+    # values we work out after parsing; must be kept if proxy is discarded (psbtProxyTable)
+    flag_flds = ('is_change', )
+    int_flds = ('num_our_keys', )
+    learned_flds = ('subpaths', 'span')
+
     def __init__(self, fd, idx):
         super().__init__()
 
@@ -360,6 +500,10 @@ class psbtOutputProxy(psbtProxy):
 
     def serialize(self, out_fd, is_v2):
 
+        if self.span:
+            # we never change outputs: copy from original
+            return self.copy_span(out_fd)
+
         wr = lambda *a: self.write(out_fd, *a)
 
         if self.subpaths:
@@ -531,10 +675,19 @@ class psbtInputProxy(psbtProxy):
                      PSBT_IN_FINAL_SCRIPTWITNESS }
 
     blank_flds = (
-        'unknown', 'utxo', 'witness_utxo', 'sighash', 'redeem_script', 'witness_script',
+        'unknown', 'span', 'utxo', 'witness_utxo', 'sighash', 'redeem_script', 'witness_script',
         'fully_signed', 'is_segwit', 'is_multisig', 'is_p2sh', 'num_our_keys',
         'required_key', 'scriptSig', 'amount', 'scriptCode', 'added_sig', 'previous_txid',
-        'prevout_idx', 'sequence', 'req_time_locktime', 'req_height_locktime'
+        'prevout_idx', 'sequence', 'req_time_locktime', 'req_height_locktime', 'prevout',
+        'utxo_txo', 'sighash_added'
+    )
+
+    # values we work out after parsing; must be kept if proxy is discarded (psbtProxyTable)
+    flag_flds = ('fully_signed', 'is_segwit', 'is_multisig', 'is_p2sh', 'sighash_added')
+    int_flds = ('num_our_keys', 'amount', 'sighash')
+    learned_flds = (
+        'subpaths', 'span', 'required_key', 'scriptSig', 'scriptCode', 'added_sig',
+        'prevout', 'utxo_txo'
     )
 
     def __init__(self, fd, idx):
@@ -566,6 +719,7 @@ class psbtInputProxy(psbtProxy):
 
         # after signing, we'll have a signature to add to output PSBT
         #self.added_sig = None
+        #self.sighash_added = False     # if we defaulted sighash, not from PSBT
 
         #self.previous_txid = None
         #self.prevout_idx = None
@@ -573,6 +727,12 @@ class psbtInputProxy(psbtProxy):
         #self.req_time_locktime = None
         #self.req_height_locktime = None
 
+        # COutPoint from unsigned txn, captured during validation
+        #self.prevout = None
+
+        # (out_idx, CTxOut) from non-witness UTXO, captured during validation
+        #self.utxo_txo = None
+
         self.parse(fd)
 
     def has_relative_timelock(self, txin):
@@ -632,16 +792,51 @@ class psbtInputProxy(psbtProxy):
             # (but if it's segwit, the ploy wouldn't work, Segwit FtW)
             # - challenge: it's a straight dsha256() for old serializations, but not for newer
             #   segwit txn's... plus I don't want to deserialize it here.
+            # - also captures the output being spent, so no need to come back later
             try:
-                observed = uint256_from_str(calc_txid(self.fd, self.utxo))
+                observed = uint256_from_str(self.scan_utxo(txin.prevout.n))
             except:
                 raise AssertionError("Trouble parsing UTXO given for input #%d" % idx)
 
             assert txin.prevout.hash == observed, "utxo hash mismatch for input #%d" % idx
 
+    def multisig_witness(self):
+        # Witness stack to spend this segwit multisig input: our signature and
+        # partial sigs from co-signers, in order of pubkeys in the validated script.
+        # - returns None if we don't have M signatures yet
+        script = self.scriptSig
+        if not script:
+            return None
+
+        M, N, pubkeys = disassemble_multisig(script)
+        ours = self.added_sig
+
+        # careful: called while caller is iterating over same file
+        fd = self.fd
+        old_pos = fd.tell()
+
+        stack = [b'']           # for CHECKMULTISIG off-by-one bug
+        for pk in pubkeys:
+            if len(stack) > M:
+                break
+            if ours and pk == ours[0]:
+                stack.append(ours[1])
+            elif pk in self.part_sig:
+                stack.append(self.get(self.part_sig[pk]))
+
+        fd.seek(old_pos)
+
+        if len(stack) <= M:
+            return None
+
+        stack.append(script)
+
+        return stack
+
     def handle_none_sighash(self):
         if self.sighash is None:
             self.sighash = SIGHASH_ALL
+            self.sighash_added = True
 
     def has_utxo(self):
         # do we have a copy of the corresponding UTXO?
@@ -671,9 +866,27 @@ class psbtInputProxy(psbtProxy):
 
         assert self.utxo, 'no utxo'
 
-        # skip over all the parts of the txn we don't care about, without
-        # fully parsing it... pull out a single TXO
-        fd.seek(self.utxo[0])
+        if self.utxo_txo is None or self.utxo_txo[0] != idx:
+            # normally done during validation
+            self.scan_utxo(idx)
+
+        utxo = self.utxo_txo[1]
+        assert utxo, "not enuf outs"
+
+        return utxo
+
+    def scan_utxo(self, out_idx):
+        # Single pass over the full previous txn (non-witness UTXO), which
+        # can be very large:
+        # - returns the txid of that txn
+        # - captures the output we are spending (if present), for get_utxo()
+        # - skips over the parts of the txn we don't care about, without fully parsing it
+        # - preserve the file pointer
+        fd = self.fd
+        old_pos = fd.tell()
+        poslen = self.utxo
+
+        fd.seek(poslen[0])
 
         _, marker, flags = unpack("<iBB", fd.read(6))
         wit_format = (marker == 0 and flags != 0x0)
@@ -681,24 +894,39 @@ class psbtInputProxy(psbtProxy):
             # rewind back over marker+flags
             fd.seek(-2, 1)
 
+        body_start = fd.tell()
+
         # How many ins? We accept zero here because utxo's inputs might have been
         # trimmed to save space, and we have test cases like that.
         num_in = deser_compact_size(fd)
         _skip_n_objs(fd, num_in, 'CTxIn')
 
         num_out = deser_compact_size(fd)
-        assert idx < num_out, "not enuf outs"
-        _skip_n_objs(fd, idx, 'CTxOut')
 
-        utxo = CTxOut()
-        utxo.deserialize(fd)
+        utxo = None
+        if out_idx < num_out:
+            _skip_n_objs(fd, out_idx, 'CTxOut')
+
+            utxo = CTxOut()
+            utxo.deserialize(fd)
 
-        # ... followed by more outs, and maybe witness data, but we don't care ...
+            _skip_n_objs(fd, num_out - out_idx - 1, 'CTxOut')
+        else:
+            # let caller of get_utxo() find this problem
+            _skip_n_objs(fd, num_out, 'CTxOut')
 
-        fd.seek(old_pos)
+        self.utxo_txo = (out_idx, utxo)
 
-        return utxo
+        if not wit_format:
+            # simple, txid is hash over whole thing
+            txid = get_hash256(fd, poslen)
+        else:
+            # ... followed by witness data, which isn't part of txid
+            txid = calc_txid(fd, poslen, (body_start, fd.tell() - body_start))
 
+        fd.seek(old_pos)
+
+        return txid
 
     def determine_my_signing_key(self, my_idx, utxo, my_xfp, psbt):
         # See what it takes to sign this particular input
@@ -898,6 +1126,20 @@ class psbtInputProxy(psbtProxy):
 
         wr = lambda *a: self.write(out_fd, *a)
 
+        if self.span:
+            # Typical: copy original records unchanged, then append what we've added.
+            # Order of keys within map does not matter.
+            self.copy_span(out_fd)
+
+            if self.added_sig:
+                pubkey, sig = self.added_sig
+                wr(PSBT_IN_PARTIAL_SIG, sig, pubkey)
+
+            if self.sighash_added:
+                wr(PSBT_IN_SIGHASH_TYPE, pack('<I', self.sighash))
+
+            return
+
         if self.utxo:
             wr(PSBT_IN_NON_WITNESS_UTXO, self.utxo)
         if self.witness_utxo:
@@ -943,6 +1185,97 @@ class psbtInputProxy(psbtProxy):
 
 
 
+class psbtProxyTable:
+    # Looks like a list of psbtInputProxy or psbtOutputProxy, but for huge PSBTs.
+    # - only offset of each map is kept, and a few recently-used proxies
+    # - others are re-parsed from file when needed; what we learned about them is
+    #   saved when they are dropped, and restored after
+    # - saved state is packed: cls.flag_flds as bits, cls.int_flds in array('q')
+    #   columns (-1 for None), and only the rest (cls.learned_flds) as objects
+    # - don't hold onto proxies for long: changes after it's dropped would be lost
+
+    def __init__(self, cls, fd, count):
+        self.cls = cls
+        self.fd = fd
+        self.offsets = array('L')
+        self.flags = bytearray(count)       # bits for cls.flag_flds, plus SAVED
+        self.ints = [array('q', (-1 for _ in range(count))) for _ in cls.int_flds]
+        self.learned = {}           # idx => tuple of values for cls.learned_flds
+        self.cache = {}             # idx => proxy
+        self.recent = []            # idx of cached proxies, oldest first
+
+        for idx in range(count):
+            # parse each one fully, so problems are found now, and to find next map
+            self.offsets.append(fd.tell())
+            cls(fd, idx)
+
+    def __len__(self):
+        return len(self.offsets)
+
+    def __iter__(self):
+        for idx in range(len(self.offsets)):
+            yield self[idx]
+
+    def __getitem__(self, idx):
+        rv = self.cache.get(idx)
+        if rv is not None:
+            return rv
+
+        if not (0 <= idx < len(self.offsets)):
+            raise IndexError(idx)
+
+        # re-parse, carefully preserving file position
+        fd = self.fd
+        old_pos = fd.tell()
+        fd.seek(self.offsets[idx])
+        rv = self.cls(fd, idx)
+        fd.seek(old_pos)
+
+        if self.flags[idx] & 0x80:
+            self.restore(idx, rv)
+
+        if len(self.recent) >= LAZY_CACHE_SIZE:
+            old_idx = self.recent.pop(0)
+            self.save(old_idx, self.cache.pop(old_idx))
+
+        self.cache[idx] = rv
+        self.recent.append(idx)
+
+        return rv
+
+    def save(self, idx, prx):
+        # capture what we've learned about a proxy we are about to drop
+        cls = self.cls
+
+        fl = 0x80
+        for bit, fld in enumerate(cls.flag_flds):
+            if getattr(prx, fld, None):
+                fl |= (1 << bit)
+        self.flags[idx] = fl
+
+        for col, fld in zip(self.ints, cls.int_flds):
+            val = getattr(prx, fld, None)
+            col[idx] = -1 if val is None else val
+
+        self.learned[idx] = tuple(getattr(prx, fld, None) for fld in cls.learned_flds)
+
+    def restore(self, idx, prx):
+        # put back what we knew, into freshly re-parsed proxy
+        cls = self.cls
+
+        fl = self.flags[idx]
+        for bit, fld in enumerate(cls.flag_flds):
+            setattr(prx, fld, bool(fl & (1 << bit)))
+
+        for col, fld in zip(self.ints, cls.int_flds):
+            val = col[idx]
+            setattr(prx, fld, None if val == -1 else val)
+
+        saved = self.learned.pop(idx)
+        for fld, val in zip(cls.learned_flds, saved):
+            setattr(prx, fld, val)
+
+
 class psbtObject(psbtProxy):
     "Just? parse and store"
 
@@ -978,13 +1311,24 @@ class psbtObject(psbtProxy):
         self.consolidation_tx = False
         # number of change outputs
         self.num_change_outputs = None
+        # for approval story, found during consider_outputs() so no other pass needed:
+        # - sum and scripts of change outputs
+        # - biggest MAX_VISIBLE_OUTPUTS others: (nValue, idx, scriptPubKey)
+        self.change_value_out = 0
+        self.change_scripts = None
+        self.largest_outs = None
 
         # when signing segwit stuff, there is some re-use of hashes
-        # only if SIGHASH_ALL
+        # - each is calculated at most once, on first use, for any sighash mix
+        # - hashSequence is only used w/ SIGHASH_ALL; hashOutputs for ALL/ALL|ANYONECANPAY
         self.hashPrevouts = None
         self.hashSequence = None
         self.hashOutputs = None
 
+        # legacy (non-segwit) sighash: pre-serialized blanked inputs, and outputs
+        self.legacy_ins = None
+        self.legacy_outs = None
+
         # this points to a MS wallet, during operation
         # - we are only supporting a single multisig wallet during signing
         self.active_multisig = None
@@ -1040,7 +1384,7 @@ class psbtObject(psbtProxy):
         if self.is_v2:
             for idx in range(self.num_outputs):
                 out = self.outputs[idx]
-                amount = unpack("<q", self.get(out.amount))[0]
+                amount = unpack_from("<q", self.get_view(out.amount))[0]
                 spk = self.get(out.script)
                 tx_out = CTxOut(nValue=amount, scriptPubKey=spk)
                 total_out += amount
@@ -1049,19 +1393,31 @@ class psbtObject(psbtProxy):
             assert self.vout_start is not None     # must call input_iter/validate first
 
             fd = self.fd
-            fd.seek(self.vout_start)
-
             tx_out = CTxOut()
-            for idx in range(self.num_outputs):
 
-                tx_out.deserialize(fd)
+            scanned = _native_txn_scan(fd, self.vout_start, self.num_outputs, False)
+            if scanned:
+                # offsets already known, no stream parsing needed
+                buf, recs = scanned
+                for idx, (pos, spos, slen) in enumerate(recs):
+                    tx_out.deserialize_at(buf, pos, spos, slen)
+                    total_out += tx_out.nValue
+                    yield idx, tx_out
 
-                total_out += tx_out.nValue
+                del buf, recs
+            else:
+                fd.seek(self.vout_start)
 
-                cont = fd.tell()
-                yield idx, tx_out
+                for idx in range(self.num_outputs):
 
-                fd.seek(cont)
+                    tx_out.deserialize(fd)
+
+                    total_out += tx_out.nValue
+
+                    cont = fd.tell()
+                    yield idx, tx_out
+
+                    fd.seek(cont)
 
         if self.total_value_out is None:
             self.total_value_out = total_out
@@ -1128,21 +1484,37 @@ class psbtObject(psbtProxy):
         # - we also capture much data about the txn on the first pass thru here
         #
         if self.is_v2:
+            # - outpoint is decoded once: validate() keeps it as inp.prevout
+            # - like v0 case below, same CTxIn is reused for each input
+            txin = CTxIn()
             for idx in range(self.num_inputs):
                 inp = self.inputs[idx]
-                prevout = COutPoint(uint256_from_str(self.get(inp.previous_txid)),
-                                    unpack("<I", self.get(inp.prevout_idx))[0])
-                sequence = inp.sequence if inp.sequence is not None else 0xffffffff
-                txin = CTxIn(outpoint=prevout, nSequence=sequence)
+                prevout = inp.prevout
+                if prevout is None:
+                    prevout = COutPoint(uint256_from_str(self.get_view(inp.previous_txid)),
+                                        unpack_from("<I", self.get_view(inp.prevout_idx))[0])
+                txin.prevout = prevout
+                txin.scriptSig = b''
+                txin.nSequence = inp.sequence if inp.sequence is not None else 0xffffffff
                 yield idx, txin
         else:
             fd = self.fd
 
             assert self.vin_start
+            txin = CTxIn()
+
+            scanned = _native_txn_scan(fd, self.vin_start, self.num_inputs, True)
+            if scanned:
+                # offsets already known, no stream parsing needed
+                buf, recs = scanned
+                for idx, (pos, spos, slen) in enumerate(recs):
+                    txin.deserialize_at(buf, pos, spos, slen)
+                    yield idx, txin
+                return
+
             # stream out the inputs
             fd.seek(self.vin_start)
 
-            txin = CTxIn()
             for idx in range(self.num_inputs):
                 txin.deserialize(fd)
 
@@ -1365,8 +1737,9 @@ class psbtObject(psbtProxy):
             assert self.fallback_locktime is None, "v0 requires exclusion of global fallback locktime"
             assert self.txn_modifiable is None, "v0 requires exclusion of global txn modifiable"
 
-        for idx, txo in self.output_iter():
-            out = self.outputs[idx]
+        # Note: these checks need only the proxy objects; outputs are deserialized
+        # once, later, in consider_outputs()
+        for out in self.outputs:
             if self.is_v2:
                 # v2 requires inclusion
                 assert out.amount
@@ -1400,9 +1773,12 @@ class psbtObject(psbtProxy):
                 assert inp.req_time_locktime is None
                 assert inp.req_height_locktime is None
 
-            self.inputs[idx].validate(idx, txin, self.my_xfp, self)
+            inp.validate(idx, txin, self.my_xfp, self)
+
+            # keep outpoint, so consider_inputs() need not parse the txn again
+            inp.prevout = txin.prevout
             if self.txn_version >= 2:
-                has_rtl = self.inputs[idx].has_relative_timelock(txin)
+                has_rtl = inp.has_relative_timelock(txin)
                 if has_rtl:
                     if has_rtl[0]:
                         tb_rel_locks.append((idx, has_rtl[1]))
@@ -1456,12 +1832,31 @@ class psbtObject(psbtProxy):
         # - mark change outputs, so perhaps we don't show them to users
 
         self.num_change_outputs = 0
+        self.change_value_out = 0
+        self.change_scripts = []
+        largest = self.largest_outs = []
         for idx, txo in self.output_iter():
             output = self.outputs[idx]
             # perform output validation
             output.validate(idx, txo, self.my_xfp, self.active_multisig, self)
             if output.is_change:
                 self.num_change_outputs += 1
+                self.change_value_out += txo.nValue
+                self.change_scripts.append(bytes(txo.scriptPubKey))
+                continue
+
+            # keep a copy of the script, since output_iter may reuse the object
+            here = txo.nValue
+            if len(largest) < MAX_VISIBLE_OUTPUTS:
+                largest.append((here, idx, bytes(txo.scriptPubKey)))
+                continue
+
+            # insertion sort
+            for li, (nv, _, _) in enumerate(largest):
+                if here > nv:
+                    largest.pop(-1)
+                    largest.insert(li, (here, idx, bytes(txo.scriptPubKey)))
+                    break
 
         if self.total_value_out is None:
             # this happens, but would expect this to have done already?
@@ -1613,8 +2008,8 @@ class psbtObject(psbtProxy):
         foreign = []
         total_in = 0
 
-        for i, txi in self.input_iter():
-            inp = self.inputs[i]
+        # - txn inputs were parsed already, by validate(); uses captured outpoints
+        for i, inp in enumerate(self.inputs):
             if inp.fully_signed:
                 self.presigned_inputs.add(i)
 
@@ -1628,7 +2023,7 @@ class psbtObject(psbtProxy):
                     continue
 
             # pull out just the CTXOut object (expensive)
-            utxo = inp.get_utxo(txi.prevout.n)
+            utxo = inp.get_utxo(inp.prevout.n)
 
             assert utxo.nValue > 0
             total_in += utxo.nValue
@@ -1642,7 +2037,7 @@ class psbtObject(psbtProxy):
             # iff to UTXO is segwit, then check it's value, and also
             # capture that value, since it's supposed to be immutable
             if inp.is_segwit:
-                history.verify_amount(txi.prevout, inp.amount, i)
+                history.verify_amount(inp.prevout, inp.amount, i)
 
             del utxo
 
@@ -1734,19 +2129,20 @@ class psbtObject(psbtProxy):
 
         assert rv.num_inputs is not None
         assert rv.num_outputs is not None
-        rv.inputs = [psbtInputProxy(fd, idx) for idx in range(rv.num_inputs)]
-        rv.outputs = [psbtOutputProxy(fd, idx) for idx in range(rv.num_outputs)]
+        if (rv.num_inputs + rv.num_outputs) > LAZY_PROXY_COUNT:
+            # too many to hold in memory at once
+            rv.inputs = psbtProxyTable(psbtInputProxy, fd, rv.num_inputs)
+            rv.outputs = psbtProxyTable(psbtOutputProxy, fd, rv.num_outputs)
+        else:
+            rv.inputs = [psbtInputProxy(fd, idx) for idx in range(rv.num_inputs)]
+            rv.outputs = [psbtOutputProxy(fd, idx) for idx in range(rv.num_outputs)]
 
         return rv
 
-    def serialize(self, out_fd, upgrade_txn=False):
-        # Ouput into a file.
-
+    def serialize_globals(self, out_fd, upgrade_txn):
         wr = lambda *a: self.write(out_fd, *a)
 
-        out_fd.write(b'psbt\xff')
-
-        if upgrade_txn and self.is_complete():
+        if upgrade_txn:
             # write out the ready-to-transmit txn
             # - means we are also a PSBT combiner in this case
             # - hard tho, due to variable length data.
@@ -1782,6 +2178,19 @@ class psbtObject(psbtProxy):
             for k, v in self.unknown.items():
                 wr(k[0], v, k[1:])
 
+    def serialize(self, out_fd, upgrade_txn=False):
+        # Ouput into a file.
+
+        out_fd.write(b'psbt\xff')
+
+        upgrade_txn = upgrade_txn and self.is_complete()
+
+        if self.span and not upgrade_txn:
+            # globals unchanged: copy them from original
+            self.copy_span(out_fd)
+        else:
+            self.serialize_globals(out_fd, upgrade_txn)
+
         # sep between globals and inputs
         out_fd.write(b'\0')
 
@@ -1812,7 +2221,7 @@ class psbtObject(psbtProxy):
 
                 for count, out_idx in enumerate(change_outs):
                     # only expecting single case, but be general
-                    dis.progress_bar_show(count / len(change_outs))
+                    dis.progress_sofar(count, len(change_outs))
 
                     oup = self.outputs[out_idx]
 
@@ -1839,13 +2248,19 @@ class psbtObject(psbtProxy):
             # progress
             dis.fullscreen('Signing...')
 
-            # Sign individual inputs
-            sigs = 0
-            success = set()
-            for in_idx, txi in self.input_iter():
-                dis.progress_bar_show(in_idx / self.num_inputs)
+            # Signing is done in three stages, each a single pass:
+            #   1) derive and verify the keys for inputs we will sign
+            #   2) compute sighash digests for those inputs
+            #   3) make signatures
+            # - progress bar covers all three
+            def progress(stage, n, count):
+                dis.progress_sofar((stage * count) + n, 3 * count)
 
-                inp = self.inputs[in_idx]
+            # Stage 1: keys
+            # - nodes are registered so they will be wiped even if we fail part-way
+            todo = []           # of (in_idx, which_key, node)
+            for in_idx, inp in enumerate(self.inputs):
+                progress(0, in_idx, self.num_inputs)
 
                 if not inp.has_utxo():
                     # maybe they didn't provide the UTXO
@@ -1860,8 +2275,7 @@ class psbtObject(psbtProxy):
                     # but in other cases, no more signatures are possible
                     continue
 
-                txi.scriptSig = inp.scriptSig
-                assert txi.scriptSig, "no scriptsig?"
+                assert inp.scriptSig, "no scriptsig?"
 
                 inp.handle_none_sighash()
                 if inp.is_multisig:
@@ -1869,7 +2283,7 @@ class psbtObject(psbtProxy):
                     for which_key in inp.required_key:
                         # get node required
                         skp = keypath_to_str(inp.subpaths[which_key])
-                        node = sv.derive_path(skp, register=False)
+                        node = sv.derive_path(skp)
 
                         # expensive test, but works... and important
                         pu = node.pubkey()
@@ -1892,19 +2306,36 @@ class psbtObject(psbtProxy):
 
                     # get node required
                     skp = keypath_to_str(inp.subpaths[which_key])
-                    node = sv.derive_path(skp, register=False)
+                    node = sv.derive_path(skp)
 
                     # expensive test, but works... and important
                     pu = node.pubkey()
                     assert pu == which_key, "Path (%s) led to wrong pubkey for input#%d"%(skp, in_idx)
 
-                if sv.deltamode:
-                    # Current user is actually a thug with a slightly wrong PIN, so we
-                    # do have access to the private keys and could sign txn, but we
-                    # are going to silently corrupt our signatures.
-                    digest = bytes(range(32))
-                else:
-                    if not inp.is_segwit:
+                todo.append((in_idx, which_key, node))
+
+            gc.collect()
+
+            # Stage 2: digests
+            ckcc.prof_start(SIGHASH)
+            digests = {}
+            if todo:
+                wanted = set(t[0] for t in todo)
+                for in_idx, txi in self.input_iter():
+                    progress(1, in_idx, self.num_inputs)
+
+                    if in_idx not in wanted:
+                        continue
+
+                    inp = self.inputs[in_idx]
+                    txi.scriptSig = inp.scriptSig
+
+                    if sv.deltamode:
+                        # Current user is actually a thug with a slightly wrong PIN, so we
+                        # do have access to the private keys and could sign txn, but we
+                        # are going to silently corrupt our signatures.
+                        digest = bytes(range(32))
+                    elif not inp.is_segwit:
                         # Hash by serializing/blanking various subparts of the transaction
                         digest = self.make_txn_sighash(in_idx, txi, inp.sighash)
                     else:
@@ -1912,6 +2343,23 @@ class psbtObject(psbtProxy):
                         digest = self.make_txn_segwit_sighash(in_idx, txi,
                                         inp.amount, inp.scriptCode, inp.sighash)
 
+                    digests[in_idx] = digest
+
+                del wanted
+
+            # release sighash caches
+            self.legacy_ins = self.legacy_outs = None
+            gc.collect()
+            ckcc.prof_stop(SIGHASH)
+
+            # Stage 3: signatures
+            ckcc.prof_start(SIGN)
+            for count, (in_idx, which_key, node) in enumerate(todo):
+                progress(2, count, len(todo))
+
+                inp = self.inputs[in_idx]
+                digest = digests.pop(in_idx)
+
                 # The precious private key we need
                 pk = node.privkey()
 
@@ -1920,28 +2368,12 @@ class psbtObject(psbtProxy):
                 #print(" digest %s" % b2a_hex(digest).decode('ascii'))
 
                 # Do the ACTUAL signature ... finally!!!
-
-                # We need to grind sometimes to get a positive R
-                # value that will encode (after DER) into a shorter string.
-                # - saves on miner's fee (which might be expected/required)
-                # - blends in with Bitcoin Core signatures which do this
-                for retry in range(10):
-                    result = ngu.secp256k1.sign(pk, digest, retry).to_bytes()
-
-                    # convert signature to DER format
-                    #assert len(result) == 65
-                    r = result[1:33]
-                    s = result[33:65]
-                    der_sig = ser_sig_der(r, s, inp.sighash)
-
-                    if len(der_sig) <= 71:
-                        # odds of needing retry: just under 50% I think
-                        break
+                der_sig = sign_low_r(pk, digest, inp.sighash)
 
                 # private key no longer required
                 stash.blank_object(pk)
                 stash.blank_object(node)
-                del pk, node, pu, skp
+                del pk
 
                 inp.added_sig = (which_key, der_sig)
 
@@ -1950,15 +2382,14 @@ class psbtObject(psbtProxy):
                 # signature (taproot SIGHASH_DEFAULT)
                 ## inp.sighash = None
 
-                success.add(in_idx)
-
                 if self.is_v2:
                     self.set_modifiable_flag(inp)
 
-                # memory cleanup
-                del result, r, s
+            ckcc.prof_stop(SIGN)
 
-                gc.collect()
+            # memory cleanup
+            del todo, digests
+            gc.collect()
 
         # done.
         dis.progress_bar_show(1)
@@ -1969,6 +2400,8 @@ class psbtObject(psbtProxy):
         # TODO possible to also cross-check with sighash from signature:
         #    1. witnes/scriptSig in serialized tx in PSBT
         #    2. psbt meta fields partial_sigs, taproot_key_sig and taproot_script_sigs
+        self.span = None            # globals will change, so cannot copy them as-is
+
         if self.txn_modifiable is None:
             # set to inputs/outputs modifiable
             # has SINGLE to false
@@ -1989,15 +2422,53 @@ class psbtObject(psbtProxy):
             # Bit 2 is the Has SIGHASH_SINGLE flag - set it to 1
             self.txn_modifiable |= 4
 
+    def legacy_sighash_inputs(self, zero_seq):
+        # Serialized copy of all txn inputs, with blank scriptSig, as needed for
+        # legacy (non-segwit) sighash. Computed once per signing session.
+        # - every record is exactly LEGACY_BLANK_TXIN bytes, so can be sliced by input index
+        # - zero_seq: nSequence forced to zero, as needed for SIGHASH_NONE/SINGLE
+        if self.legacy_ins is None:
+            self.legacy_ins = {}
+
+        rv = self.legacy_ins.get(zero_seq)
+        if rv is not None:
+            return rv
+
+        rv = bytearray(LEGACY_BLANK_TXIN * self.num_inputs)
+        pos = 0
+        for in_idx, txi in self.input_iter():
+            if zero_seq:
+                txi.nSequence = 0
+            txi.scriptSig = b''
+            rv[pos:pos+LEGACY_BLANK_TXIN] = txi.serialize()
+            pos += LEGACY_BLANK_TXIN
+
+        self.legacy_ins[zero_seq] = rv
+
+        return rv
+
+    def legacy_sighash_outputs(self):
+        # All outputs, serialized, for SIGHASH_ALL case of legacy sighash.
+        if self.legacy_outs is None:
+            # join once at end: repeated += would copy all of it, for each output
+            self.legacy_outs = b''.join(txo.serialize() for _, txo in self.output_iter())
+
+        return self.legacy_outs
+
     def make_txn_sighash(self, replace_idx, replacement, sighash_type):
         # calculate the hash value for one input of current transaction
         # - blank all script inputs
         # - except one single tx in, which is provided
         # - serialize that without witness data
         # - sha256 over that
+        # - unchanging parts are serialized once and cached, so this is linear in
+        #   txn size, rather than re-reading the whole txn for each input
         fd = self.fd
         old_pos = fd.tell()
 
+        assert not self.inputs[replace_idx].is_segwit
+        assert replacement.scriptSig
+
         # sighash regardless of ANYONECANPAY input part
         out_sighash_type = sighash_type & 0x7f
 
@@ -2007,22 +2478,21 @@ class psbtObject(psbtProxy):
         rv.update(pack('<i', self.txn_version))           # nVersion
 
         # inputs
-        num_inputs = 1 if sighash_type & SIGHASH_ANYONECANPAY else self.num_inputs
-        rv.update(ser_compact_size(num_inputs))
-        for in_idx, txi in self.input_iter():
-            if in_idx == replace_idx:
-                assert not self.inputs[in_idx].is_segwit
-                assert replacement.scriptSig
-                rv.update(replacement.serialize())
-            elif not (sighash_type & SIGHASH_ANYONECANPAY):
-                if out_sighash_type in (SIGHASH_NONE, SIGHASH_SINGLE):
-                    # do not include sequence of other inputs (zero them for digest)
-                    # which means that they can be replaced
-                    txi.nSequence = 0
-                txi.scriptSig = b''
-                rv.update(txi.serialize())
-            # else:
-            #    is SIGHASH_ANYONECANPAY so we do not include any other inputs
+        if sighash_type & SIGHASH_ANYONECANPAY:
+            # do not include any other inputs
+            rv.update(ser_compact_size(1))
+            rv.update(replacement.serialize())
+        else:
+            # for NONE and SINGLE: do not include sequence of other inputs (zero
+            # them for digest) which means that they can be replaced
+            zero_seq = out_sighash_type in (SIGHASH_NONE, SIGHASH_SINGLE)
+            blanks = memoryview(self.legacy_sighash_inputs(zero_seq))
+            pos = replace_idx * LEGACY_BLANK_TXIN
+
+            rv.update(ser_compact_size(self.num_inputs))
+            rv.update(blanks[0:pos])
+            rv.update(replacement.serialize())
+            rv.update(blanks[pos+LEGACY_BLANK_TXIN:])
 
         # outputs
         if out_sighash_type == SIGHASH_NONE:
@@ -2030,16 +2500,17 @@ class psbtObject(psbtProxy):
         elif out_sighash_type == SIGHASH_SINGLE:
             rv.update(ser_compact_size(replace_idx+1))
             assert replace_idx < self.num_outputs, "SINGLE corresponding output (%d) missing" % replace_idx
+            blank = CTxOut(-1).serialize()
             for out_idx, txo in self.output_iter():
                 if out_idx < replace_idx:
-                    rv.update(CTxOut(-1).serialize())
+                    rv.update(blank)
                 if out_idx == replace_idx:
                     rv.update(txo.serialize())
+                    break
         else:
             assert out_sighash_type == SIGHASH_ALL
             rv.update(ser_compact_size(self.num_outputs))
-            for out_idx, txo in self.output_iter():
-                rv.update(txo.serialize())
+            rv.update(self.legacy_sighash_outputs())
 
         # locktime, sighash_type
         rv.update(pack('<II', self.lock_time, sighash_type))
@@ -2049,6 +2520,21 @@ class psbtObject(psbtProxy):
         # double SHA256
         return ngu.hash.sha256s(rv.digest())
 
+    def calc_segwit_input_hashes(self):
+        # BIP-143 hashPrevouts and hashSequence, in a single pass over the inputs
+        # - same values apply to any input not using ANYONECANPAY
+        hashPrevouts = sha256()
+        hashSequence = sha256()
+
+        for in_idx, txi in self.input_iter():
+            hashPrevouts.update(txi.prevout.serialize())
+            hashSequence.update(pack("<I", txi.nSequence))
+
+        self.hashPrevouts = ngu.hash.sha256s(hashPrevouts.digest())
+        self.hashSequence = ngu.hash.sha256s(hashSequence.digest())
+
+        gc.collect()
+
     def make_txn_segwit_sighash(self, replace_idx, replacement, amount, scriptCode, sighash_type):
         # Implement BIP 143 hashing algo for signature of segwit programs.
         # see <https://github.com/bitcoin/bips/blob/master/bip-0143.mediawiki>
@@ -2059,60 +2545,51 @@ class psbtObject(psbtProxy):
         # sighash regardless of ANYONECANPAY input part
         out_sighash_type = sighash_type & 0x7f
 
-        if self.hashPrevouts and sighash_type == SIGHASH_ALL:
-            hashPrevouts = self.hashPrevouts
-            hashSequence = self.hashSequence
-            hashOutputs = self.hashOutputs
-        else:
-            # input side
-            hashPrevouts = sha256()
-            hashSequence = sha256()
-
-            if not (sighash_type & SIGHASH_ANYONECANPAY):
-                for in_idx, txi in self.input_iter():
-                    hashPrevouts.update(txi.prevout.serialize())
-                    if out_sighash_type == SIGHASH_ALL:
-                        hashSequence.update(pack("<I", txi.nSequence))
-
-                hashPrevouts = ngu.hash.sha256s(hashPrevouts.digest())
-                if out_sighash_type == SIGHASH_ALL:
-                    hashSequence = ngu.hash.sha256s(hashSequence.digest())
+        # input side: shared by all inputs, unless ANYONECANPAY
+        hashPrevouts = hashSequence = None
+        if not (sighash_type & SIGHASH_ANYONECANPAY):
+            if self.hashPrevouts is None:
+                self.calc_segwit_input_hashes()
 
-            # output side
-            hashOutputs = sha256()
+            hashPrevouts = self.hashPrevouts
             if out_sighash_type == SIGHASH_ALL:
+                hashSequence = self.hashSequence
+
+        # output side
+        hashOutputs = None
+        if out_sighash_type == SIGHASH_ALL:
+            if self.hashOutputs is None:
+                # shared by all inputs signing with ALL (with or w/o ANYONECANPAY)
+                rv = sha256()
                 for out_idx, txo in self.output_iter():
-                    hashOutputs.update(txo.serialize())
-
-                hashOutputs = ngu.hash.sha256s(hashOutputs.digest())
+                    rv.update(txo.serialize())
 
-            elif out_sighash_type == SIGHASH_SINGLE:
-                # Even though below case is consensus valid, we block it.
-                # If users do not want to sign any outputs, NONE sighash flag
-                # should be used instead.
-                assert replace_idx < self.num_outputs, \
-                            "SINGLE corresponding output (%d) missing" % replace_idx
+                self.hashOutputs = ngu.hash.sha256s(rv.digest())
+                gc.collect()
 
-                for out_idx, txo in self.output_iter():
-                    if out_idx == replace_idx:
-                        hashOutputs = ngu.hash.sha256d(txo.serialize())
-            else:
-                assert out_sighash_type == SIGHASH_NONE
+            hashOutputs = self.hashOutputs
 
-            if sighash_type == SIGHASH_ALL:
-                # cache this multitude of hashes
-                self.hashPrevouts = hashPrevouts
-                self.hashSequence = hashSequence
-                self.hashOutputs = hashOutputs
+        elif out_sighash_type == SIGHASH_SINGLE:
+            # Even though below case is consensus valid, we block it.
+            # If users do not want to sign any outputs, NONE sighash flag
+            # should be used instead.
+            assert replace_idx < self.num_outputs, \
+                        "SINGLE corresponding output (%d) missing" % replace_idx
 
-            gc.collect()
+            # unique to each input, so nothing to cache
+            for out_idx, txo in self.output_iter():
+                if out_idx == replace_idx:
+                    hashOutputs = ngu.hash.sha256d(txo.serialize())
+                    break
+        else:
+            assert out_sighash_type == SIGHASH_NONE
 
         rv = sha256()
 
         # version number
         rv.update(pack('<i', self.txn_version))       # nVersion
-        rv.update(hashPrevouts if isinstance(hashPrevouts, bytes) else bytes(32))
-        rv.update(hashSequence if isinstance(hashSequence, bytes) else bytes(32))
+        rv.update(hashPrevouts or bytes(32))
+        rv.update(hashSequence or bytes(32))
 
         rv.update(replacement.prevout.serialize())
 
@@ -2123,7 +2600,7 @@ class psbtObject(psbtProxy):
         rv.update(pack("<q", amount))
         rv.update(pack("<I", replacement.nSequence))
 
-        rv.update(hashOutputs if isinstance(hashOutputs, bytes) else bytes(32))
+        rv.update(hashOutputs or bytes(32))
 
         # locktime, sighash_type
         rv.update(pack('<II', self.lock_time, sighash_type))
@@ -2136,16 +2613,15 @@ class psbtObject(psbtProxy):
     def is_complete(self):
         # Are all the inputs (now) signed?
 
-        # some might have been given as signed
-        signed = len(self.presigned_inputs)
-
-        # plus we added some signatures
-        for inp in self.inputs:
+        signed = 0
+        for idx, inp in enumerate(self.inputs):
             if inp.is_multisig:
-                # but we can't combine/finalize multisig stuff, so will never't be 'final'
+                # Co-signers' partial sigs aren't verified here, so never call it
+                # 'final'; host can still ask for finalize (STXN_FINALIZE) over USB.
                 return False
 
-            if inp.added_sig:
+            if inp.added_sig or (idx in self.presigned_inputs):
+                # we signed it, or was given as signed
                 signed += 1
 
         return signed == self.num_inputs
@@ -2154,10 +2630,16 @@ class psbtObject(psbtProxy):
         # Stream out the finalized transaction, with signatures applied
         # - assumption is it's complete already.
         # - returns the TXID of resulting transaction
-        # - but in segwit case, needs to re-read to calculate it
-        # - fd must be read/write and seekable to support txid calc
+        # - txid is hashed as we go: only non-witness parts are fed to it, so no
+        #   need to re-read anything, and fd can be write-only
+        txid_h = sha256()
 
-        fd.write(pack('<i', self.txn_version))           # nVersion
+        def wr(b, is_witness=False):
+            fd.write(b)
+            if not is_witness:
+                txid_h.update(b)
+
+        wr(pack('<i', self.txn_version))           # nVersion
 
         # does this txn require witness data to be included?
         # - yes, if the original txn had some
@@ -2166,19 +2648,25 @@ class psbtObject(psbtProxy):
 
         if needs_witness:
             # zero marker, and flags=0x01
-            fd.write(b'\x00\x01')
-
-        body_start = fd.tell()
+            wr(b'\x00\x01', True)
 
         # inputs
-        fd.write(ser_compact_size(self.num_inputs))
+        wr(ser_compact_size(self.num_inputs))
         for in_idx, txi in self.input_iter():
             inp = self.inputs[in_idx]
 
             if inp.is_segwit:
 
-                if inp.is_p2sh:
-                    # multisig (p2sh) segwit still requires the script here.
+                if inp.is_multisig:
+                    if inp.redeem_script:
+                        # P2SH-P2WSH: push of the P2WSH script, which hashes the
+                        # multisig script that goes into the witness
+                        txi.scriptSig = ser_string(b'\x00\x20' + ngu.hash.sha256s(inp.scriptSig))
+                    else:
+                        # native P2WSH
+                        txi.scriptSig = b''
+                elif inp.is_p2sh:
+                    # p2sh-wrapped segwit still requires the script here.
                     txi.scriptSig = ser_string(inp.scriptSig)
                 else:
                     # major win for segwit (p2pkh): no redeem script bloat anymore
@@ -2199,46 +2687,45 @@ class psbtObject(psbtProxy):
 
                 txi.scriptSig = s
 
-            fd.write(txi.serialize())
+            wr(txi.serialize())
 
         # outputs
-        fd.write(ser_compact_size(self.num_outputs))
+        wr(ser_compact_size(self.num_outputs))
         for out_idx, txo in self.output_iter():
-            fd.write(txo.serialize())
+            wr(txo.serialize())
 
             # capture change output amounts (if segwit)
             if self.outputs[out_idx].is_change and self.outputs[out_idx].witness_script:
                 history.add_segwit_utxos(out_idx, txo.nValue)
 
-        body_end = fd.tell()
-
         if needs_witness:
             # witness values
             # - preserve any given ones, add ours
             for in_idx, wit in self.input_witness_iter():
                 inp = self.inputs[in_idx]
 
-                if inp.is_segwit and inp.added_sig:
+                if inp.is_segwit and inp.is_multisig:
+                    # combine all the signatures we have, with witness script
+                    assert not wit.scriptWitness.stack, 'replacing non-empty?'
+                    stack = inp.multisig_witness()
+                    assert stack, 'Not enough signatures on input #%d' % in_idx
+                    wit.scriptWitness.stack = stack
+
+                elif inp.is_segwit and inp.added_sig:
                     # put in new sig: wit is a CTxInWitness
                     assert not wit.scriptWitness.stack, 'replacing non-empty?'
-                    assert not inp.is_multisig, 'Multisig PSBT combine not supported'
 
                     pubkey, der_sig = inp.added_sig
                     assert pubkey[0] in {0x02, 0x03} and len(pubkey) == 33, "bad v0 pubkey"
                     wit.scriptWitness.stack = [der_sig, pubkey]
 
-                fd.write(wit.serialize())
+                wr(wit.serialize(), True)
 
         # locktime
-        fd.write(pack('<I', self.lock_time))
+        wr(pack('<I', self.lock_time))
 
-        # calc transaction ID
-        if not needs_witness:
-            # easy w/o witness data
-            txid = ngu.hash.sha256s(fd.checksum.digest())
-        else:
-            # legacy cost here for segwit: re-read what we just wrote
-            txid = calc_txid(fd, (0, fd.tell()), (body_start, body_end-body_start))
+        # transaction ID: double-sha256 over non-witness parts
+        txid = ngu.hash.sha256s(txid_h.digest())
 
         history.add_segwit_utxos_finalize(txid)
 
@@ -17,6 +17,12 @@ class PSRAMWrapper:
         # one-copy byte-wise access
         return uctypes.bytes_at(self.base+offset, ln)
 
+    def read_view(self, offset, ln):
+        # zero-copy access: memoryview into PSRAM, caller must not modify
+        assert offset + ln <= self.length, (offset+ln)
+
+        return memoryview(self._wr)[offset:offset+ln]
+
     def write_at(self, offset, ln):
         # word-aligned writes only
         assert offset % 4 == 0, offset
@@ -28,7 +34,8 @@ class PSRAMWrapper:
     # Be compatible with SPIFlash class...
 
     def read(self, address, buf, cmd=None):
-        buf[:] = self.read_at(address, len(buf))
+        # copy once, straight from mapped memory into caller's buffer
+        buf[:] = self.read_view(address, len(buf))
 
     def write(self, address, buf):
         ln = len(buf)
@@ -61,6 +68,6 @@ class PSRAMWrapper:
         for pos in range(0, self.length, len(z)):
             self.write_at(pos, len(z))[:] = z
 
-            dis.progress_bar_show(pos / self.length)
+            dis.progress_sofar(pos, self.length)
 
 # EOF
@@ -14,6 +14,17 @@ class PassphraseSaver:
     # to a file on MicroSD card. Order is preserved.
     # AES-256 CTR with key=SHA256(SHA256(salt + derived key off master + salt))
     # where: salt=sha256(microSD serial # details)
+
+    # Decrypted contents, for this session: (card change time, card id hash, key, list, file).
+    # - forgotten when any card is inserted or removed, see CardSlot.last_change
+    _cache = None
+    _gen = 0            # bumped whenever _cache changes, see PassphraseSaverMenu
+
+    @classmethod
+    def _set_cache(cls, c):
+        cls._cache = c
+        cls._gen += 1
+
     def __init__(self):
         self.key = None
 
@@ -23,12 +34,12 @@ class PassphraseSaver:
         # - some very minor obscurity, but we aren't relying on that.
         return card.get_sd_root() + '/.tmp.tmp'
 
-    def _calc_key(self, card, force=False):
+    def _calc_key(self, card, force=False, salt=None):
         # calculate the key to be used.
         if not force and self.key:
             return
 
-        salt = card.get_id_hash()
+        salt = salt or card.get_id_hash()
 
         with stash.SensitiveValues(bypass_tmp=True) as sv:
             self.key = bytearray(sv.encryption_key(salt))
@@ -49,19 +60,81 @@ class PassphraseSaver:
         except:
             return []
 
+    @classmethod
+    def forget(cls):
+        # drop cached contents, and key
+        c = cls._cache
+        if c:
+            stash.blank_object(c[2])
+            cls._set_cache(None)
+
+        # menu made from that list, has hints of the passwords
+        MenuSystem.built.pop(PassphraseSaverMenu, None)
+
+    def _load(self, card):
+        # Like _read(), but keep result for session, so the key isn't
+        # derived and whole file decrypted each time the menu is shown.
+        id_hash = card.get_id_hash()
+        c = PassphraseSaver._cache
+        if c and c[0] == CardSlot.last_change and c[1] == id_hash:
+            self.key = c[2]
+            return c[3]
+
+        self.forget()
+        self._calc_key(card, force=True, salt=id_hash)
+
+        data = []
+        msg = b''
+        try:
+            with open(self.filename(card), 'rb') as f:
+                msg = f.read()
+            data = ujson.loads(ngu.aes.CTR(self.key).cipher(msg))
+        except:
+            # same as _read(): missing file or noise
+            pass
+
+        PassphraseSaver._set_cache((CardSlot.last_change, id_hash, self.key, data, msg))
+
+        return data
+
     async def _save(self, card, data):
         assert self.key
         encrypt = ngu.aes.CTR(self.key)
         msg = encrypt.cipher(ujson.dumps(data))
+        fname = self.filename(card)
+
+        # CTR mode: when just appending, only the tail of the file changes
+        c = PassphraseSaver._cache
+        old = c[4] if (c and c[2] == self.key) else None
+        pos = 0
+        if old and len(msg) >= len(old):
+            try:
+                if os.stat(fname)[6] == len(old):
+                    while pos < len(old) and old[pos] == msg[pos]:
+                        pos += 1
+            except OSError:
+                pos = 0
+
+        try:
+            if pos:
+                with open(fname, 'r+b') as fd:
+                    fd.seek(pos)
+                    fd.write(msg[pos:])
+            else:
+                # overwrites whatever already there
+                with open(fname, 'wb') as fd:
+                    fd.write(msg)
+        except:
+            # cached list may have been changed already; re-read next time
+            self.forget()
+            raise
 
-        # overwrites whatever already there
-        with open(self.filename(card), 'wb') as fd:
-            fd.write(msg)
+        if old is not None:
+            PassphraseSaver._set_cache(c[0:3] + (data, msg))
 
     async def delete(self, idx):
         with CardSlot() as card:
-            self._calc_key(card)
-            data = self._read(card)
+            data = self._load(card)
 
             try:
                 del data[idx]
@@ -75,8 +148,7 @@ class PassphraseSaver:
         from glob import dis
         dis.fullscreen('Reading...')
         with CardSlot() as card:
-            self._calc_key(card)
-            data = self._read(card)
+            data = self._load(card)
 
             to_add = dict(xfp=xfp, pw=bip39pw)
             if to_add not in data:
@@ -87,9 +159,15 @@ class PassphraseSaver:
 
 class PassphraseSaverMenu(MenuSystem):
 
+    @classmethod
+    def data_version(cls):
+        # contents come from PassphraseSaver's cache, only good until card changes
+        if not PassphraseSaver._cache:
+            return None
+        return (CardSlot.last_change, PassphraseSaver._gen)
+
     def update_contents(self):
-        tmp = PassphraseSaverMenu.construct()
-        self.replace_items(tmp)
+        self.rebuild()
 
     @staticmethod
     async def apply(menu, idx, item):
@@ -182,8 +260,7 @@ class PassphraseSaverMenu(MenuSystem):
         # if any error hit.
         pw_saver = PassphraseSaver()
         with CardSlot() as card:
-            pw_saver._calc_key(card)
-            data = pw_saver._read(card)
+            data = pw_saver._load(card)
 
             if not data: return None
 
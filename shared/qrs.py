@@ -2,14 +2,62 @@
 #
 # qrs.py - QR Display related UX
 #
-import framebuf, uqr
+import framebuf, uqr, uasyncio
+from ucollections import OrderedDict
+from ubinascii import hexlify as b2a_hex
 from ux import UserInteraction, ux_wait_keyup, the_ux 
 from utils import word_wrap
 
+# how many rendered QR's to keep around: current, neighbours, and a few more
+QR_CACHE_SIZE = const(5)
+
+# BBQr: values too big for one QR are split over many, and shown as an animation
+# - see <https://bbqr.org>; we only make 'H' (hex) encoding, which suits alnum mode
+BBQR_PART_LEN = const(100)          # bytes of payload per QR, about version 7
+BBQR_MAX_PARTS = const(1295)        # two base36 digits
+BBQR_FRAME_MS = const(250)          # time each part is shown
+BBQR_CACHE_MAX = const(32)          # keep all rendered parts, if no more than this
+
+
+def bbqr_parts_needed(data_len):
+    # how many QR's to show data_len bytes, or None if too big for BBQr
+    n = (data_len + BBQR_PART_LEN - 1) // BBQR_PART_LEN
+    return n if 1 <= n <= BBQR_MAX_PARTS else None
+
+class BBQrParts:
+    # Acts like a list of strings: the BBQr parts, but each is only made when needed.
+    # - file_type is one letter: 'P' for PSBT, 'T' for transaction, see spec
+
+    def __init__(self, raw, file_type):
+        self.count = bbqr_parts_needed(len(raw))
+        assert self.count, 'too big'
+        assert len(file_type) == 1
+        self.raw = raw
+        self.hdr = 'B$H' + file_type + self.b36(self.count)
+
+    @staticmethod
+    def b36(n):
+        # two digits of base36, upper case
+        d = '0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ'
+        return d[n // 36] + d[n % 36]
+
+    def __len__(self):
+        return self.count
+
+    def __getitem__(self, idx):
+        if not (0 <= idx < self.count):
+            raise IndexError
+        pos = idx * BBQR_PART_LEN
+        body = b2a_hex(self.raw[pos:pos+BBQR_PART_LEN]).decode().upper()
+        return self.hdr + self.b36(idx) + body
+
 
 class QRDisplaySingle(UserInteraction):
     # Show a single QR code for (typically) a list of addresses, or a single value.
 
+    cache_size = QR_CACHE_SIZE
+    animated = False
+
     def __init__(self, addrs, is_alnum, start_n=0, sidebar=None):
         self.is_alnum = is_alnum
         self.idx = 0             # start with first address
@@ -18,6 +66,8 @@ class QRDisplaySingle(UserInteraction):
         self.sidebar = sidebar
         self.start_n = start_n
         self.qr_data = None
+        self.cache = OrderedDict()      # idx => QR, most recent last
+        self.prefetcher = None
 
     def calc_qr(self, msg):
         # Version 2 would be nice, but can't hold what we need, even at min error correction,
@@ -36,7 +86,43 @@ class QRDisplaySingle(UserInteraction):
             enc = uqr.Mode_BYTE
 
         # can fail if not enough space in QR
-        self.qr_data = uqr.make(msg, min_version=2, max_version=11, encoding=enc)
+        return uqr.make(msg, min_version=2, max_version=11, encoding=enc)
+
+    def get_qr(self, idx):
+        # QR for one of our values, from LRU cache if possible
+        cache = self.cache
+        rv = cache.pop(idx, None)
+        if rv is None:
+            rv = self.calc_qr(self.addrs[idx])
+
+            if len(cache) >= self.cache_size:
+                cache.pop(next(iter(cache)))
+
+        cache[idx] = rv
+
+        return rv
+
+    async def prefetch(self):
+        # While they look at this one, render the ones they will likely want next.
+        # - uqr.make blocks, so do one at a time and let the key handling run between
+        for idx in (self.idx+1, self.idx-1):
+            await uasyncio.sleep_ms(50)
+            if 0 <= idx < len(self.addrs) and idx not in self.cache:
+                try:
+                    self.get_qr(idx)
+                except:
+                    # not our problem yet; redraw will report it
+                    pass
+
+    def start_prefetch(self):
+        self.stop_prefetch()
+        if len(self.addrs) > 1:
+            self.prefetcher = uasyncio.create_task(self.prefetch())
+
+    def stop_prefetch(self):
+        if self.prefetcher:
+            self.prefetcher.cancel()
+            self.prefetcher = None
 
     def redraw(self):
         # Redraw screen.
@@ -48,9 +134,10 @@ class QRDisplaySingle(UserInteraction):
 
         # make the QR, if needed.
         if not self.qr_data:
-            dis.busy_bar(True)
+            if self.idx not in self.cache and not self.animated:
+                dis.busy_bar(True)
 
-            self.calc_qr(msg)
+            self.qr_data = self.get_qr(self.idx)
 
         # draw display
         dis.clear()
@@ -119,7 +206,7 @@ class QRDisplaySingle(UserInteraction):
                 dis.text(x, y, sidebar[i:i+ll], FontSmall)
                 y += dy
 
-        if not inv and len(self.addrs) > 1:
+        if not inv and len(self.addrs) > 1 and not self.animated:
             # show path number, very tiny
             ai = str(self.start_n + self.idx)
             if len(ai) == 1:
@@ -132,8 +219,16 @@ class QRDisplaySingle(UserInteraction):
 
 
     async def interact_bare(self):
-        from glob import NFC
         self.redraw()
+        self.start_prefetch()
+
+        try:
+            await self.key_loop()
+        finally:
+            self.stop_prefetch()
+
+    async def key_loop(self):
+        from glob import NFC
 
         while 1:
             ch = await ux_wait_keyup()
@@ -165,9 +260,47 @@ class QRDisplaySingle(UserInteraction):
                 # self.idx has changed, so need full re-render
                 self.qr_data = None
                 self.redraw()
+                self.start_prefetch()
 
     async def interact(self):
         await self.interact_bare()
         the_ux.pop()
 
+
+class QRDisplayAnimated(QRDisplaySingle):
+    # Cycle thru the parts of a BBQr on a timer, until X or OK is pressed.
+    # - parts is BBQrParts (or a list of strings made to same spec)
+
+    animated = True
+
+    def __init__(self, parts):
+        super().__init__(parts, True)
+        if len(parts) <= BBQR_CACHE_MAX:
+            self.cache_size = len(parts)
+        self.animator = None
+
+    def redraw(self):
+        self.sidebar = ('%d/%d' % (self.idx+1, len(self.addrs)), 7)
+        super().redraw()
+
+    async def animate(self):
+        # show next part, and wrap around: scanner can start anywhere
+        while 1:
+            await uasyncio.sleep_ms(BBQR_FRAME_MS)
+            self.idx = (self.idx + 1) % len(self.addrs)
+            self.qr_data = None
+            self.redraw()
+
+    async def interact_bare(self):
+        self.redraw()
+        if len(self.addrs) > 1:
+            self.animator = uasyncio.create_task(self.animate())
+
+        try:
+            await ux_wait_keyup('xy')
+        finally:
+            if self.animator:
+                self.animator.cancel()
+                self.animator = None
+
 # EOF
@@ -2,8 +2,8 @@
 #
 # See also: <https://github.com/micropython/micropython-lib/blob/master/LICENSE>
 #
-from ucollections import deque
 from uasyncio.core import sleep_ms
+from uasyncio.event import Event
 
 
 class QueueEmpty(BaseException):
@@ -17,56 +17,75 @@ class QueueFull(BaseException):
 class Queue:
     """A queue, useful for coordinating producer and consumer coroutines.
 
-    If maxsize is less than or equal to zero, the queue size is infinite. If it
-    is an integer greater than 0, then "yield from put()" will block when the
-    queue reaches maxsize, until an item is removed by get().
+    Fixed-capacity ring buffer: nothing is allocated after construction, and
+    get() sleeps until something is put, rather than polling. If maxsize is
+    less than or equal to zero, a default capacity is used. When full,
+    "await put()" will block until an item is removed by get().
 
     Unlike the standard library Queue, you can reliably know this Queue's size
     with qsize(), since your single-threaded uasyncio application won't be
     interrupted between calling qsize() and doing an operation on the Queue.
     """
     _attempt_delay = 10         # milliseconds
+    _default_size = 64
 
     def __init__(self, maxsize=0):
         self.maxsize = maxsize
-        self._queue = deque((), 20)
+        self._size = maxsize if maxsize > 0 else self._default_size
+        self._ring = [None] * self._size
+        self._head = 0          # next to be removed
+        self._count = 0
+        self._ready = Event()   # set while not empty
 
     def _get(self):
-        return self._queue.popleft()
-
-    def get(self):
-        """Returns generator, which can be used for getting (and removing)
-        an item from a queue.
+        h = self._head
+        val = self._ring[h]
+        self._ring[h] = None
+        self._head = (h + 1) % self._size
+        self._count -= 1
+        if not self._count:
+            self._ready.clear()
+        return val
+
+    async def get(self):
+        """Get (and remove) an item from the queue, waiting until one is put.
 
         Usage::
 
-            item = yield from queue.get()
+            item = await queue.get()
         """
-        while not self._queue:
-            yield from sleep_ms(self._attempt_delay)
+        while not self._count:
+            await self._ready.wait()
         return self._get()
 
+    async def wait(self):
+        """Wait until there is an item in the queue, but don't remove it."""
+        while not self._count:
+            await self._ready.wait()
+
     def get_nowait(self):
         """Remove and return an item from the queue.
 
         Return an item if one is immediately available, else raise QueueEmpty.
         """
-        if not self._queue:
+        if not self._count:
             raise QueueEmpty()
         return self._get()
 
     def _put(self, val):
-        self._queue.append(val)
+        self._ring[(self._head + self._count) % self._size] = val
+        self._count += 1
+        self._ready.set()
 
-    def put(self, val):
-        """Returns generator which can be used for putting item in a queue.
+    async def put(self, val):
+        """Put an item in the queue, waiting while it is full.
 
         Usage::
 
-            yield from queue.put(item)
+            await queue.put(item)
         """
-        while self.qsize() >= self.maxsize and self.maxsize:
-            yield from sleep_ms(self._attempt_delay)
+        while self._count >= self._size:
+            await sleep_ms(self._attempt_delay)
         self._put(val)
 
     def put_nowait(self, val):
@@ -74,25 +93,18 @@ class Queue:
 
         If no free slot is immediately available, raise QueueFull.
         """
-        if self.qsize() >= self.maxsize and self.maxsize:
+        if self._count >= self._size:
             raise QueueFull()
         self._put(val)
 
     def qsize(self):
         """Number of items in the queue."""
-        return len(self._queue)
+        return self._count
 
     def empty(self):
         """Return True if the queue is empty, False otherwise."""
-        return not self._queue
+        return not self._count
 
     def full(self):
-        """Return True if there are maxsize items in the queue.
-
-        Note: if the Queue was initialized with maxsize=0 (the default),
-        then full() is never True.
-        """
-        if self.maxsize <= 0:
-            return False
-        else:
-            return self.qsize() >= self.maxsize
+        """Return True if there is no space for another item."""
+        return self._count >= self._size
@@ -19,7 +19,6 @@ from ux import PressRelease, ux_input_numbers, ux_input_text, show_qr_code
 from actions import goto_top_menu
 from stash import SecretStash
 from ubinascii import hexlify as b2a_hex
-from pwsave import PassphraseSaver, PassphraseSaverMenu
 from glob import settings, dis
 from pincodes import pa
 from nvstore import SettingsObject
@@ -31,7 +30,39 @@ VALID_LENGTHS = (24, 18, 12)
 
 # bit flag that means "also include bare prefix as a valid word"
 _PREFIX_MARKER = const(1<<26)
-    
+_IS_NODE = const(0x8000)
+
+def next_char(sofar):
+    # same as bip39.next_char(), but walks prefix table in flash rather than wordlist
+    # - returns (is exact word, string of next letters, the word if only one matches)
+    # - see misc/bip39_index.py for table layout
+    from ustruct import unpack_from
+    from bip39_index import NODES, KIDS
+
+    mask, base = unpack_from('<IH', NODES, 0)
+    for n, ch in enumerate(sofar):
+        bit = ord(ch) - 97
+        if not (0 <= bit < 26) or not (mask & (1 << bit)):
+            return False, '', None
+
+        # kids are in letter order, so count the letters before this one
+        rank = bin(mask & ((1 << bit) - 1)).count('1')
+        kid, = unpack_from('<H', KIDS, 2*(base + rank))
+
+        if not (kid & _IS_NODE):
+            # only one word left
+            word = bip39.wordlist_en[kid]
+            if word[n+1:len(sofar)] != sofar[n+1:]:
+                return False, '', None
+            rest = word[len(sofar):]
+            return (not rest), rest[0:1], word
+
+        mask, base = unpack_from('<IH', NODES, 6*(kid & ~_IS_NODE))
+
+    nexts = ''.join(chr(97+i) for i in range(26) if mask & (1 << i))
+
+    return bool(mask & _PREFIX_MARKER), nexts, None
+
 def letter_choices(sofar='', depth=0, thres=5):
     # make a list of word completions based on indicated prefix
     if not sofar:
@@ -40,7 +71,7 @@ def letter_choices(sofar='', depth=0, thres=5):
         # - and q- which is really qu-, because English.
         return [('%s-' % chr(97+i)) if i != 16 else 'qu-'  for i in range(26) if i != 23]
 
-    exact, nexts, matched = bip39.next_char(sofar)
+    exact, nexts, matched = next_char(sofar)
     #print("[%d] %s => x=%r n=%r m=%r" % (depth, sofar, exact, nexts, matched))
 
     if not nexts:
@@ -65,7 +96,7 @@ def letter_choices(sofar='', depth=0, thres=5):
     if len(sofar) >= 2:
         for n, w in enumerate(rv):
             if w[-1] != '-': continue
-            exact, nexts, matched = bip39.next_char(w[:-1])
+            exact, nexts, matched = next_char(w[:-1])
             if matched:
                 rv[n] = matched
 
@@ -795,7 +826,7 @@ async def word_quiz(words, limited=None, title='Word %d is?'):
     return
 
 async def make_seed_vault_menu(*a):
-    rv = SeedVaultMenu.construct()
+    rv = SeedVaultMenu.cached_construct()
     return SeedVaultMenu(rv)
 
 class SeedVaultMenu(MenuSystem):
@@ -1005,11 +1036,15 @@ class SeedVaultMenu(MenuSystem):
 
         return rv
 
+    @classmethod
+    def data_version(cls):
+        # seeds list lives in (master) settings; tmp seed changes reload settings
+        return (SettingsObject.version, bool(pa.tmp_value))
+
     def update_contents(self):
         # Reconstruct the list of wallets on this dynamic menu, because
         # we added or changed them and are showing that same menu again.
-        tmp = self.construct()
-        self.replace_items(tmp)
+        self.rebuild()
 
 class EphemeralSeedMenu(MenuSystem):
 
@@ -1109,6 +1144,7 @@ class PassphraseMenu(MenuSystem):
                 with CardSlot() as card:
                     # check if passphrases file exists on SD
                     # if yes add menu item
+                    from pwsave import PassphraseSaver
                     if card.exists(PassphraseSaver.filename(card)):
                         items.insert(0, MenuItem('Restore Saved', menu=self.restore_saved))
 
@@ -1118,9 +1154,11 @@ class PassphraseMenu(MenuSystem):
 
     @staticmethod
     async def restore_saved(*a):
+        from pwsave import PassphraseSaverMenu
+
         dis.fullscreen("Decrypting...")
         try:
-            items = PassphraseSaverMenu.construct()
+            items = PassphraseSaverMenu.cached_construct()
         except CardMissingError:
             await needs_microsd()
             return
@@ -1266,6 +1304,7 @@ class PassphraseMenu(MenuSystem):
                                  meta="BIP-39 Passphrase on [%s]" % parent_xfp_str)
         if ch == '1':
             try:
+                from pwsave import PassphraseSaver
                 await PassphraseSaver().append(xfp, pp_sofar)
             except CardMissingError:
                 await needs_microsd()
@@ -244,25 +244,25 @@ async def test_microsd():
 
 
 async def start_selftest():
+    # in order; on failure, can retry from failed step, rather than starting over
+    steps = [ test_oled, test_psram, test_nfc, test_microsd, test_numpad,
+                test_secure_element, test_sd_active, test_usb_light ]
+    # add more tests here
+
+    n = 0
+    while n < len(steps):
+        try:
+            await steps[n]()
+            n += 1
+        except (RuntimeError, AssertionError) as e:
+            e = str(e) or problem_file_line(e)
+            ch = await ux_show_story("Test failed:\n" + str(e)
+                                + "\n\nPress (1) to retry that test, or OK to stop.",
+                                'FAIL', escape='1')
+            if ch != '1':
+                return
+
+    settings.set('tested', True)
+    await ux_show_story("Selftest complete", 'PASS')
 
-    try:
-        await test_oled()
-        await test_psram()
-        await test_nfc()
-        await test_microsd()
-        await test_numpad()
-        await test_secure_element()
-        await test_sd_active()
-        await test_usb_light()
-
-        # add more tests here
-
-        settings.set('tested', True)
-        await ux_show_story("Selftest complete", 'PASS')
-
-    except (RuntimeError, AssertionError) as e:
-        e = str(e) or problem_file_line(e)
-        await ux_show_story("Test failed:\n" + str(e), 'FAIL')
-        
-    
 # EOF
@@ -74,11 +74,7 @@ def ser_string(s):
     return ser_compact_size(len(s)) + s
 
 def deser_uint256(f):
-    r = 0
-    for i in range(8):
-        t = struct.unpack("<I", f.read(4))[0]
-        r += t << (i * 32)
-    return r
+    return int.from_bytes(f.read(32), 'little')
 
 
 def ser_uint256(u):
@@ -331,6 +327,14 @@ class CTxIn(object):
         self.scriptSig = deser_string(f)
         self.nSequence = struct.unpack("<I", f.read(4))[0]
 
+    def deserialize_at(self, buf, pos, script_pos, script_len):
+        # same as deserialize(), but from a buffer where offsets are
+        # already known (see ckcc.txn_vector_scan)
+        self.prevout = COutPoint(int.from_bytes(buf[pos:pos+32], 'little'),
+                                    struct.unpack_from("<I", buf, pos+32)[0])
+        self.scriptSig = bytes(buf[script_pos:script_pos+script_len])
+        self.nSequence = struct.unpack_from("<I", buf, script_pos+script_len)[0]
+
     def serialize(self):
         r = self.prevout.serialize()
         r += ser_string(self.scriptSig)
@@ -352,6 +356,11 @@ class CTxOut(object):
         self.nValue = struct.unpack("<q", f.read(8))[0]
         self.scriptPubKey = deser_string(f)
 
+    def deserialize_at(self, buf, pos, script_pos, script_len):
+        # same as deserialize(), but offsets already known (see ckcc.txn_vector_scan)
+        self.nValue = struct.unpack_from("<q", buf, pos)[0]
+        self.scriptPubKey = bytes(buf[script_pos:script_pos+script_len])
+
     def serialize(self):
         r = struct.pack("<q", self.nValue)
         r += ser_string(self.scriptPubKey)
@@ -9,7 +9,12 @@
 # - the offset is the file name
 # - (<Mk3) last 64k of memory reserved for settings
 #
+import ckcc
 from uhashlib import sha256
+from micropython import const
+
+# hash hardware on Mk4; others import it from here
+sha256 = getattr(ckcc, 'sha256', sha256)
 
 
 # Use PSRAM chip
@@ -20,6 +25,9 @@ PADOUT = lambda n: n
 def ALIGN4(n):
      return n & ~0x3
 
+# writes are combined into blocks of this size before going into PSRAM
+WR_BUF_SIZE = const(2048)
+
 class SFFile:
     def __init__(self, start, length=0, max_size=None, message=None, pre_erased=False):
         if not pre_erased:
@@ -28,7 +36,8 @@ class SFFile:
         self.pos = 0
         self.length = length        # byte-wise length
         self.message = message
-        self.runt = False
+        self.wbuf = None
+        self.wlen = 0
 
         if max_size != None:
             # Write
@@ -36,8 +45,9 @@ class SFFile:
             self.readonly = False
             self.checksum = sha256()
 
-            # up to 3 bytes that haven't been written-out yet
-            self.runt = bytearray()
+            # bytes that haven't been written-out yet; PSRAM up to _pos is done
+            self.wbuf = bytearray(WR_BUF_SIZE)
+            self.wlen = 0
             self._pos = 0
         else:
             # Read
@@ -93,41 +103,71 @@ class SFFile:
         return False
 
     def close(self):
-        # PSRAM might leave a little behind
-        if self.runt:
-            # write final runt, might be up to 3 bytes (padding w/ zeros)
-            assert len(self.runt) <= 3      # , 'rl=%d'%len(self.runt)
-            assert self._pos + len(self.runt) == self.pos
-            self.runt.extend(bytes(4-len(self.runt)))
-            PSRAM.write(self.start + self._pos, self.runt)
+        # write out what's buffered, and final runt padded w/ zeros
+        if self.wlen:
+            assert self._pos + self.wlen == self.length
+            n = (self.wlen + 3) & ~0x3
+            for i in range(self.wlen, n):
+                self.wbuf[i] = 0
+            PSRAM.write(self.start + self._pos, memoryview(self.wbuf)[0:n])
+
+            self.wlen = 0
+            self._pos = self.length
+
+        # further writes not possible
+        self.wbuf = None
+
+    def flush(self):
+        # write out buffer, leaving only the runt (0..3 bytes) which isn't aligned
+        here = ALIGN4(self.wlen)
+        if not here:
+            return
+
+        wb = self.wbuf
+        PSRAM.write(self.start + self._pos, memoryview(wb)[0:here])
+        self._pos += here
+
+        runt = self.wlen - here
+        for i in range(runt):
+            wb[i] = wb[here+i]
+        self.wlen = runt
 
-            self.runt = None
-            self._pos = self.pos
+        if self.message:
+            from glob import dis
+            dis.progress_sofar(self.pos, self.length)
 
     def write(self, b):
-        # immediate write, no buffering
+        # buffered write: PSRAM is memory-mapped, but can only do word-aligned writes
         assert not self.readonly
         assert self.pos == self.length              # "can only append"
         assert self.pos + len(b) <= self.max_size   # "past end"
 
-        left = len(b)
+        if isinstance(b, str):
+            b = b.encode()
 
-        # Mk4: memory-mapped, but can only do word-aligned writes
+        left = len(b)
         self.checksum.update(b)
 
-        self.runt.extend(b)
-        here = ALIGN4(len(self.runt))
-        if here:
-            PSRAM.write(self.start + self._pos, self.runt[0:here])
-            self._pos += here
-            self.runt = self.runt[here:]
-
         self.pos += left
         self.length = self.pos
 
-        if self.message:
-            from glob import dis
-            dis.progress_sofar(self.pos, self.length)
+        wb = self.wbuf
+        src = memoryview(b)
+        while len(src):
+            if not self.wlen and len(src) >= WR_BUF_SIZE:
+                # big and we're aligned: skip the buffer
+                here = ALIGN4(len(src))
+                PSRAM.write(self.start + self._pos, src[0:here])
+                self._pos += here
+            else:
+                here = min(len(src), WR_BUF_SIZE - self.wlen)
+                wb[self.wlen:self.wlen+here] = src[0:here]
+                self.wlen += here
+
+                if self.wlen == WR_BUF_SIZE:
+                    self.flush()
+
+            src = src[here:]
 
         return left
 
@@ -143,21 +183,39 @@ class SFFile:
             # at EOF
             return b''
 
-        rv = bytearray(ll)
-        PSRAM.read(self.start + self.pos, rv)
+        if self.wlen:
+            # reading back what we are writing
+            self.flush()
+
+        # many callers expect return to be bytes and have those methods, like "find"
+        # - single copy, directly from memory-mapped PSRAM
+        rv = bytes(PSRAM.read_view(self.start + self.pos, ll))
 
         self.pos += ll
 
-        # altho tempting to return a bytearray (which we already have) many
-        # callers expect return to be bytes and have those methods, like "find"
-        return bytes(rv)
+        return rv
+
+    def view(self, pos, ll):
+        # zero-copy read of a range of the file: memoryview into PSRAM
+        # - contents only valid until area is re-used, so don't keep it around
+        # - read-only by convention; file position is not changed
+        assert self.readonly
+        assert 0 <= pos and pos + ll <= self.length
+
+        return PSRAM.read_view(self.start + pos, ll)
 
     def readinto(self, b):
-        # limitation: this will read past end of file, but not tell the caller
+        # copy once into caller's buffer, and never past end of file
         actual = min(self.length - self.pos, len(b))
         if actual <= 0:
             return 0
 
+        if self.wlen:
+            self.flush()
+
+        if actual < len(b):
+            b = memoryview(b)[0:actual]
+
         PSRAM.read(self.start + self.pos, b)
 
         self.pos += actual
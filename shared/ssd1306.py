@@ -26,6 +26,9 @@ SET_PRECHARGE       = const(0xd9)
 SET_VCOM_DESEL      = const(0xdb)
 SET_CHARGE_PUMP     = const(0x8d)
 
+# granularity of partial updates, in columns
+COL_STEP            = const(8)
+
 # Subclassing FrameBuffer provides support for graphics primitives
 # http://docs.micropython.org/en/latest/pyboard/library/framebuf.html
 class SSD1306(framebuf.FrameBuffer):
@@ -40,6 +43,9 @@ class SSD1306(framebuf.FrameBuffer):
         self.buffer = bytearray(1024)
         assert len(self.buffer) == self.pages * self.width
 
+        # copy of what the OLED has now, or None if not known
+        self.shown = None
+
         super().__init__(self.buffer, self.width, self.height, framebuf.MONO_VLSB)
         self.init_display()
 
@@ -84,19 +90,46 @@ class SSD1306(framebuf.FrameBuffer):
         self.write_cmd(SET_NORM_INV | (invert & 1))
 
     def show(self):
+        # Send only the pages which changed since last time, and within those,
+        # only the span of columns which changed.
         x0 = 0
-        x1 = self.width - 1
         if self.width == 64:
             # displays with width of 64 pixels are shifted by 32
             x0 += 32
-            x1 += 32
-        self.write_cmd(SET_COL_ADDR)
-        self.write_cmd(x0)
-        self.write_cmd(x1)
-        self.write_cmd(SET_PAGE_ADDR)
-        self.write_cmd(0)
-        self.write_cmd(self.pages - 1)
-        self.write_data(self.buffer)
+
+        w = self.width
+        buf = memoryview(self.buffer)
+
+        if self.shown is None:
+            self.set_window(x0, x0 + w - 1, 0, self.pages - 1)
+            self.write_data(buf)
+            self.shown = bytearray(self.buffer)
+            return
+
+        shown = memoryview(self.shown)
+        for pg in range(self.pages):
+            st = pg * w
+            end = st + w
+            if buf[st:end] == shown[st:end]:
+                continue
+
+            while buf[st:st+COL_STEP] == shown[st:st+COL_STEP]:
+                st += COL_STEP
+            while buf[end-COL_STEP:end] == shown[end-COL_STEP:end]:
+                end -= COL_STEP
+
+            col = x0 + st - (pg * w)
+            self.set_window(col, col + (end - st) - 1, pg, pg)
+            self.write_data(buf[st:end])
+            shown[st:end] = buf[st:end]
+
+    def forget(self):
+        # OLED contents changed behind our back; next show() will send everything
+        self.shown = None
+
+    def set_window(self, x0, x1, pg0, pg1):
+        # where following data goes: columns x0..x1 and pages pg0..pg1, inclusive
+        self.write_cmds(bytes([SET_COL_ADDR, x0, x1, SET_PAGE_ADDR, pg0, pg1]))
 
 SPI_RATE = const(40000000)        # max chip can do, still slower than display limit tho
 
@@ -128,6 +161,18 @@ class SSD1306_SPI(SSD1306):
             print("SPI[cmd]: %r" % self.spi)
         self.cs(1)
 
+    def write_cmds(self, cmds):
+        # several command bytes, one SPI setup and one transfer
+        self.spi.init(baudrate=SPI_RATE, polarity=0, phase=0)
+        self.cs(1)
+        self.dc(0)
+        self.cs(0)
+        try:
+            self.spi.write(cmds)
+        except:
+            print("SPI[cmds]: %r" % self.spi)
+        self.cs(1)
+
     def write_data(self, buf):
         self.spi.init(baudrate=SPI_RATE, polarity=0, phase=0)
         self.cs(1)
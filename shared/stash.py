@@ -12,6 +12,7 @@
 #
 import ngu, uctypes, gc, bip39, utime
 from uhashlib import sha256
+from ucollections import OrderedDict
 from utils import swab32, call_later_ms, B2A
 
 
@@ -81,10 +82,11 @@ class SecretStash:
         return nv
 
     @staticmethod
-    def decode(secret, _bip39pw=''):
+    def decode(secret, _bip39pw='', _ms=None):
         # expecting 72-bytes of secret payload; decode contents into objects
         # returns:
         #    type, secrets bytes, HDNode(root)
+        # - _ms: already-stretched BIP-39 master secret for these words+passphrase, if known
         #
         marker = secret[0]
 
@@ -111,7 +113,7 @@ class SecretStash:
             seed_bits = secret[1:1+ll]
 
             # slow: 2+ seconds
-            ms = bip39.master_secret(bip39.b2a_words(seed_bits), _bip39pw)
+            ms = _ms or SecretStash.stretch(secret, _bip39pw)
 
             hd.from_master(ms)
 
@@ -131,6 +133,13 @@ class SecretStash:
 
             return 'master', ms, hd
 
+    @staticmethod
+    def stretch(secret, _bip39pw=''):
+        # BIP-39 key stretching (PBKDF2), for a words-type secret
+        ll = ((secret[0] & 0x3) + 2) * 8
+
+        return bip39.master_secret(bip39.b2a_words(secret[1:1+ll]), _bip39pw)
+
     @staticmethod
     def storage_serialize(secret):
         # make it a JSON-compatible field
@@ -163,6 +172,12 @@ bip39_passphrase = False
 CACHE_CHECK_RATE = const(10*1000)   # 10 seconds
 CACHE_MAX_LIFE = const(60*1000)     # one minute
 
+# max number of parent nodes kept by SensitiveValues.derive_path
+DERIVE_CACHE_SIZE = const(8)
+
+# max number of public-only nodes kept by SensitiveValues.public_node
+PUBLIC_CACHE_SIZE = const(16)
+
 class SensitiveValues:
     # be a context manager, and holder of secrets in-memory
 
@@ -170,8 +185,15 @@ class SensitiveValues:
     _cache_secret = None
     _cache_used = None
 
+    # BIP-39 stretched master secret for cached secret: (sha256(secret+passphrase), ms)
+    _cache_stretched = None
+
+    # public-only nodes: (master xpub, chain, hardened path) => HDNode, in LRU order
+    _pub_nodes = OrderedDict()
+
     def __init__(self, secret=None, bip39pw='', bypass_tmp=False):
         self.spots = []
+        self._prefixes = None
 
         self._bip39pw = bip39pw
 
@@ -197,8 +219,9 @@ class SensitiveValues:
                 # slow: read from secure element(s)
                 self.secret = pa.fetch(bypass_tmp=bypass_tmp)
 
-            # slow: do bip39 key stretching (typically)
-            self.mode, self.raw, self.node = SecretStash.decode(self.secret, self._bip39pw)
+            # slow: do bip39 key stretching (typically), unless cached
+            ms = self.stretched() if not bypass_tmp else None
+            self.mode, self.raw, self.node = SecretStash.decode(self.secret, self._bip39pw, ms)
 
             if not bypass_tmp:
                 # DO NOT save to cache if we are bypassing tmp
@@ -215,14 +238,48 @@ class SensitiveValues:
         self.chain = chains.current_chain()
 
     @classmethod
-    def clear_cache(cls):
+    def clear_cache(cls, keep_public=False):
         # clear cached secrets we have
         # - call any time, certainly when main secret changes
         # - will be called after 2 minutes of idle keypad
+        # - public nodes are kept for whole login session, unless seed changes
         blank_object(cls._cache_secret)
         cls._cache_secret = None
         cls._cache_used = None
 
+        if cls._cache_stretched:
+            blank_object(cls._cache_stretched[1])
+            cls._cache_stretched = None
+
+        if not keep_public:
+            cls._pub_nodes.clear()
+
+            # saved passphrases are cached under a key from the old seed
+            import sys
+            pws = sys.modules.get('pwsave')
+            if pws:
+                pws.PassphraseSaver.forget()
+
+    def stretched(self):
+        # BIP-39 stretched seed for our secret and passphrase; kept with
+        # the cached secret, so wiped along with it
+        if not (self.secret[0] & 0x80):
+            return None
+
+        key = ngu.hash.sha256s(bytes(self.secret) + self._bip39pw.encode())
+
+        c = SensitiveValues._cache_stretched
+        if c and c[0] == key:
+            return c[1]
+
+        if c:
+            blank_object(c[1])
+
+        ms = bytearray(SecretStash.stretch(self.secret, self._bip39pw))
+        SensitiveValues._cache_stretched = (key, ms)
+
+        return ms
+
     def save_to_cache(self):
         # add to cache, must copy here to avoid wipe
         if not self._cache_secret:
@@ -261,7 +318,7 @@ class SensitiveValues:
 
         if dt >= CACHE_MAX_LIFE:
             # clear cached secrets after 1 minute if unused
-            cls.clear_cache()
+            cls.clear_cache(keep_public=True)
         else:
             # keep waiting
             call_later_ms(CACHE_CHECK_RATE, cls.cache_check)
@@ -286,6 +343,7 @@ class SensitiveValues:
 
         # just in case this holds some pointers?
         del self.spots
+        self._prefixes = None
 
         # .. and some GC will help too!
         gc.collect()
@@ -317,6 +375,47 @@ class SensitiveValues:
             nw = len_to_numwords(len(self.raw))
         settings.put('words', nw)
 
+    @classmethod
+    def public_node(cls, path):
+        # Public-only node (as if from an xpub) for a string path, no secrets inside.
+        # - hardened prefix of path is derived once per seed/chain and cached,
+        #   so repeated exports and USB xpub requests don't need the secret
+        # - remainder of path is non-hardened, so derived publicly
+        # - result is a copy, caller can modify it
+        from glob import settings
+        import chains
+
+        path = path.replace('h', "'")
+        if "'" in path:
+            hard, soft = path.rsplit("'", 1)
+            hard += "'"
+        else:
+            hard, soft = 'm', path
+
+        chain = chains.current_chain()
+        key = (settings.get('xpub'), chain.ctype, hard)
+
+        rv = cls._pub_nodes.pop(key, None)
+        if rv is None:
+            with cls() as sv:
+                xpub = chain.serialize_public(sv.derive_path(hard))
+
+            rv = ngu.hdnode.HDNode()
+            rv.deserialize(xpub)
+
+        if key[0]:
+            # (re)insert as most-recently used; drop least-recent if full
+            while len(cls._pub_nodes) >= PUBLIC_CACHE_SIZE:
+                cls._pub_nodes.pop(next(iter(cls._pub_nodes)))
+            cls._pub_nodes[key] = rv
+
+        rv = rv.copy()
+        for i in soft.split('/'):
+            if i and i != 'm':
+                rv.derive(int(i), False)
+
+        return rv
+
     def register(self, item):
         # Caller can add his own sensitive (derived?) data to our wiper
         # typically would be byte arrays or byte strings, but also
@@ -325,11 +424,9 @@ class SensitiveValues:
 
     def derive_path(self, path, master=None, register=True):
         # Given a string path, derive the related subkey
-        rv = (master or self.node).copy()
-
-        if register:
-            self.register(rv)
-
+        # - parent nodes (path less last component) are kept in a
+        #   cache, since most callers walk many siblings, like m/84h/0h/0h/{0,1}/*
+        parts = []
         for i in path.split('/'):
             if i == 'm': continue
             if not i: continue      # trailing or duplicated slashes
@@ -343,10 +440,44 @@ class SensitiveValues:
                 is_hard = False
 
             assert 0 <= here < 0x80000000
+            parts.append((here, is_hard))
+
+        if master or not parts:
+            rv = (master or self.node).copy()
+        else:
+            rv = self.derive_prefix(tuple(parts[:-1])).copy()
+            parts = parts[-1:]
+
+        if register:
+            self.register(rv)
+
+        for here, is_hard in parts:
             rv.derive(here, is_hard)
 
         return rv
 
+    def derive_prefix(self, prefix):
+        # Return (cached) node for a parent path, as tuple of (index, is_hard).
+        # - do not modify the result; make copy
+        # - cached nodes are wiped when we exit, like everything else
+        if self._prefixes is None:
+            self._prefixes = {}
+
+        rv = self._prefixes.get(prefix)
+        if rv is None:
+            if len(self._prefixes) >= DERIVE_CACHE_SIZE:
+                # unusual, but don't grow w/o limit; node is wiped later
+                self._prefixes.clear()
+
+            rv = self.node.copy()
+            self.register(rv)
+            for here, is_hard in prefix:
+                rv.derive(here, is_hard)
+
+            self._prefixes[prefix] = rv
+
+        return rv
+
     def duress_root(self):
         # Return a bip32 node for the duress wallet linked to this wallet.
         # 0x80000000 - 0xCC10 = 2147431408
@@ -11,7 +11,6 @@ import uctypes, errno, ngu, sys, stash, bip39
 from menu import MenuSystem, MenuItem
 from ux import ux_show_story, ux_confirm, ux_dramatic_pause, ux_enter_number, the_ux, ux_aborted
 from stash import SecretStash
-from drv_entro import bip85_derive
 
 # see from mk4-bootloader/se2.h
 NUM_TRICKS      = const(14)
@@ -72,6 +71,7 @@ def construct_duress_secret(flags, tc_arg):
         # derive the secret via BIP-85
         nwords = 24 if (tc_arg//1000 == 1) else 12
         mmode = 0 if (nwords == 12) else 2          # weak: based on menu design
+        from drv_entro import bip85_derive
         new_secret, _, _, path = bip85_derive(mmode, tc_arg)
         path = "BIP85(words=%d, index=%d)" % (nwords, tc_arg)
 
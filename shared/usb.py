@@ -4,13 +4,16 @@
 #
 import ckcc, pyb, callgate, sys, ux, ngu, stash, aes256ctr
 from uasyncio import sleep_ms, core
-from uhashlib import sha256
+from sffile import sha256
 from public_constants import MAX_MSG_LEN, MAX_BLK_LEN, AFC_SCRIPT
 from public_constants import STXN_FLAGS_MASK
 from ustruct import pack, unpack_from
+from utime import ticks_us, ticks_diff
+from array import array
 from ckcc import watchpoint, is_simulator
 from utils import problem_file_line, call_later_ms
 from version import is_devmode, MAX_TXN_LEN, MAX_UPLOAD_LEN
+from prof import USB_RX
 from exceptions import FramingError, CCBusyError, HSMDenied, HSMCMDDisabled
 
 # Unofficial, unpermissioned... numbers
@@ -43,21 +46,48 @@ hid_descp = bytes([
             0xc0,              # END_COLLECTION
         ])
 
+# Windowed upload ('upwn'): we only reply to every Nth chunk, so host can keep
+# that many in flight.
+UPLOAD_WINDOW = const(8)
+
+# keyboard emulation: host polls us this often (ms); pyb.hid_keyboard uses 8
+# - each character typed takes two reports (key down, all up)
+KBD_POLL_MS = const(2)
+
+# handler returns this when no reply should be sent at all
+NO_REPLY = object()
+
 # Only these whitelisted USB commands are allowed once we enter HSM mode.
 # NOTE: 'robo' here would allow firmware changes during HSM mode!
 HSM_WHITELIST = frozenset({
     'logo', 'ping', 'vers',     # harmless/boring
     'upld', 'sha2', 'dwld', 'stxn',     # up/download/sign PSBT needed
+    'upwn',                     # pipelined upload
+    'have',                     # skip upload if file already here
+    'bach',                     # batch: each sub command checked too
     'mitm', 'ncry',             # maybe limited by policy tho
     'smsg',                     # limited by policy
-    'blkc', 'hsts',             # report status values
+    'blkc', 'hsts', 'stat',     # report status values
     'stok', 'smok',             # completion check: sign txn or msg
+    'ntfy',                     # completion notification
     'xpub', 'msck',             # quick status checks
     'p2sh', 'show',             # limited by HSM policy
     'user',                     # auth HSM user, other user cmds not allowed
     'gslr',                     # read storage locker; hsm mode only, limited usage
 })
 
+# Protocol counters, see 'stat' command: index into USBHandler.stats
+ST_RX_PKTS = const(0)
+ST_RX_BYTES = const(1)
+ST_TX_PKTS = const(2)
+ST_TX_BYTES = const(3)
+ST_CRYPT_US = const(4)          # time in decrypt_inplace/encrypt_packet
+ST_NUM = const(5)
+ST_NAMES = ('rx_pkts', 'rx_bytes', 'tx_pkts', 'tx_bytes', 'crypt_us')
+
+# per-command timings kept, at most (fuzzing could make many)
+MAX_CMD_STATS = const(32)
+
 # HSM related commands that are not allowed if 'hsmcmd' is disabled.
 HSM_DISABLE_CMDS = frozenset({
     "user",
@@ -76,7 +106,10 @@ def enable_keyboard_emulation():
         enable_usb()
     else:
         # real device
-        pyb.usb_mode('VCP+HID', hid=pyb.hid_keyboard)
+        # same as pyb.hid_keyboard, except polling interval: (subclass, protocol,
+        # max packet length, polling interval, report descriptor)
+        hid_info = pyb.hid_keyboard[0:3] + (KBD_POLL_MS, pyb.hid_keyboard[4])
+        pyb.usb_mode('VCP+HID', hid=hid_info)
         global handler
         if not handler:
             handler = USBHandler()
@@ -100,6 +133,16 @@ def enable_usb():
     if "USB" not in IMPT.tasks:
         IMPT.start_task('USB', handler.usb_hid_recv())
 
+def notify_action_done():
+    # A UserAuthorizedAction has completed: tell host, if they asked for that.
+    # - never while a request is being read, handled or answered, since host
+    #   would take it as the reply; usb_hid_recv sends it after, in that case
+    if handler and handler.notify:
+        handler.notify_pending = True
+        if not handler.in_request:
+            from uasyncio import create_task
+            create_task(handler.send_notify())
+
 def disable_usb():
     from imptask import IMPT
 
@@ -125,6 +168,22 @@ class USBHandler:
         # - reset at offset zero, can be read back anytime
         self.file_checksum = sha256()
         self.is_fw_upgrade = False
+        self.fw_hash = None
+
+        # next sequence number expected for windowed upload, or -1 if not started
+        self.upload_seq = -1
+
+        # opt-in: push 'done' when user authorized action completes (see 'ntfy')
+        self.notify = False
+        self.notify_encrypted = False
+        self.notify_pending = False
+        self.tx_busy = False
+
+        # true from first packet of a request, until its reply is sent
+        self.in_request = False
+
+        # counters for 'stat' command; nothing secret in here
+        self.reset_stats()
 
         # handle simulator
         self.blockable = getattr(self.dev, 'pipe', self.dev)
@@ -132,6 +191,10 @@ class USBHandler:
         self.msg = bytearray(2048+12)
         assert len(self.msg) == MAX_MSG_LEN
 
+        # each HID report is read into here, never a new object
+        self.rx_buf = bytearray(64)
+        self.rx_view = memoryview(self.rx_buf)
+
         self.encrypted_req = False
 
         # not bound to a specific crypto setup by default
@@ -142,17 +205,21 @@ class USBHandler:
         self.decrypt = None
 
     def get_packet(self):
-        # read next packet (64 bytes) waiting on the wire. Unframe it and return
-        # active part of packet, flags associated.
-        buf = self.dev.recv(64, timeout=5000)
+        # read next packet (64 bytes) waiting on the wire, into self.rx_buf. Unframe
+        # it and return length of active part of packet (starts at rx_buf[1]), flags.
+        # - recv into existing buffer: nothing allocated per packet
+        buf = self.rx_buf
+        got = self.dev.recv(buf, timeout=5000)
         ckcc.usb_active()
 
-        if not buf:
+        if not got:
             raise FramingError('timeout')
-        elif len(buf) < 64:
+
+        self.stats[ST_RX_PKTS] += 1
+        self.stats[ST_RX_BYTES] += got
+
+        if got < 64:
             raise FramingError('short')
-        elif len(buf) > 64:
-            raise FramingError('long')
 
         # first byte gives us the actual size, status
         # all illegal combos here may become special messages someday
@@ -161,7 +228,7 @@ class USBHandler:
         len_here = int(flag & 0x3f)
         is_encrypted = bool(flag & 0x40)
 
-        return buf[1:1+len_here], is_last, is_encrypted
+        return len_here, is_last, is_encrypted
 
     async def usb_hid_recv(self):
         # blocks and builds up a full-length command packet in memory
@@ -172,15 +239,15 @@ class USBHandler:
             yield core._io_queue.queue_read(self.blockable)
 
             try:
-                here, is_last, is_encrypted = self.get_packet()
+                lh, is_last, is_encrypted = self.get_packet()
 
-                #print('Rx[%d]' % len(here))
-                if here:
-                    lh = len(here)
+                #print('Rx[%d]' % lh)
+                if lh:
+                    self.in_request = True
                     if msg_len+lh > MAX_MSG_LEN:
                         raise FramingError('xlong')
 
-                    self.msg[msg_len:msg_len + lh] = here
+                    self.msg[msg_len:msg_len + lh] = self.rx_view[1:1+lh]
                     msg_len += lh
                 else:
                     # treat zero-length packets as a reset request
@@ -208,51 +275,24 @@ class USBHandler:
                     self.encrypted_req = False
 
                 # process request
-                try:
-                    # this saves memory over a simple slice (confirmed)
-                    args = memoryview(self.msg)[4:msg_len]
-                    resp = await self.handle(self.msg[0:4], args)
-                    msg_len = 0
-                except CCBusyError:
-                    # auth UX is doing something else
-                    resp = b'busy'
-                    msg_len = 0
-                except HSMDenied:
-                    resp = b'err_Not allowed in HSM mode'
-                    msg_len = 0
-                except HSMCMDDisabled:
-                    # do NOT change below error msg as other applications depend on it
-                    resp = b'err_HSM commands disabled'
-                    msg_len = 0
-                except (ValueError, AssertionError) as exc:
-                    # some limited invalid args feedback
-                    #print("USB request caused assert: ", end='')
-                    #sys.print_exception(exc)
-                    msg = str(exc)
-                    if not msg:
-                        msg = 'Assertion ' + problem_file_line(exc)
-                    resp = b'err_' + msg.encode()[0:80]
-                    msg_len = 0
-                except MemoryError:
-                    # prefer to catch at higher layers, but sometimes can't
-                    resp = b'err_Out of RAM'
-                    msg_len = 0
-                except FramingError as exc:
-                    raise exc
-                except Exception as exc:
-                    # catch bugs and fuzzing too
-                    if is_simulator() or is_devmode:
-                        print("USB request caused this: ", end='')
-                        sys.print_exception(exc)
-                    resp = b'err_Confused ' + problem_file_line(exc)
-                    msg_len = 0
+                # - this saves memory over a simple slice (confirmed)
+                args = memoryview(self.msg)[4:msg_len]
+                cmd = bytes(self.msg[0:4])
+                started = ticks_us()
+                resp = await self.dispatch(cmd, args)
+                self.cmd_timing(cmd, ticks_diff(ticks_us(), started))
+                msg_len = 0
 
-                # aways send a reply if they get this far
-                await self.send_response(resp)
+                # aways send a reply if they get this far, unless handler
+                # specifically doesn't want one
+                if resp is not NO_REPLY:
+                    await self.send_response(resp)
 
             except FramingError as exc:
                 reason = exc.args[0]
                 # print("Framing: %s" % reason)
+                fe = self.framing_stats
+                fe[reason] = fe.get(reason, 0) + 1
                 await self.framing_error(reason)
                 msg_len = 0
 
@@ -262,28 +302,94 @@ class USBHandler:
                 #sys.print_exception(exc)
                 msg_len = 0
 
-    def decrypt_inplace(self, msg_len):
-        # self.msg is encrypted. decode it in place
-        # - seems dangerous to use memview here, but works
-        # - some memory alloc still happens here tho
-        self.msg[0:msg_len] = self.decrypt(memoryview(self.msg)[0:msg_len])
-
-    def encrypt_response(self, msg):
-        # encrypt what we'll send to desktop
-
-        return self.encrypt(msg)
+            finally:
+                if not msg_len:
+                    # between requests: deferred 'done' can go now
+                    self.in_request = False
+                    if self.notify_pending:
+                        await self.send_notify()
 
-    async def send_response(self, resp):
-        # send a python object as the response
-        # - we know how to encode a few things, or send binary
-        # - sadly we cannot stream here because we cannot subclass streams
-        # - cannot reuse rx buffer either!
+    async def dispatch(self, cmd, args):
+        # handle one command, and map most errors into a response for it
+        try:
+            return await self.handle(cmd, args)
+        except CCBusyError:
+            # auth UX is doing something else
+            return b'busy'
+        except HSMDenied:
+            return b'err_Not allowed in HSM mode'
+        except HSMCMDDisabled:
+            # do NOT change below error msg as other applications depend on it
+            return b'err_HSM commands disabled'
+        except (ValueError, AssertionError) as exc:
+            # some limited invalid args feedback
+            #print("USB request caused assert: ", end='')
+            #sys.print_exception(exc)
+            msg = str(exc)
+            if not msg:
+                msg = 'Assertion ' + problem_file_line(exc)
+            return b'err_' + msg.encode()[0:80]
+        except MemoryError:
+            # prefer to catch at higher layers, but sometimes can't
+            return b'err_Out of RAM'
+        except FramingError as exc:
+            raise exc
+        except Exception as exc:
+            # catch bugs and fuzzing too
+            if is_simulator() or is_devmode:
+                print("USB request caused this: ", end='')
+                sys.print_exception(exc)
+            return b'err_Confused ' + problem_file_line(exc)
 
+    def decrypt_inplace(self, msg_len):
+        # self.msg is encrypted. decode it in place, no allocation
+        started = ticks_us()
+        self.decrypt(memoryview(self.msg)[0:msg_len])
+        self.stats[ST_CRYPT_US] += ticks_diff(ticks_us(), started)
+
+    def encrypt_packet(self, pkt):
+        # encrypt (in place) part of what we'll send to desktop
+        # - CTR mode, so can be done packet by packet, in order
+        started = ticks_us()
+        self.encrypt(pkt)
+        self.stats[ST_CRYPT_US] += ticks_diff(ticks_us(), started)
+
+    def reset_stats(self):
+        self.stats = array('L', (0 for _ in range(ST_NUM)))
+        self.framing_stats = {}         # reason => count
+        self.cmd_stats = {}             # cmd => [count, total_us, max_us]
+
+    def cmd_timing(self, cmd, us):
+        # track how long each command took to handle (not including response)
+        cs = self.cmd_stats
+        here = cs.get(cmd)
+        if here is None:
+            if len(cs) >= MAX_CMD_STATS:
+                return
+            here = cs[cmd] = [0, 0, 0]
+
+        here[0] += 1
+        here[1] += us
+        if us > here[2]:
+            here[2] = us
+
+    def stats_report(self):
+        # everything as a (JSON-able) dict
+        rv = dict(zip(ST_NAMES, self.stats))
+        rv['framing'] = self.framing_stats
+        rv['cmds'] = {k.decode(): v for k,v in self.cmd_stats.items()}
+        return rv
+
+    def response_parts(self, resp):
+        # encode a response into a tuple of buffers for sending
         # handle simple types here
 
         if isinstance(resp, (bytes, bytearray)):
             # preformated
             assert len(resp) >= 4
+        elif isinstance(resp, tuple):
+            # parts, typically: (header, body)
+            return resp
         elif resp is None:
             resp = b'okay'
         elif isinstance(resp, int):
@@ -292,35 +398,86 @@ class USBHandler:
             #print("Unknown resp: " + repr(resp))
             raise NotImplementedError()
 
-        assert len(resp) >= 4
+        return (resp, )
+
+    async def send_notify(self):
+        # unsolicited 'done' frame: no command ever replies with that code,
+        # so host can tell it apart if it crosses with a request on the wire
+        if self.notify_pending and not self.in_request:
+            self.notify_pending = False
+            await self.send_response(b'done', self.notify_encrypted)
+
+    async def send_response(self, resp, encrypted=None):
+        # send a python object as the response
+        # - encrypted (if link is setup) when request was, unless told otherwise
+        # - only one response at a time on the wire; rare, but 'done' notification
+        #   can happen while a reply is still being sent
+        while self.tx_busy:
+            await sleep_ms(5)
+
+        self.tx_busy = True
+        try:
+            await self.send_packets(resp,
+                        self.encrypted_req if encrypted is None else encrypted)
+        finally:
+            self.tx_busy = False
+
+    async def send_packets(self, resp, encrypted):
+        # - we know how to encode a few things, or send binary
+        # - tuple of buffers is sent as if concatenated, but without doing that,
+        #   so can stream from memoryview into PSRAM, for example
+        # - cannot reuse rx buffer!
+
+        parts = self.response_parts(resp)
+        left = sum(len(p) for p in parts)
+
+        assert left >= 4
 
         msg = bytearray(64)
+        body = memoryview(msg)[1:]
 
-        if self.encrypt and self.encrypted_req:
-            resp = self.encrypt_response(resp)
+        if self.encrypt and encrypted:
+            encrypt = True
             final_flag = 0x80 | 0x40
         else:
+            encrypt = False
             final_flag = 0x80
 
-        pos = 0
-        left = len(resp)
+        part_idx = 0
+        pos = 0             # within current part
         while left:
             # sent up to 63 bytes per packet
             here = min(left, 63)
             msg[0] = here
-            msg[1:1+here] = resp[pos:pos+here]
+
+            # fill packet, maybe from more than one part
+            fill = 0
+            while fill < here:
+                part = parts[part_idx]
+                ln = min(here - fill, len(part) - pos)
+                body[fill:fill+ln] = part[pos:pos+ln]
+                fill += ln
+                pos += ln
+                if pos == len(part):
+                    part_idx += 1
+                    pos = 0
+
+            if encrypt:
+                self.encrypt_packet(body[0:here])
             if here == left:
                 # no more to come
                 assert 0 <= here < 64
                 msg[0] |= final_flag
 
             left -= here
-            pos += here
 
             ckcc.usb_active()
             for retries in range(100):
                 chk = self.dev.send(msg)
-                if chk == 64: break
+                if chk == 64:
+                    self.stats[ST_TX_PKTS] += 1
+                    self.stats[ST_TX_BYTES] += 64
+                    break
 
                 # Host may not have read previous value yet, so might need
                 # to wait for it. Data loss possible here, but also the
@@ -387,7 +544,21 @@ class USBHandler:
             offset, total_size = unpack_from('<II', args)
             data = memoryview(args)[4+4:]
 
-            return await self.handle_upload(offset, total_size, data)
+            ckcc.prof_start(USB_RX)
+            try:
+                return await self.handle_upload(offset, total_size, data)
+            finally:
+                ckcc.prof_stop(USB_RX)
+
+        if cmd == 'bach':
+            # several commands in one message
+            return await self.handle_batch(args)
+
+        if cmd == 'upwn':
+            seq, offset, total_size = unpack_from('<III', args)
+            data = memoryview(args)[4+4+4:]
+
+            return await self.handle_windowed_upload(seq, offset, total_size, data)
 
         if cmd == 'dwld':
             offset, length, fileno = unpack_from('<III', args)
@@ -413,6 +584,11 @@ class USBHandler:
         if cmd == 'sha2':
             return b'biny' + self.file_checksum.digest()
 
+        if cmd == 'have':
+            # host offers hash of file it would upload; 1 if we have it already
+            file_len, file_sha = unpack_from('<I32s', args)
+            return int(self.handle_have(file_len, file_sha))
+
         if cmd == 'xpub':
             assert self.encrypted_req, 'must encrypt'
             return self.handle_xpub(args)
@@ -432,6 +608,18 @@ class USBHandler:
             sign_msg(msg, subpath, addr_fmt)
             return None
 
+        if cmd == 'smbt':
+            # sign batch of messages: uploaded text file, one per line
+            batch_len, batch_sha = unpack_from('<I32s', args)
+            if batch_sha != self.file_checksum.digest():
+                return b'err_Checksum'
+
+            assert 2 <= batch_len <= MAX_TXN_LEN, "badlen"
+
+            from auth import sign_msg_batch
+            sign_msg_batch(batch_len)
+            return None
+
         if cmd == 'p2sh':
             # show P2SH (probably multisig) address on screen (also provides it back)
             # - must provide redeem script, and list of [xfp+path]
@@ -506,6 +694,14 @@ class USBHandler:
             sign_transaction(txn_len, (flags & STXN_FLAGS_MASK), txn_sha)
             return None
 
+        if cmd == 'ntfy':
+            # Subscribe (or not) to unsolicited 'done' message when whatever needed
+            # user approval is ready; then use the usual stok/smok/... to get result.
+            enable, = unpack_from('<I', args)
+            self.notify = bool(enable)
+            self.notify_encrypted = self.encrypted_req
+            return None
+
         if cmd == 'stok' or cmd == 'bkok' or cmd == 'smok' or cmd == 'pwok':
             # Have we finished (whatever) the transaction,
             # which needed user approval? If so, provide result.
@@ -591,6 +787,14 @@ class USBHandler:
 
             return None
 
+        if cmd == 'stat':
+            # protocol counters and timings, optionally reset after reading
+            import ujson
+            rv = b'asci' + ujson.dumps(self.stats_report())
+            if len(args) >= 4 and unpack_from('<I', args)[0]:
+                self.reset_stats()
+            return rv
+
         if cmd == 'hsts':
             # can always query HSM mode
             from hsm import hsm_status_report
@@ -672,9 +876,10 @@ class USBHandler:
 
         # Would be nice to have nonce in addition to the counter, but
         # harder on the desktop side.
+        # - both used in-place, on our rx buffer or each tx packet
         ctr = aes256ctr.new(self.session_key)
-        self.encrypt = ctr.cipher
-        self.decrypt = ctr.copy().cipher
+        self.encrypt = ctr.cipher_into
+        self.decrypt = ctr.copy().cipher_into
 
         from glob import settings
         xfp = settings.get('xfp', 0)
@@ -716,29 +921,52 @@ class USBHandler:
         if offset == 0:
             self.file_checksum = sha256()
 
-        resp = bytearray(4 + length)
-        resp[0:4] = b'biny'
-        buf = memoryview(resp)[4:]
-
         pos = (MAX_TXN_LEN * file_number) + offset
 
+        # no copy: reply is streamed straight out of PSRAM
         from glob import PSRAM
-        PSRAM.read(pos, buf)
+        buf = PSRAM.read_view(pos, length)
 
         self.file_checksum.update(buf)
 
-        return resp
+        return (b'biny', buf)
+
+    def handle_have(self, file_len, file_sha):
+        # Content-addressed staging: if start of PSRAM still holds exactly that file
+        # (ie. same PSBT sent again after a timeout), it becomes the current upload,
+        # and host can go straight to stxn. Otherwise nothing changes.
+        from glob import PSRAM, hsm_active
+
+        if not (1 <= file_len <= MAX_TXN_LEN):
+            return False
+
+        buf = PSRAM.read_view(0, file_len)
+        if hsm_active and bytes(buf[0:5]) != b'psbt\xff':
+            return False
+
+        chk = sha256(buf)
+        if chk.digest() != file_sha:
+            return False
+
+        self.file_checksum = chk
+        self.is_fw_upgrade = False
+        self.fw_hash = None
+
+        return True
 
     async def handle_upload(self, offset, total_size, data):
         from glob import PSRAM
         from glob import dis, hsm_active
-        from utils import check_firmware_hdr
-        from sigheader import FW_HEADER_OFFSET, FW_HEADER_SIZE, FW_HEADER_MAGIC
+        from utils import check_firmware_hdr, check_firmware_sig
+        from sigheader import FW_HEADER_OFFSET, FW_HEADER_SIZE, FW_HEADER_MAGIC, FW_MIN_LENGTH
 
         # maintain a running SHA256 over what's received
+        # - and another over what would be firmware, hashed the way bootloader does
         if offset == 0:
             self.file_checksum = sha256()
             self.is_fw_upgrade = False
+            self.fw_hash = sha256() if total_size >= FW_MIN_LENGTH else None
+            self.fw_hash_pos = 0
 
         assert offset % 256 == 0, 'alignment'
         assert offset+len(data) <= total_size <= MAX_UPLOAD_LEN, 'long'
@@ -772,6 +1000,20 @@ class USBHandler:
                     if prob:
                         raise ValueError(prob)
                     self.is_fw_upgrade = bytes(hdr)
+                else:
+                    self.fw_hash = None
+
+            if self.fw_hash and not is_trailer:
+                if pos != self.fw_hash_pos:
+                    # out of order or repeated: can't know, leave it to bootloader
+                    self.fw_hash = None
+                elif pos == (FW_HEADER_OFFSET & ~255):
+                    # signature itself (end of header) is not covered
+                    self.fw_hash.update(here[:-64])
+                    self.fw_hash_pos += len(here)
+                else:
+                    self.fw_hash.update(here)
+                    self.fw_hash_pos += len(here)
 
             if is_trailer and self.is_fw_upgrade:
                 # expect the trailer to exactly match the original one
@@ -779,6 +1021,14 @@ class USBHandler:
                 hdr = memoryview(here)[-128:]
                 assert hdr == self.is_fw_upgrade        # indicates hacking
 
+                # fail now, rather than after user approves and we reboot
+                if self.fw_hash and self.fw_hash_pos == pos:
+                    fw_digest = sha256(self.fw_hash.digest()).digest()
+                    self.fw_hash = None
+                    prob = check_firmware_sig(self.is_fw_upgrade, fw_digest)
+                    if prob:
+                        raise ValueError(prob)
+
                 # but don't write it, instead offer user a chance to abort
                 from auth import authorize_upgrade
                 authorize_upgrade(self.is_fw_upgrade, pos, psram_offset=0)
@@ -796,6 +1046,72 @@ class USBHandler:
 
         return offset
 
+    async def handle_batch(self, args):
+        # Envelope for several commands: each is u16 length, then cmd+args as usual.
+        # - each is handled exactly as if sent by itself, incl. HSM rules and errors
+        # - reply has each response, in order, also prefixed by u16 length
+        # - cannot be nested, and any no-reply commands (upwn) reply 'okay' here
+        rv = [b'bach']
+        pos = 0
+        while pos < len(args):
+            ln, = unpack_from('<H', args, pos)
+            pos += 2
+            assert 4 <= ln <= len(args) - pos, 'badlen'
+
+            cmd = args[pos:pos+4]
+            assert bytes(cmd) != b'bach', 'nested'
+
+            try:
+                resp = await self.dispatch(cmd, args[pos+4:pos+ln])
+            except FramingError as exc:
+                # only this sub-command failed; same reply as if sent by itself
+                reason = exc.args[0]
+                fe = self.framing_stats
+                fe[reason] = fe.get(reason, 0) + 1
+                resp = b'fram' + reason.encode()
+            pos += ln
+
+            if resp is NO_REPLY:
+                resp = None
+
+            resp = b''.join(self.response_parts(resp))
+            rv.append(pack('<H', len(resp)))
+            rv.append(resp)
+
+        return b''.join(rv)
+
+    async def handle_windowed_upload(self, seq, offset, total_size, data):
+        # Same as upld, but host numbers the chunks (0, 1, 2...) and does not wait
+        # for a reply to each one before sending the next.
+        # - we ack every UPLOAD_WINDOW chunks: int2 = (seq, bytes so far); cumulative
+        # - last chunk gets sha256 over whole file instead, same as sha2 command
+        # - errors are reported right away, and following chunks fail as well,
+        #   until host restarts from offset zero
+        if offset == 0:
+            self.upload_seq = 0
+
+        if seq != self.upload_seq:
+            self.upload_seq = -1
+            raise ValueError('seq')
+
+        self.upload_seq = -1
+        ckcc.prof_start(USB_RX)
+        try:
+            await self.handle_upload(offset, total_size, data)
+        finally:
+            ckcc.prof_stop(USB_RX)
+        self.upload_seq = seq + 1
+
+        sofar = offset + len(data)
+
+        if sofar >= total_size:
+            return b'biny' + self.file_checksum.digest()
+
+        if (seq % UPLOAD_WINDOW) == (UPLOAD_WINDOW - 1):
+            return pack('<4sII', 'int2', seq, sofar)
+
+        return NO_REPLY
+
     def handle_xpub(self, subpath):
         # Share the xpub for the indicated subpath. Expects
         # a text string which is the path derivation.
@@ -813,12 +1129,11 @@ class USBHandler:
 
         chain = current_chain()
 
-        with stash.SensitiveValues() as sv:
-            node = sv.derive_path(subpath)
-
-            xpub = chain.serialize_public(node)
+        # public-only, and usually cached already
+        node = stash.SensitiveValues.public_node(subpath)
+        xpub = chain.serialize_public(node)
 
-            return b'asci' + xpub.encode()
+        return b'asci' + xpub.encode()
 
     def handle_bag_number(self, bag_num):
         import version, callgate
@@ -953,32 +1268,26 @@ class EmulatedKeyboard:
             # Keyboard Enter
             "\r": 0x28,
         }
-        buf = bytearray(8)
-        pwd_len = len(keystroke_string)
-        dis.fullscreen('Typing...')
-
-        for i, ch in enumerate(keystroke_string, start=1):
-            cap = False
+        # all reports up front: key down (maybe shifted), then all keys up
+        up = bytes(8)
+        reports = []
+        for ch in keystroke_string:
             if ch in char_map:
-                to_press = char_map[ch]
+                reports.append(bytes([0, 0, char_map[ch], 0, 0, 0, 0, 0]))
             else:
-                cap = True
-                to_press = char_map[ch.lower()]
-
-            buf[2] = to_press
-            if cap:
                 # set LEFT SHIFT for capital letters
-                buf[0] = 0x02  
-
-            while self.dev.send(buf) == 0:
-                await sleep_ms(5)
+                reports.append(bytes([0x02, 0, char_map[ch.lower()], 0, 0, 0, 0, 0]))
+            reports.append(up)
 
-            # all keys up
-            buf[2] = 0x00
-            buf[0] = 0x00
+        dis.fullscreen('Typing...')
 
-            while self.dev.send(buf) == 0:
-                await sleep_ms(5)
+        num = len(reports)
+        for i, rpt in enumerate(reports, start=1):
+            # send() gives zero until host has taken the previous report
+            while self.dev.send(rpt) == 0:
+                await sleep_ms(1)
 
-            dis.progress_bar_show(i/pwd_len)
+            if (i % 16 == 0) or (i == num):
+                # screen updates are slower than typing now
+                dis.progress_bar_show(i/num)
 # EOF 
@@ -24,6 +24,16 @@ def do_usb_command(cmd, args):
         return
 
     try:
+        if cmd == 'MEMS':
+            # heap checkpoints, see memstats.py
+            import memstats
+            return b'biny' + repr(memstats.report()).encode()
+
+        if cmd == 'PROF':
+            # phase timers, see prof.py
+            import prof
+            return b'biny' + prof.report().encode()
+
         if cmd == 'EVAL':
             return b'biny' + repr(eval(str(args, 'utf8'))).encode()
 
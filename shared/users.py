@@ -52,10 +52,13 @@ def calc_hmac_key(text_password):
     # Calculate a 32-byte key based on user's text password, PBKDF2_ITER_COUNT,
     # and device serial number as salt.
     # - before v4, this was pbkdf2_sha256
-    import version
+    import version, ckcc
 
     salt = ngu.hash.sha256s(b'pepper' + version.serial_number().encode())
-    pw = ngu.hash.pbkdf2_sha512(text_password, salt, PBKDF2_ITER_COUNT)
+
+    # Mk4: same result, but faster C version; see pbkdf2_sha512.c
+    kdf = getattr(ckcc, 'pbkdf2_sha512', ngu.hash.pbkdf2_sha512)
+    pw = kdf(text_password, salt, PBKDF2_ITER_COUNT)
 
     return pw[0:32]
 
@@ -80,6 +83,9 @@ UserInfo = namedtuple('UserInfo', 'auth_mode secret last_counter')
 class Users:
     '''Track users and thier TOTP secrets or hashed passwords'''    
 
+    # base32 text of secret => decoded bytes; see auth_okay()
+    _decoded = {}
+
     @classmethod
     def get(cls):
         rv = settings.get(KEY)
@@ -187,6 +193,29 @@ class Users:
 
         return b, picked
 
+    @classmethod
+    def decoded_secret(cls, text):
+        # keyed by the stored text, so never stale if a user is re-created
+        rv = cls._decoded.get(text)
+        if rv is None:
+            if len(cls._decoded) >= MAX_NUMBER_USERS:
+                cls._decoded.clear()
+            rv = cls._decoded[text] = b32decode(text)
+        return rv
+
+    @classmethod
+    def auth_all(cls, pending, psbt_hash=None):
+        # check all of {username: (token, counter)} at once
+        # - returns (list of good usernames, None) or (None, (username, problem)) on first failure
+        rv = []
+        for u, (token, counter) in pending.items():
+            problem = cls.auth_okay(u, token, totp_time=counter, psbt_hash=psbt_hash)
+            if problem:
+                return None, (u, problem)
+            rv.append(u)
+
+        return rv, None
+
     @classmethod
     def auth_okay(cls, username, token, totp_time=None, psbt_hash=None):
         # check a password/totp
@@ -199,7 +228,7 @@ class Users:
             return 'unknown user'
 
         auth_mode, secret, last_counter = u
-        secret = b32decode(secret)
+        secret = cls.decoded_secret(secret)
 
         if auth_mode == USER_AUTH_HMAC:
             expect = hmac_sha256(secret, psbt_hash or bytes(32))
@@ -34,6 +34,25 @@ class imported:
         # recovery that tasty memory.
         gc.collect()
 
+def lazy_import(modname, fname):
+    # Async function for menu items of rarely used features: imports module
+    # only when first called, so not at boot, then calls fname from it.
+    async def doit(*a, **kw):
+        return await getattr(__import__(modname), fname)(*a, **kw)
+    return doit
+
+# where HSM policy is saved; here so we can check for it without importing hsm.py
+HSM_POLICY_FNAME = '/flash/hsm-policy.json'
+
+def hsm_policy_available():
+    # Is there an HSM policy ready to go? Offer the menu item then.
+    import uos
+    try:
+        uos.stat(HSM_POLICY_FNAME)
+        return True
+    except:
+        return False
+
 # class min_dramatic_pause:
 #     # insure that something takes at least N ms
 #     def __init__(self, min_time):
@@ -136,31 +155,40 @@ class HexWriter:
 
 class Base64Writer:
     # Emulate a file/stream but convert binary to Base64 as they write
+    # - PSBT serializer does many tiny writes: collect them, and encode in big pieces
+    CHUNK = 3*1024
+
     def __init__(self, fd):
         self.fd = fd
-        self.runt = b''
+        self.runt = bytearray()
 
     def __enter__(self):
         self.fd.__enter__()
         return self
 
     def __exit__(self, *a, **k):
+        self.flush(3)
         if self.runt:
             self.fd.write(b2a_base64(self.runt))
         self.fd.write(b'\r\n')
         return self.fd.__exit__(*a, **k)
 
+    def flush(self, min_len):
+        # encode as much as we can, in multiples of 3 bytes
+        here = len(self.runt) - (len(self.runt) % 3)
+        if here < min_len:
+            return
+
+        tmp = b2a_base64(self.runt[0:here])
+        # library puts in newlines!?
+        assert tmp[-1:] == b'\n', tmp
+        assert tmp[-2:-1] != b'=', tmp
+        self.fd.write(tmp[:-1])
+        self.runt = self.runt[here:]
+
     def write(self, buf):
-        if self.runt:
-            buf = self.runt + buf
-        rl = len(buf) % 3
-        self.runt = buf[-rl:] if rl else b''
-        if rl < len(buf):
-            tmp = b2a_base64(buf[:(-rl if rl else None)])
-            # library puts in newlines!?
-            assert tmp[-1:] == b'\n', tmp
-            assert tmp[-2:-1] != b'=', tmp
-            self.fd.write(tmp[:-1])
+        self.runt.extend(buf)
+        self.flush(self.CHUNK)
 
 def swab32(n):
     # endian swap: 32 bits
@@ -326,18 +354,15 @@ class DecodeStreamer:
     def more(self, buf):
         # Generator:
         # - accumulate into mod-N groups
-        # - strip whitespace
-        for ch in buf:
-            if chr(ch).isspace(): continue
-            self.runt.append(ch)
-            if len(self.runt) == 128*self.mod:
-                yield self.a2b(self.runt)
-                self.runt = bytearray()
+        # - strip whitespace: split/join is native code, much faster than per-char here
+        self.runt.extend(b''.join(bytes(buf).split()))
 
         here = len(self.runt) - (len(self.runt) % self.mod)
-        if here:
-            yield self.a2b(self.runt[0:here])
-            self.runt = self.runt[here:]
+        step = 1024 * self.mod
+        for pos in range(0, here, step):
+            yield self.a2b(self.runt[pos:min(pos+step, here)])
+
+        self.runt = self.runt[here:]
 
 class HexStreamer(DecodeStreamer):
     # be a generator that converts hex digits into binary
@@ -399,6 +424,54 @@ def check_firmware_hdr(hdr, binary_size):
     return None
 
 
+# Firmware signing pubkeys, compressed; same order as approved_pubkeys[] in
+# stm32/mk4-bootloader/firmware-keys.h
+FW_PUBKEYS = (
+    b'02b4cb4126f7e16cf38ff2b4711dfb23010d76d666a78aa36c9b53f9f67b581805',
+    b'03d6a2c81d1c815edfa60c296db8578f8d5e296992ced178c17b20d7317ba196b5',
+    b'0242ef660156c4cf95f4b5f038641126c59939c166320612144c259c68358cd3ba',
+    b'0267605456820cecc51dbc820816c139eff5bfba327cce5fe3741e62d7e9fcc54c',
+    b'0343b1cf37d27c891f5bfeacf3ba33fc9581d9e7dd2595ef14ddef97bb33f3d8a7',
+    b'02d05cdc761630dd30c280f156265ca861d74f6969e5b8573d35e22a58ddce9ac6',
+)
+
+def check_firmware_sig(hdr, fw_digest):
+    # Check signature in header against double-sha256 of firmware (sig itself skipped).
+    # Return text of error msg if any.
+    # - early warning only: bootloader repeats this over the PSRAM copy before install
+    from sigheader import FWH_PY_FORMAT
+    from ustruct import unpack_from
+
+    pubkey_num = unpack_from(FWH_PY_FORMAT, hdr)[3]
+    sig = bytes(hdr[-64:])
+
+    if pubkey_num >= len(FW_PUBKEYS):
+        return "Unknown signing key."
+
+    want = a2b_hex(FW_PUBKEYS[pubkey_num])
+    for rec_id in range(4):
+        try:
+            got = ngu.secp256k1.signature(bytes([31 + rec_id]) + sig).verify_recover(fw_digest)
+        except ValueError:
+            continue
+        if got.to_bytes() == want:
+            return None
+
+    return "Firmware signature is not valid."
+
+def firmware_digest_more(h, pos, data, fw_len):
+    # Feed part of a firmware image (found at pos) into sha256 h, same as bootloader
+    # does: signature at end of header is skipped, and nothing past fw_len.
+    from sigheader import FW_HEADER_OFFSET, FW_HEADER_SIZE
+
+    sig_at = FW_HEADER_OFFSET + FW_HEADER_SIZE - 64
+    end = min(pos + len(data), fw_len)
+
+    for a, b in ((pos, min(end, sig_at)), (max(pos, sig_at + 64), end)):
+        if a < b:
+            h.update(data[a-pos:b-pos])
+
+
 def clean_shutdown(style=0):
     # wipe SPI flash and shutdown (wiping main memory)
     # - mk4: SPI flash not used, but NFC may hold data (PSRAM cleared by bootrom)
@@ -141,6 +141,10 @@ class PressRelease:
                     if so_far >= rep_delay:
                         self.num_repeats += 1
                         return self.last_key
+                else:
+                    # nothing held down, so no repeat to time: sleep until next event
+                    await numpad.wait()
+                    continue
 
                 await sleep_ms(1)
                 so_far += 1
@@ -173,99 +177,161 @@ class PressRelease:
 # (using FontSmall)
 CH_PER_W = const(17)
 
-async def ux_show_story(msg, title=None, escape=None, sensitive=False,
-                        strict_escape=False, scrollbar=True):
-    # show a big long string, and wait for XY to continue
-    # - returns character used to get out (X or Y)
-    # - can accept other chars to 'escape' as well.
+class StoryLines:
+    # Word-wrapped lines of a story, made only as far as the user has scrolled.
     # - accepts a stream or string
-    from glob import dis, numpad
-    from display import FontLarge
-
-    lines = []
-    if title:
-        # kinda weak rendering but it works.
-        lines.append('\x01' + title)
-
-    if hasattr(msg, 'readline'):
-        msg.seek(0)
-        for ln in msg:
+    # - adds title (special marker) at top, and 'EOT' once end is known
+
+    def __init__(self, msg, title=None):
+        self.lines = []
+        self.offsets = []       # of source text, for each line made so far
+        if title:
+            # kinda weak rendering but it works.
+            self.lines.append('\x01' + title)
+            self.offsets.append(0)
+
+        self.msg = msg
+        self.pos = 0
+        self.done = False
+
+        if hasattr(msg, 'readline'):
+            self.size = msg.seek(0, 2)
+            msg.seek(0)
+        else:
+            self.size = len(msg)
+
+    def next_line(self):
+        # next line of source text, or None at the end
+        msg = self.msg
+        if hasattr(msg, 'readline'):
+            ln = msg.readline()
+            if not ln:
+                return None
+            self.pos += len(ln)
             if ln[-1] == '\n': 
                 ln = ln[:-1]
-
-            if len(ln) > CH_PER_W:
+        else:
+            if self.pos > self.size:
+                return None
+            nl = msg.find('\n', self.pos)
+            if nl < 0:
+                nl = self.size
+            ln = msg[self.pos:nl]
+            self.pos = nl + 1
+
+        return ln
+
+    def need(self, count):
+        # make sure we have at least count lines, unless there are no more
+        lines = self.lines
+        while len(lines) < count and not self.done:
+            here = self.pos
+            ln = self.next_line()
+
+            if ln is None:
+                self.finish()
+            elif len(ln) > CH_PER_W:
+                was = len(lines)
                 lines.extend(word_wrap(ln, CH_PER_W))
+                self.offsets.extend([here] * (len(lines) - was))
             else:
                 # ok if empty string, just a blank line
                 lines.append(ln)
+                self.offsets.append(here)
+
+    def finish(self):
+        # trim blank lines at end, add our own marker
+        lines = self.lines
+        while lines and not lines[-1]:
+            lines.pop()
+            self.offsets.pop()
 
+        lines.append('EOT')
+        self.offsets.append(self.size)
+        self.done = True
+        self.close()
+
+    def close(self):
         # no longer needed & rude to our caller, but let's save the memory
-        msg.close()
-        del msg
-        gc.collect()
-    else:
-        for ln in msg.split('\n'):
-            if len(ln) > CH_PER_W:
-                lines.extend(word_wrap(ln, CH_PER_W))
-            else:
-                # ok if empty string, just a blank line
-                lines.append(ln)
+        if self.msg is not None:
+            if hasattr(self.msg, 'close'):
+                self.msg.close()
+            self.msg = None
+            gc.collect()
+
+    def fraction(self, top):
+        # how far down we are, for scroll bar
+        if self.done:
+            return top / len(self.lines)
 
-    # trim blank lines at end, add our own marker
-    while not lines[-1]:
-        lines = lines[:-1]
+        return self.offsets[top] / max(1, self.size)
 
-    lines.append('EOT')
+async def ux_show_story(msg, title=None, escape=None, sensitive=False,
+                        strict_escape=False, scrollbar=True):
+    # show a big long string, and wait for XY to continue
+    # - returns character used to get out (X or Y)
+    # - can accept other chars to 'escape' as well.
+    # - accepts a stream or string
+    # - text is wrapped as needed, so first screen is quick even for huge stories
+    from glob import dis, numpad
+    from display import FontLarge
+
+    story = StoryLines(msg, title)
+    del msg
+    lines = story.lines
 
     top = 0
     H = 5
     ch = None
     pr = PressRelease()
-    while 1:
-        # redraw
-        dis.clear()
-
-        y=0
-        for ln in lines[top:top+H]:
-            if ln == 'EOT':
-                dis.hline(y+3)
-            elif ln and ln[0] == '\x01':
-                dis.text(0, y, ln[1:], FontLarge)
-                y += 21
-            else:
-                dis.text(0, y, ln)
+    try:
+        while 1:
+            # redraw: wrap enough for this screen and next page
+            story.need(top + (3 * H))
+            dis.clear()
+
+            y=0
+            for ln in lines[top:top+H]:
+                if ln == 'EOT':
+                    dis.hline(y+3)
+                elif ln and ln[0] == '\x01':
+                    dis.text(0, y, ln[1:], FontLarge)
+                    y += 21
+                else:
+                    dis.text(0, y, ln)
 
-                if sensitive and len(ln) > 3 and ln[2] == ':':
-                    dis.mark_sensitive(y, y+13)
+                    if sensitive and len(ln) > 3 and ln[2] == ':':
+                        dis.mark_sensitive(y, y+13)
 
-                y += 13
+                    y += 13
 
-        if scrollbar:
-            # help in cases when last char in a row hidden by scroll bar
-            dis.scroll_bar(top / len(lines))
+            if scrollbar:
+                # help in cases when last char in a row hidden by scroll bar
+                dis.scroll_bar(story.fraction(top))
 
-        dis.show()
+            dis.show()
 
-        # wait to do something
-        ch = await pr.wait()
-        if escape and (ch == escape or ch in escape):
-            # allow another way out for some usages
-            return ch
-        elif ch in 'xy':
-            if not strict_escape:
+            # wait to do something
+            ch = await pr.wait()
+            if escape and (ch == escape or ch in escape):
+                # allow another way out for some usages
                 return ch
-        elif ch == '0':
-            top = 0
-        elif ch == '7':     # page up
-            top = max(0, top-H)
-        elif ch == '9':     # page dn
-            top = min(len(lines)-2, top+H)
-        elif ch == '5':     # scroll up
-            top = max(0, top-1)
-        elif ch == '8':     # scroll dn
-            top = min(len(lines)-2, top+1)
-
-        
+            elif ch in 'xy':
+                if not strict_escape:
+                    return ch
+            elif ch == '0':
+                top = 0
+            elif ch == '7':     # page up
+                top = max(0, top-H)
+            elif ch == '9':     # page dn
+                top = min(len(lines)-2, top+H)
+            elif ch == '5':     # scroll up
+                top = max(0, top-1)
+            elif ch == '8':     # scroll dn
+                top = min(len(lines)-2, top+1)
+    finally:
+        story.close()
+
 
 async def idle_logout():
     import glob
@@ -373,6 +439,12 @@ async def show_qr_code(data, is_alnum, msg=None):
     o = QRDisplaySingle([data], is_alnum, sidebar=msg)
     await o.interact_bare()
 
+async def show_bbqr_codes(raw, file_type):
+    # binary data, too big for a single QR: show as animated BBQr
+    from qrs import QRDisplayAnimated, BBQrParts
+    o = QRDisplayAnimated(BBQrParts(raw, file_type))
+    await o.interact_bare()
+
 async def ux_enter_bip32_index(prompt, can_cancel=False, unlimited=False):
     if unlimited:
         max_value = (2 ** 31) - 1  # we handle hardened
@@ -20,13 +20,24 @@ def _host_done_cb(_psram):
 # singleton: block device implemented on half of the PSRAM
 VBLKDEV = ckcc.PSRAM()
 
+# second LUN, read-only for host, only used in "outbox" mode (see PSRAM.split)
+OUTBOX = ckcc.PSRAM(1)
+
 class VirtDisk:
     def __init__(self):
         # Feature is enabled, altho USB might be off.
         glob.VD = self
 
         self.ignore = set()
+
+        # results written to separate read-only disk, when enabled
+        self.outbox = False
+        from glob import settings
+        if settings.get('vdout', 0):
+            self.set_outbox(True)
+
         self.contents = self.sample()
+        VBLKDEV.changes()       # reset: what we have now is the baseline
 
         assert ckcc.PSRAM
         VBLKDEV.callback(_host_done_cb)
@@ -36,8 +47,35 @@ class VirtDisk:
         # we've been disabled, stop
         VBLKDEV.set_inserted(False)
         VBLKDEV.callback(None)
+        if self.outbox:
+            self.set_outbox(False)
         glob.VD = None
 
+    def set_outbox(self, enable):
+        # Change between one disk, and inbox/outbox pair. Contents are lost.
+        # - host sees number of LUNs only at enumeration, so USB must bounce
+        from mk4 import make_psram_fs
+
+        enable = bool(enable)
+        if enable == self.outbox:
+            return
+
+        was_on = bool(pyb.usb_mode())
+        if was_on:
+            disable_usb()
+
+        VBLKDEV.set_inserted(False)
+        VBLKDEV.split(enable)
+        VBLKDEV.wipe()
+        make_psram_fs()
+        if enable:
+            OUTBOX.wipe()
+            OUTBOX.set_inserted(True)
+        VBLKDEV.set_inserted(True)
+        self.outbox = enable
+        if was_on:
+            enable_usb()
+
     def unmount(self, written_files):
         # just unmount; ignore errors
         try:
@@ -45,6 +83,20 @@ class VirtDisk:
         except:
             pass
 
+        if self.outbox:
+            try:
+                os.umount('/vdout')
+            except:
+                pass
+
+            if any(fn.startswith('/vdout/') for fn in written_files):
+                # host must re-read the outbox; inbox was never disturbed
+                OUTBOX.set_inserted(False)
+                utime.sleep_ms(MIN_QUIET_TIME)
+                OUTBOX.set_inserted(True)
+
+            return
+
         # ignore the files we write ourselves
         for fn in written_files:
             if fn.startswith('/vdisk/'):
@@ -57,6 +109,10 @@ class VirtDisk:
 
     def mount(self, readonly=False):
         # Prepare to read the filesystem. Block host. Return mount pt.
+        # - with outbox: host keeps inbox, and writes go only to the outbox
+        if self.outbox and not readonly:
+            return self.mount_outbox()
+
         for _ in range(10):
             # wait until it's been idle for a little bit
             host = VBLKDEV.get_time()
@@ -82,6 +138,22 @@ class VirtDisk:
 
             return None
 
+    def mount_outbox(self):
+        # Inbox is readable at /vdisk as usual, but we write into the outbox,
+        # which the host cannot change under us. Return mount pt.
+        try:
+            os.mount(VBLKDEV, '/vdisk', readonly=True)
+            os.mount(OUTBOX, '/vdout')
+            return '/vdout'
+        except OSError as exc:
+            sys.print_exception(exc)
+            try:
+                os.umount('/vdisk')
+            except:
+                pass
+
+            return None
+
     def sample(self):
         # Peek at the contents of the disk right now
         # - only root directory
@@ -110,6 +182,11 @@ class VirtDisk:
 
         return actual
 
+    def file_sha256(self, filename):
+        # length and SHA-256 of a file on the disk, without reading it through
+        # the filesystem: done in C using hash hardware, over clusters in place
+        return VBLKDEV.sha256(filename.split('/')[-1])
+
     def new_psbt(self, filename, sz):
         # New incoming PSBT has been detected, start to sign it.
         from auth import sign_psbt_file
@@ -128,6 +205,11 @@ class VirtDisk:
             # auto mode not enabled, so ignore changes
             return
 
+        if VBLKDEV.changes() is None:
+            # host wrote only file data, or same bytes again, but no root
+            # directory entries changed: don't bother to mount and look (see psramdisk.c)
+            return
+
         now = self.sample()
         if now == self.contents:
             # no-op change, common, ignore
@@ -177,6 +259,8 @@ class VirtDisk:
         disable_usb()
         VBLKDEV.wipe()
         make_psram_fs()
+        if self.outbox:
+            OUTBOX.wipe()
         enable_usb()
 
         await sleep_ms(50)
@@ -5,7 +5,7 @@
 # - for secret spliting on paper
 # - all combination of partial XOR seed phrases are working wallets
 #
-import stash, ngu, bip39, random
+import stash, ngu, bip39, random, ckcc
 from ux import ux_show_story, the_ux, ux_confirm, ux_dramatic_pause
 from seed import word_quiz, WordNestMenu, set_seed_value, set_ephemeral_seed
 from glob import settings
@@ -14,6 +14,9 @@ from actions import goto_top_menu
 
 def xor(*args):
     # bit-wise xor between all args
+    if hasattr(ckcc, 'seed_xor'):
+        return ckcc.seed_xor(args)[0]
+
     vlen = len(args[0])
     # all have to be same length
     assert all(len(e) == vlen for e in args)
@@ -25,6 +28,16 @@ def xor(*args):
 
     return rv
 
+def xor_words(parts):
+    # combine encoded parts, and get words of result; one call on Mk4, see seed_xor.c
+    # - returns (bytearray of secret, list of words)
+    if hasattr(ckcc, 'seed_xor'):
+        seed, nums = ckcc.seed_xor(parts)
+        return seed, [bip39.wordlist_en[n] for n in nums]
+
+    seed = xor(*parts)
+    return seed, bip39.b2a_words(seed).split(' ')
+
 async def xor_split_start(*a):
 
     ch = await ux_show_story('''\
@@ -119,23 +132,28 @@ Otherwise, press OK to continue.'''.format(n=num_parts), escape='2')
 Quiz Passed!\n
 You have confirmed the details of the new split.''')
 
-# list of seed phrases
+# list of encoded seed phrases: words are decoded once, as each part is entered
 import_xor_parts = []
 
+def forget_xor_parts():
+    for p in import_xor_parts:
+        stash.blank_object(p)
+    import_xor_parts.clear()
+
 class XORWordNestMenu(WordNestMenu):
 
     async def all_done(self, new_words):
         # So we have another part, might be done or not.
         global import_xor_parts
         assert len(new_words) == self.target_words
-        import_xor_parts.append(new_words)
+        import_xor_parts.append(bytearray(bip39.a2b_words(' '.join(new_words))))
 
         XORWordNestMenu.pop_all()
 
         num_parts = len(import_xor_parts)
-        enc_parts = [bip39.a2b_words(w) for w in import_xor_parts]
-        seed = xor(*enc_parts)
-        chk_word = bip39.b2a_words(seed).split(' ')[-1]
+        seed, words = xor_words(import_xor_parts)
+        chk_word = words[-1]
+        del words
 
         msg = "You've entered %d parts so far.\n\n" % num_parts
         if num_parts >= 2:
@@ -154,7 +172,7 @@ class XORWordNestMenu(WordNestMenu):
 
         if ch == 'x':
             # give up
-            import_xor_parts.clear()          # concern: we are contaminated w/ secrets
+            forget_xor_parts()          # concern: we are contaminated w/ secrets
             return None
         elif ch == '1':
             # do another list of words
@@ -234,8 +252,7 @@ or press (2) for 18 words XOR.''', escape="12")
 
     curr_num_words = settings.get('words', desired_num_words)
 
-    global import_xor_parts
-    import_xor_parts.clear()
+    forget_xor_parts()
 
     from pincodes import pa
 
@@ -256,8 +273,7 @@ or press (2) for 18 words XOR.''', escape="12")
         elif ch == '1':
             with stash.SensitiveValues() as sv:
                 if sv.mode == 'words':
-                    words = bip39.b2a_words(sv.raw).split(' ')
-                    import_xor_parts.append(words)
+                    import_xor_parts.append(bytearray(sv.raw))
 
     return XORWordNestMenu(num_words=desired_num_words)
 
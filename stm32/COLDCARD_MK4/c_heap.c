@@ -0,0 +1,201 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * c_heap.c - malloc/free/realloc for the C-language extensions (libngu, uqr, aes).
+ *
+ * - MicroPython core never uses malloc() and friends, only these libraries do.
+ * - allocations come from a fixed arena in .bss, sized by CKCC_C_HEAP_SIZE
+ *   (see mpconfigboard.mk), so they don't fragment the Python GC heap.
+ * - if the arena is full (or disabled with size zero), falls back to the GC heap
+ *   like before. Arena memory is not scanned by GC, so extensions must not keep
+ *   the only reference to a Python object in there; none do today.
+ * - freed blocks are wiped, since they often held key material.
+ * - usage is reported by ckcc.c_heap_stats()
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/gc.h"
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#ifndef CKCC_C_HEAP_SIZE
+# define CKCC_C_HEAP_SIZE       0
+#endif
+
+#if CKCC_C_HEAP_SIZE
+
+// Each block starts with a header; size includes the header, and is
+// always a multiple of 8. Blocks are contiguous, so walking from the start
+// of the arena visits them all. Simple first-fit: we only expect a few
+// dozen live allocations at most.
+typedef struct {
+    uint32_t    size;
+    uint32_t    in_use;
+} blk_hdr_t;
+
+#define HDR_SIZE        sizeof(blk_hdr_t)
+#define MIN_SPLIT       (HDR_SIZE + 16)
+
+static uint8_t arena[CKCC_C_HEAP_SIZE] __attribute__((aligned(8)));
+static bool arena_ready;
+
+#endif
+
+// stats, for ckcc.c_heap_stats()
+static uint32_t bytes_used, high_water, num_fallback;
+
+#if CKCC_C_HEAP_SIZE
+
+// in_arena()
+//
+    static inline bool
+in_arena(const void *ptr)
+{
+    return ((const uint8_t *)ptr >= arena) && ((const uint8_t *)ptr < arena+sizeof(arena));
+}
+
+// arena_alloc()
+//
+    static void *
+arena_alloc(size_t size)
+{
+    if(!arena_ready) {
+        blk_hdr_t *first = (blk_hdr_t *)arena;
+        first->size = sizeof(arena) & ~7;
+        first->in_use = 0;
+        arena_ready = true;
+    }
+
+    if(!size || (size > sizeof(arena))) return NULL;
+
+    uint32_t need = (size + HDR_SIZE + 7) & ~7;
+
+    for(uint8_t *p = arena; p < arena+sizeof(arena); ) {
+        blk_hdr_t *h = (blk_hdr_t *)p;
+
+        if(!h->in_use && (h->size >= need)) {
+            if(h->size - need >= MIN_SPLIT) {
+                // split off remainder as new free block
+                blk_hdr_t *rest = (blk_hdr_t *)(p + need);
+                rest->size = h->size - need;
+                rest->in_use = 0;
+                h->size = need;
+            }
+            h->in_use = 1;
+
+            bytes_used += h->size;
+            if(bytes_used > high_water) {
+                high_water = bytes_used;
+            }
+
+            return p + HDR_SIZE;
+        }
+
+        p += h->size;
+    }
+
+    return NULL;
+}
+
+// arena_free()
+//
+    static void
+arena_free(void *ptr)
+{
+    blk_hdr_t *h = (blk_hdr_t *)((uint8_t *)ptr - HDR_SIZE);
+
+    bytes_used -= h->size;
+    h->in_use = 0;
+    memset(ptr, 0, h->size - HDR_SIZE);
+
+    // coalesce all neighbouring free blocks; one pass over the arena
+    for(uint8_t *p = arena; p < arena+sizeof(arena); ) {
+        blk_hdr_t *a = (blk_hdr_t *)p;
+
+        if(!a->in_use) {
+            uint8_t *nxt = p + a->size;
+            while(nxt < arena+sizeof(arena) && !((blk_hdr_t *)nxt)->in_use) {
+                blk_hdr_t *b = (blk_hdr_t *)nxt;
+                a->size += b->size;
+                nxt += b->size;
+                memset(b, 0, HDR_SIZE);
+            }
+        }
+
+        p += a->size;
+    }
+}
+
+#endif
+
+void *malloc(size_t size)
+{
+#if CKCC_C_HEAP_SIZE
+    void *rv = arena_alloc(size);
+    if(rv) return rv;
+#endif
+
+    num_fallback++;
+    return m_malloc(size);
+}
+
+void free(void *ptr)
+{
+    if(!ptr) return;
+
+#if CKCC_C_HEAP_SIZE
+    if(in_arena(ptr)) {
+        arena_free(ptr);
+        return;
+    }
+#endif
+
+    m_free(ptr);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    if(!ptr) return malloc(size);
+
+#if CKCC_C_HEAP_SIZE
+    if(in_arena(ptr)) {
+        blk_hdr_t *h = (blk_hdr_t *)((uint8_t *)ptr - HDR_SIZE);
+        size_t have = h->size - HDR_SIZE;
+
+        if(size <= have) return ptr;
+
+        void *rv = malloc(size);
+        if(!rv) return NULL;
+
+        memcpy(rv, ptr, have);
+        arena_free(ptr);
+
+        return rv;
+    }
+#endif
+
+    return m_realloc(ptr, size);
+}
+
+// c_heap_stats()
+//
+// Returns (arena_size, bytes_in_use, high_water, num_fallback_allocs). Sizes include
+// block headers. Fallback count is number of mallocs that went to GC heap instead.
+//
+    STATIC mp_obj_t
+c_heap_stats(void)
+{
+    mp_obj_t rv[4] = {
+        MP_OBJ_NEW_SMALL_INT(CKCC_C_HEAP_SIZE),
+        MP_OBJ_NEW_SMALL_INT(bytes_used),
+        MP_OBJ_NEW_SMALL_INT(high_water),
+        mp_obj_new_int_from_uint(num_fallback),
+    };
+
+    return mp_obj_new_tuple(4, rv);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(c_heap_stats_obj, c_heap_stats);
+
+// EOF
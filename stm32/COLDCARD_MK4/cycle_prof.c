@@ -0,0 +1,117 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * cycle_prof.c - named phase timers, based on the DWT cycle counter.
+ *
+ * - C code calls prof_start/prof_stop directly (see cycle_prof.h)
+ * - python uses ckcc.prof_start(n), prof_stop(n), prof_report(), prof_reset()
+ * - slots accumulate total cycles and number of start/stop pairs
+ * - counter is 32 bits, so one interval must be under ~35 seconds at 120Mhz
+ *
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "cycle_prof.h"
+
+typedef struct {
+    uint64_t    total;
+    uint32_t    started;        // CYCCNT at start, or zero if not running
+    uint32_t    count;
+} prof_slot_t;
+
+static prof_slot_t slots[PROF_NUM_SLOTS];
+
+// prof_setup()
+//
+    static void
+prof_setup(void)
+{
+    if(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) return;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// prof_start()
+//
+    void
+prof_start(int slot)
+{
+    if((slot < 0) || (slot >= PROF_NUM_SLOTS)) return;
+
+    prof_setup();
+
+    // zero is our "not running" marker, so avoid it
+    slots[slot].started = DWT->CYCCNT | 1;
+}
+
+// prof_stop()
+//
+    void
+prof_stop(int slot)
+{
+    if((slot < 0) || (slot >= PROF_NUM_SLOTS)) return;
+
+    prof_slot_t *s = &slots[slot];
+    if(!s->started) return;
+
+    s->total += (uint32_t)(DWT->CYCCNT - s->started);
+    s->count++;
+    s->started = 0;
+}
+
+STATIC mp_obj_t py_prof_start(mp_obj_t slot_in)
+{
+    prof_start(mp_obj_get_int(slot_in));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(prof_start_obj, py_prof_start);
+
+STATIC mp_obj_t py_prof_stop(mp_obj_t slot_in)
+{
+    prof_stop(mp_obj_get_int(slot_in));
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(prof_stop_obj, py_prof_stop);
+
+// prof_report()
+//
+// Returns (cycles_per_second, [(total_cycles, count), ...]) with one entry per slot.
+//
+    STATIC mp_obj_t
+prof_report(void)
+{
+    mp_obj_t rv = mp_obj_new_list(PROF_NUM_SLOTS, NULL);
+
+    for(int i=0; i<PROF_NUM_SLOTS; i++) {
+        mp_obj_t here[2] = {
+            mp_obj_new_int_from_ull(slots[i].total),
+            mp_obj_new_int_from_uint(slots[i].count),
+        };
+        ((mp_obj_list_t *)MP_OBJ_TO_PTR(rv))->items[i] = mp_obj_new_tuple(2, here);
+    }
+
+    mp_obj_t pair[2] = { mp_obj_new_int_from_uint(SystemCoreClock), rv };
+
+    return mp_obj_new_tuple(2, pair);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(prof_report_obj, prof_report);
+
+// prof_reset()
+//
+    STATIC mp_obj_t
+prof_reset(void)
+{
+    memset(slots, 0, sizeof(slots));
+
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(prof_reset_obj, prof_reset);
+
+// EOF
@@ -0,0 +1,14 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ */
+#pragma once
+#include <stdint.h>
+
+// Accumulating cycle counters, using the DWT cycle counter. Slot numbers
+// are shared with python code: see shared/prof.py for their names.
+#define PROF_NUM_SLOTS      16
+
+void prof_start(int slot);
+void prof_stop(int slot);
+
+// EOF
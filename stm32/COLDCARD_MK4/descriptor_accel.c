@@ -0,0 +1,112 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * descriptor_accel.c - native version of the BIP-380 descriptor checksum.
+ *
+ * - exposed as ckcc.descriptor_checksum(), see modckcc.c
+ * - semantics must match descriptor_checksum() in shared/descriptor.py and
+ *   the simulator version in unix/variant/ckcc.py
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+static const char INPUT_CHARSET[] =
+    "0123456789()[],'/*abcdefgh@:$%{}IJKLMNOPQRSTUVWXYZ&+-.;<=>?!^_|~"
+    "ijklmnopqrstuvwxyzABCDEFGH`#\"\\ ";
+static const char CHECKSUM_CHARSET[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+// polymod()
+//
+    static inline uint64_t
+polymod(uint64_t c, int val)
+{
+    uint8_t c0 = c >> 35;
+
+    c = ((c & 0x7ffffffffULL) << 5) ^ val;
+
+    if(c0 & 1) c ^= 0xf5dee51989ULL;
+    if(c0 & 2) c ^= 0xa9fdca3312ULL;
+    if(c0 & 4) c ^= 0x1bab10e32dULL;
+    if(c0 & 8) c ^= 0x3706b1677aULL;
+    if(c0 & 16) c ^= 0x644d626ffdULL;
+
+    return c;
+}
+
+// bad_char()
+//
+// Raise ValueError(ch) like the python code, where ch is the whole (utf-8) character.
+//
+    static void
+bad_char(const uint8_t *p, const uint8_t *end)
+{
+    size_t len = 1;
+
+    if(p[0] >= 0x80) {
+        while((p+len < end) && ((p[len] & 0xc0) == 0x80)) len++;
+    }
+
+    mp_obj_t ch = mp_obj_new_str((const char *)p, len);
+
+    nlr_raise(mp_obj_new_exception_arg1(&mp_type_ValueError, ch));
+}
+
+// descriptor_checksum(desc)
+//
+// Returns the 8-character checksum of desc (str), as text.
+//
+    STATIC mp_obj_t
+descriptor_checksum(mp_obj_t desc_in)
+{
+    size_t len;
+    const uint8_t *p = (const uint8_t *)mp_obj_str_get_data(desc_in, &len);
+    const uint8_t *end = p + len;
+
+    // reverse lookup: ascii => position in INPUT_CHARSET, or 0xff
+    uint8_t lookup[128];
+    memset(lookup, 0xff, sizeof(lookup));
+    for(int i=0; i < sizeof(INPUT_CHARSET)-1; i++) {
+        lookup[(uint8_t)INPUT_CHARSET[i]] = i;
+    }
+
+    uint64_t c = 1;
+    int cls = 0;
+    int clscount = 0;
+
+    for(; p < end; p++) {
+        uint8_t pos = (p[0] < 0x80) ? lookup[p[0]] : 0xff;
+        if(pos == 0xff) {
+            bad_char(p, end);
+        }
+
+        c = polymod(c, pos & 31);
+        cls = cls * 3 + (pos >> 5);
+        if(++clscount == 3) {
+            c = polymod(c, cls);
+            cls = 0;
+            clscount = 0;
+        }
+    }
+
+    if(clscount > 0) {
+        c = polymod(c, cls);
+    }
+    for(int j=0; j < 8; j++) {
+        c = polymod(c, 0);
+    }
+    c ^= 1;
+
+    char rv[8];
+    for(int j=0; j < 8; j++) {
+        rv[j] = CHECKSUM_CHARSET[(c >> (5 * (7 - j))) & 31];
+    }
+
+    return mp_obj_new_str(rv, sizeof(rv));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(descriptor_checksum_obj, descriptor_checksum);
+
+// EOF
@@ -0,0 +1,315 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * hw_sha256.c - SHA-256 using the STM32L4S5 hash peripheral.
+ *
+ * - exposed as ckcc.sha256(), same API as uhashlib.sha256
+ * - also ckcc.kdf_7zaes() for compat7z.py, which is all hashing
+ * - register-level, like the bootloader's faster_sha256.c
+ * - any number of objects may be active: state is swapped in and out of the
+ *   hardware for each call (see "context swapping" in the reference manual)
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "hw_sha256.h"
+
+// context registers needed for SHA-256 (no HMAC)
+#define NUM_CSR         38
+
+typedef struct _hw_sha256_obj_t {
+    mp_obj_base_t base;
+
+    bool        started;            // ctx is valid, else nothing hashed yet
+    bool        done;               // digest is final
+    uint8_t     num_pending;        // up to 3 bytes might be waiting from last call
+    uint8_t     pending[4];
+
+    uint32_t    imr, str, cr;
+    uint32_t    csr[NUM_CSR];
+
+    uint8_t     digest[32];
+} hw_sha256_obj_t;
+
+const mp_obj_type_t hw_sha256_type;
+
+// hw_sha256_start()
+//
+    void
+hw_sha256_start(void)
+{
+    __HAL_RCC_HASH_CLK_ENABLE();
+
+    // SHA-256 is ALGO=0b11; data written as 8-bit type, so no byte swapping
+    HASH->CR = HASH_CR_ALGO_0 | HASH_CR_ALGO_1 | HASH_CR_DATATYPE_1 | HASH_CR_INIT;
+}
+
+// hw_sha256_update()
+//
+// Whole words only, except for final call.
+//
+    void
+hw_sha256_update(const uint8_t *data, uint32_t len, bool final)
+{
+    for(; len >= 4; len -= 4, data += 4) {
+        uint32_t    tmp;
+        memcpy(&tmp, data, 4);
+        HASH->DIN = tmp;
+    }
+
+    if(!final) return;
+
+    // number of valid bits in last word written
+    MODIFY_REG(HASH->STR, HASH_STR_NBLW, 8 * len);
+    if(len) {
+        uint32_t    tmp = 0;
+        memcpy(&tmp, data, len);
+        HASH->DIN = tmp;
+    }
+}
+
+// hw_sha256_final()
+//
+    void
+hw_sha256_final(uint8_t digest[32])
+{
+    SET_BIT(HASH->STR, HASH_STR_DCAL);
+
+    while(!(HASH->SR & HASH_SR_DCIS)) {
+        // wait
+    }
+
+    for(int i=0; i<8; i++) {
+        uint32_t tmp = __REV((i < 5) ? HASH->HR[i] : HASH_DIGEST->HR[i]);
+        memcpy(&digest[i*4], &tmp, 4);
+    }
+}
+
+// ctx_restore()
+//
+    static void
+ctx_restore(hw_sha256_obj_t *self)
+{
+    if(!self->started) {
+        hw_sha256_start();
+        return;
+    }
+
+    __HAL_RCC_HASH_CLK_ENABLE();
+
+    HASH->IMR = self->imr;
+    HASH->STR = self->str;
+    HASH->CR = self->cr;
+
+    // reset processor, before restoring the context registers
+    SET_BIT(HASH->CR, HASH_CR_INIT);
+
+    for(int i=0; i<NUM_CSR; i++) {
+        HASH->CSR[i] = self->csr[i];
+    }
+}
+
+// ctx_save()
+//
+    static void
+ctx_save(hw_sha256_obj_t *self)
+{
+    while(HASH->SR & HASH_SR_BUSY) {
+        // wait for block in progress
+    }
+
+    self->imr = HASH->IMR & (HASH_IMR_DINIE | HASH_IMR_DCIE);
+    self->str = HASH->STR & HASH_STR_NBLW;
+    self->cr = HASH->CR & (HASH_CR_DMAE | HASH_CR_DATATYPE | HASH_CR_MODE
+                                | HASH_CR_ALGO | HASH_CR_LKEY | HASH_CR_MDMAT);
+
+    for(int i=0; i<NUM_CSR; i++) {
+        self->csr[i] = HASH->CSR[i];
+    }
+
+    self->started = true;
+}
+
+// feed()
+//
+// Hardware must already hold our context.
+//
+    static void
+feed(hw_sha256_obj_t *self, const uint8_t *data, size_t len)
+{
+    if(self->num_pending) {
+        // complete the word we were saving
+        int fill = 4 - self->num_pending;
+        memcpy(&self->pending[self->num_pending], data, fill);
+        hw_sha256_update(self->pending, 4, false);
+        data += fill;
+        len -= fill;
+    }
+
+    uint32_t whole = len & ~0x3;
+    hw_sha256_update(data, whole, false);
+
+    // save runt for later
+    self->num_pending = len - whole;
+    memcpy(self->pending, data + whole, self->num_pending);
+}
+
+// do_update()
+//
+    static void
+do_update(hw_sha256_obj_t *self, const uint8_t *data, size_t len)
+{
+    if(self->done) {
+        mp_raise_ValueError(MP_ERROR_TEXT("finalised"));
+    }
+
+    if(self->num_pending + len < 4) {
+        // not even a word yet: keep for later
+        memcpy(&self->pending[self->num_pending], data, len);
+        self->num_pending += len;
+
+        return;
+    }
+
+    ctx_restore(self);
+    feed(self, data, len);
+    ctx_save(self);
+}
+
+// sha256([data])
+//
+STATIC mp_obj_t hw_sha256_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args)
+{
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+
+    hw_sha256_obj_t *self = m_new_obj(hw_sha256_obj_t);
+    memset(self, 0, sizeof(*self));
+    self->base.type = &hw_sha256_type;
+
+    if(n_args == 1) {
+        mp_buffer_info_t buf;
+        mp_get_buffer_raise(args[0], &buf, MP_BUFFER_READ);
+        do_update(self, buf.buf, buf.len);
+    }
+
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// update(data)
+//
+STATIC mp_obj_t hw_sha256_update_meth(mp_obj_t self_in, mp_obj_t data_in)
+{
+    hw_sha256_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(data_in, &buf, MP_BUFFER_READ);
+    do_update(self, buf.buf, buf.len);
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(hw_sha256_update_obj, hw_sha256_update_meth);
+
+// digest()
+//
+// Can be called again, but no more updates are possible after.
+//
+STATIC mp_obj_t hw_sha256_digest(mp_obj_t self_in)
+{
+    hw_sha256_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if(!self->done) {
+        ctx_restore(self);
+        hw_sha256_update(self->pending, self->num_pending, true);
+        hw_sha256_final(self->digest);
+
+        self->done = true;
+    }
+
+    return mp_obj_new_bytes(self->digest, 32);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(hw_sha256_digest_obj, hw_sha256_digest);
+
+STATIC const mp_rom_map_elem_t hw_sha256_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&hw_sha256_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_digest), MP_ROM_PTR(&hw_sha256_digest_obj) },
+};
+STATIC MP_DEFINE_CONST_DICT(hw_sha256_locals_dict, hw_sha256_locals_dict_table);
+
+const mp_obj_type_t hw_sha256_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_sha256,
+    .make_new = hw_sha256_make_new,
+    .locals_dict = (mp_obj_dict_t *)&hw_sha256_locals_dict,
+};
+
+// kdf_7zaes(salt, password, rounds_pow, [progress_fcn])
+//
+// Key stretching for 7z AES: single SHA-256 over (salt + password + LE64 counter)
+// repeated 2**rounds_pow times. Password must already be UTF-16-LE. See
+// Builder.calculate_key() in shared/compat7z.py, which is the reference version.
+//
+    STATIC mp_obj_t
+kdf_7zaes(size_t n_args, const mp_obj_t *args)
+{
+    mp_buffer_info_t salt, pw;
+    mp_get_buffer_raise(args[0], &salt, MP_BUFFER_READ);
+    mp_get_buffer_raise(args[1], &pw, MP_BUFFER_READ);
+
+    mp_int_t rounds_pow = mp_obj_get_int(args[2]);
+    mp_obj_t progress_fcn = (n_args >= 4) ? args[3] : mp_const_none;
+
+    if((rounds_pow < 0) || (rounds_pow > 24)) {
+        mp_raise_ValueError(NULL);
+    }
+    uint32_t rounds = 1 << rounds_pow;
+
+    // whole message for one round; only the counter changes
+    size_t msg_len = salt.len + pw.len + 8;
+    uint8_t *msg = m_new(uint8_t, msg_len);
+    memcpy(msg, salt.buf, salt.len);
+    memcpy(msg + salt.len, pw.buf, pw.len);
+    uint8_t *ctr = msg + salt.len + pw.len;
+    memset(ctr, 0, 8);
+
+    hw_sha256_obj_t st = { 0 };
+
+    for(uint32_t i=0; i<rounds; i++) {
+        if(i % 1000 == 0) {
+            // python code might use the hash hardware, so swap out around it
+            if(i) ctx_save(&st);
+
+            if(progress_fcn != mp_const_none) {
+                mp_call_function_1(progress_fcn, mp_obj_new_float((mp_float_t)i / rounds));
+            }
+
+            // .. or start fresh, the first time
+            ctx_restore(&st);
+        }
+
+        ctr[0] = i & 0xff;
+        ctr[1] = (i >> 8) & 0xff;
+        ctr[2] = (i >> 16) & 0xff;
+        ctr[3] = (i >> 24) & 0xff;
+
+        feed(&st, msg, msg_len);
+    }
+
+    uint8_t digest[32];
+    hw_sha256_update(st.pending, st.num_pending, true);
+    hw_sha256_final(digest);
+
+    memset(msg, 0, msg_len);
+    m_del(uint8_t, msg, msg_len);
+
+    mp_obj_t rv = mp_obj_new_bytes(digest, 32);
+    memset(digest, 0, 32);
+
+    return rv;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(kdf_7zaes_obj, 3, 4, kdf_7zaes);
+
+// EOF
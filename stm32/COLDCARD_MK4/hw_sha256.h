@@ -0,0 +1,15 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Direct use of the hash peripheral, for one whole message at a time. No
+// state is kept in hardware between calls into mpy code, so anything can
+// use it afterwards (even the bootloader).
+void hw_sha256_start(void);
+void hw_sha256_update(const uint8_t *data, uint32_t len, bool final);
+void hw_sha256_final(uint8_t digest[32]);
+
+// EOF
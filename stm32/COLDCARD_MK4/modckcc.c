@@ -251,6 +251,33 @@ MP_DEFINE_CONST_FUN_OBJ_1(watchpoint_obj, watchpoint);
 // See psram.c
 extern const mp_obj_type_t psram_type;
 
+// See psbt_accel.c
+MP_DECLARE_CONST_FUN_OBJ_2(psbt_map_scan_obj);
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(txn_vector_scan_obj);
+MP_DECLARE_CONST_FUN_OBJ_3(bip32_paths_unpack_obj);
+
+// See hw_sha256.c
+extern const mp_obj_type_t hw_sha256_type;
+MP_DECLARE_CONST_FUN_OBJ_VAR_BETWEEN(kdf_7zaes_obj);
+
+// See descriptor_accel.c
+MP_DECLARE_CONST_FUN_OBJ_1(descriptor_checksum_obj);
+
+// See c_heap.c
+MP_DECLARE_CONST_FUN_OBJ_0(c_heap_stats_obj);
+
+// See cycle_prof.c
+MP_DECLARE_CONST_FUN_OBJ_1(prof_start_obj);
+MP_DECLARE_CONST_FUN_OBJ_1(prof_stop_obj);
+MP_DECLARE_CONST_FUN_OBJ_0(prof_report_obj);
+MP_DECLARE_CONST_FUN_OBJ_0(prof_reset_obj);
+
+// See pbkdf2_sha512.c
+MP_DECLARE_CONST_FUN_OBJ_3(pbkdf2_sha512_obj);
+
+// See seed_xor.c
+MP_DECLARE_CONST_FUN_OBJ_1(seed_xor_obj);
+
 STATIC const mp_rom_map_elem_t ckcc_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),            MP_ROM_QSTR(MP_QSTR_ckcc) },
     { MP_ROM_QSTR(MP_QSTR_rng),                 MP_ROM_PTR(&pyb_rng_get_obj) },
@@ -267,6 +294,19 @@ STATIC const mp_rom_map_elem_t ckcc_module_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_stack_limit),         MP_ROM_PTR(&stack_limit_obj) },
     { MP_ROM_QSTR(MP_QSTR_usb_active),          MP_ROM_PTR(&usb_active_obj) },
     { MP_ROM_QSTR(MP_QSTR_PSRAM),               MP_ROM_PTR(&psram_type) },
+    { MP_ROM_QSTR(MP_QSTR_psbt_map_scan),       MP_ROM_PTR(&psbt_map_scan_obj) },
+    { MP_ROM_QSTR(MP_QSTR_txn_vector_scan),     MP_ROM_PTR(&txn_vector_scan_obj) },
+    { MP_ROM_QSTR(MP_QSTR_bip32_paths_unpack),  MP_ROM_PTR(&bip32_paths_unpack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sha256),              MP_ROM_PTR(&hw_sha256_type) },
+    { MP_ROM_QSTR(MP_QSTR_kdf_7zaes),           MP_ROM_PTR(&kdf_7zaes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_descriptor_checksum), MP_ROM_PTR(&descriptor_checksum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_c_heap_stats),        MP_ROM_PTR(&c_heap_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_start),          MP_ROM_PTR(&prof_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_stop),           MP_ROM_PTR(&prof_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_report),         MP_ROM_PTR(&prof_report_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_reset),          MP_ROM_PTR(&prof_reset_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pbkdf2_sha512),       MP_ROM_PTR(&pbkdf2_sha512_obj) },
+    { MP_ROM_QSTR(MP_QSTR_seed_xor),            MP_ROM_PTR(&seed_xor_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(ckcc_module_globals, ckcc_module_globals_table);
@@ -337,23 +377,6 @@ ckcc_heap_end(void)
     return rv;
 }
 
-// There is no classical C heap in bare-metal ports, only Python
-// garbage-collected heap. For completeness, emulate C heap via
-// GC heap. Note that MicroPython core never uses malloc() and friends,
-// but I need these for the C-language extensions I'm using.
-void *malloc(size_t size)
-{
-    return m_malloc(size);
-}
-
-void free(void *ptr)
-{
-    m_free(ptr);
-}
-
-void *realloc(void *ptr, size_t size)
-{
-    return m_realloc(ptr, size);
-}
+// malloc() and friends for the C-language extensions: see c_heap.c
 
 // EOF
@@ -14,6 +14,10 @@ MICROPY_VFS_FAT = 1
 CFLAGS_EXTRA += -DMP_CONFIGFILE=\"boards/$(BOARD)/ckcc-port.h\"
 CFLAGS_EXTRA += -DCOLDCARD_DEBUG=$(DEBUG_BUILD)
 
+# size of arena for malloc() used by C extensions; zero to use GC heap (see c_heap.c)
+CKCC_C_HEAP_SIZE ?= 32768
+CFLAGS_EXTRA += -DCKCC_C_HEAP_SIZE=$(CKCC_C_HEAP_SIZE)
+
 # obsolete
 # need the CDC inf file to be built before this file
 #initfs.c: $(GEN_CDCINF_HEADER)
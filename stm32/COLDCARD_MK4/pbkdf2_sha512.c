@@ -0,0 +1,289 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * pbkdf2_sha512.c - PBKDF2-HMAC-SHA512 for HSM user passwords (users.calc_hmac_key)
+ *
+ * - exposed as ckcc.pbkdf2_sha512(password, salt, iterations), see modckcc.c
+ * - same results as ngu.hash.pbkdf2_sha512(), for the usual 64-byte output
+ * - no hash hardware for SHA-512 on this chip, so all software, but:
+ *      - HMAC pads are hashed once, and each round is exactly two compressions
+ *      - rounds are unrolled 8 at a time to keep working state in registers
+ *      - nothing allocated per round
+ * - checked on host against hashlib: misc/pbkdf2-kat.py
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+static const uint64_t K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+static const uint64_t H0[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
+
+#define ROR(x, n)       (((x) >> (n)) | ((x) << (64 - (n))))
+#define S0(x)           (ROR(x, 28) ^ ROR(x, 34) ^ ROR(x, 39))
+#define S1(x)           (ROR(x, 14) ^ ROR(x, 18) ^ ROR(x, 41))
+#define s0(x)           (ROR(x, 1) ^ ROR(x, 8) ^ ((x) >> 7))
+#define s1(x)           (ROR(x, 19) ^ ROR(x, 61) ^ ((x) >> 6))
+#define CH(x, y, z)     ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z)    (((x) & (y)) | ((z) & ((x) | (y))))
+
+// message schedule kept as 16-word ring
+#define W(i)            w[(i) & 15]
+#define WNEXT(i)        (W(i) += s1(W((i)-2)) + W((i)-7) + s0(W((i)-15)))
+
+// one round; caller rotates the variable names instead of moving values
+#define RND(a, b, c, d, e, f, g, h, i, wi) do {             \
+        uint64_t t1 = h + S1(e) + CH(e, f, g) + K[i] + (wi);    \
+        d += t1;                                                \
+        h = t1 + S0(a) + MAJ(a, b, c);                          \
+    } while(0)
+
+#define RND8(i, WX) do {                                    \
+        RND(a, b, c, d, e, f, g, h, (i)+0, WX((i)+0));     \
+        RND(h, a, b, c, d, e, f, g, (i)+1, WX((i)+1));     \
+        RND(g, h, a, b, c, d, e, f, (i)+2, WX((i)+2));     \
+        RND(f, g, h, a, b, c, d, e, (i)+3, WX((i)+3));     \
+        RND(e, f, g, h, a, b, c, d, (i)+4, WX((i)+4));     \
+        RND(d, e, f, g, h, a, b, c, (i)+5, WX((i)+5));     \
+        RND(c, d, e, f, g, h, a, b, (i)+6, WX((i)+6));     \
+        RND(b, c, d, e, f, g, h, a, (i)+7, WX((i)+7));     \
+    } while(0)
+
+// compress()
+//
+// One SHA-512 block: input already as 16 host-order words.
+//
+    static void
+compress(uint64_t state[8], const uint64_t block[16])
+{
+    uint64_t w[16];
+    memcpy(w, block, sizeof(w));
+
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    RND8(0, W);
+    RND8(8, W);
+    for(int i=16; i<80; i+=16) {
+        RND8(i, WNEXT);
+        RND8(i+8, WNEXT);
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// load_be()
+//
+    static inline uint64_t
+load_be(const uint8_t *p)
+{
+    uint64_t rv = 0;
+    for(int i=0; i<8; i++) rv = (rv << 8) | p[i];
+    return rv;
+}
+
+// Streaming hash, only used for setup steps: long keys, and the salt.
+typedef struct {
+    uint64_t    state[8];
+    uint64_t    total;          // bytes hashed so far
+    uint8_t     buf[128];
+    uint32_t    fill;
+} sha512_ctx_t;
+
+// ctx_block()
+//
+    static void
+ctx_block(sha512_ctx_t *ctx)
+{
+    uint64_t blk[16];
+
+    for(int i=0; i<16; i++) blk[i] = load_be(&ctx->buf[8*i]);
+    compress(ctx->state, blk);
+    ctx->fill = 0;
+}
+
+// ctx_update()
+//
+    static void
+ctx_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    ctx->total += len;
+
+    while(len) {
+        uint32_t here = MIN(len, sizeof(ctx->buf) - ctx->fill);
+
+        memcpy(&ctx->buf[ctx->fill], data, here);
+        ctx->fill += here;
+        data += here;
+        len -= here;
+
+        if(ctx->fill == sizeof(ctx->buf)) {
+            ctx_block(ctx);
+        }
+    }
+}
+
+// ctx_final()
+//
+// Add padding; digest is left in ctx->state as host-order words.
+//
+    static void
+ctx_final(sha512_ctx_t *ctx)
+{
+    uint64_t bits = ctx->total * 8;
+
+    ctx->buf[ctx->fill++] = 0x80;
+    if(ctx->fill > 112) {
+        memset(&ctx->buf[ctx->fill], 0, sizeof(ctx->buf) - ctx->fill);
+        ctx_block(ctx);
+    }
+    memset(&ctx->buf[ctx->fill], 0, sizeof(ctx->buf) - ctx->fill);
+    for(int i=0; i<8; i++) ctx->buf[127-i] = bits >> (8*i);
+    ctx_block(ctx);
+
+    memset(ctx->buf, 0, sizeof(ctx->buf));
+}
+
+// pbkdf2_sha512_block()
+//
+// First (and only) 64-byte output block of PBKDF2-HMAC-SHA512.
+//
+    static void
+pbkdf2_sha512_block(const uint8_t *pw, size_t pw_len, const uint8_t *salt, size_t salt_len,
+                    uint32_t iterations, uint8_t out[64])
+{
+    uint8_t key[128];
+    uint64_t istate[8], ostate[8], blk[16];
+
+    // HMAC key: hashed if too long, then zero padded
+    memset(key, 0, sizeof(key));
+    if(pw_len > sizeof(key)) {
+        sha512_ctx_t ctx = { .total = 0, .fill = 0 };
+        memcpy(ctx.state, H0, sizeof(H0));
+        ctx_update(&ctx, pw, pw_len);
+        ctx_final(&ctx);
+        for(int i=0; i<8; i++) {
+            for(int j=0; j<8; j++) key[8*i+j] = ctx.state[i] >> (56 - 8*j);
+        }
+        memset(&ctx, 0, sizeof(ctx));
+    } else {
+        memcpy(key, pw, pw_len);
+    }
+
+    // inner and outer pad states: hashed once for all iterations
+    memcpy(istate, H0, sizeof(istate));
+    memcpy(ostate, H0, sizeof(ostate));
+    for(int i=0; i<16; i++) {
+        uint64_t k = load_be(&key[8*i]);
+        blk[i] = k ^ 0x3636363636363636ULL;
+    }
+    compress(istate, blk);
+    for(int i=0; i<16; i++) {
+        uint64_t k = load_be(&key[8*i]);
+        blk[i] = k ^ 0x5c5c5c5c5c5c5c5cULL;
+    }
+    compress(ostate, blk);
+    memset(key, 0, sizeof(key));
+
+    // U1 = HMAC(pw, salt || INT(1))
+    static const uint8_t one[4] = { 0, 0, 0, 1 };
+    uint64_t u[8], t[8], acc[8];
+
+    sha512_ctx_t ctx = { .total = 128, .fill = 0 };
+    memcpy(ctx.state, istate, sizeof(istate));
+    ctx_update(&ctx, salt, salt_len);
+    ctx_update(&ctx, one, 4);
+    ctx_final(&ctx);
+    memcpy(t, ctx.state, sizeof(t));
+    memset(&ctx, 0, sizeof(ctx));
+
+    // outer: one block, holds 64-byte inner digest + padding
+    memset(blk, 0, sizeof(blk));
+    memcpy(blk, t, 64);
+    blk[8] = 0x8000000000000000ULL;
+    blk[15] = (128 + 64) * 8;
+    memcpy(u, ostate, sizeof(u));
+    compress(u, blk);
+    memcpy(acc, u, sizeof(acc));
+
+    // remaining rounds: U(n) = HMAC(pw, U(n-1)), each two compressions;
+    // padding words of blk stay fixed, only first 8 words change
+    for(uint32_t n=1; n<iterations; n++) {
+        memcpy(blk, u, 64);
+        memcpy(t, istate, sizeof(t));
+        compress(t, blk);
+
+        memcpy(blk, t, 64);
+        memcpy(u, ostate, sizeof(u));
+        compress(u, blk);
+
+        for(int i=0; i<8; i++) acc[i] ^= u[i];
+    }
+
+    for(int i=0; i<8; i++) {
+        for(int j=0; j<8; j++) out[8*i+j] = acc[i] >> (56 - 8*j);
+    }
+
+    memset(istate, 0, sizeof(istate));
+    memset(ostate, 0, sizeof(ostate));
+    memset(u, 0, sizeof(u));
+    memset(t, 0, sizeof(t));
+    memset(acc, 0, sizeof(acc));
+    memset(blk, 0, sizeof(blk));
+}
+
+// pbkdf2_sha512(password, salt, iterations)
+//
+// Returns 64 bytes. Password and salt may be str or bytes.
+//
+    STATIC mp_obj_t
+pbkdf2_sha512(mp_obj_t pw_in, mp_obj_t salt_in, mp_obj_t iter_in)
+{
+    mp_buffer_info_t pw, salt;
+    mp_get_buffer_raise(pw_in, &pw, MP_BUFFER_READ);
+    mp_get_buffer_raise(salt_in, &salt, MP_BUFFER_READ);
+
+    mp_int_t iterations = mp_obj_get_int(iter_in);
+    if(iterations < 1) {
+        mp_raise_ValueError(NULL);
+    }
+
+    uint8_t out[64];
+    pbkdf2_sha512_block(pw.buf, pw.len, salt.buf, salt.len, iterations, out);
+
+    mp_obj_t rv = mp_obj_new_bytes(out, sizeof(out));
+    memset(out, 0, sizeof(out));
+
+    return rv;
+}
+MP_DEFINE_CONST_FUN_OBJ_3(pbkdf2_sha512_obj, pbkdf2_sha512);
+
+// EOF
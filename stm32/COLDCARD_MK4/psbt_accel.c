@@ -0,0 +1,270 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * psbt_accel.c - native helpers for the hottest parts of PSBT parsing.
+ *
+ * - exposed as functions of the ckcc module, see modckcc.c
+ * - semantics must match the python code in shared/psbt.py and
+ *   the simulator versions in unix/variant/ckcc.py
+ * - always buffer-based (typically a memoryview over PSRAM), never raw addresses
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+// read_compact_size()
+//
+// Decode a Bitcoin compact-size integer. Returns number of bytes consumed, or
+// zero if truncated. 64-bit values are never reasonable for our uses, so rejected.
+//
+    static int
+read_compact_size(const uint8_t *p, const uint8_t *end, uint32_t *out)
+{
+    if(p >= end) return 0;
+
+    uint8_t b = p[0];
+
+    if(b < 253) {
+        *out = b;
+        return 1;
+    }
+    if(b == 253) {
+        if(end - p < 3) return 0;
+        *out = p[1] | (p[2] << 8);
+        return 3;
+    }
+    if(b == 254) {
+        if(end - p < 5) return 0;
+        *out = p[1] | (p[2] << 8) | (p[3] << 16) | ((uint32_t)p[4] << 24);
+        return 5;
+    }
+
+    return 0;
+}
+
+// psbt_map_scan(buf, offset)
+//
+// Scan one key/value map of a PSBT, starting at offset into buf. Stops after the
+// zero-length key which ends the map. Returns:
+//
+//      ([(key_type, key_offset, key_len, val_offset, val_len), ...], end_offset)
+//
+// Offsets are relative to start of buf, and key_offset includes the key type byte.
+// If buf ends where the next key would start, stops there like the python loop
+// does, and end_offset is None. Truncated records raise ValueError('eof').
+//
+    STATIC mp_obj_t
+psbt_map_scan(mp_obj_t buf_in, mp_obj_t offset_in)
+{
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_READ);
+
+    mp_int_t offset = mp_obj_get_int(offset_in);
+    if((offset < 0) || (offset > buf.len)) {
+        mp_raise_ValueError(NULL);
+    }
+
+    const uint8_t *base = (const uint8_t *)buf.buf;
+    const uint8_t *end = base + buf.len;
+    const uint8_t *p = base + offset;
+
+    mp_obj_t rv = mp_obj_new_list(0, NULL);
+
+    while(1) {
+        uint32_t ks, vs;
+
+        if(p == end) {
+            // EOF, but no terminator
+            mp_obj_t pair[2] = { rv, mp_const_none };
+
+            return mp_obj_new_tuple(2, pair);
+        }
+
+        int n = read_compact_size(p, end, &ks);
+        if(!n) goto eof;
+        p += n;
+
+        if(ks == 0) {
+            // end of this map
+            break;
+        }
+
+        if((uint32_t)(end - p) < ks) goto eof;
+        const uint8_t *key = p;
+        p += ks;
+
+        n = read_compact_size(p, end, &vs);
+        if(!n) goto eof;
+        p += n;
+
+        if((uint32_t)(end - p) < vs) goto eof;
+
+        mp_obj_t here[5] = {
+            MP_OBJ_NEW_SMALL_INT(key[0]),
+            MP_OBJ_NEW_SMALL_INT(key - base),
+            MP_OBJ_NEW_SMALL_INT(ks),
+            MP_OBJ_NEW_SMALL_INT(p - base),
+            MP_OBJ_NEW_SMALL_INT(vs),
+        };
+        mp_obj_list_append(rv, mp_obj_new_tuple(5, here));
+
+        p += vs;
+    }
+
+    mp_obj_t pair[2] = { rv, MP_OBJ_NEW_SMALL_INT(p - base) };
+
+    return mp_obj_new_tuple(2, pair);
+
+eof:
+    mp_raise_ValueError(MP_ERROR_TEXT("eof"));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(psbt_map_scan_obj, psbt_map_scan);
+
+// txn_vector_scan(buf, offset, count, is_input, want_list)
+//
+// Walk a vector of CTxIn (is_input) or CTxOut objects, serialized without
+// a leading count, as found inside a bitcoin transaction. Returns end offset,
+// or if want_list:
+//
+//      ([(obj_offset, script_offset, script_len), ...], end_offset)
+//
+// - CTxIn: outpoint (36 bytes) at obj_offset; nSequence follows the script
+// - CTxOut: nValue (8 bytes) at obj_offset
+//
+    STATIC mp_obj_t
+txn_vector_scan(size_t n_args, const mp_obj_t *args)
+{
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(args[0], &buf, MP_BUFFER_READ);
+
+    mp_int_t offset = mp_obj_get_int(args[1]);
+    mp_int_t count = mp_obj_get_int(args[2]);
+    bool is_input = mp_obj_is_true(args[3]);
+    bool want_list = mp_obj_is_true(args[4]);
+
+    if((offset < 0) || (offset > buf.len) || (count < 0)) {
+        mp_raise_ValueError(NULL);
+    }
+
+    const uint8_t *base = (const uint8_t *)buf.buf;
+    const uint8_t *end = base + buf.len;
+    const uint8_t *p = base + offset;
+
+    // fixed-size parts, before and after the script
+    const int prefix = is_input ? (32+4) : 8;
+    const int suffix = is_input ? 4 : 0;
+
+    mp_obj_t rv = want_list ? mp_obj_new_list(0, NULL) : mp_const_none;
+
+    for(mp_int_t i=0; i<count; i++) {
+        const uint8_t *obj = p;
+        uint32_t sl;
+
+        if(end - p < prefix) goto eof;
+        p += prefix;
+
+        int n = read_compact_size(p, end, &sl);
+        if(!n) goto eof;
+        p += n;
+
+        // careful: sl could be anything
+        uint32_t left = end - p;
+        if((left < sl) || (left - sl < suffix)) goto eof;
+
+        if(want_list) {
+            mp_obj_t here[3] = {
+                MP_OBJ_NEW_SMALL_INT(obj - base),
+                MP_OBJ_NEW_SMALL_INT(p - base),
+                MP_OBJ_NEW_SMALL_INT(sl),
+            };
+            mp_obj_list_append(rv, mp_obj_new_tuple(3, here));
+        }
+
+        p += sl + suffix;
+    }
+
+    if(!want_list) {
+        return MP_OBJ_NEW_SMALL_INT(p - base);
+    }
+
+    mp_obj_t pair[2] = { rv, MP_OBJ_NEW_SMALL_INT(p - base) };
+
+    return mp_obj_new_tuple(2, pair);
+
+eof:
+    mp_raise_ValueError(MP_ERROR_TEXT("eof"));
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(txn_vector_scan_obj, 5, 5, txn_vector_scan);
+
+// bip32_paths_unpack(buf, vals, my_xfp)
+//
+// Decode the values of PSBT_*_BIP32_DERIVATION records: vals is a list of
+// (offset, length) into buf, each being LE32 xfp followed by LE32 path components.
+// Lengths must already be checked by caller. Xfp of zero is replaced by my_xfp.
+// Returns:
+//
+//      ([[xfp, *path], ...], num_ours, num_zero)
+//
+    STATIC mp_obj_t
+bip32_paths_unpack(mp_obj_t buf_in, mp_obj_t vals_in, mp_obj_t my_xfp_in)
+{
+    mp_buffer_info_t buf;
+    mp_get_buffer_raise(buf_in, &buf, MP_BUFFER_READ);
+
+    uint32_t my_xfp = mp_obj_get_int_truncated(my_xfp_in);
+
+    size_t count;
+    mp_obj_t *vals;
+    mp_obj_get_array(vals_in, &count, &vals);
+
+    const uint8_t *base = (const uint8_t *)buf.buf;
+
+    mp_obj_t rv = mp_obj_new_list(count, NULL);
+    int num_ours = 0, num_zero = 0;
+
+    for(size_t i=0; i<count; i++) {
+        size_t n;
+        mp_obj_t *pl;
+        mp_obj_get_array_fixed_n(vals[i], 2, &pl);
+
+        mp_int_t pos = mp_obj_get_int(pl[0]);
+        mp_int_t ln = mp_obj_get_int(pl[1]);
+
+        if((pos < 0) || (ln < 4) || (ln % 4) || (ln > buf.len) || (pos > buf.len - ln)) {
+            mp_raise_ValueError(NULL);
+        }
+
+        n = ln / 4;
+        mp_obj_t here = mp_obj_new_list(n, NULL);
+        mp_obj_list_t *lst = MP_OBJ_TO_PTR(here);
+
+        const uint8_t *p = base + pos;
+        for(size_t j=0; j<n; j++, p += 4) {
+            uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+
+            if(j == 0) {
+                if(v == 0) {
+                    v = my_xfp;
+                    num_zero++;
+                }
+                if(v == my_xfp) {
+                    num_ours++;
+                }
+            }
+
+            lst->items[j] = mp_obj_new_int_from_uint(v);
+        }
+
+        ((mp_obj_list_t *)MP_OBJ_TO_PTR(rv))->items[i] = here;
+    }
+
+    mp_obj_t trio[3] = { rv, MP_OBJ_NEW_SMALL_INT(num_ours), MP_OBJ_NEW_SMALL_INT(num_zero) };
+
+    return mp_obj_new_tuple(3, trio);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(bip32_paths_unpack_obj, bip32_paths_unpack);
+
+// EOF
@@ -3,6 +3,11 @@
  *
  * Implement a ram disk in PSRAM, accessible by host as MSC and mpy as block dev.
  *
+ * Normally one LUN covering all of the top half of PSRAM. In "split" mode, there
+ * are two: LUN 0 the inbox (host writes PSBT there), and LUN 1 the outbox, which is
+ * read-only for the host. We can publish results into the outbox without
+ * disconnecting USB, and only the outbox is ejected/re-inserted to show the change.
+ *
  */
 #include <stdint.h>
 
@@ -21,7 +26,9 @@
 #include "py/runtime.h"
 #include "py/mperrno.h"
 #include "softtimer.h"
+#include "irq.h"
 #include "ulight.h"
+#include "hw_sha256.h"
 
 // Our storage, in quad-serial SPI PSRAM chip
 // - using top half of chip only
@@ -31,33 +38,59 @@ static const uint32_t PSRAM_SIZE = 0x400000;           // 4 megs (half)
 static const uint32_t BLOCK_SIZE = 512;
 static const uint32_t BLOCK_COUNT = PSRAM_SIZE / BLOCK_SIZE;    // = 8192
 
+// in split mode, outbox takes this much off the end; inbox gets the rest
+static const uint32_t OUTBOX_BLOCKS = 2048;                     // = 1 meg
+
 extern __IO uint32_t uwTick;
 
-// this code will always be the first LUN
-static const uint8_t MY_LUN = 0;
+#define MAX_LUNS        2
+#define INBOX_LUN       0
+#define OUTBOX_LUN      1
 
-STATIC mp_obj_t psram_wipe_and_setup(mp_obj_t unused_self);
-STATIC const uint8_t psram_msc_lu_num = 1;
+STATIC mp_obj_t psram_wipe_and_setup(mp_obj_t self_in);
+STATIC uint8_t psram_msc_lu_num = 1;
 
 typedef struct _psram_obj_t {
     mp_obj_base_t base;
 
+    uint8_t         lun;
     uint32_t        host_write_time;
 } psram_obj_t;
 
-// singleton
+// one object per possible LUN; first is the usual one
 const mp_obj_type_t psram_type;
 psram_obj_t psram_obj = {
     { &psram_type },
+    INBOX_LUN,
+};
+psram_obj_t psram_outbox_obj = {
+    { &psram_type },
+    OUTBOX_LUN,
+};
+
+// where each LUN lives inside our half of PSRAM
+// - note that "started" is more like inserted vs. ejected
+typedef struct {
+    uint32_t    first_blk;
+    uint32_t    num_blks;
+    bool        started;
+    bool        readonly;           // for host
+} psram_lun_t;
+
+static psram_lun_t luns[MAX_LUNS] = {
+    { 0, BLOCK_COUNT, false, false },
+    { BLOCK_COUNT, 0, false, true },
 };
 
 #define HOST_WR_TIMEOUT     750            // (ms)
 static soft_timer_entry_t  host_wr_done;
 
-// we only have a single LUN, so flags can be simple
-// - note that "started" is more like inserted vs. ejected
-bool flag_STARTED = false;
-bool flag_READONLY = false;
+// Which root directory entries of the inbox the host has changed, see psram_changes()
+// - bit per 32-byte entry; FAT16 as we format it has 512 entries
+// - all_changed: boot sector rewritten, or layout we can't track (ie. FAT32)
+#define MAX_ROOT_ENTS       512
+static uint8_t  root_changed[MAX_ROOT_ENTS / 8];
+static bool     all_changed;
 
 // psram_init()
 //
@@ -112,17 +145,78 @@ wr_timeout_now(void)
 // block_to_ptr()
 //
     static uint8_t *
-block_to_ptr(uint32_t blk, uint16_t num_blk)
+block_to_ptr(uint8_t lun, uint32_t blk, uint16_t num_blk)
 {
     // Range checking on incoming requests also done in SCSI_CheckAddressRange()
     // but this is an extra layer of safety, important since we might expose
     // our address space otherwise!
     // - note unsigned arguments
+    // - blk is relative to start of the LUN
+
+    if(lun >= MAX_LUNS) return NULL;
+
+    const psram_lun_t *lu = &luns[lun];
+
+    if(blk >= lu->num_blks) return NULL;
+    if((blk+num_blk) > lu->num_blks) return NULL;
+
+    return &PSRAM_TOP_BASE[(lu->first_blk + blk) * BLOCK_SIZE];
+}
+
+// note_host_changes()
+//
+    static void
+note_host_changes(const uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+    // Before a host write to the inbox lands: compare against current contents
+    // and note which root directory entries will really change. Hosts rewrite
+    // metadata constantly, mostly with the same bytes.
+    const uint8_t *bs = block_to_ptr(INBOX_LUN, 0, 1);
+
+    uint32_t rsvd = bs[14] | (bs[15] << 8);
+    uint32_t num_fats = bs[16];
+    uint32_t num_ents = bs[17] | (bs[18] << 8);
+    uint32_t fat_size = bs[22] | (bs[23] << 8);
+
+    uint32_t root_first = rsvd + (num_fats * fat_size);
+    uint32_t root_blks = ((num_ents * 32) + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    if(!num_ents || num_ents > MAX_ROOT_ENTS) {
+        // no fixed root directory area (FAT32) or nonsense: can't track
+        all_changed = true;
+        return;
+    }
 
-    if(blk >= BLOCK_COUNT) return NULL;
-    if((blk+num_blk) > BLOCK_COUNT) return NULL;
+    for(uint32_t i=0; i < blk_len; i++, buf += BLOCK_SIZE) {
+        uint32_t blk = blk_addr + i;
+        const uint8_t *was = block_to_ptr(INBOX_LUN, blk, 1);
 
-    return &PSRAM_TOP_BASE[blk * BLOCK_SIZE];
+        if(blk == 0) {
+            if(memcmp(was, buf, BLOCK_SIZE)) {
+                all_changed = true;
+            }
+            continue;
+        }
+
+        if(blk < root_first || blk >= root_first + root_blks) continue;
+
+        for(uint32_t e=0; e < BLOCK_SIZE/32; e++) {
+            uint32_t n = ((blk - root_first) * (BLOCK_SIZE/32)) + e;
+
+            if(n >= num_ents) break;
+            if(!memcmp(was + (e*32), buf + (e*32), 32)) continue;
+
+            root_changed[n / 8] |= 1 << (n % 8);
+        }
+    }
+}
+
+// valid_lun()
+//
+    static inline bool
+valid_lun(uint8_t lun)
+{
+    return lun < psram_msc_lu_num;
 }
 
 // Sent in response to MODE SENSE(6) command
@@ -176,7 +270,7 @@ STATIC const int8_t psram_msc_inquiry_data[36] = {
 // Initialise all logical units (it's only ever called once, with lun_in=0)
 STATIC int8_t psram_msc_Init(uint8_t lun_in)
 {
-    if(lun_in != MY_LUN) return -1;
+    if(!valid_lun(lun_in)) return -1;
 
     // don't change flag here, might have been set by python
     //flags_STARTED = false;
@@ -188,7 +282,7 @@ STATIC int8_t psram_msc_Init(uint8_t lun_in)
 // Process SCSI INQUIRY command for the logical unit
 STATIC int psram_msc_Inquiry(uint8_t lun, const uint8_t *params, uint8_t *data_out)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     ckcc_usb_active = true;
 
@@ -222,11 +316,11 @@ STATIC int psram_msc_Inquiry(uint8_t lun, const uint8_t *params, uint8_t *data_o
 STATIC int8_t psram_msc_GetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size)
 {
     // might be important not to write to pointers if unexpected LUN
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     ckcc_usb_active = true;
 
-    *block_num = BLOCK_COUNT;
+    *block_num = luns[lun].num_blks;
     *block_size = BLOCK_SIZE;
 
     return 0;
@@ -235,32 +329,32 @@ STATIC int8_t psram_msc_GetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *
 // Check if a logical unit is ready
 STATIC int8_t psram_msc_IsReady(uint8_t lun)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     // NOTE: called frequently, and must be T for MacOS to recognize at all
     // when F, macos keeps trying to work until it's ready again (freezing programs
     // trying to work with the drive).
-    return flag_STARTED ? 0 : -1;
+    return luns[lun].started ? 0 : -1;
 }
 
 // Check if a logical unit is write protected
 STATIC int8_t psram_msc_IsWriteProtected(uint8_t lun)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
-    return flag_READONLY ? 1 : 0;
+    return luns[lun].readonly ? 1 : 0;
 }
 
 // Start or stop a logical unit
 STATIC int8_t psram_msc_StartStopUnit(uint8_t lun, uint8_t started)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     // host is not allowed to change our ready status: always fail
     //printf("PSRAMdisk: started=%d tried\n", started);
     ckcc_usb_active = true;
 
-    if(!started) {
+    if(!started && (lun == INBOX_LUN)) {
         // (macos) is trying to "eject" the disk. Note this event.
         wr_timeout_now();
     }
@@ -280,10 +374,10 @@ STATIC int8_t psram_msc_StartStopUnit(uint8_t lun, uint8_t started)
 // Prepare a logical unit for possible removal
 STATIC int8_t psram_msc_PreventAllowMediumRemoval(uint8_t lun, uint8_t param)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     //printf("PSRAMdisk: prevallow=%d\n", param);
-    if(param == 0) {
+    if((param == 0) && (lun == INBOX_LUN)) {
         // allow removal == host is done (like after umount in MacOS)
         wr_timeout_now();
     }
@@ -294,11 +388,11 @@ STATIC int8_t psram_msc_PreventAllowMediumRemoval(uint8_t lun, uint8_t param)
 // Read data from a logical unit
 STATIC int8_t psram_msc_Read(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     ckcc_usb_active = true;
 
-    uint8_t *ptr = block_to_ptr(blk_addr, blk_len);
+    uint8_t *ptr = block_to_ptr(lun, blk_addr, blk_len);
     if(!ptr) return -1;
 
     memcpy(buf, ptr, blk_len*BLOCK_SIZE);
@@ -309,13 +403,20 @@ STATIC int8_t psram_msc_Read(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint1
 // Write data to a logical unit
 STATIC int8_t psram_msc_Write(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
 {
-    if(lun != MY_LUN) return -1;
+    if(!valid_lun(lun)) return -1;
 
     ckcc_usb_active = true;
 
-    uint8_t *ptr = block_to_ptr(blk_addr, blk_len);
+    // outbox is read-only for host; SCSI layer should check, but be sure
+    if(luns[lun].readonly) return -1;
+
+    uint8_t *ptr = block_to_ptr(lun, blk_addr, blk_len);
     if(!ptr) return -1;
 
+    if(lun == INBOX_LUN) {
+        note_host_changes(buf, blk_addr, blk_len);
+    }
+
     memcpy(ptr, buf, blk_len*BLOCK_SIZE);
 
     reset_wr_timeout();
@@ -363,15 +464,27 @@ STATIC void psram_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind
 }
 
 STATIC mp_obj_t psram_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    // Parse arguments: none allowed
-    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, 0, NULL, NULL);
-
-    // singleton, we take no args
-    return MP_OBJ_FROM_PTR(&psram_obj);
+    // Parse arguments: optional LUN number
+    enum { ARG_lun };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_lun, MP_ARG_INT, {.u_int = INBOX_LUN} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // singletons, one per LUN
+    switch(args[ARG_lun].u_int) {
+        case INBOX_LUN:
+            return MP_OBJ_FROM_PTR(&psram_obj);
+        case OUTBOX_LUN:
+            return MP_OBJ_FROM_PTR(&psram_outbox_obj);
+        default:
+            mp_raise_ValueError(NULL);
+    }
 }
 
 STATIC mp_obj_t psram_readblocks(size_t n_args, const mp_obj_t *args) {
-    //psram_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    psram_obj_t *self = MP_OBJ_TO_PTR(args[0]);
     uint32_t block_num = mp_obj_get_int(args[1]);
 
     mp_buffer_info_t bufinfo;
@@ -382,7 +495,7 @@ STATIC mp_obj_t psram_readblocks(size_t n_args, const mp_obj_t *args) {
     if(blk_len < 1) goto fail;
     if((blk_len * BLOCK_SIZE) != bufinfo.len) goto fail;
 
-    uint8_t *ptr = block_to_ptr(block_num, blk_len);
+    uint8_t *ptr = block_to_ptr(self->lun, block_num, blk_len);
     if(!ptr) goto fail;
 
     memcpy(bufinfo.buf, ptr, bufinfo.len);
@@ -395,7 +508,7 @@ fail:
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(psram_readblocks_obj, 3, 3, psram_readblocks);
 
 STATIC mp_obj_t psram_writeblocks(size_t n_args, const mp_obj_t *args) {
-    //psram_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    psram_obj_t *self = MP_OBJ_TO_PTR(args[0]);
     uint32_t block_num = mp_obj_get_int(args[1]);
 
     mp_buffer_info_t bufinfo;
@@ -406,7 +519,7 @@ STATIC mp_obj_t psram_writeblocks(size_t n_args, const mp_obj_t *args) {
     if(blk_len < 1) goto fail;
     if((blk_len * BLOCK_SIZE) != bufinfo.len) goto fail;
 
-    uint8_t *ptr = block_to_ptr(block_num, blk_len);
+    uint8_t *ptr = block_to_ptr(self->lun, block_num, blk_len);
     if(!ptr) goto fail;
 
     memcpy(ptr, bufinfo.buf, bufinfo.len);
@@ -418,18 +531,18 @@ fail:
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(psram_writeblocks_obj, 3, 3, psram_writeblocks);
 
-int direct_psram_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+static int direct_read_blocks(uint8_t lun, uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
     // Return zero or -MP_EIO
-    uint8_t *ptr = block_to_ptr(block_num, num_blocks);
+    uint8_t *ptr = block_to_ptr(lun, block_num, num_blocks);
     if(!ptr) return -MP_EIO;
 
     memcpy(dest, ptr, num_blocks * BLOCK_SIZE);
 
     return 0;
 }
-int direct_psram_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+static int direct_write_blocks(uint8_t lun, const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
     // Return zero or -MP_EIO
-    uint8_t *ptr = block_to_ptr(block_num, num_blocks);
+    uint8_t *ptr = block_to_ptr(lun, block_num, num_blocks);
     if(!ptr) return -MP_EIO;
 
     memcpy(ptr, src, num_blocks * BLOCK_SIZE);
@@ -443,8 +556,22 @@ int direct_psram_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t n
     return 0;
 }
 
+// native blockdev calls don't get the object, so need one of each per LUN
+int direct_psram_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    return direct_read_blocks(INBOX_LUN, dest, block_num, num_blocks);
+}
+int direct_psram_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    return direct_write_blocks(INBOX_LUN, src, block_num, num_blocks);
+}
+static int direct_outbox_read_blocks(uint8_t *dest, uint32_t block_num, uint32_t num_blocks) {
+    return direct_read_blocks(OUTBOX_LUN, dest, block_num, num_blocks);
+}
+static int direct_outbox_write_blocks(const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
+    return direct_write_blocks(OUTBOX_LUN, src, block_num, num_blocks);
+}
+
 STATIC mp_obj_t psram_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in) {
-    //psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
     mp_int_t cmd = mp_obj_get_int(cmd_in);
 
     switch (cmd) {
@@ -458,7 +585,7 @@ STATIC mp_obj_t psram_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in)
             return MP_OBJ_NEW_SMALL_INT(0);
 
         case MP_BLOCKDEV_IOCTL_BLOCK_COUNT:
-            return MP_OBJ_NEW_SMALL_INT(BLOCK_COUNT);
+            return MP_OBJ_NEW_SMALL_INT(luns[self->lun].num_blks);
 
         case MP_BLOCKDEV_IOCTL_BLOCK_SIZE:
             return MP_OBJ_NEW_SMALL_INT(BLOCK_SIZE);
@@ -466,7 +593,7 @@ STATIC mp_obj_t psram_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in)
         case MP_BLOCKDEV_IOCTL_BLOCK_ERASE: {
             mp_int_t block_num = mp_obj_get_int(arg_in);
 
-            uint8_t *ptr = block_to_ptr(block_num, 1);
+            uint8_t *ptr = block_to_ptr(self->lun, block_num, 1);
             if(!ptr) return mp_const_none;
 
             memset(ptr, 0xff, BLOCK_SIZE);
@@ -480,36 +607,51 @@ STATIC mp_obj_t psram_ioctl(mp_obj_t self_in, mp_obj_t cmd_in, mp_obj_t arg_in)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(psram_ioctl_obj, psram_ioctl);
 
-static void psram_init_vfs(fs_user_mount_t *vfs, bool readonly) {
+static void psram_init_vfs(fs_user_mount_t *vfs, psram_obj_t *self, bool readonly) {
     // Simulates mounting the block device into VFS system. Assumes FAT format.
+    bool outbox = (self->lun == OUTBOX_LUN);
+
     vfs->base.type = &mp_fat_vfs_type;
     vfs->blockdev.flags |= MP_BLOCKDEV_FLAG_NATIVE | MP_BLOCKDEV_FLAG_HAVE_IOCTL;
 
     vfs->fatfs.drv = vfs;
     vfs->fatfs.part = 0; // no partions; we have no MBR, like a floppy
     vfs->blockdev.readblocks[0] = MP_OBJ_FROM_PTR(&psram_readblocks_obj);
-    vfs->blockdev.readblocks[1] = MP_OBJ_FROM_PTR(&psram_obj);
-    vfs->blockdev.readblocks[2] = MP_OBJ_FROM_PTR(direct_psram_read_blocks);
+    vfs->blockdev.readblocks[1] = MP_OBJ_FROM_PTR(self);
+    vfs->blockdev.readblocks[2] = MP_OBJ_FROM_PTR(outbox ? direct_outbox_read_blocks
+                                                            : direct_psram_read_blocks);
     if(!readonly) {
         vfs->blockdev.writeblocks[0] = MP_OBJ_FROM_PTR(&psram_writeblocks_obj);
-        vfs->blockdev.writeblocks[1] = MP_OBJ_FROM_PTR(&psram_obj);
-        vfs->blockdev.writeblocks[2] = MP_OBJ_FROM_PTR(direct_psram_write_blocks);
+        vfs->blockdev.writeblocks[1] = MP_OBJ_FROM_PTR(self);
+        vfs->blockdev.writeblocks[2] = MP_OBJ_FROM_PTR(outbox ? direct_outbox_write_blocks
+                                                            : direct_psram_write_blocks);
     }
     vfs->blockdev.u.ioctl[0] = MP_OBJ_FROM_PTR(&psram_ioctl_obj);
-    vfs->blockdev.u.ioctl[1] = MP_OBJ_FROM_PTR(&psram_obj);
+    vfs->blockdev.u.ioctl[1] = MP_OBJ_FROM_PTR(self);
 }
 
-mp_obj_t psram_wipe_and_setup(mp_obj_t unused_self)
+mp_obj_t psram_wipe_and_setup(mp_obj_t self_in)
 {
     // Erase and reformat filesystem
     //  - you probably should unmount it, before calling this 
+    psram_obj_t *self = self_in ? MP_OBJ_TO_PTR(self_in) : &psram_obj;
+    const psram_lun_t *lu = &luns[self->lun];
+
+    if(!lu->num_blks) {
+        // outbox, when not in split mode
+        mp_raise_ValueError(NULL);
+    }
 
     // Wipe contents for security.
-    memset(PSRAM_TOP_BASE, 0x21, BLOCK_SIZE * BLOCK_COUNT);
+    memset(&PSRAM_TOP_BASE[lu->first_blk * BLOCK_SIZE], 0x21, BLOCK_SIZE * lu->num_blks);
+
+    if(self->lun == INBOX_LUN) {
+        all_changed = true;
+    }
 
     // Build obj to handle blockdev protocol
     fs_user_mount_t vfs = {0};
-    psram_init_vfs(&vfs, false);
+    psram_init_vfs(&vfs, self, false);
 
     // newfs:
     // - FAT16 (auto)
@@ -522,6 +664,13 @@ mp_obj_t psram_wipe_and_setup(mp_obj_t unused_self)
         goto fail;
     }
 
+    if(self->lun == OUTBOX_LUN) {
+        // nothing else on the outbox: it's for our results
+        f_setlabel(&vfs.fatfs, "CC-OUTBOX");
+
+        return mp_const_none;
+    }
+
     // set volume label, which becomes mountpoint on MacOS
     // .. can't do this from python AFAIK
     f_setlabel(&vfs.fatfs, "COLDCARD");
@@ -569,8 +718,54 @@ static DWORD clst2sect (    /* !=0:Sector number, 0:Failed (invalid cluster#) */
     return fs->database + fs->csize * clst;     /* Start sector number of the cluster */
 }
 
+// how many link map entries fit on the stack; more than enough unless fragmented
+#define SMALL_LINKMAP       64
+
+// file_link_map()
+//
+// Build the FatFs cluster link map for an open file: see
+// <http://elm-chan.org/fsw/ff/doc/lseek.html> to learn this magic. Uses the
+// caller's small table when it fits, otherwise one from the heap, sized as FatFs
+// asks. Returns number of extents found, and sets *map (maybe the small one)
+// and *map_len (zero if nothing to free).
+//
+    static int
+file_link_map(FIL *fp, DWORD *small, DWORD **map, DWORD *map_len)
+{
+    small[0] = SMALL_LINKMAP;
+    fp->cltbl = small;
+    *map = small;
+    *map_len = 0;
+
+    FRESULT rv = f_lseek(fp, CREATE_LINKMAP);
+
+    if(rv == FR_NOT_ENOUGH_CORE) {
+        // fragmented file: small[0] now holds required size of table
+        DWORD need = small[0];
+        DWORD *big = m_new(DWORD, need);
+
+        big[0] = need;
+        fp->cltbl = big;
+        *map = big;
+        *map_len = need;
+
+        rv = f_lseek(fp, CREATE_LINKMAP);
+    }
+
+    if(rv != FR_OK) {
+        mp_raise_ValueError(MP_ERROR_TEXT("lseek"));
+    }
+
+    // map[0] is now the number of words used, including itself
+    int num_used = ((*map)[0] - 1) / 2;
+    if(num_used < 1) {
+        mp_raise_ValueError(NULL);
+    }
+
+    return num_used;
+}
 
-mp_obj_t psram_mmap_file(mp_obj_t unused_self, mp_obj_t fname_in)
+mp_obj_t psram_mmap_file(mp_obj_t self_in, mp_obj_t fname_in)
 {
     // Find a file inside a FATFS and return a list of tuples which
     // provide the physical locations/lengths of the bytes of the
@@ -578,9 +773,11 @@ mp_obj_t psram_mmap_file(mp_obj_t unused_self, mp_obj_t fname_in)
     // - file path must be striped of mountpt
     const char *fname = mp_obj_str_get_str(fname_in);
 
+    psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
     // Build obj to handle python protocol
     fs_user_mount_t vfs = {0};
-    psram_init_vfs(&vfs, true);
+    psram_init_vfs(&vfs, self, true);
 
     FRESULT res = f_mount(&vfs.fatfs);
     if (res != FR_OK) {
@@ -593,34 +790,27 @@ mp_obj_t psram_mmap_file(mp_obj_t unused_self, mp_obj_t fname_in)
         mp_raise_ValueError(MP_ERROR_TEXT("file no open"));
     }
 
-    // see <http://elm-chan.org/fsw/ff/doc/lseek.html> to learn this magic
-    DWORD   mapping[64];
-    mapping[0] = MP_ARRAY_SIZE(mapping);
-    fp.cltbl = mapping;
-
-    int rv = f_lseek(&fp, CREATE_LINKMAP);
-    if(rv != FR_OK) {
-        mp_raise_ValueError(MP_ERROR_TEXT("lseek"));
-    }
+    // find the clusters, however many pieces
+    DWORD   small[SMALL_LINKMAP];
+    DWORD   *mapping, map_len;
+    int num_used = file_link_map(&fp, small, &mapping, &map_len);
 
     // Convert and remap list of clusters
 
     // import ckcc; ckcc.PSRAM().mmap('serial.txt')
     
-    int num_used = (mapping[0] - 1) / 2;
-    if((num_used < 1) || (num_used >= MP_ARRAY_SIZE(mapping))) {
-        mp_raise_ValueError(NULL);
-    }
     DWORD *ptr = &mapping[1];
 
-    mp_obj_t    tups[num_used];
+    // build result in place; too many to hold on the stack first
+    mp_obj_t rv = mp_obj_new_list(num_used, NULL);
+    mp_obj_t *tups = ((mp_obj_list_t *)MP_OBJ_TO_PTR(rv))->items;
 
     uint32_t so_far = 0;
     for(int i=0; i<num_used; i++) {
         int num_clusters = *(ptr++);
         uint32_t cluster = *(ptr++);
 
-        uint8_t *spot = block_to_ptr(clst2sect(&vfs.fatfs, cluster), num_clusters);
+        uint8_t *spot = block_to_ptr(self->lun, clst2sect(&vfs.fatfs, cluster), num_clusters);
         if(!spot) {
             //printf("[%d] (cl=0x%lx ln=%d) => ", i, cluster, num_clusters);
             //printf("0x%lx\n", clst2sect(&vfs.fatfs, cluster));
@@ -645,20 +835,26 @@ mp_obj_t psram_mmap_file(mp_obj_t unused_self, mp_obj_t fname_in)
     }
     f_close(&fp);
 
-    return mp_obj_new_list(num_used, tups);
+    if(map_len) {
+        m_del(DWORD, mapping, map_len);
+    }
+
+    return rv;
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(psram_mmap_file_obj, psram_mmap_file);
 
-mp_obj_t psram_copy_file(mp_obj_t unused_self, mp_obj_t offset_in, mp_obj_t fname_in)
+mp_obj_t psram_copy_file(mp_obj_t self_in, mp_obj_t offset_in, mp_obj_t fname_in)
 {
     // Find a file inside a FATFS and copy it into another area of PSRAM.
     // - file path must be striped of mountpt
     uint32_t    offset = mp_obj_get_int(offset_in);         // checks below
     const char *fname = mp_obj_str_get_str(fname_in);
 
+    psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
     // Build obj to handle python protocol
     fs_user_mount_t vfs = {0};
-    psram_init_vfs(&vfs, true);
+    psram_init_vfs(&vfs, self, true);
 
     FRESULT res = f_mount(&vfs.fatfs);
     if (res != FR_OK) {
@@ -671,22 +867,12 @@ mp_obj_t psram_copy_file(mp_obj_t unused_self, mp_obj_t offset_in, mp_obj_t fnam
         mp_raise_ValueError(MP_ERROR_TEXT("file no open"));
     }
 
-    // see <http://elm-chan.org/fsw/ff/doc/lseek.html> to learn this magic
-    DWORD   mapping[64];
-    mapping[0] = MP_ARRAY_SIZE(mapping);
-    fp.cltbl = mapping;
-
-    int rv = f_lseek(&fp, CREATE_LINKMAP);
-    if(rv != FR_OK) {
-        mp_raise_ValueError(MP_ERROR_TEXT("lseek"));
-    }
+    // find the clusters, however many pieces
+    DWORD   small[SMALL_LINKMAP];
+    DWORD   *mapping, map_len;
+    int num_used = file_link_map(&fp, small, &mapping, &map_len);
 
     // Convert and remap list of clusters
-    
-    int num_used = (mapping[0] - 1) / 2;
-    if((num_used < 1) || (num_used >= MP_ARRAY_SIZE(mapping))) {
-        mp_raise_ValueError(NULL);
-    }
 
     uint32_t actual_len = fp.obj.objsize;
 
@@ -704,7 +890,7 @@ mp_obj_t psram_copy_file(mp_obj_t unused_self, mp_obj_t offset_in, mp_obj_t fnam
         int num_clusters = *(ptr++);
         uint32_t cluster = *(ptr++);
 
-        uint8_t *spot = block_to_ptr(clst2sect(&vfs.fatfs, cluster), num_clusters);
+        uint8_t *spot = block_to_ptr(self->lun, clst2sect(&vfs.fatfs, cluster), num_clusters);
         if(!spot) {
             //printf("[%d] (cl=0x%lx ln=%d) => ", i, cluster, num_clusters);
             //printf("0x%lx\n", clst2sect(&vfs.fatfs, cluster));
@@ -728,10 +914,104 @@ mp_obj_t psram_copy_file(mp_obj_t unused_self, mp_obj_t offset_in, mp_obj_t fnam
     }
     f_close(&fp);
 
+    if(map_len) {
+        m_del(DWORD, mapping, map_len);
+    }
+
     return MP_OBJ_NEW_SMALL_INT(actual_len);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_3(psram_copy_file_obj, psram_copy_file);
 
+mp_obj_t psram_sha256_file(mp_obj_t self_in, mp_obj_t fname_in)
+{
+    // Find a file inside a FATFS and return (length, sha256 digest) of its
+    // contents, working directly on the clusters in memory.
+    // - file path must be striped of mountpt
+    const char *fname = mp_obj_str_get_str(fname_in);
+
+    psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    // Build obj to handle python protocol
+    fs_user_mount_t vfs = {0};
+    psram_init_vfs(&vfs, self, true);
+
+    FRESULT res = f_mount(&vfs.fatfs);
+    if (res != FR_OK) {
+        mp_raise_ValueError(MP_ERROR_TEXT("unmountable"));
+    }
+
+    // open the file directly
+    FIL fp = {0};
+    if(f_open(&vfs.fatfs, &fp, fname, FA_READ) != FR_OK) {
+        mp_raise_ValueError(MP_ERROR_TEXT("file no open"));
+    }
+
+    uint32_t actual_len = fp.obj.objsize;
+    uint8_t digest[32];
+
+    hw_sha256_start();
+
+    if(actual_len) {
+        // find the clusters, however many pieces
+        DWORD   small[SMALL_LINKMAP];
+        DWORD   *mapping, map_len;
+        int num_used = file_link_map(&fp, small, &mapping, &map_len);
+
+        // check all of them before starting: cannot stop halfway
+        uint32_t so_far = 0;
+        DWORD *ptr = &mapping[1];
+        for(int i=0; i<num_used; i++, ptr += 2) {
+            int num_clusters = ptr[0];
+
+            if(!block_to_ptr(self->lun, clst2sect(&vfs.fatfs, ptr[1]), num_clusters)) {
+                mp_raise_ValueError(MP_ERROR_TEXT("clstfck"));
+            }
+            so_far += num_clusters*BLOCK_SIZE;
+        }
+        if(so_far < actual_len) {
+            mp_raise_ValueError(NULL);
+        }
+
+        // all but last extent are whole clusters, so whole words
+        so_far = 0;
+        ptr = &mapping[1];
+        for(int i=0; i<num_used; i++, ptr += 2) {
+            int num_clusters = ptr[0];
+            const uint8_t *spot = block_to_ptr(self->lun,
+                                    clst2sect(&vfs.fatfs, ptr[1]), num_clusters);
+            uint32_t len = num_clusters*BLOCK_SIZE;
+            bool last = (i == num_used-1);
+
+            if(last) {
+                // final cluster might include some bytes past the EOF
+                len = actual_len - so_far;
+            } else {
+                so_far += len;
+            }
+
+            hw_sha256_update(spot, len, last);
+        }
+
+        if(map_len) {
+            m_del(DWORD, mapping, map_len);
+        }
+    } else {
+        hw_sha256_update(NULL, 0, true);
+    }
+
+    hw_sha256_final(digest);
+
+    f_close(&fp);
+
+    mp_obj_t    pair[2] = {
+        mp_obj_new_int_from_uint(actual_len),
+        mp_obj_new_bytes(digest, 32),
+    };
+
+    return mp_obj_new_tuple(2, pair);
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(psram_sha256_file_obj, psram_sha256_file);
+
 mp_obj_t psram_set_callback(mp_obj_t unused_self, mp_obj_t callback_in)
 {
     // set or clear the callback, use None to disable
@@ -743,19 +1023,40 @@ mp_obj_t psram_set_callback(mp_obj_t unused_self, mp_obj_t callback_in)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(psram_set_callback_obj, psram_set_callback);
 
-mp_obj_t psram_set_inserted(mp_obj_t unused_self, mp_obj_t enable_in)
+mp_obj_t psram_set_inserted(mp_obj_t self_in, mp_obj_t enable_in)
 {
     // set or clear insertion status (media started)
+    psram_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    psram_lun_t *lu = &luns[self->lun];
+
     if(enable_in != MP_ROM_NONE) {
         bool enable = !!mp_obj_get_int(enable_in);
 
-        flag_STARTED = enable;
+        lu->started = enable;
     }
 
-    return MP_OBJ_NEW_SMALL_INT(flag_STARTED);
+    return MP_OBJ_NEW_SMALL_INT(lu->started);
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(psram_set_inserted_obj, psram_set_inserted);
 
+mp_obj_t psram_set_split(mp_obj_t unused_self, mp_obj_t enable_in)
+{
+    // Change between one LUN (whole area) and inbox + read-only outbox.
+    // - USB must be disabled: host sees new number of LUNs when it enumerates again
+    // - contents are lost; caller must wipe() each disk after this
+    bool split = !!mp_obj_get_int(enable_in);
+
+    luns[INBOX_LUN].num_blks = split ? (BLOCK_COUNT - OUTBOX_BLOCKS) : BLOCK_COUNT;
+    luns[OUTBOX_LUN].first_blk = luns[INBOX_LUN].num_blks;
+    luns[OUTBOX_LUN].num_blks = split ? OUTBOX_BLOCKS : 0;
+    luns[OUTBOX_LUN].started = false;
+
+    psram_msc_lu_num = split ? 2 : 1;
+
+    return mp_const_none;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(psram_set_split_obj, psram_set_split);
+
 mp_obj_t psram_get_time(mp_obj_t unused_self)
 {
     // return time of last write from host
@@ -764,6 +1065,40 @@ mp_obj_t psram_get_time(mp_obj_t unused_self)
 }
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(psram_get_time_obj, psram_get_time);
 
+mp_obj_t psram_changes(mp_obj_t unused_self)
+{
+    // What has host changed in the inbox root directory, since last call?
+    // - None: nothing (ie. only file data, or same bytes rewritten)
+    // - True: can't say, look at everything
+    // - else: list of root directory entry numbers changed
+    // take a copy and reset, so USB irq can't change it while we look
+    uint8_t changed[sizeof(root_changed)];
+
+    mp_uint_t irq_state = disable_irq();
+    bool all = all_changed;
+    memcpy(changed, root_changed, sizeof(changed));
+    all_changed = false;
+    memset(root_changed, 0, sizeof(root_changed));
+    enable_irq(irq_state);
+
+    if(all) {
+        return mp_const_true;
+    }
+
+    mp_obj_t rv = mp_const_none;
+    for(int n=0; n < MAX_ROOT_ENTS; n++) {
+        if(!(changed[n / 8] & (1 << (n % 8)))) continue;
+
+        if(rv == mp_const_none) {
+            rv = mp_obj_new_list(0, NULL);
+        }
+        mp_obj_list_append(rv, MP_OBJ_NEW_SMALL_INT(n));
+    }
+
+    return rv;
+}
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(psram_changes_obj, psram_changes);
+
 
 STATIC const mp_rom_map_elem_t psram_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_readblocks), MP_ROM_PTR(&psram_readblocks_obj) },
@@ -772,9 +1107,12 @@ STATIC const mp_rom_map_elem_t psram_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_wipe), MP_ROM_PTR(&psram_wipe_obj) },
     { MP_ROM_QSTR(MP_QSTR_mmap), MP_ROM_PTR(&psram_mmap_file_obj) },
     { MP_ROM_QSTR(MP_QSTR_copy_file), MP_ROM_PTR(&psram_copy_file_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sha256), MP_ROM_PTR(&psram_sha256_file_obj) },
     { MP_ROM_QSTR(MP_QSTR_callback), MP_ROM_PTR(&psram_set_callback_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_inserted), MP_ROM_PTR(&psram_set_inserted_obj) },
+    { MP_ROM_QSTR(MP_QSTR_split), MP_ROM_PTR(&psram_set_split_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_time), MP_ROM_PTR(&psram_get_time_obj) },
+    { MP_ROM_QSTR(MP_QSTR_changes), MP_ROM_PTR(&psram_changes_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(psram_locals_dict, psram_locals_dict_table);
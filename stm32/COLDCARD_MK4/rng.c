@@ -58,23 +58,61 @@ static void rng_init(void) {
 
 static uint32_t last_value;
 
-static uint32_t rng_get_or_fault(void)
+// rng_seed_recover()
+//
+// Seed error: the noise source failed its health test. Per reference manual,
+// clear the flag and restart the peripheral; values already in DR are discarded.
+//
+static void rng_seed_recover(void)
 {
-    // Enable the RNG peripheral if it's not already enabled
-    rng_init();
-
-    // Wait for a new random number to be ready, takes on the order of 10us
-    uint32_t start = HAL_GetTick();
+    RNG->SR &= ~RNG_SR_SEIS;
+    RNG->CR &= ~RNG_CR_RNGEN;
+    RNG->CR |= RNG_CR_RNGEN;
+}
 
-    while (!(RNG->SR & RNG_SR_DRDY)) {
-        if (HAL_GetTick() - start >= RNG_TIMEOUT_MS) {
-            // hardware failure... do not return anything!
-            mp_raise_OSError(MP_EFAULT);
+// rng_wait_word()
+//
+// Wait for one new value, with health checks: fail rather than return anything
+// doubtful. Assumes rng_init() already done.
+//
+static uint32_t rng_wait_word(void)
+{
+    uint32_t sr = RNG->SR;
+
+    if((sr & (RNG_SR_DRDY | RNG_SR_SECS | RNG_SR_CECS)) != RNG_SR_DRDY) {
+        // slow path: not ready yet, or a fault. Takes on the order of 1us normally.
+        uint32_t start = HAL_GetTick();
+
+        while(1) {
+            if(sr & RNG_SR_CECS) {
+                // RNG clock is wrong, so noise source can't be trusted
+                mp_raise_OSError(MP_EFAULT);
+            }
+            if(sr & RNG_SR_SECS) {
+                rng_seed_recover();
+            } else if(sr & RNG_SR_DRDY) {
+                break;
+            }
+
+            if(HAL_GetTick() - start >= RNG_TIMEOUT_MS) {
+                // hardware failure... do not return anything!
+                mp_raise_OSError(MP_EFAULT);
+            }
+
+            sr = RNG->SR;
         }
     }
 
+    return RNG->DR;
+}
+
+static uint32_t rng_get_or_fault(void)
+{
+    // Enable the RNG peripheral if it's not already enabled
+    rng_init();
+
     // Get and return the new random number
-    last_value = RNG->DR;
+    last_value = rng_wait_word();
 
     return last_value;
 }
@@ -132,21 +170,32 @@ random_buffer(uint8_t *p, size_t count)
 {
     uint32_t last = last_value;
 
+    rng_init();
+
     while(count) {
-        uint32_t next = rng_get_or_fault();
+        uint32_t next = rng_wait_word();
 
         if(next == last) {
             // if rng_init0 isn't called at boot time, then this fault will happen! Very Bad!
             mp_raise_OSError(MP_EEXIST);
         }
 
-        int here = MIN(4, count);
-
-        memcpy(p, &next, here);
-        p += here;
-        count -= here;
+        if(count >= 4 && !((uint32_t)p & 3)) {
+            // typical case for bulk fills: aligned word writes
+            *(uint32_t *)p = next;
+            p += 4;
+            count -= 4;
+        } else {
+            int here = MIN(4, count);
+
+            memcpy(p, &next, here);
+            p += here;
+            count -= here;
+        }
 
         last = next;
     }
+
+    last_value = last;
 }
 
@@ -0,0 +1,94 @@
+/*
+ * (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+ *
+ * seed_xor.c - combine Seed XOR parts, and find BIP-39 word numbers of the result.
+ *
+ * - exposed as ckcc.seed_xor(parts), see modckcc.c
+ * - semantics must match seed_xor() in unix/variant/ckcc.py
+ * - returns word numbers, not words: caller has bip39.wordlist_en for that
+ *
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "py/obj.h"
+#include "py/runtime.h"
+#include "hw_sha256.h"
+
+// seed_xor(parts)
+//
+// Parts is a list of 16, 24 or 32 byte values (encoded seed phrases), all same
+// length. Returns (bytearray of combined value, tuple of word numbers), where
+// last word includes the BIP-39 checksum bits.
+//
+    STATIC mp_obj_t
+seed_xor(mp_obj_t parts_in)
+{
+    size_t num_parts;
+    mp_obj_t *parts;
+    mp_obj_get_array(parts_in, &num_parts, &parts);
+
+    if(num_parts < 1) {
+        mp_raise_ValueError(NULL);
+    }
+
+    // combined value, plus room for checksum byte
+    uint8_t acc[32 + 1] = { 0 };
+    size_t vlen = 0;
+
+    for(size_t i=0; i < num_parts; i++) {
+        mp_buffer_info_t buf;
+        mp_get_buffer_raise(parts[i], &buf, MP_BUFFER_READ);
+
+        if(i == 0) {
+            vlen = buf.len;
+            if(vlen != 16 && vlen != 24 && vlen != 32) {
+                mp_raise_ValueError(MP_ERROR_TEXT("length"));
+            }
+        } else if(buf.len != vlen) {
+            memset(acc, 0, sizeof(acc));
+            mp_raise_ValueError(MP_ERROR_TEXT("length"));
+        }
+
+        const uint8_t *p = buf.buf;
+        for(size_t j=0; j < vlen; j++) {
+            acc[j] ^= p[j];
+        }
+    }
+
+    // checksum is first vlen/4 bits of sha256; never more than one byte
+    uint8_t digest[32];
+    hw_sha256_start();
+    hw_sha256_update(acc, vlen, true);
+    hw_sha256_final(digest);
+    acc[vlen] = digest[0];
+    memset(digest, 0, sizeof(digest));
+
+    // 11 bits per word, big-endian, across entropy and checksum
+    int num_words = (vlen * 8 + vlen / 4) / 11;
+    mp_obj_t words[24];
+    uint32_t bits = 0;
+    int have = 0;
+    const uint8_t *p = acc;
+
+    for(int i=0; i < num_words; i++) {
+        while(have < 11) {
+            bits = (bits << 8) | *(p++);
+            have += 8;
+        }
+        have -= 11;
+        words[i] = MP_OBJ_NEW_SMALL_INT((bits >> have) & 0x7ff);
+    }
+    bits = 0;
+
+    mp_obj_t rv[2] = {
+        mp_obj_new_bytearray(vlen, acc),
+        mp_obj_new_tuple(num_words, words),
+    };
+    memset(acc, 0, sizeof(acc));
+
+    return mp_obj_new_tuple(2, rv);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(seed_xor_obj, seed_xor);
+
+// EOF
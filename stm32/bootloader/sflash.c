@@ -50,10 +50,13 @@ static SPI_HandleTypeDef   sf_spi_port;
 
 uint32_t     sf_completed_upgrade;
 
-// sf_read_bytes()
+// sf_read_start()
+//
+// Start a continuous read: chip auto-increments the address for as long as
+// CS stays low. Follow with sf_read_more() calls, then sf_read_end().
 //
     static HAL_StatusTypeDef
-sf_read(uint32_t addr, int len, uint8_t *buf)
+sf_read_start(uint32_t addr)
 {
     // send via SPI(1)
     uint8_t     pkt[5] = { CMD_FAST_READ,
@@ -63,11 +66,43 @@ sf_read(uint32_t addr, int len, uint8_t *buf)
     CS_LOW();
 
     HAL_StatusTypeDef rv = HAL_SPI_Transmit(&sf_spi_port, pkt, sizeof(pkt), HAL_MAX_DELAY);
-    if(rv == HAL_OK) {
-        rv = HAL_SPI_Receive(&sf_spi_port, buf, len, HAL_MAX_DELAY);
+    if(rv != HAL_OK) {
+        CS_HIGH();
     }
 
+    return rv;
+}
+
+// sf_read_more()
+//
+// Next len bytes of a read started by sf_read_start(). Clock only runs
+// during the transfer, so caller can do other work between calls.
+//
+    static inline HAL_StatusTypeDef
+sf_read_more(int len, uint8_t *buf)
+{
+    return HAL_SPI_Receive(&sf_spi_port, buf, len, HAL_MAX_DELAY);
+}
+
+// sf_read_end()
+//
+    static inline void
+sf_read_end(void)
+{
     CS_HIGH();
+}
+
+// sf_read()
+//
+    static HAL_StatusTypeDef
+sf_read(uint32_t addr, int len, uint8_t *buf)
+{
+    HAL_StatusTypeDef rv = sf_read_start(addr);
+
+    if(rv == HAL_OK) {
+        rv = sf_read_more(len, buf);
+        sf_read_end();
+    }
 
     return rv;
 }
@@ -236,13 +271,18 @@ sf_do_upgrade(uint32_t size)
 
     uint8_t     tmp[256] __attribute__((aligned(8)));
 
+    // one read command for whole image, rather than one per chunk
+    if(sf_read_start(0) != HAL_OK) {
+        INCONSISTENT();
+    }
+
     for(uint32_t pos=0; pos<size; pos += sizeof(tmp)) {
         // show some progress
         if((pos % 4096) == 0) {
             oled_show_progress(screen_upgrading, pos*100/size);
         }
 
-        if(sf_read(pos, sizeof(tmp), tmp) != HAL_OK) {
+        if(sf_read_more(sizeof(tmp), tmp) != HAL_OK) {
             INCONSISTENT();
         }
 
@@ -257,12 +297,17 @@ sf_do_upgrade(uint32_t size)
                 ASSERT(rv == 0);
             }
 
-            rv = flash_burn(addr, *(b++));
-            ASSERT(rv == 0);
+            // erased flash reads as all ones already: skip the slow burn
+            if(*b != ~0ULL) {
+                rv = flash_burn(addr, *b);
+                ASSERT(rv == 0);
+            }
+            b++;
             addr += sizeof(uint64_t);
         }
 
         if(dfu_button_pressed() && !flash_is_security_level2()) {
+            sf_read_end();
             flash_lock();
 
             dfu_by_request();
@@ -270,6 +315,7 @@ sf_do_upgrade(uint32_t size)
         }
     }
 
+    sf_read_end();
     flash_lock();
 }
 
@@ -291,12 +337,19 @@ sf_calc_checksum(const coldcardFirmwareHeader_t *hdr, uint8_t fw_digest[32])
     uint32_t pos = 0;
     uint8_t buf[128];
     STATIC_ASSERT(FW_HEADER_OFFSET % sizeof(buf) == 0);
+    STATIC_ASSERT(FW_HEADER_SIZE == sizeof(buf));
 
     oled_show_progress(screen_verify, 1);
 
+    // single continuous read, from start to end of firmware
+    if(sf_read_start(0) != HAL_OK) {
+        goto fail;
+    }
+
     // do part up to header.
     for(; pos < FW_HEADER_OFFSET; pos += sizeof(buf)) { 
-        if(sf_read(pos, sizeof(buf), buf) != HAL_OK) {
+        if(sf_read_more(sizeof(buf), buf) != HAL_OK) {
+            sf_read_end();
         fail:
             // fail for sure with bad signature; user can try again
             memset(fw_digest, 0, 32);
@@ -311,10 +364,16 @@ sf_calc_checksum(const coldcardFirmwareHeader_t *hdr, uint8_t fw_digest[32])
     sha256_update(&ctx, (const uint8_t *)hdr, FW_HEADER_SIZE - 64);
 
     // then the rest after the 'header' ... the useful firmware
+    // - header copy in sflash still has to be clocked past
+    if(sf_read_more(FW_HEADER_SIZE, buf) != HAL_OK) {
+        sf_read_end();
+        goto fail;
+    }
     pos += FW_HEADER_SIZE;
 
     for(int count=0; pos < total_len; pos += sizeof(buf), count++) { 
-        if(sf_read(pos, sizeof(buf), buf) != HAL_OK) {
+        if(sf_read_more(sizeof(buf), buf) != HAL_OK) {
+            sf_read_end();
             goto fail;
         }
         sha256_update(&ctx, buf, sizeof(buf));
@@ -325,6 +384,8 @@ sf_calc_checksum(const coldcardFirmwareHeader_t *hdr, uint8_t fw_digest[32])
         }
     }
 
+    sf_read_end();
+
     ASSERT(pos == hdr->firmware_length);
 
     sha256_final(&ctx, fw_digest);
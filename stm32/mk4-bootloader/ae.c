@@ -45,6 +45,11 @@ static const char *copyright_msg = "Copyright 2018- by Coinkite Inc.";
 #define AE_CHIP_IS_SETUP        0x35d25d63
 static uint32_t ae_chip_is_setup;
 
+// Inside a short run of commands (see ae_seq_begin), and chip has been woken
+// since; so no need to wake it again before next command.
+static bool ae_in_seq;
+static bool ae_seq_awake;
+
 // Forward refs...
 static void crc16_chain(uint8_t length, const uint8_t *data, uint8_t crc[2]);
 static void ae_wake(void);
@@ -303,6 +308,7 @@ ae_send_sleep(void)
     ae_wake();
 
     _send_bits(IOFLAG_SLEEP);
+    ae_seq_awake = false;
 }
 
 // ae_send_idle()
@@ -316,6 +322,30 @@ ae_send_idle(void)
     ae_wake();
 
     _send_bits(IOFLAG_IDLE);
+    ae_seq_awake = false;
+}
+
+// ae_seq_begin()
+//
+// Start a run of commands which happen back-to-back: the chip is woken before
+// the first, but stays awake after that, so we skip the 3ms wake cycle for the
+// others. Caller must keep the whole run well inside the chip's watchdog
+// period (~1.3s), so only for short sequences without user interaction.
+//
+    static void
+ae_seq_begin(void)
+{
+    ae_in_seq = true;
+    ae_seq_awake = false;
+}
+
+// ae_seq_end()
+//
+    static void
+ae_seq_end(void)
+{
+    ae_in_seq = false;
+    ae_seq_awake = false;
 }
 
 // ae_reset_chip()
@@ -650,7 +680,11 @@ ae_send_n(aeopcode_t opcode, uint8_t p1, uint16_t p2, const uint8_t *data, uint8
     STATS(last_p2 = p2);
 
     // important to wake chip at this point.
-    ae_wake();
+    // - unless part of a sequence, and it's already awake
+    if(!ae_seq_awake) {
+        ae_wake();
+        ae_seq_awake = ae_in_seq;
+    }
 
     _send_serialized((const uint8_t *)&known, sizeof(known));
 
@@ -902,10 +936,15 @@ ae_checkmac(uint8_t keynum, const uint8_t secret[32])
 	ae_keep_alive();
 
 	// - load tempkey with a known nonce value
+	// - then CheckMac right after, without another wake
 	uint8_t zeros[8] = {0};
 	uint8_t tempkey[32];
+    ae_seq_begin();
 	rv = ae_pick_nonce(numin, tempkey);
-	RET_IF_BAD(rv);
+    if(rv) {
+        ae_seq_end();
+        return rv;
+    }
 
 	// - hash nonce and lots of other bits together
 	SHA256_CTX ctx;
@@ -954,6 +993,8 @@ ae_checkmac(uint8_t keynum, const uint8_t secret[32])
 	ae_send_n(OP_CheckMac, 0x01, keynum, (uint8_t *)&req, sizeof(req));
 
 	rv = ae_read1();
+    ae_seq_end();
+
 	if(rv != 0) {
 		// did it work?! No.
 		if(rv == AE_CHECKMAC_FAIL) {
@@ -1330,13 +1371,18 @@ ae_gendig_slot(int slot_num, const uint8_t slot_contents[32], uint8_t digest[32]
     uint8_t num_in[20], tempkey[32];
 
 	rng_buffer(num_in, sizeof(num_in));
+    ae_seq_begin();
 	int rv = ae_pick_nonce(num_in, tempkey);
-    RET_IF_BAD(rv);
+    if(rv) {
+        ae_seq_end();
+        return rv;
+    }
 
     //using Zone=2="Data" => "KeyID specifies a slot in the Data zone"
     ae_send(OP_GenDig, 0x2, slot_num);
 
     rv = ae_read1();
+    ae_seq_end();
     RET_IF_BAD(rv);
 
     ae_keep_alive();
@@ -1376,13 +1422,18 @@ ae_gendig_counter(int counter_num, const uint32_t expected_value, uint8_t digest
     uint8_t num_in[20], tempkey[32];
 
 	rng_buffer(num_in, sizeof(num_in));
+    ae_seq_begin();
 	int rv = ae_pick_nonce(num_in, tempkey);
-    RET_IF_BAD(rv);
+    if(rv) {
+        ae_seq_end();
+        return rv;
+    }
 
     //using Zone=4="Counter" => "KeyID specifies the monotonic counter ID"
     ae_send(OP_GenDig, 0x4, counter_num);
 
     rv = ae_read1();
+    ae_seq_end();
     RET_IF_BAD(rv);
 
     ae_keep_alive();
@@ -55,6 +55,12 @@ static const uint8_t before_show[] = {
 static SPI_HandleTypeDef   spi_port;
 #endif
 
+// Last image drawn by oled_show_progress, and what went onto its bottom line
+// (incl. bar), so we can send just the newly-filled columns next time.
+static const uint8_t *bar_pixels;
+static uint32_t bar_count;
+static uint8_t bar_line[128];
+
 // write_bytes()
 //
     static inline void
@@ -209,6 +215,7 @@ oled_setup(void)
 oled_show_raw(uint32_t len, const uint8_t *pixels)
 {
     oled_setup();
+    bar_pixels = NULL;
 
     oled_write_cmd_sequence(sizeof(before_show), before_show);
 
@@ -230,6 +237,7 @@ oled_show_raw(uint32_t len, const uint8_t *pixels)
 oled_show(const uint8_t *pixels)
 {
     oled_setup();
+    bar_pixels = NULL;
 
     oled_write_cmd_sequence(sizeof(before_show), before_show);
 
@@ -266,12 +274,47 @@ oled_show(const uint8_t *pixels)
 // oled_show_progress()
 //
 // Perform simple RLE decompression, and add a bar on final screen line.
+//
+// - if same image as last call and bar has only grown, sends just the new
+//   columns of the bottom page, not whole screen
+// - zero progress always redraws everything: callers start there, and the
+//   main firmware may have drawn over us since last time
 //
     void
 oled_show_progress(const uint8_t *pixels, int progress)
 {
     oled_setup();
 
+    const uint16_t p_start = 896;
+    uint32_t p_count = 1280 * progress / 1000;
+
+    if(p_count > 128) p_count = 128;
+    if(p_count < 0) p_count = 0;
+
+    if((pixels == bar_pixels) && p_count && (p_count >= bar_count)) {
+        if(p_count == bar_count) return;
+
+        const uint8_t cmds[] = {
+            0x21, bar_count, p_count-1,     // column address range: new part of bar
+            0x22, 0x07, 0x07                // page start/end address: last 8 lines
+        };
+
+        for(int x=bar_count; x < p_count; x++) {
+            bar_line[x] |= 0x80;
+        }
+
+        oled_write_cmd_sequence(sizeof(cmds), cmds);
+        oled_write_data(p_count - bar_count, bar_line + bar_count);
+
+        bar_count = p_count;
+        rng_delay();
+
+        return;
+    }
+
+    bar_pixels = pixels;
+    bar_count = p_count;
+
     oled_write_cmd_sequence(sizeof(before_show), before_show);
 
     HAL_GPIO_WritePin(GPIOA, CS_PIN, 1);
@@ -281,12 +324,6 @@ oled_show_progress(const uint8_t *pixels, int progress)
     uint8_t         buf[127];
     const uint8_t *p = pixels;
 
-    const uint16_t p_start = 896;
-    uint32_t p_count = 1280 * progress / 1000;
-
-    if(p_count > 128) p_count = 128;
-    if(p_count < 0) p_count = 0;
-
     bool last_line = false;
 
     uint16_t offset = 0;
@@ -322,6 +359,8 @@ oled_show_progress(const uint8_t *pixels, int progress)
             for(int j=0; (p_count > 0) && (j<len); j++, p_count--) {
                 buf[j] |= 0x80;
             }
+
+            memcpy(bar_line + (offset - p_start), buf, len);
         }
 
         write_bytes(len, buf);
@@ -300,7 +300,8 @@ psram_recover_firmware(void)
 // psram_do_upgrade()
 //
 // Copy from PSRAM to real flash, at final executable location.
-// Takes just 15 seconds!
+// Uses fast row programming, which is much quicker than double-words, and
+// leaves alone any pages which are already correct.
 //
 // NOTE: Incoming start address is typically not aligned.
 //
@@ -322,40 +323,51 @@ psram_do_upgrade(const uint8_t *start, uint32_t size)
 
     int rv;
 
-    // one uint64_t at a time = 8 bytes
-    uint64_t tmp;
-    for(uint32_t pos=0; pos < size; pos += 8) {
+    // whole rows at a time, using fast programming; source data is copied
+    // into SRAM first, since PSRAM isn't aligned, and FSTPG wants no stalls
+    uint32_t row[FLASH_ROW_SIZE/4];
+    uint32_t pos = 0;
+
+    for(; pos+FLASH_ROW_SIZE <= size; pos += FLASH_ROW_SIZE) {
         uint32_t dest = FIRMWARE_START+pos;
 
-        if(dest % (4*FLASH_ERASE_SIZE) == 0) {
+        if(dest % (16*FLASH_ERASE_SIZE) == 0) {
             // show some progress
             oled_show_progress(screen_upgrading, pos*100/size);
         }
 
+        if(dest % FLASH_ERASE_SIZE == 0) {
+            // skip whole pages which already hold the right bytes; typical
+            // between point releases. Safe to redo if we get reset partway.
+            if((pos + FLASH_ERASE_SIZE <= size)
+                    && memcmp((const void *)dest, start+pos, FLASH_ERASE_SIZE) == 0) {
+                pos += FLASH_ERASE_SIZE - FLASH_ROW_SIZE;
+                continue;
+            }
+
+            // page erase as we go
+            rv = flash_page_erase(dest);
+            ASSERT(rv == 0);
+        }
+
+        memcpy(row, start+pos, FLASH_ROW_SIZE);
+        rv = flash_burn_row(dest, row);
+        ASSERT(rv == 0);
+    }
+
+    // any runt at the end: one uint64_t at a time = 8 bytes
+    uint64_t tmp;
+    for(; pos < size; pos += 8) {
+        uint32_t dest = FIRMWARE_START+pos;
+
         if(dest % FLASH_ERASE_SIZE == 0) {
             // page erase as we go
             rv = flash_page_erase(dest);
-#if 0
-            if(rv) {
-                puts2("erase rv=");
-                puthex2(rv);
-                putchar('\n');
-            }
-#endif
             ASSERT(rv == 0);
         }
 
         memcpy(&tmp, start+pos, 8);
         rv = flash_burn(dest, tmp);
-#if 0
-        if(rv) {
-            puts2("burn rv=");
-            puthex2(rv);
-            puts2(" addr=");
-            puthex8(dest);
-            putchar('\n');
-        }
-#endif
         ASSERT(rv == 0);
     }
 
@@ -183,24 +183,28 @@ dfu_hdr_parse(const uint8_t *ptr, uint32_t *target_size)
     return NULL;
 }
 
+// bytes read from card at once; half of all our SRAM 0x00002000
+#define CHUNK_SIZE      (512*8)
+
 // sdcard_try_file()
 //
-    void
-sdcard_try_file(uint32_t blk_pos)
+// Caller's buffer (CHUNK_SIZE) is used for reading, since we don't have room for two.
+//
+    static void
+sdcard_try_file(uint32_t blk_pos, uint8_t buf[CHUNK_SIZE])
 {
     oled_show(screen_verify);
 
     // read full possible file into PSRAM, assume continguous, and big enough
     uint8_t *ps = (uint8_t *)PSRAM_BASE;
-    uint8_t buf[512*8];      // half of all our SRAM 0x00002000
     
-    for(uint32_t off = 0; off < FW_MAX_LENGTH_MK4; off += sizeof(buf)) {
-        int rv = HAL_SD_ReadBlocks(&hsd, buf, blk_pos+(off/512), sizeof(buf)/512, 60000);
+    for(uint32_t off = 0; off < FW_MAX_LENGTH_MK4; off += CHUNK_SIZE) {
+        int rv = HAL_SD_ReadBlocks(&hsd, buf, blk_pos+(off/512), CHUNK_SIZE/512, 60000);
         if(rv != HAL_OK) {
             puts("long read fail");
             return;
         }
-        memcpy(ps + off, buf, sizeof(buf));
+        memcpy(ps + off, buf, CHUNK_SIZE);
     }
 
     // work in psram now
@@ -252,32 +256,46 @@ sdcard_search(void)
     sdcard_setup();
     if(!sdcard_probe(&num_blocks)) return;
 
-    uint8_t     blk[512];
-    for(int pos=0; pos<num_blocks; pos += 1) {
-        // read a single block
-        int rv = HAL_SD_ReadBlocks(&hsd, blk, pos, 1, 60000);
+    // multi-block reads are much faster than one at a time
+    uint8_t     buf[CHUNK_SIZE];
+    uint32_t    next_redraw = 0;
+
+    for(uint32_t pos=0; pos<num_blocks; ) {
+        if(pos >= next_redraw) {
+            oled_show_progress(screen_search, pos*100 / num_blocks);
+            sdcard_light(true);
+            next_redraw = pos + 128;
+        }
+
+        uint32_t count = MIN(CHUNK_SIZE/512, num_blocks - pos);
+        int rv = HAL_SD_ReadBlocks(&hsd, buf, pos, count, 60000);
         if(rv != HAL_OK) {
             puts("fail read");
 
             return;
         }
 
-        if(memcmp(blk, "DfuSe", 5) == 0) {
-            // candidate file found
-            puts2("found @ ");
-            puthex8(pos);
-            putchar('\n');
-
-            sdcard_try_file(pos);
-
-            goto redraw;
+        uint32_t i;
+        for(i=0; i<count; i++) {
+            if(memcmp(buf + (512*i), "DfuSe", 5) == 0) break;
         }
 
-        if(pos % 128 == 0) {
-        redraw:
-            oled_show_progress(screen_search, pos*100 / num_blocks);
-            sdcard_light(true);
+        if(i == count) {
+            pos += count;
+            continue;
         }
+
+        // candidate file found
+        pos += i;
+        puts2("found @ ");
+        puthex8(pos);
+        putchar('\n');
+
+        sdcard_try_file(pos, buf);
+
+        // not it; keep looking after that block (buffer was reused)
+        pos += 1;
+        next_redraw = pos;
     }
 
 }
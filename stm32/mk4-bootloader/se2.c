@@ -44,6 +44,10 @@ static se2_secrets_t _tbd;
 // HAL API requires shift here.
 #define I2C_ADDR        (0x1b << 1)
 
+// number of immediate retries when polling for a response, before we start to
+// wait between tries: roughly 5ms of bus time at 400khz
+#define FAST_POLLS      160
+
 // Result codes from chip
 // - the meaning depends on the command
 #define RC_SUCCESS      0xAA
@@ -154,9 +158,11 @@ se2_read_n(uint8_t len, uint8_t *rx)
     // Response time of the chip varies from 0ms (read buffer), is typically
     // 3ms for simple things, and peaks at 200ms for complex ECC stuff.
     // Poll until chip provides an answer.
+    // - first polls are back-to-back: each NACK'ed attempt takes ~30us of bus
+    //   time, so we see typical answers right away, rather than on next 1ms tick
     ASSERT(len >= 2);
 
-    for(int tries=0; tries<300; tries++) {
+    for(int tries=0; tries<(FAST_POLLS+300); tries++) {
         HAL_StatusTypeDef rv = HAL_I2C_Master_Receive(&i2c_port, I2C_ADDR, rx, len, HAL_MAX_DELAY);
         if(rv == HAL_OK) {
             if(rx[0] != len-1) {
@@ -166,7 +172,9 @@ se2_read_n(uint8_t len, uint8_t *rx)
             return rx[1];
         }
 
-        delay_ms(1);
+        if(tries >= FAST_POLLS) {
+            delay_ms(1);
+        }
     }
 
     // timeout
@@ -344,13 +352,12 @@ se2_write_encrypted(uint8_t page_num, const uint8_t data[32], int keynum, const
 
 
 
-// se2_read_encrypted()
+// se2_read_decrypt()
 //
-// - use key to read, but must also do verify because no replay protection otherwise
-// - page must be protected with EPH or ECH, and of course !RP
+// Read and decrypt a page, but NOT verified yet. See se2_read_encrypted().
 //
-    void
-se2_read_encrypted(uint8_t page_num, uint8_t data[32], int keynum, const uint8_t *secret)
+    static void
+se2_read_decrypt(uint8_t page_num, uint8_t data[32], int keynum, const uint8_t *secret)
 {
     // only supporting secret A or S.
     ASSERT((keynum == 0) || (keynum == 2));
@@ -379,11 +386,45 @@ se2_read_encrypted(uint8_t page_num, uint8_t data[32], int keynum, const uint8_t
     hmac_sha256_final(&ctx, secret, otp);
 
     xor_mixin(data, otp, 32);
+}
+
+// se2_read_encrypted()
+//
+// - use key to read, but must also do verify because no replay protection otherwise
+// - page must be protected with EPH or ECH, and of course !RP
+//
+    void
+se2_read_encrypted(uint8_t page_num, uint8_t data[32], int keynum, const uint8_t *secret)
+{
+    se2_read_decrypt(page_num, data, keynum, secret);
 
     // CRITICAL: verify right result using a nonce we pick!
     CHECK_RIGHT(se2_verify_page(page_num, data, keynum, secret));
 }
 
+// se2_read_encrypted_n()
+//
+// Same as se2_read_encrypted() over a run of pages: all the reads first, then all
+// the verifies, and only then check results. Every page gets the same bus traffic
+// and work, regardless of what fails.
+//
+    static void
+se2_read_encrypted_n(uint8_t first_page, int count, uint8_t data[][32],
+                        int keynum, const uint8_t *secret)
+{
+    for(int i=0; i<count; i++) {
+        se2_read_decrypt(first_page+i, data[i], keynum, secret);
+    }
+
+    // CRITICAL: verify right result using a nonce we pick! (for each)
+    bool ok = true;
+    for(int i=0; i<count; i++) {
+        ok &= se2_verify_page(first_page+i, data[i], keynum, secret);
+    }
+
+    CHECK_RIGHT(ok);
+}
+
 
 // se2_get_protection()
 //
@@ -652,11 +693,10 @@ se2_read_trick_data(int slot_num, uint16_t tc_flags, uint8_t data[64])
     if(setjmp(error_env)) fatal_mitm();
 
     se2_setup();
-    se2_read_encrypted(slot_num+1, &data[0], 0, SE2_SECRETS->pairing);
 
-    if(tc_flags & TC_XPRV_WALLET) {
-        se2_read_encrypted(slot_num+2, &data[32], 0, SE2_SECRETS->pairing);
-    }
+    // one slot, or two for xprv
+    int count = (tc_flags & TC_XPRV_WALLET) ? 2 : 1;
+    se2_read_encrypted_n(slot_num+1, count, (uint8_t (*)[32])data, 0, SE2_SECRETS->pairing);
 }
 
 // se2_test_trick_pin()
@@ -686,10 +726,7 @@ se2_test_trick_pin(const char *pin, int pin_len, trick_slot_t *found_slot, bool
 
     // always read all data first, and without any time differences
     uint8_t slots[NUM_TRICKS][32];
-    int pn = PGN_TRICK(0);
-    for(int i=0; i<NUM_TRICKS; i++, pn++) {
-        se2_read_encrypted(pn, slots[i], 0, SE2_SECRETS->pairing);
-    }
+    se2_read_encrypted_n(PGN_TRICK(0), NUM_TRICKS, slots, 0, SE2_SECRETS->pairing);
     se2_clear_volatile();
     
     // Look for matches
@@ -200,6 +200,53 @@ flash_burn(uint32_t address, uint64_t val)
     return rv;
 }
 
+// flash_burn_row()
+//
+// Fast-program one row (512 bytes, 64 double-words) that was already erased.
+// See FLASH_Program_Fast() in HAL. Same rules as flash_burn() but also:
+//  - dest must be row-aligned, and src must be aligned and in SRAM: no flash
+//    reads of any kind are allowed until the row is complete
+//  - the whole row must be written, back to back, or we get MISSERR; so
+//    interrupts are masked during the loop, like HAL does
+//
+    __attribute__((section(".ramfunc")))
+    __attribute__((noinline))
+    int
+flash_burn_row(uint32_t address, const uint32_t *src)
+{
+    uint32_t    rv;
+
+    _flash_wait_done();
+
+    // clear any and all errors, including PEMPTY
+    FLASH->SR = FLASH->SR & FLASH_FLAG_SR_ERRORS;
+
+    __HAL_FLASH_DATA_CACHE_DISABLE();
+
+    CLEAR_BIT(FLASH->CR, (FLASH_CR_PG | FLASH_CR_MER1 | FLASH_CR_PER | FLASH_CR_PNB));
+    SET_BIT(FLASH->CR, FLASH_CR_FSTPG);
+
+    // all 128 words, back to back, with no interruptions
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    __IO uint32_t *dest = (__IO uint32_t *)address;
+    for(int i=0; i<FLASH_ROW_SIZE/4; i++) {
+        *(dest++) = *(src++);
+    }
+
+    __set_PRIMASK(primask);
+
+    rv = _flash_wait_done();
+
+    CLEAR_BIT(FLASH->CR, FLASH_CR_FSTPG);
+
+    __HAL_FLASH_DATA_CACHE_RESET();
+    __HAL_FLASH_DATA_CACHE_ENABLE();
+
+    return rv;
+}
+
 // flash_page_erase()
 //
 // See HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *PageError)
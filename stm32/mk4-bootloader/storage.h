@@ -16,6 +16,10 @@
 // but when erasing "pages" they are half as big, since only in one physical bank
 #define FLASH_ERASE_SIZE                    ((uint32_t)0x1000)
 
+// unit for fast programming (FSTPG): 64 double-words on L4+ parts,
+// see FLASH_NB_DOUBLE_WORDS_IN_ROW in HAL and RM0432
+#define FLASH_ROW_SIZE                      512
+
 // Details of the OTP area. 64-bit slots.
 #define OPT_FLASH_BASE     0x1FFF7000
 #define NUM_OPT_SLOTS      128
@@ -46,6 +50,7 @@ void flash_setup0(void);
 void flash_lock(void);
 void flash_unlock(void);
 int flash_burn(uint32_t address, uint64_t val);
+int flash_burn_row(uint32_t address, const uint32_t *src);
 int flash_page_erase(uint32_t address);
 
 // write to OTP
@@ -1,7 +1,10 @@
 # (c) Copyright 2020 by Coinkite Inc. This file is covered by license found in COPYING-CC.
 #
 
-SIM_PATH = '/tmp/ckcc-simulator.sock'
+import os
+
+# run_sim_tests.py --shards sets this, one simulator per shard
+SIM_PATH = os.environ.get('CKCC_SIM_SOCK', '/tmp/ckcc-simulator.sock')
 
 # Simulator normally powers up with this 'wallet'
 simulator_fixed_tprv = "tprv8ZgxMBicQKsPeXJHL3vPPgTAEqQ5P2FD9qDeCQT4Cp1EMY5QkwMPWFxHdxHrxZhhcVRJ2m7BNWTz9Xre68y7mX5vCdMJ5qXMUfnrZ2si2X4"
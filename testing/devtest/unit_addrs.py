@@ -57,3 +57,16 @@ for raw_txo, expect_type, expect_sw, expect_hash in cases:
     assert addr_type == expect_type, addr_type
 
 
+# bulk rendering matches one-at-a-time, and skips junk
+import chains
+ch = chains.current_chain()
+scripts = []
+for raw_txo, _, _, _ in cases:
+    out = CTxOut()
+    out.deserialize(BytesIO(a2b_hex(raw_txo)))
+    scripts.append(out.scriptPubKey)
+
+got = ch.render_addresses(scripts + [b'\x6a\x00'])
+assert got[:-1] == [ch.render_address(s) for s in scripts], got
+assert got[-1] is None
+
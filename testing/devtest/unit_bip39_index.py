@@ -0,0 +1,23 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# seed.next_char() walks a prefix table; must agree with bip39.next_char() everywhere.
+#
+#   execfile('../../testing/devtest/unit_bip39_index.py')
+#
+import bip39
+from seed import next_char
+
+def norm(rv):
+    exact, nexts, matched = rv
+    return bool(exact), str(nexts), (matched or None)
+
+tried = set()
+for n in range(2048):
+    w = bip39.wordlist_en[n]
+    for pfx in [w[0:i] for i in range(1, len(w)+1)] + [w+'z', w[0:2]+'x']:
+        if pfx in tried: continue
+        tried.add(pfx)
+
+        assert norm(next_char(pfx)) == norm(bip39.next_char(pfx)), pfx
+
+assert len(tried) > 6000
@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+#
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# Load harness: K headless simulators, each driven by its own thread through
+# upload / sign / download cycles, like a production line with many Coldcards.
+#
+#   cd testing; python load_harness.py -n 4 --ins 1 --ins 10 --ins 50 -r 5
+#
+# - each simulator gets a private tree under /tmp/ckcc-load-N (see make_shard_tree)
+#   and socket /tmp/ckcc-load-N.sock; its output goes to /tmp/ckcc-load-N/log.txt
+# - host side: wall time per phase, measured here, and bytes moved per second
+# - device side: firmware's own phase timers (shared/prof.py) via 'PROF' command
+# - use --json to keep numbers, so protocol changes can be compared run to run
+#
+import os, sys, time, json, argparse, threading
+from hashlib import sha256
+from struct import pack
+from ckcc_protocol.client import ColdcardDevice
+from ckcc_protocol.protocol import CCProtocolPacker
+import run_sim_tests
+from run_sim_tests import ColdcardSimulator, make_shard_tree
+from txn import fake_txn
+
+LOAD_ROOT = "/tmp/ckcc-load-%d"
+LOAD_SOCK = "/tmp/ckcc-load-%d.sock"
+
+PHASES = ['upload', 'sign', 'download', 'cycle']
+
+class FakeConfig:
+    # enough of pytest's config for the fake_txn fixture
+    def __init__(self, psbt2):
+        self.psbt2 = psbt2
+
+    def getoption(self, name):
+        assert name == 'psbt2'
+        return self.psbt2
+
+def percentile(values, pct):
+    # nearest rank; values must be sorted
+    if not values:
+        return 0
+    idx = max(0, min(len(values) - 1, int(round(pct / 100.0 * len(values))) - 1))
+    return values[idx]
+
+def read_prof(dev):
+    # parse prof.report(): "name: N ms (count)" lines, skip boot marks
+    rv = {}
+    for ln in dev.send_recv(b'PROF', encrypt=False).decode().split('\n'):
+        if ':' not in ln or ln.startswith('boot '):
+            continue
+        name, rest = ln.split(':', 1)
+        ms, count = rest.split('ms')
+        rv[name.strip()] = (int(ms), int(count.strip(' ()')))
+    return rv
+
+def upload(dev, psbt, use_have):
+    # normal upload, unless device says it has this file already ('have' command)
+    if use_have:
+        sha = sha256(psbt).digest()
+        if dev.send_recv(b'have' + pack('<I32s', len(psbt), sha)) == 1:
+            return len(psbt), sha
+
+    return dev.upload_file(psbt)
+
+def run_device(num, dev, sizes, rounds, psbt2, use_have, results):
+    # one production station: same workload for every device
+    # - fixture's own function, from under pytest's wrapper
+    make_txn = fake_txn.__wrapped__(dev, FakeConfig(psbt2))
+    psbts = [(ins, outs, make_txn(ins, outs, dev.master_xpub, segwit_in=True))
+                for ins, outs in sizes]
+
+    dev.send_recv(b'EXEC' + b'import prof; prof.reset()', encrypt=False)
+
+    for ins, outs, psbt in psbts:
+        for r in range(rounds):
+            t0 = time.time()
+            ll, sha = upload(dev, psbt, use_have)
+
+            t1 = time.time()
+            dev.send_recv(CCProtocolPacker.sign_transaction(ll, sha, False))
+            dev.send_recv(CCProtocolPacker.sim_keypress(b'y'), timeout=None)
+
+            done = None
+            while done is None:
+                time.sleep(0.01)
+                done = dev.send_recv(CCProtocolPacker.get_signed_txn(), timeout=None)
+
+            t2 = time.time()
+            signed = dev.download_file(*done)
+            t3 = time.time()
+
+            results.append(dict(device=num, ins=ins, outs=outs, round=r,
+                                up_bytes=len(psbt), down_bytes=len(signed),
+                                upload=t1-t0, sign=t2-t1, download=t3-t2, cycle=t3-t0))
+
+    return read_prof(dev)
+
+def summarize(results, profs, wall):
+    # print latency percentiles (ms) per workload and phase, then throughput
+    rv = dict(wall=wall, workloads={}, devices=profs)
+
+    print("\n%-10s %-9s %8s %8s %8s %8s" % ('workload', 'phase', 'p50', 'p90', 'p99', 'max'))
+    for key in sorted(set((r['ins'], r['outs']) for r in results)):
+        rows = [r for r in results if (r['ins'], r['outs']) == key]
+        label = '%dx%d' % key
+        rv['workloads'][label] = w = dict(count=len(rows), psbt_bytes=rows[0]['up_bytes'])
+
+        for ph in PHASES:
+            vals = sorted(r[ph] * 1000 for r in rows)
+            w[ph] = [percentile(vals, p) for p in (50, 90, 99, 100)]
+            print("%-10s %-9s %8.1f %8.1f %8.1f %8.1f" % (label, ph, *w[ph]))
+
+        up = sum(r['up_bytes'] for r in rows)
+        up_time = sum(r['upload'] for r in rows)
+        w['upload_Bps'] = up / up_time if up_time else 0
+        print("%-10s upload %.1f KiB/s per device, psbt %d bytes" % (label,
+                            w['upload_Bps'] / 1024, w['psbt_bytes']))
+
+    moved = sum(r['up_bytes'] + r['down_bytes'] for r in results)
+    rv['host'] = dict(cycles=len(results), bytes=moved,
+                      cycles_per_sec=len(results) / wall, Bps=moved / wall)
+    print("\nHost: %d cycles in %.1f s: %.2f cycles/s, %.1f KiB/s over all devices"
+                % (len(results), wall, len(results) / wall, moved / wall / 1024))
+
+    print("\nDevice side (ms total, count):")
+    for num in sorted(profs):
+        prof = profs[num]
+        rx_bytes = sum(r['up_bytes'] for r in results if r['device'] == num)
+        rx_ms = prof.get('usb_rx', (0, 0))[0]
+        line = ', '.join('%s=%d/%d' % (k, ms, c) for k, (ms, c) in prof.items())
+        if rx_ms:
+            line += '; usb_rx %.1f KiB/s' % (rx_bytes / rx_ms * 1000 / 1024)
+        print("  #%d: %s" % (num, line or 'no PROF data'))
+
+    return rv
+
+def main():
+    parser = argparse.ArgumentParser(description="Drive many simulated Coldcards at once")
+    parser.add_argument("-n", "--devices", type=int, default=4, help="simulators to launch")
+    parser.add_argument("--ins", type=int, action="append",
+                        help="PSBT inputs (repeat for several sizes), default 10")
+    parser.add_argument("--outs", type=int, default=2, help="PSBT outputs")
+    parser.add_argument("-r", "--rounds", type=int, default=3, help="cycles per size, per device")
+    parser.add_argument("--psbt2", action="store_true", help="use PSBTv2")
+    parser.add_argument("--have", action="store_true",
+                        help="offer hash first, skip upload if device still has the PSBT")
+    parser.add_argument("-w", "--sim-init-wait", type=int, default=60,
+                        help="max seconds to wait for simulators to answer")
+    parser.add_argument("--json", type=str, metavar="FILE", help="save results here")
+    args = parser.parse_args()
+
+    sizes = [(i, args.outs) for i in (args.ins or [10])]
+
+    sims = []
+    for num in range(args.devices):
+        root = make_shard_tree(num, LOAD_ROOT)
+        log = open(os.path.join(root, "log.txt"), "w")
+        sim = ColdcardSimulator(path=LOAD_SOCK % num, args=["--eff"], script="headless.py",
+                                cwd=os.path.join(root, "unix"), log=log)
+        sims.append(sim)
+
+    run_sim_tests.SIM_INIT_WAIT = args.sim_init_wait
+    for num, sim in enumerate(sims):
+        sim.start()
+        if not sim.wait_ready(1):
+            print("Simulator #%d not ready, see %s/log.txt" % (num, LOAD_ROOT % num))
+            sys.exit(1)
+
+    devs = [ColdcardDevice(sn=LOAD_SOCK % num) for num in range(args.devices)]
+
+    results = []
+    profs = {}
+    errors = []
+
+    def worker(num):
+        try:
+            profs[num] = run_device(num, devs[num], sizes, args.rounds, args.psbt2,
+                                    args.have, results)
+        except Exception as exc:
+            errors.append((num, exc))
+
+    print("Running %d devices, sizes %r, %d rounds" % (args.devices, sizes, args.rounds))
+    threads = [threading.Thread(target=worker, args=(n,)) for n in range(args.devices)]
+
+    t0 = time.time()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    wall = time.time() - t0
+
+    for dev in devs:
+        dev.close()
+    for sim in sims:
+        sim.stop()
+        sim.log.close()
+
+    for num, exc in errors:
+        print("Device #%d failed: %r" % (num, exc))
+
+    if not results:
+        sys.exit(1)
+
+    rv = summarize(results, profs, wall)
+
+    if args.json:
+        rv['args'] = vars(args)
+        with open(args.json, 'wt') as fd:
+            json.dump(rv, fd, indent=2)
+        print("Saved: %s" % args.json)
+
+    sys.exit(1 if errors else 0)
+
+if __name__ == '__main__':
+    main()
+
+# EOF
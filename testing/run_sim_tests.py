@@ -17,6 +17,7 @@ python run_sim_tests.py                                        # same as with '-
 python run_sim_tests.py -m all --onetime --veryslow            # run all tests (cca 252 minutes)
 python run_sim_tests.py -m test_multisig.py -k cosigning       # run only tests that match expression from test_multisig.py
 python run_sim_tests.py -m test_export.py --pdb                # run only export tests and attach debugger
+python run_sim_tests.py --shards 4                             # same as '-m all', split over 4 simulators at once
 
 
 Onetime/veryslow tests are completely separated form the rest of the test suite.
@@ -28,15 +29,22 @@ python run_sim_tests.py --collect veryslow                     # just print all
 python run_sim_tests.py --collect manual                       # just print all manual tests to stdout
 
 Make sure to run manual test if you want to state that your changes passed all the tests.
+
+With --shards N, each shard gets a private copy of the tree (symlinks, except for unix/work and
+the pytest cache) under /tmp/ckcc-shard-N, its own simulator socket, and a share of the modules.
+Output of each shard goes to /tmp/ckcc-shard-N/log.txt; results are merged at the end.
+Onetime/veryslow tests still run afterwards, one at a time.
 """
 
-import os, time, glob, json, pytest, atexit, signal, argparse, subprocess, contextlib
+import os, sys, time, glob, json, shutil, pytest, atexit, signal, argparse, subprocess, contextlib
 from typing import List
 
 from pytest import ExitCode
 
 
-SIM_INIT_WAIT = 2  # 2 seconds, can be tweaked via cmdline arguments ( -w 6 )
+SIM_INIT_WAIT = 30  # max seconds until simulator answers, can be tweaked via cmdline arguments ( -w 60 )
+SIM_SOCK = None    # default socket path, unless --sock (used by --shards)
+SHARD_ROOT = "/tmp/ckcc-shard-%d"
 
 
 @contextlib.contextmanager
@@ -50,6 +58,9 @@ def pushd(new_dir):
 
 
 def remove_client_sockets():
+    if SIM_SOCK:
+        # other shards are still using theirs
+        return
     with pushd("/tmp"):
         for fn in glob.glob("ckcc-client*.sock"):
             os.remove(fn)
@@ -100,7 +111,6 @@ def _run_tests_with_simulator(test_module: str, simulator_args: List[str], pytes
                               pytest_k: str, pdb: bool, failed_first: bool, psbt2=False) -> ExitCode:
     sim = ColdcardSimulator(args=simulator_args)
     sim.start()
-    time.sleep(1)
     cmd_list = [
         "--cache-clear", "-m", pytest_marks, "--sim", test_module if test_module is not None else ""
     ]
@@ -123,7 +133,7 @@ def _run_tests_with_simulator(test_module: str, simulator_args: List[str], pytes
 
 def run_tests_with_simulator(test_module=None, simulator_args=None, pytest_k=None, pdb=False,
                              failed_first=False, psbt2=False,
-                             pytest_marks="not onetime and not veryslow and not manual"):
+                             pytest_marks="not onetime and not veryslow and not manual and not timing"):
     failed = []
     exit_code = _run_tests_with_simulator(test_module, simulator_args, pytest_marks, pytest_k,
                                           pdb, failed_first, psbt2=psbt2)
@@ -156,28 +166,61 @@ class PytestCollectMarked:
 
 
 class ColdcardSimulator:
-    def __init__(self, path=None, args=None):
+    def __init__(self, path=None, args=None, script="simulator.py", cwd="../unix",
+                 log=None):
         self.proc = None
         self.args = args
-        self.path = "/tmp/ckcc-simulator.sock" if path is None else path
+        self.path = SIM_SOCK if path is None else path
+        self.script = script
+        self.cwd = cwd
+        self.log = log
 
     def start(self):
         # here we are in testing directory
         cmd_list = [
             "python",
-            "simulator.py"
+            self.script
         ]
         if self.args is not None:
             cmd_list.extend(self.args)
+        if self.path:
+            cmd_list.extend(["--sock", self.path])
 
         self.proc = subprocess.Popen(
             cmd_list,
             # this needs to be in firmware/unix - expected to be run from firmware/testing
-            cwd="../unix",
+            cwd=self.cwd,
+            stdout=self.log,
+            stderr=subprocess.STDOUT if self.log else None,
             preexec_fn=os.setsid
         )
-        time.sleep(SIM_INIT_WAIT)
         atexit.register(self.stop)
+        if not self.wait_ready(SIM_INIT_WAIT):
+            print(f"Simulator not ready after {SIM_INIT_WAIT} seconds")
+
+    def wait_ready(self, timeout):
+        # poll until simulator is up and answering over USB, rather than fixed sleep
+        from ckcc_protocol.client import ColdcardDevice
+        from ckcc_protocol.protocol import CCProtocolPacker
+
+        path = self.path or "/tmp/ckcc-simulator.sock"
+        end = time.time() + timeout
+        while time.time() < end:
+            if os.path.exists(path):
+                try:
+                    dev = ColdcardDevice(sn=path)
+                    dev.send_recv(CCProtocolPacker.ping(b"ready"))
+                except Exception:
+                    time.sleep(0.1)
+                    continue
+                try:
+                    dev.close()
+                except Exception:
+                    pass
+                return True
+            time.sleep(0.1)
+
+        return False
 
     def stop(self):
         pp = self.proc.poll()
@@ -188,10 +231,114 @@ class ColdcardSimulator:
         atexit.unregister(self.stop)
 
 
+def simulator_args_for(test_module, default_args):
+    # simulator command line needed by each module, or None to skip it
+    if test_module in ["test_rng.py", "test_pincodes.py", "test_rolls.py"]:
+        # test_pincodes.py can only be run against real device
+        # test_rng.py not needed when using simulator
+        # test_rolls.py should be run alone as it does not need simulator
+        return None
+    if test_module in ["test_bsms.py", "test_address_explorer.py", "test_export.py",
+                       "test_multisig.py", "test_ux.py"]:
+        return default_args + ["--set", "vidsk=1"]
+    if test_module == "test_vdisk.py":
+        return ["--eject"] + default_args + ["--set", "vidsk=1"]
+    if test_module == "test_bip39pw.py":
+        return []
+    if test_module in ["test_unit.py", "test_se2.py", "test_backup.py"]:
+        # test_nvram_mk4 needs to run without --eff
+        # se2 duress wallet activated as ephemeral seed requires proper `settings.load`
+        return ["--set", "nfc=1"]
+    if test_module == "test_ephemeral.py":
+        return ["--set", "nfc=1", "--set", "vidsk=1"]
+    return default_args
+
+
+def make_shard_tree(num, pattern=None):
+    # private copy of firmware tree for one shard: symlinks to everything, except
+    # unix/work (simulator state) and the pytest cache, which tests write into
+    top = os.path.realpath("..")
+    root = (pattern or SHARD_ROOT) % num
+    if os.path.exists(root):
+        shutil.rmtree(root)
+    os.makedirs(root)
+
+    for fn in os.listdir(top):
+        if fn in ("unix", "testing"):
+            continue
+        os.symlink(os.path.join(top, fn), os.path.join(root, fn))
+
+    for sub, private in [("unix", "work"), ("testing", ".pytest_cache")]:
+        os.makedirs(os.path.join(root, sub))
+        for fn in os.listdir(os.path.join(top, sub)):
+            if fn == private:
+                continue
+            os.symlink(os.path.join(top, sub, fn), os.path.join(root, sub, fn))
+
+    # fresh, empty simulator work area, with same subdirs
+    src = os.path.join(top, "unix", "work")
+    shutil.copytree(src, os.path.join(root, "unix", "work"),
+                    ignore=lambda d, names: [n for n in names
+                                             if os.path.isfile(os.path.join(d, n))
+                                             and n not in ("README.md", ".gitignore")])
+    return root
+
+
+def run_sharded(test_modules, args):
+    # split modules over N child runners, each with own simulator; biggest files first
+    # as a rough guess of run time, each going to the least-loaded shard
+    shards = [[] for _ in range(args.shards)]
+    load = [0] * args.shards
+    for mod in sorted(test_modules, key=os.path.getsize, reverse=True):
+        idx = load.index(min(load))
+        shards[idx].append(mod)
+        load[idx] += os.path.getsize(mod)
+
+    procs = []
+    for num, mods in enumerate(shards):
+        if not mods:
+            continue
+        root = make_shard_tree(num)
+        result_file = os.path.join(root, "result.json")
+        sock = "/tmp/ckcc-simulator-%d.sock" % num
+
+        cmd = [sys.executable, "run_sim_tests.py", "--sock", sock, "--result-file", result_file,
+               "-w", str(SIM_INIT_WAIT)]
+        for m in mods:
+            cmd += ["-m", m]
+        if args.pytest_k:
+            cmd += ["-k", args.pytest_k]
+        if args.ff:
+            cmd.append("--ff")
+        if args.psbt2:
+            cmd.append("--psbt2")
+
+        log = open(os.path.join(root, "log.txt"), "w")
+        print(f"Shard {num}: {' '.join(mods)}")
+        procs.append((num, result_file, log,
+                      subprocess.Popen(cmd, cwd=os.path.join(root, "testing"),
+                                       stdout=log, stderr=subprocess.STDOUT)))
+
+    result = []
+    for num, result_file, log, proc in procs:
+        proc.wait()
+        log.close()
+        try:
+            with open(result_file) as f:
+                for module, ec, failed in json.load(f):
+                    result.append((module, ExitCode(ec), failed))
+        except (OSError, ValueError):
+            # runner itself died; see its log
+            result.append((f"shard {num}", ExitCode.INTERNAL_ERROR, [SHARD_ROOT % num]))
+        print(f"Shard {num} done, exit code {proc.returncode}")
+
+    return result
+
+
 def main():
     parser = argparse.ArgumentParser(description="Run tests against simulated Coldcard")
     parser.add_argument("-w", "--sim-init-wait", type=int,
-                        help="Choose how much to sleep after simulator is started")
+                        help="Max seconds to wait for simulator to answer after start")
     parser.add_argument("-m", "--module", action="append", help="Choose only n modules to run")
     parser.add_argument("--pdb", action="store_true", help="Go to debugger on failure")
     parser.add_argument("--psbt2", action="store_true", help="`fake_txn` produces PSBTv2")
@@ -204,8 +351,18 @@ def main():
                         help="Collect marked test and print them to stdout")
     parser.add_argument("-k", "--pytest-k", type=str, metavar="EXPRESSION", default=None,
                         help="only run tests which match the given substring expression")
+    parser.add_argument("--shards", type=int, default=0, metavar="N",
+                        help="run modules on N simulators in parallel")
+    parser.add_argument("--sock", type=str, default=None, help=argparse.SUPPRESS)
+    parser.add_argument("--result-file", type=str, default=None, help=argparse.SUPPRESS)
     args = parser.parse_args()
 
+    if args.sock:
+        # we are one shard of several: use private simulator socket
+        global SIM_SOCK
+        SIM_SOCK = args.sock
+        os.environ["CKCC_SIM_SOCK"] = args.sock
+
     if args.sim_init_wait:
         global SIM_INIT_WAIT
         SIM_INIT_WAIT = args.sim_init_wait
@@ -227,29 +384,19 @@ def main():
             if not os.path.exists(fn):
                 raise RuntimeError(f"{fn} does not exist")
         test_modules = sorted(args.module)
-    result = []
+    if args.shards and args.shards > 1 and test_modules:
+        result = run_sharded(test_modules, args)
+        remove_client_sockets()
+        test_modules = []
+    else:
+        result = []
+
     for test_module in test_modules:
-        test_args = DEFAULT_SIMULATOR_ARGS
-        if test_module in ["test_rng.py", "test_pincodes.py", "test_rolls.py"]:
-            # test_pincodes.py can only be run against real device
-            # test_rng.py not needed when using simulator
-            # test_rolls.py should be run alone as it does not need simulator
+        test_args = simulator_args_for(test_module, DEFAULT_SIMULATOR_ARGS)
+        if test_args is None:
             print("Skipped", test_module)
             continue
         print("Started", test_module)
-        if test_module in ["test_bsms.py", "test_address_explorer.py", "test_export.py",
-                           "test_multisig.py", "test_ux.py"]:
-            test_args = DEFAULT_SIMULATOR_ARGS + ["--set", "vidsk=1"]
-        if test_module == "test_vdisk.py":
-            test_args = ["--eject"] + DEFAULT_SIMULATOR_ARGS + ["--set", "vidsk=1"]
-        if test_module == "test_bip39pw.py":
-            test_args = []
-        if test_module in ["test_unit.py", "test_se2.py", "test_backup.py"]:
-            # test_nvram_mk4 needs to run without --eff
-            # se2 duress wallet activated as ephemeral seed requires proper `settings.load`
-            test_args = ["--set", "nfc=1"]
-        if test_module == "test_ephemeral.py":
-            test_args = ["--set", "nfc=1", "--set", "vidsk=1"]
         ec, failed_tests = run_tests_with_simulator(test_module, simulator_args=test_args,
                                                     pytest_k=args.pytest_k, pdb=args.pdb,
                                                     failed_first=args.ff, psbt2=args.psbt2)
@@ -275,6 +422,10 @@ def main():
                                                         simulator_args=DEFAULT_SIMULATOR_ARGS,
                                                         psbt2=args.psbt2)
             result.append((f"onetime: {onetime_test}", ec, failed_tests))
+    if args.result_file:
+        with open(args.result_file, "w") as f:
+            json.dump([(m, int(ec), failed) for m, ec, failed in result], f)
+
     print("All done")
     any_failed = False
     for module, ec, failed in result:
@@ -213,6 +213,62 @@ def test_bip_vectors(mode, index, entropy, expect, cap_story, need_keypress,
     need_keypress('x')
 
 
+@pytest.mark.parametrize('mode,expect', [
+    ('12 words', 'girl mad pet galaxy egg matter matrix prison refuse sense ordinary nose'),
+    ('WIF (privkey)', 'Kzyv4uF39d4Jrw2W7UryTHwZr1zQVNk4dAFyqE6BuMrMh1Za7uhp'),
+    ('XPRV (BIP-32)', 'xprv9s21ZrQH143K2srSbCSg4m4kLvPMzcWydgmKEnMmoZUurYuBuYG46c6P71UGXMzmriLzCCBvKQWBUv3vPB3m1SATMhp3uEjXHJ42jFg7myX'),
+    ('32-bytes hex', 'ea3ceb0b02ee8e587779c63f4b7b3a21e950a213f1ec53cab608d13e8796e6dc'),
+    ('Passwords', 'dKLoepugzdVJvdL56ogNV'),
+])
+@pytest.mark.parametrize('count', [1, 5])
+def test_batch_export(mode, expect, count, goto_home, pick_menu_item, need_keypress, cap_story,
+                      set_encoded_secret, settings_set, load_export_and_verify_signature,
+                      reset_seed_words):
+    # many indices in one file; index 0 must match single-value vectors
+    set_encoded_secret(a2b_hex(EXAMPLE_XPRV))
+    settings_set('chain', 'BTC')
+
+    goto_home()
+    pick_menu_item('Advanced/Tools')
+    pick_menu_item('Derive Seed B85')
+    need_keypress('y')
+    time.sleep(0.1)
+    title, story = cap_story()
+    if "You have a temporary seed active - deriving from temporary" in story:
+        need_keypress("y")
+
+    time.sleep(0.1)
+    pick_menu_item('Batch Export')
+    pick_menu_item(mode)
+
+    # start index: blank is zero
+    need_keypress('y')
+    time.sleep(0.1)
+    for n in str(count):
+        need_keypress(n)
+    need_keypress('y')
+
+    time.sleep(0.1)
+    title, story = cap_story()
+    assert f'save {count} values' in story
+    need_keypress('1')
+
+    time.sleep(0.1)
+    title, story = cap_story()
+    assert title == 'Saved'
+    contents, _ = load_export_and_verify_signature(story, "sd", fpattern="drv", label=None)
+
+    lines = [ln for ln in contents.split('\n') if ' => ' in ln]
+    assert len(lines) == count
+    assert lines[0].endswith("/0' => " + expect)
+    for n, ln in enumerate(lines):
+        assert f"/{n}' => " in ln
+    assert len(set(ln.split(' => ')[1] for ln in lines)) == count
+
+    need_keypress('y')
+    reset_seed_words()
+
+
 @pytest.mark.qrcode
 @pytest.mark.parametrize('mode,pattern', [ 
     ('WIF (privkey)', r'[1-9A-HJ-NP-Za-km-z]{51,52}' ),
@@ -0,0 +1,102 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# Heap usage: run big jobs on the simulator, then read back the firmware's heap
+# checkpoints (shared/memstats.py) and the live heap after a collection.
+#
+# - limits are for the simulator; it's a 64-bit build so objects are larger than
+#   on Mk4, which has about 530k free after boot
+# - simulator heap is large (9m) so it rarely collects by itself; checkpoints are
+#   taken after a collection, so they show what the job retains, not garbage
+# - leak checks: once job is done, live heap should not have grown much; some
+#   caches (xpubs, derived nodes) are allowed to stay
+#
+import pytest, time
+from ast import literal_eval
+
+# most heap retained (live, after a collect) at any checkpoint of a job
+HEAP_LIMIT = 1536 * 1024
+
+# growth of live heap, measured before and after a job
+LEAK_LIMIT = 32 * 1024
+
+@pytest.fixture
+def live_heap(sim_exec):
+    # bytes in use after a full collection; results of previous job released first
+    def doit():
+        rv = sim_exec('import gc; from auth import UserAuthorizedAction; '
+                      'UserAuthorizedAction.cleanup(); gc.collect(); RV.write(str(gc.mem_alloc()))')
+        return int(rv)
+
+    return doit
+
+@pytest.fixture
+def heap_stats(dev, sim_exec):
+    # call to start from clean heap and no checkpoints; gives fcn to read them back
+    def read():
+        rv = literal_eval(dev.send_recv(b'MEMS', encrypt=False).decode())
+        sim_exec('import memstats; memstats.reset()')
+        return rv
+
+    def doit():
+        sim_exec('import memstats, gc; memstats.reset(live=True); gc.collect()')
+        return read
+
+    return doit
+
+def check_stats(stats, labels, limit=HEAP_LIMIT):
+    # all expected checkpoints were reached, and none used too much
+    for lab in labels:
+        assert lab in stats, 'checkpoint %r not reached' % lab
+
+    for lab, (hits, min_free, max_used, num_gc) in stats.items():
+        print('%-12s hits=%d max_used=%d min_free=%d' % (lab, hits, max_used, min_free))
+        assert max_used <= limit, '%s: %d bytes retained' % (lab, max_used)
+
+@pytest.mark.parametrize('num_ins', [10, 50])
+def test_sign_heap(num_ins, dev, fake_txn, try_sign, live_heap, heap_stats):
+    psbt = fake_txn(num_ins, 2, dev.master_xpub, segwit_in=True)
+
+    before = live_heap()
+    stats = heap_stats()
+    try_sign(psbt, accept=True)
+
+    check_stats(stats(), ['parse', 'validate', 'approve', 'sign'])
+
+    grew = live_heap() - before
+    assert grew <= LEAK_LIMIT, grew
+
+def test_ms_import_heap(clear_ms, import_ms_wallet, live_heap, heap_stats):
+    # biggest multisig we support, classic p2sh
+    clear_ms()
+    before = live_heap()
+    stats = heap_stats()
+
+    import_ms_wallet(15, 15, accept=True)
+    time.sleep(.1)
+
+    check_stats(stats(), ['ms_import'])
+
+    clear_ms()
+    grew = live_heap() - before
+    assert grew <= LEAK_LIMIT, grew
+
+def test_backup_heap(settings_set, import_ephemeral_xprv, restore_main_seed, backup_system,
+                     live_heap, heap_stats):
+    # backup with seed vault in use: more to render
+    settings_set("seedvault", 1)
+    settings_set("seeds", [])
+    import_ephemeral_xprv("sd", from_main=True, seed_vault=True)
+    restore_main_seed(seed_vault=True, preserve_settings=True)
+
+    before = live_heap()
+    stats = heap_stats()
+
+    backup_system()
+    time.sleep(.1)
+
+    check_stats(stats(), ['backup', 'backup_7z'])
+
+    grew = live_heap() - before
+    assert grew <= LEAK_LIMIT, grew
+
+# EOF
@@ -185,6 +185,137 @@ def test_sign_msg_microsd_good(sign_on_microsd, msg, path, addr_vs_path, addr_fm
     addr_vs_path(addr, path, addr_fmt)
     assert verify_message(addr, sig, msg) is True
 
+@pytest.mark.parametrize('num_msgs', [1, 5, 50])
+def test_sign_msg_microsd_batch(num_msgs, open_microsd, cap_story, pick_menu_item, goto_home,
+                                need_keypress, microsd_path, addr_vs_path):
+    # many messages in one file, tab-separated fields, one approval
+    fname = 't-msgbatch.txt'
+    result_fname = 't-msgbatch-signed.txt'
+    fmts = [AF_CLASSIC, AF_P2WPKH, AF_P2WPKH_P2SH]
+
+    try: os.unlink(microsd_path(result_fname))
+    except OSError: pass
+
+    batch = [('hello %d' % n, "m/84'/0'/0'/0/%d" % n, fmts[n % 3]) for n in range(num_msgs)]
+    with open_microsd(fname, 'wt') as sd:
+        for msg, path, af in batch:
+            sd.write('%s\t%s\t%s\n' % (msg, path, addr_fmt_names[af]))
+
+    goto_home()
+    pick_menu_item('Advanced/Tools')
+    pick_menu_item('File Management')
+    pick_menu_item('Sign Text File')
+    time.sleep(.1)
+    need_keypress('y')
+    time.sleep(.1)
+    pick_menu_item(fname)
+
+    title, story = cap_story()
+    assert story.startswith('Ok to sign these %d messages?' % num_msgs)
+    need_keypress('y')
+
+    for r in range(50):
+        time.sleep(0.1)
+        title, story = cap_story()
+        if title == 'File Signed': break
+    else:
+        assert False, 'timed out'
+
+    blocks = open_microsd(result_fname, 'rt').read().split('\n\n')
+    assert len(blocks) == num_msgs
+    for (msg, path, af), blk in zip(batch, blocks):
+        lines = [i.strip() for i in blk.strip().split('\n')]
+        assert lines[0] == '-----BEGIN BITCOIN SIGNED MESSAGE-----'
+        assert lines[1] == msg
+        addr, sig = lines[3], lines[4]
+        addr_vs_path(addr, path, af)
+        assert verify_message(addr, sig, msg) is True
+
+def test_sign_msg_microsd_batch_blanks(open_microsd, cap_story, pick_menu_item, goto_home,
+                                       need_keypress):
+    # blank lines don't count towards the max, and nothing past them is lost
+    fname = 't-msgbatch.txt'
+    num_msgs = 50
+    with open_microsd(fname, 'wt') as sd:
+        for n in range(num_msgs):
+            sd.write('hello %d\tm/%d\n\n' % (n, n))
+
+    goto_home()
+    pick_menu_item('Advanced/Tools')
+    pick_menu_item('File Management')
+    pick_menu_item('Sign Text File')
+    time.sleep(.1)
+    need_keypress('y')
+    time.sleep(.1)
+    pick_menu_item(fname)
+
+    title, story = cap_story()
+    assert story.startswith('Ok to sign these %d messages?' % num_msgs)
+    assert ('hello %d' % (num_msgs-1)) in story
+    need_keypress('x')
+
+@pytest.mark.parametrize('num_msgs', [1, 10])
+def test_sign_msg_usb_batch(num_msgs, dev, need_keypress, addr_vs_path):
+    # upload batch file, then 'smbt' command; result is a file, like PSBT signing
+    from struct import pack
+    fmts = [AF_CLASSIC, AF_P2WPKH, AF_P2WPKH_P2SH]
+    batch = [('hello %d' % n, "m/84'/0'/0'/0/%d" % n, fmts[n % 3]) for n in range(num_msgs)]
+    body = ''.join('%s\t%s\t%s\n' % (msg, path, addr_fmt_names[af])
+                        for msg, path, af in batch).encode()
+
+    ll, sha = dev.upload_file(body)
+    dev.send_recv(b'smbt' + pack('<I32s', ll, sha), timeout=None)
+
+    need_keypress('y')
+
+    done = None
+    while done == None:
+        time.sleep(0.050)
+        done = dev.send_recv(CCProtocolPacker.get_signed_txn(), timeout=None)
+
+    resp_len, chk = done
+    result = dev.download_file(resp_len, chk).decode()
+
+    blocks = result.split('\n\n')
+    assert len(blocks) == num_msgs
+    for (msg, path, af), blk in zip(batch, blocks):
+        lines = [i.strip() for i in blk.strip().split('\n')]
+        assert lines[0] == '-----BEGIN BITCOIN SIGNED MESSAGE-----'
+        assert lines[1] == msg
+        addr, sig = lines[3], lines[4]
+        addr_vs_path(addr, path, af)
+        assert verify_message(addr, sig, msg) is True
+
+def test_sign_msg_usb_batch_fail(dev):
+    # too many messages: rejected before any approval
+    from struct import pack
+    body = ''.join('hello %d\tm/%d\n' % (n, n) for n in range(51)).encode()
+
+    ll, sha = dev.upload_file(body)
+    with pytest.raises(CCProtoError) as ee:
+        dev.send_recv(b'smbt' + pack('<I32s', ll, sha), timeout=None)
+    assert 'too many msgs' in str(ee.value)
+
+def test_sign_msg_microsd_batch_fail(open_microsd, cap_story, pick_menu_item, goto_home,
+                                     need_keypress):
+    # one bad line rejects whole batch
+    fname = 't-msgbatch.txt'
+    with open_microsd(fname, 'wt') as sd:
+        sd.write('hello\tm/1\n')
+        sd.write('  bad\tm/2\n')
+
+    goto_home()
+    pick_menu_item('Advanced/Tools')
+    pick_menu_item('File Management')
+    pick_menu_item('Sign Text File')
+    time.sleep(.1)
+    need_keypress('y')
+    time.sleep(.1)
+    pick_menu_item(fname)
+
+    title, story = cap_story()
+    assert 'msg 2: leading space' in story
+
 
 @pytest.fixture
 def sign_using_nfc(goto_home, pick_menu_item, nfc_write_text, cap_story):
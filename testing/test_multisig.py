@@ -1612,6 +1612,12 @@ def test_bitcoind_cosigning(cc_sign_first, dev, bitcoind, import_ms_wallet, clea
     tx_hex = rr["hex"]
     res = bitcoind.supply_wallet.testmempoolaccept([tx_hex])
     assert res[0]["allowed"]
+
+    if not cc_sign_first and addr_style != 'legacy':
+        # we are last signer of segwit multisig: combine and finalize on device too
+        _, txn = try_sign(psbt, finalize=True)
+        assert txn.hex() == tx_hex
+
     txn_id = bitcoind.supply_wallet.sendrawtransaction(rr['hex'])
     assert len(txn_id) == 64
 
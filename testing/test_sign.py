@@ -170,6 +170,62 @@ def test_speed_test(dev, fake_txn, is_mark3, is_mark4, start_sign, end_sign, nee
     print("  Tx time: %.1f" % tx_time)
     print("Sign time: %.1f" % ready_time)
 
+@pytest.mark.unfinalized
+@pytest.mark.parametrize('style', ['p2pkh', 'p2sh-p2wpkh', 'p2wpkh'])
+@pytest.mark.parametrize('num_io', [1, 10, 100,
+                                    pytest.param(500, marks=pytest.mark.veryslow),
+                                    pytest.param(1000, marks=pytest.mark.veryslow)])
+def test_sign_scaling(num_io, style, dev, fake_txn, need_keypress, cap_story, is_simulator,
+                      sim_exec):
+    # benchmark: wall time per phase, for N inputs and N outputs
+    # - works on real device too (--dev), but approval phase needs simulator or debug build
+    # - prints firmware's own phase timers (see shared/prof.py) when available
+    segwit_in = (style != 'p2pkh')
+    wrapped = (style == 'p2sh-p2wpkh')
+
+    psbt = fake_txn(num_io, num_io, dev.master_xpub, segwit_in=segwit_in, wrapped=wrapped)
+
+    try:
+        sim_exec('import prof; prof.reset()')
+        has_prof = True
+    except Exception:
+        has_prof = False
+
+    times = {}
+
+    dt = time.time()
+    ll, sha = dev.upload_file(psbt)
+    times['upload'] = time.time() - dt
+
+    dt = time.time()
+    dev.send_recv(CCProtocolPacker.sign_transaction(ll, sha, False))
+    if is_simulator():
+        # wait for the approval story: parse and validate are done by then
+        while cap_story()[0] != 'OK TO SEND?':
+            time.sleep(0.05)
+        times['parse+validate'] = time.time() - dt
+        dt = time.time()
+
+    need_keypress('y', timeout=None)
+
+    done = None
+    while done == None:
+        time.sleep(0.05)
+        done = dev.send_recv(CCProtocolPacker.get_signed_txn(), timeout=None)
+    times['sign'] = time.time() - dt
+
+    dt = time.time()
+    resp_len, chk = done
+    dev.download_file(resp_len, chk)
+    times['download'] = time.time() - dt
+
+    print("\n%d ins/outs (%s), %d bytes:" % (num_io, style, len(psbt)))
+    for k, v in times.items():
+        print("  %16s: %.2f s" % (k, v))
+
+    if has_prof:
+        print(dev.send_recv(b'PROF', encrypt=False).decode())
+
 if 0:
     # TODO: attempt to re-create the mega transaction: 5,569 inputs, one out
     # see <https://bitcoin.stackexchange.com/questions/11542>
@@ -290,6 +346,18 @@ def test_real_signing(fake_txn, use_regtest, try_sign, dev, num_ins, segwit, dec
         assert all(x['txinwitness'] for x in decoded['vin'])
 
 
+@pytest.mark.parametrize('segwit', [True, False])
+def test_sign_eof_terminated(fake_txn, try_sign, dev, segwit):
+    # last output's map ends at EOF, without its zero-length key: still signed,
+    # that output is re-encoded (no span to copy) and gets terminator back
+    psbt = fake_txn(2, 2, dev.master_xpub, segwit_in=segwit)
+    assert psbt[-1] == 0
+
+    _, expect = try_sign(psbt, accept=True)
+    _, got = try_sign(psbt[:-1], accept=True)
+
+    assert BasicPSBT().parse(got) == BasicPSBT().parse(expect)
+
 @pytest.mark.unfinalized        # iff we_finalize=F
 @pytest.mark.parametrize('we_finalize', [ False, True ])
 @pytest.mark.parametrize('num_dests', [ 1, 10, 25 ])
@@ -1489,6 +1557,35 @@ def test_qr_txn(num_in, num_out, request, fake_txn, try_sign, dev, cap_screen_qr
         qr = cap_screen_qr().decode()
         assert qr.lower() == txn.hex()
 
+@pytest.mark.parametrize('num_in,num_out', [(1,1), (5,10)])
+def test_bbqr_txn(num_in, num_out, fake_txn, try_sign, dev, cap_screen_qr, cap_story, need_keypress):
+    # signed txn as animated BBQr: collect all the parts, and rebuild it
+    psbt = fake_txn(num_in, num_out, dev.master_xpub, segwit_in=True)
+    _, txn = try_sign(psbt, accept=True, finalize=True)
+
+    title, story = cap_story()
+    assert 'animated QR' in story
+    need_keypress('2')
+
+    parts = {}
+    for retry in range(200):
+        qr = cap_screen_qr().decode()
+        assert qr[0:4] == 'B$HT', qr
+        count = int(qr[4:6], 36)
+        parts[int(qr[6:8], 36)] = qr[8:]
+        if len(parts) == count:
+            break
+        time.sleep(0.05)
+    else:
+        raise pytest.fail('missing parts')
+
+    need_keypress('x')
+
+    assert sorted(parts) == list(range(count))
+    assert all(len(parts[i]) == len(parts[0]) for i in range(count-1))
+    got = bytes.fromhex(''.join(parts[i] for i in range(count)))
+    assert got == txn
+
 def test_missing_keypaths(dev, try_sign, fake_txn):
 
     # make valid psbt
@@ -0,0 +1,86 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# Timing harness: run fixed workloads, record wall time and the firmware's own
+# phase timers (shared/prof.py) and heap checkpoints (shared/memstats.py).
+#
+# - meant for real hardware with a debug build:  py.test test_timing.py --dev
+# - also works on simulator, where numbers are only useful with --perf
+# - results go into debug/timing-<fw version>.json, to compare releases
+#
+import pytest, time, json
+from ckcc_protocol.protocol import CCProtocolPacker
+from ckcc_protocol.constants import AF_P2WPKH, AF_CLASSIC
+from txn import *
+
+pytestmark = pytest.mark.timing
+
+@pytest.fixture(scope='module')
+def timing_log(dev):
+    # collect results for whole module, then save as JSON
+    version = dev.send_recv(CCProtocolPacker.version()).split('\n')
+    results = dict(version=version, ops={})
+
+    yield results['ops']
+
+    fn = 'debug/timing-%s.json' % version[1]
+    with open(fn, 'wt') as fd:
+        json.dump(results, fd, indent=2)
+    print("Timing results: %s" % fn)
+
+@pytest.fixture
+def timed(dev, sim_exec, timing_log):
+    # run fcn() once, and record wall time plus firmware's counters under name
+    def doit(name, fcn):
+        sim_exec('import prof, memstats; prof.reset(); memstats.reset()')
+
+        dt = time.time()
+        fcn()
+        wall = time.time() - dt
+
+        timing_log[name] = dict(wall=round(wall, 3),
+                    prof=dev.send_recv(b'PROF', encrypt=False).decode(),
+                    mems=dev.send_recv(b'MEMS', encrypt=False).decode())
+
+        print("%s: %.2f s" % (name, wall))
+
+    return doit
+
+def test_settings_load(timed, sim_exec):
+    # time nvstore read and decrypt of current settings, on device
+    def doit():
+        rv = sim_exec('from glob import settings; settings.load(); RV.write("ok")')
+        assert rv == 'ok', rv
+
+    timed('settings_load', doit)
+
+@pytest.mark.parametrize('addr_fmt', [AF_CLASSIC, AF_P2WPKH])
+def test_address_export(timed, dev, need_keypress, addr_fmt):
+    # derive and show 10 addresses
+    def doit():
+        for n in range(10):
+            dev.send_recv(CCProtocolPacker.show_address("m/84'/0'/0'/0/%d" % n, addr_fmt),
+                          timeout=None)
+            need_keypress('y')
+
+    timed('address_export_%d' % addr_fmt, doit)
+
+@pytest.mark.parametrize('num_io', [1, 10, 50, 200])
+def test_psbt_sign(timed, dev, fake_txn, need_keypress, num_io):
+    # upload, approve, sign and download; same workload every release
+    psbt = fake_txn(num_io, num_io, dev.master_xpub, segwit_in=True)
+
+    def doit():
+        ll, sha = dev.upload_file(psbt)
+        dev.send_recv(CCProtocolPacker.sign_transaction(ll, sha, False))
+        need_keypress('y', timeout=None)
+
+        done = None
+        while done == None:
+            time.sleep(0.05)
+            done = dev.send_recv(CCProtocolPacker.get_signed_txn(), timeout=None)
+
+        dev.download_file(*done)
+
+    timed('psbt_sign_%d' % num_io, doit)
+
+# EOF
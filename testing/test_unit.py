@@ -139,6 +139,10 @@ def test_decoding(unit_test):
     # utils.py Hex/Base64 streaming decoders
     unit_test('devtest/unit_decoding.py')
 
+def test_bip39_index(unit_test):
+    # seed.py prefix table vs. bip39.next_char
+    unit_test('devtest/unit_bip39_index.py')
+
 @pytest.mark.parametrize('hasher', ['sha256', 'sha1', 'sha512'])
 @pytest.mark.parametrize('msg', [b'123', b'b'*78])
 @pytest.mark.parametrize('key', [b'3245', b'b'*78])
@@ -155,6 +159,28 @@ def test_hmac(sim_exec, msg, key, hasher):
     assert got == expect
     #print(expect)
 
+@pytest.mark.parametrize('nonce', [bytes(12), bytes(10) + b'\x12\xff', b'\xff'*11 + b'\xfe'])
+@pytest.mark.parametrize('ctr', [0, 0xfffffffe])
+def test_aes_ctr_wrap(sim_exec, nonce, ctr):
+    # long runs go to AES peripheral on Mk4, which only counts in the last 32 bits;
+    # crossing that wrap, in one call, must carry into nonce like 128-bit counter
+    import pyaes
+    from binascii import a2b_hex
+
+    key = bytes(range(32))
+    iv = nonce + ctr.to_bytes(4, 'big')
+    msg = bytes(range(256)) * 2
+
+    cmd = "import aes256ctr; from ubinascii import hexlify as b2a_hex; " + \
+            f"e = aes256ctr.new({key}, {iv}); m = bytes(range(256)) * 2; " + \
+            "RV.write(b2a_hex(e.cipher(m[0:96]) + e.cipher(m[96:])))"
+    got = a2b_hex(sim_exec(cmd))
+
+    counter = pyaes.Counter(int.from_bytes(iv, 'big'))
+    expect = pyaes.AESModeOfOperationCTR(key, counter).encrypt(msg)
+
+    assert got == expect
+
 @pytest.mark.parametrize('secret,counter,expect', [
         ( b'abcdefghij', 1, '765705'),
         ( b'abcdefghij', 2, '816065'),
@@ -146,6 +146,22 @@ def test_hacky_upgrade(mode, cap_story, transport, dev, sim_exec, make_firmware,
     #         assert a == hdr, f"wrong @ {pos}"
     #     else:
     #         assert a == data[pos:pos+128], repr(pos)
-    
+
+@pytest.mark.parametrize('transport', ['sd', 'usb'])
+def test_upgrade_bad_sig(transport, dev, sim_eval, make_firmware, upload_file, upgrade_by_sd):
+    # tampered body is refused once it has all arrived, before any approval
+    mkn = int(eval(sim_eval('version.hw_label'))[2])
+    data = bytearray(make_firmware(mkn))
+    hdr = bytes(data[FW_HEADER_OFFSET:FW_HEADER_OFFSET+FW_HEADER_SIZE])
+
+    data[FW_HEADER_OFFSET + FW_HEADER_SIZE + 100] ^= 0x55
+
+    if transport == 'sd':
+        upgrade_by_sd(bytes(data), expect_fail="signature is not valid")
+        return
+
+    with pytest.raises(CCProtoError) as ee:
+        upload_file(bytes(data) + hdr)
+    assert "signature is not valid" in str(ee)
 
 # EOF
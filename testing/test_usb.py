@@ -160,6 +160,180 @@ def test_upload_fails(dev):
         # bad position
         v = dev.send_recv(CCProtocolPacker.upload(1000, 3, data))
 
+def test_upload_have(dev):
+    # staged file is found by hash, and becomes current upload again
+    from hashlib import sha256
+    import os
+
+    data = os.urandom(3000)
+    have = lambda d: dev.send_recv(b'have' + struct.pack('<I32s', len(d), sha256(d).digest()))
+
+    for pos in range(0, len(data), 1024):
+        dev.send_recv(CCProtocolPacker.upload(pos, len(data), data[pos:pos+1024]))
+
+    # download changes running hash; 'have' restores it
+    dev.send_recv(CCProtocolPacker.download(0, 100, 0))
+    assert dev.send_recv(CCProtocolPacker.sha256()) != sha256(data).digest()
+
+    assert have(data) == 1
+    assert dev.send_recv(CCProtocolPacker.sha256()) == sha256(data).digest()
+
+    # not there: different or shorter file
+    assert have(os.urandom(3000)) == 0
+    assert have(data[:-1]) == 0
+    assert dev.send_recv(CCProtocolPacker.sha256()) == sha256(data).digest()
+
+def raw_send(dev, msg):
+    # frame an unencrypted request by hand, without waiting for any reply
+    for pos in range(0, len(msg), 63):
+        here = msg[pos:pos+63]
+        flag = len(here) | (0x80 if pos+63 >= len(msg) else 0)
+        dev.dev.write(bytes([flag]) + here + bytes(63-len(here)))
+
+def raw_recv(dev, timeout_ms=3000):
+    # read one unencrypted reply, or None if nothing comes
+    rv = b''
+    while 1:
+        pkt = dev.dev.read(64, timeout_ms=timeout_ms)
+        if not pkt:
+            assert not rv, 'partial reply'
+            return None
+        pkt = bytes(pkt)
+        rv += pkt[1:1+(pkt[0] & 0x3f)]
+        if pkt[0] & 0x80:
+            return rv
+
+def test_upload_windowed(dev):
+    # 'upwn': host does not wait, acks come every 8th chunk, then sha256 at end
+    from hashlib import sha256
+    import os
+
+    chunk = 256
+    count = 20
+    data = os.urandom(chunk * count)
+
+    for seq in range(count):
+        pos = seq * chunk
+        raw_send(dev, b'upwn' + struct.pack('<III', seq, pos, len(data)) + data[pos:pos+chunk])
+
+    for seq in (7, 15):
+        assert raw_recv(dev) == b'int2' + struct.pack('<II', seq, (seq+1) * chunk)
+    assert raw_recv(dev) == b'biny' + sha256(data).digest()
+    assert raw_recv(dev, timeout_ms=200) is None
+
+    assert dev.send_recv(CCProtocolPacker.sha256()) == sha256(data).digest()
+
+def test_upload_windowed_bad_seq(dev):
+    # chunk out of order: error, and so is every chunk after, until host restarts
+    from hashlib import sha256
+    import os
+
+    chunk = 256
+    data = os.urandom(chunk * 4)
+    up = lambda seq, n: raw_send(dev, b'upwn'
+                + struct.pack('<III', seq, n*chunk, len(data)) + data[n*chunk:(n+1)*chunk])
+
+    up(0, 0)
+    up(2, 1)
+    assert raw_recv(dev) == b'err_seq'
+    up(1, 1)
+    assert raw_recv(dev) == b'err_seq'
+    assert raw_recv(dev, timeout_ms=200) is None
+
+    # start over at offset zero: works
+    for n in range(4):
+        up(n, n)
+    assert raw_recv(dev) == b'biny' + sha256(data).digest()
+    assert raw_recv(dev, timeout_ms=200) is None
+
+def test_batch(dev):
+    # 'bach': sub-commands handled in order, each gets own reply, failures included
+    def sub(msg):
+        return struct.pack('<H', len(msg)) + msg
+
+    cmds = [b'pingabc', b'zzzz', b'\xff\xff\xff\xff', b'xpubm', b'pingxyz']
+    raw_send(dev, b'bach' + b''.join(sub(c) for c in cmds))
+    resp = raw_recv(dev)
+
+    assert resp[0:4] == b'bach'
+    got = []
+    pos = 4
+    while pos < len(resp):
+        ln, = struct.unpack_from('<H', resp, pos)
+        got.append(resp[pos+2:pos+2+ln])
+        pos += 2 + ln
+
+    assert got == [b'binyabc', b'err_Unknown cmd', b'framdecode', b'err_must encrypt',
+                        b'binyxyz']
+
+    # cannot nest, bad length: whole batch rejected
+    raw_send(dev, b'bach' + sub(b'bach' + sub(b'ping')))
+    assert raw_recv(dev) == b'err_nested'
+    raw_send(dev, b'bach' + struct.pack('<H', 100) + b'ping')
+    assert raw_recv(dev) == b'err_badlen'
+
+def test_usb_stats(dev):
+    # 'stat': counters since last reset, framing errors by reason, time per command
+    import json
+
+    raw_send(dev, b'stat' + struct.pack('<I', 1))
+    assert raw_recv(dev)[0:4] == b'asci'
+
+    for i in range(3):
+        raw_send(dev, b'pinghello')
+        assert raw_recv(dev) == b'binyhello'
+
+    # too short to be a command
+    dev.dev.write(bytes([0x80 | 2]) + b'ab' + bytes(61))
+    assert raw_recv(dev) == b'frambadsz'
+
+    raw_send(dev, b'stat')
+    resp = raw_recv(dev)
+    assert resp[0:4] == b'asci'
+    st = json.loads(resp[4:])
+
+    # 3 pings, bad one and this request; each is one packet
+    assert st['rx_pkts'] == 5
+    assert st['rx_bytes'] == 5 * 64
+    assert st['tx_pkts'] >= 5
+    assert st['tx_bytes'] == st['tx_pkts'] * 64
+    assert st['framing'] == {'badsz': 1}
+
+    count, total_us, max_us = st['cmds']['ping']
+    assert count == 3
+    assert 0 < max_us <= total_us
+    assert st['cmds']['stat'][0] == 1
+    assert st['crypt_us'] == 0
+
+def test_notify_done(dev, need_keypress):
+    # opt-in unsolicited 'done' frame, after user approves; never instead of a reply
+    def llread(wait=3):
+        for _ in range(wait * 10):
+            rv = dev.dev.read(64, timeout_ms=100)
+            if rv:
+                return bytes(rv)
+
+    dev.send_recv(b'ntfy' + struct.pack('<I', 1), encrypt=False)
+    try:
+        dev.send_recv(CCProtocolPacker.sign_message(b'hello', 'm'), encrypt=False)
+
+        # still waiting on user: reply to poll, not the notification
+        assert dev.send_recv(CCProtocolPacker.get_signed_msg(), encrypt=False) is None
+        assert llread(wait=1) is None
+
+        need_keypress('y')
+
+        resp = llread()
+        assert resp and resp[0] == 0x80 | 4, resp
+        assert resp[1:5] == b'done'
+        assert llread(wait=1) is None
+
+        # result is then read as usual
+        addr, sig = dev.send_recv(CCProtocolPacker.get_signed_msg(), encrypt=False)
+        assert addr and 40 <= len(sig) <= 65
+    finally:
+        dev.send_recv(b'ntfy' + struct.pack('<I', 0), encrypt=False)
+
 def test_encryption(dev):
     "Setup session key and test link encryption works"
 
@@ -28,7 +28,10 @@ def start():
     # manage unix socket cleanup for client
     def cleanup():
         try:
-            os.unlink('/tmp/ckcc-simulator.sock')
+            if '--sock' in sys.argv:
+                os.unlink(sys.argv[sys.argv.index('--sock')+1])
+            else:
+                os.unlink('/tmp/ckcc-simulator.sock')
         except: pass
 
     cleanup()
@@ -35,6 +35,11 @@ import sim_mk4
 import sim_psram
 import sim_vdisk
 
+if '--perf' in sys.argv:
+    # add Mk4-like hardware delays
+    import sim_perf
+    sim_perf.install()
+
 if sys.argv[-1] != '-q':
     import main     # must be last, does not return
 
@@ -23,6 +23,9 @@ from binascii import b2a_hex, a2b_hex
 MPY_UNIX = 'l-port/micropython'
 
 UNIX_SOCKET_PATH = '/tmp/ckcc-simulator.sock'
+if '--sock' in sys.argv:
+    # alternate path, so several simulators can run at once (see testing/run_sim_tests.py)
+    UNIX_SOCKET_PATH = sys.argv[sys.argv.index('--sock')+1]
 
 # top-left coord of OLED area; size is 1:1 with real pixels... 128x64 pixels
 OLED_ACTIVE = (46, 85)
@@ -37,6 +40,7 @@ class OLEDSimulator:
 
     def __init__(self, factory):
         self.movie = None
+        self.last_buf = bytes(1024)
 
         s = factory.create_software_sprite( (128,64), bpp=32)
         self.sprite = s
@@ -52,6 +56,7 @@ class OLEDSimulator:
     def render(self, window, buf):
         # do a full-screen update of the OLED contents and display
         assert len(buf) == 1024, len(buf)
+        self.last_buf = bytes(buf)
 
         for y in range(0, 64, 8):
             line = buf[y*128//8:]
@@ -76,38 +81,56 @@ class OLEDSimulator:
         print("Snapshot saved: %s" % fn.split('/', 1)[1])
 
     def movie_start(self):
+        # only raw OLED contents are kept while recording, and only when they change;
+        # conversion to images is left until the end
         self.movie = []
-        self.last_frame = time.time() - 0.1
         print("Movie recording started.")
         self.new_frame()
 
     def movie_end(self):
         fn = time.strftime('../movie-%j-%H%M%S.gif')
-        from PIL import Image, ImageSequence
+        from PIL import Image
 
         if not self.movie: return
 
-        dt0, img = self.movie[0]
+        # each frame is shown until the next one arrived; last one for a second
+        frames = []
+        for n, (when, buf) in enumerate(self.movie):
+            nxt = self.movie[n+1][0] if n+1 < len(self.movie) else when + 1.0
+            frames.append((int((nxt - when) * 1000), self.frame_image(buf)))
 
-        img.save(fn, save_all=True, append_images=[fr for _,fr in self.movie[1:]],
-                        duration=[max(dt, 20) for dt,_ in self.movie], loop=50)
+        img = frames[0][1]
+        img.save(fn, save_all=True, append_images=[fr for _,fr in frames[1:]],
+                        duration=[max(dt, 20) for dt,_ in frames], loop=50)
 
-        print("Movie saved: %s (%d frames)" % (fn.split('/', 1)[1], len(self.movie)))
+        print("Movie saved: %s (%d frames)" % (fn.split('/', 1)[1], len(frames)))
 
         self.movie = None
 
     def new_frame(self):
+        # remember OLED contents, if they have changed since last frame
+        if self.movie and self.movie[-1][1] == self.last_buf:
+            return
+
+        self.movie.append((time.time(), self.last_buf))
+
+    @staticmethod
+    def frame_image(buf):
+        # 1024 bytes of OLED memory (8 pages of 128 columns, LSB at top) => palette image
         from PIL import Image
 
-        dt = int((time.time() - self.last_frame) * 1000)
-        self.last_frame = time.time()
+        px = bytearray(128*64)
+        for y in range(64):
+            pg, mask = (y // 8) * 128, 1 << (y % 8)
+            row = y * 128
+            for x in range(128):
+                if buf[pg + x] & mask:
+                    px[row + x] = 1
+
+        img = Image.frombytes('P', (128, 64), bytes(px))
+        img.putpalette([0x11, 0x11, 0x11,  0xcc, 0xcc, 0xff])      # same as bg, fg
 
-        with tempfile.NamedTemporaryFile() as tmp:
-            sdl2.SDL_SaveBMP(self.sprite.surface, tmp.name.encode('ascii'))
-            tmp.file.seek(0)
-            img = Image.open(tmp.file)
-            img = img.convert('P')
-            self.movie.append((dt, img))
+        return img
 
 class BareMetal:
     #
@@ -1,6 +1,26 @@
 # slow replacement for ARM assembly code module
 import ngu
 
+class _CTR:
+    # adds cipher_into() which ngu version lacks
+    def __init__(self, ctr):
+        self.ctr = ctr
+
+    def cipher(self, buf):
+        return self.ctr.cipher(buf)
+
+    def cipher_into(self, buf):
+        buf[0:len(buf)] = self.ctr.cipher(buf)
+
+    def copy(self):
+        return _CTR(self.ctr.copy())
+
+    def blank(self):
+        self.ctr.blank()
+
 def new(key, nonce=None):
-    return ngu.aes.CTR(key, nonce or bytes(16))
+    return _CTR(ngu.aes.CTR(key, nonce or bytes(16)))
 
+def backend():
+    # see external/c-modules/aes256ctr/module.c
+    return 'sw'
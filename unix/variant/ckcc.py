@@ -10,6 +10,9 @@ from ubinascii import hexlify as b2a_hex
 #import utime as time
 
 from uerrno import *
+
+# see hw_sha256.c: hash hardware on real Mk4, same API
+from uhashlib import sha256
 ERANGE = const(34)
 
 rng_fd = open('/dev/urandom', 'rb')
@@ -221,6 +224,187 @@ def vcp_enabled(_):
 def usb_active():
     pass
 
+def kdf_7zaes(salt, password, rounds_pow, progress_fcn=None):
+    # see hw_sha256.c for the real thing
+    if not (0 <= rounds_pow <= 24):
+        raise ValueError
+    rounds = 1 << rounds_pow
+
+    result = sha256()
+    for i in range(rounds):
+        if i % 1000 == 0 and progress_fcn:
+            progress_fcn(i/rounds)
+        result.update(salt)
+        result.update(password)
+        result.update(ustruct.pack('<Q', i))
+
+    return result.digest()
+
+def _read_compact_size(buf, pos):
+    # returns (value, new pos); see psbt_accel.c
+    b = buf[pos]
+    if b < 253:
+        return b, pos+1
+    if b == 253:
+        return ustruct.unpack_from('<H', buf, pos+1)[0], pos+3
+    if b == 254:
+        return ustruct.unpack_from('<I', buf, pos+1)[0], pos+5
+    raise ValueError('eof')
+
+def psbt_map_scan(buf, offset):
+    # see psbt_accel.c for the real thing
+    rv = []
+    end = len(buf)
+    if not (0 <= offset <= end):
+        raise ValueError
+
+    pos = offset
+    try:
+        while 1:
+            if pos == end:
+                # EOF, but no terminator
+                return rv, None
+
+            ks, pos = _read_compact_size(buf, pos)
+            if ks == 0:
+                break
+
+            key_pos = pos
+            pos += ks
+            if pos > end:
+                raise IndexError
+            vs, pos = _read_compact_size(buf, pos)
+            if pos + vs > end:
+                raise IndexError
+
+            rv.append((buf[key_pos], key_pos, ks, pos, vs))
+            pos += vs
+    except IndexError:
+        raise ValueError('eof')
+
+    return rv, pos
+
+def txn_vector_scan(buf, offset, count, is_input, want_list):
+    # see psbt_accel.c for the real thing
+    end = len(buf)
+    if not (0 <= offset <= end) or count < 0:
+        raise ValueError
+
+    prefix = (32+4) if is_input else 8
+    suffix = 4 if is_input else 0
+
+    rv = []
+    pos = offset
+    try:
+        for i in range(count):
+            obj = pos
+            pos += prefix
+            sl, pos = _read_compact_size(buf, pos)
+            if pos + sl + suffix > end:
+                raise IndexError
+            if want_list:
+                rv.append((obj, pos, sl))
+            pos += sl + suffix
+    except IndexError:
+        raise ValueError('eof')
+
+    return (rv, pos) if want_list else pos
+
+def bip32_paths_unpack(buf, vals, my_xfp):
+    # see psbt_accel.c for the real thing
+    rv = []
+    num_ours = num_zero = 0
+    for pos, ln in vals:
+        if pos < 0 or ln < 4 or (ln % 4) or pos + ln > len(buf):
+            raise ValueError
+        here = list(ustruct.unpack_from('<%dI' % (ln//4), buf, pos))
+        if here[0] == 0:
+            here[0] = my_xfp
+            num_zero += 1
+        if here[0] == my_xfp:
+            num_ours += 1
+        rv.append(here)
+
+    return rv, num_ours, num_zero
+
+def descriptor_checksum(desc):
+    # see descriptor_accel.c for the real thing
+    from descriptor import INPUT_CHARSET, CHECKSUM_CHARSET, polymod
+
+    c = 1
+    cls = clscount = 0
+    for ch in desc:
+        pos = INPUT_CHARSET.find(ch)
+        if pos == -1:
+            raise ValueError(ch)
+
+        c = polymod(c, pos & 31)
+        cls = cls * 3 + (pos >> 5)
+        clscount += 1
+        if clscount == 3:
+            c = polymod(c, cls)
+            cls = clscount = 0
+
+    if clscount:
+        c = polymod(c, cls)
+    for j in range(8):
+        c = polymod(c, 0)
+    c ^= 1
+
+    return ''.join(CHECKSUM_CHARSET[(c >> (5 * (7 - j))) & 31] for j in range(8))
+
+def pbkdf2_sha512(password, salt, iterations):
+    # see pbkdf2_sha512.c for the real thing
+    import ngu
+    if iterations < 1:
+        raise ValueError
+    return ngu.hash.pbkdf2_sha512(password, salt, iterations)
+
+def seed_xor(parts):
+    # see seed_xor.c for the real thing
+    vlen = len(parts[0])
+    if vlen not in (16, 24, 32) or any(len(p) != vlen for p in parts):
+        raise ValueError('length')
+
+    acc = bytearray(vlen)
+    for p in parts:
+        for i in range(vlen):
+            acc[i] ^= p[i]
+
+    # entropy then checksum bits, 11 bits per word
+    v = int.from_bytes(acc + sha256(acc).digest()[0:1], 'big')
+    num_words = (vlen * 8 + vlen // 4) // 11
+    shift = (vlen + 1) * 8
+
+    return acc, tuple((v >> (shift - 11*(i+1))) & 0x7ff for i in range(num_words))
+
+def c_heap_stats():
+    # simulator uses the real C heap; see c_heap.c
+    return (0, 0, 0, 0)
+
+# see cycle_prof.c; simulator counts microseconds, not cycles
+_prof = [[0, 0, 0] for i in range(16)]
+
+def prof_start(slot):
+    import utime
+    if 0 <= slot < len(_prof):
+        _prof[slot][2] = utime.ticks_us()
+
+def prof_stop(slot):
+    import utime
+    if 0 <= slot < len(_prof) and _prof[slot][2]:
+        s = _prof[slot]
+        s[0] += utime.ticks_diff(utime.ticks_us(), s[2])
+        s[1] += 1
+        s[2] = 0
+
+def prof_report():
+    return (1000000, [(t, c) for t, c, _ in _prof])
+
+def prof_reset():
+    for s in _prof:
+        s[:] = [0, 0, 0]
+
 def get_cpi_id():
     if ('--mk2' in sys.argv):
         return 0x2222       # don't know
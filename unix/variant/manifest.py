@@ -9,6 +9,7 @@ freeze_as_mpy('', [
 	'pyb.py',
 	'sim_mk4.py',
 	'sim_nfc.py',
+	'sim_perf.py',
 	'sim_psram.py',
 	'sim_quickstart.py',
 	'sim_secel.py',
@@ -29,6 +29,9 @@ class USB_HID:
     def __init__(self):
         self.pipe = None
         self.last_from = None
+        if '--sock' in sys.argv:
+            # see simulator.py
+            self.fn = sys.argv[sys.argv.index('--sock')+1].encode()
         self._open()
 
     def _open(self):
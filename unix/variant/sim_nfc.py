@@ -23,6 +23,8 @@ class SimulatedNFCHandler(NFCHandler):
 
     async def big_write(self, data):
         import os
+        if not isinstance(data, (bytes, bytearray)):
+            data = b''.join(bytes(ch) for ch in data)
         self.write(0, data)
         #n = open('nfc-dump.ndef', 'wb').write(self.dump_ndef())
         with open(DATA_FILE, 'wb') as ff:
@@ -0,0 +1,116 @@
+# (c) Copyright 2024 by Coinkite Inc. This file is covered by license found in COPYING-CC.
+#
+# sim_perf.py - "performance fidelity" mode: slow the simulator's hardware down to Mk4 speeds
+#
+# - enable with --perf on simulator command line
+# - delays are injected where the simulator stands in for hardware: secure elements
+#   (callgate), PSRAM, OLED over SPI, NFC over I2C, and SD card mount
+# - numbers are rough, from timing a real Mk4; tune with BareMetal (--metal) if needed
+# - interpreter itself still runs at desktop speed: no way to slow the VM from here
+#
+import sys, utime
+
+# microseconds per operation, or per byte
+SE_PIN_OP       = 1200000       # callgate PIN method: several SE1 and SE2 commands
+SE_PREFIX       = 150000        # anti-phishing words
+SE2_TRICK_OP    = 90000         # trick PIN actions
+PSRAM_PER_KB    = 25            # memory-mapped octo-SPI
+OLED_PER_BYTE   = 1             # SPI at ~8Mhz, plus overhead
+NFC_PER_BYTE    = 25            # I2C at 400khz
+SD_MOUNT        = 120000        # card power-up and FAT mount
+
+def _wait(us):
+    if us > 0:
+        utime.sleep_us(us)
+
+def _patch_gate():
+    import ckcc
+    orig = ckcc.gate
+    costs = {16: SE_PREFIX, 18: SE_PIN_OP, 22: SE2_TRICK_OP}
+
+    def gate(method, buf_io, arg2):
+        _wait(costs.get(method, 0))
+        return orig(method, buf_io, arg2)
+
+    ckcc.gate = gate
+
+def _patch_psram():
+    import sim_psram
+    cls = sim_psram.SimulatedPSRAMWrapper
+
+    o_read, o_write, o_read_at = cls.read, cls.write, cls.read_at
+
+    def read(self, address, buf, cmd=None):
+        _wait(len(buf) * PSRAM_PER_KB // 1024)
+        return o_read(self, address, buf, cmd)
+
+    def write(self, address, buf):
+        _wait(len(buf) * PSRAM_PER_KB // 1024)
+        return o_write(self, address, buf)
+
+    def read_at(self, offset, ln):
+        _wait(ln * PSRAM_PER_KB // 1024)
+        return o_read_at(self, offset, ln)
+
+    cls.read, cls.write, cls.read_at = read, write, read_at
+
+def _patch_oled():
+    import ssd1306
+    cls = ssd1306.SSD1306_SPI
+    orig = cls.write_data
+
+    def write_data(self, buf):
+        _wait(len(buf) * OLED_PER_BYTE)
+        return orig(self, buf)
+
+    cls.write_data = write_data
+
+def _patch_nfc(cls):
+    o_read, o_write, o_big_write = cls.read, cls.write, cls.big_write
+
+    def read(self, offset, count):
+        _wait(count * NFC_PER_BYTE)
+        return o_read(self, offset, count)
+
+    def write(self, offset, data):
+        _wait(len(data) * NFC_PER_BYTE)
+        return o_write(self, offset, data)
+
+    async def big_write(self, data):
+        if not isinstance(data, (bytes, bytearray)):
+            data = b''.join(bytes(ch) for ch in data)
+        _wait(len(data) * NFC_PER_BYTE)
+        return await o_big_write(self, data)
+
+    cls.read, cls.write, cls.big_write = read, write, big_write
+
+def _patch_sd():
+    import files
+    cls = files.CardSlot
+    orig = cls.__enter__
+
+    def enter(self):
+        _wait(SD_MOUNT)
+        return orig(self)
+
+    cls.__enter__ = enter
+
+def install():
+    _patch_gate()
+    _patch_psram()
+    _patch_oled()
+
+    # NFC and files modules pull in much of the system; wait until mk4.init0()
+    import mk4
+    orig_init0 = mk4.init0
+
+    def init0():
+        orig_init0()
+        _patch_nfc(sys.modules['nfc'].NFCHandler)
+        _patch_sd()
+
+    mk4.init0 = init0
+
+    print("Simulator: performance fidelity mode (--perf)")
+
+# EOF
@@ -10,7 +10,7 @@ SIMDIR_PATH = ckcc.get_sim_root_dirs()[0] + '/VirtDisk/'
 class SimBlockDev:
     # replace ckcc.PSRAM block device that's implemented in C
 
-    def __init__(self):
+    def __init__(self, lun=0):
         self.cb = None
         self.inserted = False
 
@@ -29,6 +29,19 @@ class SimBlockDev:
     def wipe(self):
         print("sim-virtdisk: wipe (not implemented)")
 
+    def split(self, en):
+        print("sim-virtdisk: outbox (not implemented)")
+
+    def changes(self):
+        # no block-level tracking here: always look
+        return True
+
+    def sha256(self, fname):
+        # (length, digest) of a file on the disk
+        from uhashlib import sha256
+        data = open(SIMDIR_PATH+fname, 'rb').read()
+        return len(data), sha256(data).digest()
+
     @classmethod
     async def monitor_task(cls, self):
         # works, but hard to manage the atask
@@ -64,6 +77,10 @@ class SimulatedVirtDisk(vdisk.VirtDisk):
         return list(sorted((SIMDIR_PATH+fn, get_filesize(SIMDIR_PATH+fn)) 
                                 for (fn,ty,_) in os.ilistdir(SIMDIR_PATH) if ty == 0x8000))
 
+    def set_outbox(self, enable):
+        # just the one directory here
+        print("sim-virtdisk: outbox (not implemented)")
+
     def mount(self, readonly=False):
         return SIMDIR_PATH[:-1]
 
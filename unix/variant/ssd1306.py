@@ -72,6 +72,10 @@ class SSD1306(framebuf.FrameBuffer):
         self.write_cmd(self.pages - 1)
         self.write_data(self.buffer)
 
+    def forget(self):
+        # always sending whole frames here
+        pass
+
 
 class SSD1306_SPI(SSD1306):
     def __init__(self, width, height, spi, dc, res, cs, external_vcc=False):
@@ -82,6 +86,9 @@ class SSD1306_SPI(SSD1306):
     def write_cmd(self, cmd):
         pass
 
+    def write_cmds(self, cmds):
+        pass
+
     def write_data(self, buf):
         self.pipe.write(buf)
 